@@ -0,0 +1,48 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include <memory>
+#include <string>
+#include "Core/Engine.h"
+#include "Profiling/Benchmark.h"
+//================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+// Usage: Benchmark [directory], where the reports get written to (the working directory by default)
+int main(int argc, char* argv[])
+{
+	// Synthetic worlds are built and ticked on the CPU, so there is no window or GPU involved
+	Engine::EngineMode_Enable(Engine_Headless);
+	auto engine = make_unique<Engine>(new Context);
+	engine->Initialize();
+
+	string directory = argc > 1 ? string(argv[1]) + "/" : "";
+	Benchmark benchmark(engine->GetContext());
+	bool success = benchmark.Run(Benchmark::GetDefaultScenes(), directory + "benchmark_scenes.json");
+	success = benchmark.Run_Systems(directory + "benchmark_systems.json") && success;
+
+	return success ? 0 : 1;
+}
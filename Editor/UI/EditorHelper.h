@@ -160,7 +160,7 @@ public:
 		// Save the scene asynchronously
 		m_context->GetSubsystem<Directus::Threading>()->AddTask([this, filePath]()
 		{
-			m_scene->SaveToFile(filePath);
+			m_scene->SaveToFile(filePath, Directus::World_Save_Incremental);
 		});
 	}
 
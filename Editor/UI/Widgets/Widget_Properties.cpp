@@ -525,7 +525,8 @@ void Widget_Properties::ShowCollider(shared_ptr<Collider>& collider)
 			"Cylinder",
 			"Capsule",
 			"Cone",
-			"Mesh"
+			"Mesh",
+			"Static Mesh"
 		};
 		auto shapeInt				= (int)collider->GetShapeType();
 		const char* shapeCharPtr	= type[shapeInt];
@@ -0,0 +1,237 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========
+#include "Allocators.h"
+#include <cstdlib>
+#include <algorithm>
+//======================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+#if ALLOCATION_TRACKING == 1
+// The engine is linked statically, so replacing the global operator new affects the whole executable
+// it ends up in (e.g. the editor), not just the engine. Heap counts include the allocations of the host.
+void* operator new(size_t size)
+{
+	Directus::Allocation_Counters::OnHeapAllocation(size);
+	if (void* ptr = malloc(size ? size : 1))
+		return ptr;
+
+	throw bad_alloc();
+}
+
+void* operator new(size_t size, align_val_t alignment)
+{
+	Directus::Allocation_Counters::OnHeapAllocation(size);
+	size = size ? size : 1;
+	#ifdef _MSC_VER
+	if (void* ptr = _aligned_malloc(size, (size_t)alignment))
+		return ptr;
+	#else
+	if (void* ptr = aligned_alloc((size_t)alignment, (size + (size_t)alignment - 1) / (size_t)alignment * (size_t)alignment))
+		return ptr;
+	#endif
+
+	throw bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, align_val_t) noexcept
+{
+	#ifdef _MSC_VER
+	_aligned_free(ptr);
+	#else
+	free(ptr);
+	#endif
+}
+#endif
+
+namespace Directus
+{
+	atomic<uint64_t> Allocation_Counters::m_heapAllocations		= 0;
+	atomic<uint64_t> Allocation_Counters::m_heapBytes			= 0;
+	atomic<uint64_t> Allocation_Counters::m_poolAllocations		= 0;
+	atomic<uint64_t> Allocation_Counters::m_poolChunkAllocations	= 0;
+
+	//= POOL ALLOCATOR ========================================================================================
+	Pool_Allocator::Pool_Allocator(size_t blockSize, size_t blockAlignment, unsigned int blocksPerChunk /*= 256*/)
+	{
+		// A free block stores the link to the next free block in place
+		m_blockAlignment	= max(blockAlignment, alignof(FreeBlock));
+		m_blockSize			= max(blockSize, sizeof(FreeBlock));
+		m_blockSize			= (m_blockSize + m_blockAlignment - 1) / m_blockAlignment * m_blockAlignment;
+		m_blocksPerChunk	= max(blocksPerChunk, 1u);
+		m_blocksInUse		= 0;
+		m_free				= nullptr;
+	}
+
+	Pool_Allocator::~Pool_Allocator()
+	{
+		// Blocks which are still in use (e.g. held by other statics) are leaked rather than left dangling
+		if (m_blocksInUse != 0)
+			return;
+
+		for (const auto chunk : m_chunks)
+		{
+			::operator delete(chunk, align_val_t(m_blockAlignment));
+		}
+	}
+
+	void* Pool_Allocator::Allocate()
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		if (!m_free)
+		{
+			AllocateChunk();
+		}
+
+		auto block	= m_free;
+		m_free		= block->next;
+		m_blocksInUse++;
+		Allocation_Counters::OnPoolAllocation();
+
+		return block;
+	}
+
+	void Pool_Allocator::Deallocate(void* block)
+	{
+		if (!block)
+			return;
+
+		lock_guard<mutex> lock(m_mutex);
+
+		auto freeBlock	= static_cast<FreeBlock*>(block);
+		freeBlock->next	= m_free;
+		m_free			= freeBlock;
+		m_blocksInUse--;
+	}
+
+	void Pool_Allocator::AllocateChunk()
+	{
+		auto chunk = static_cast<uint8_t*>(::operator new(m_blockSize * m_blocksPerChunk, align_val_t(m_blockAlignment)));
+		m_chunks.emplace_back(chunk);
+		Allocation_Counters::OnPoolChunkAllocation();
+
+		// Thread the new blocks into the free list, in address order
+		for (unsigned int i = m_blocksPerChunk; i-- > 0;)
+		{
+			auto block	= reinterpret_cast<FreeBlock*>(chunk + i * m_blockSize);
+			block->next	= m_free;
+			m_free		= block;
+		}
+	}
+	//=========================================================================================================
+
+	//= FRAME ARENA ===========================================================================================
+	namespace _Frame_Arena
+	{
+		static const size_t bufferAlignment = 64;
+		// Thread locals can't be exported, so the binding lives here rather than in the class
+		static thread_local Frame_Arena* bound = nullptr;
+	}
+
+	Frame_Arena& Frame_Arena::Get()
+	{
+		static Frame_Arena instance;
+		return _Frame_Arena::bound ? *_Frame_Arena::bound : instance;
+	}
+
+	Frame_Arena* Frame_Arena::Bind(Frame_Arena* arena)
+	{
+		Frame_Arena* previous	= _Frame_Arena::bound;
+		_Frame_Arena::bound		= arena;
+		return previous;
+	}
+
+	Frame_Arena::Frame_Arena(size_t capacity /*= 1024 * 1024*/)
+	{
+		m_capacity				= max(capacity, _Frame_Arena::bufferAlignment);
+		m_buffer				= static_cast<uint8_t*>(::operator new(m_capacity, align_val_t(_Frame_Arena::bufferAlignment)));
+		m_offset				= 0;
+		m_bytesLastFrame		= 0;
+		m_overflowsLastFrame	= 0;
+		m_overflowBytes			= 0;
+	}
+
+	Frame_Arena::~Frame_Arena()
+	{
+		Reset();
+		::operator delete(m_buffer, align_val_t(_Frame_Arena::bufferAlignment));
+	}
+
+	void* Frame_Arena::Allocate(size_t size, size_t alignment /*= alignof(max_align_t)*/)
+	{
+		size_t offset = m_offset.load(memory_order_relaxed);
+		while (true)
+		{
+			size_t start	= (offset + alignment - 1) / alignment * alignment;
+			size_t end		= start + size;
+			if (end > m_capacity || alignment > _Frame_Arena::bufferAlignment)
+				break;
+
+			if (m_offset.compare_exchange_weak(offset, end, memory_order_relaxed))
+				return m_buffer + start;
+		}
+
+		// Doesn't fit, fall back to the heap until the next reset
+		lock_guard<mutex> lock(m_overflowMutex);
+		alignment	= max(alignment, alignof(max_align_t));
+		void* ptr	= ::operator new(size, align_val_t(alignment));
+		m_overflow.emplace_back(ptr, alignment);
+		m_overflowBytes += size;
+
+		return ptr;
+	}
+
+	void Frame_Arena::Reset()
+	{
+		lock_guard<mutex> lock(m_overflowMutex);
+
+		size_t used				= min(m_offset.load(memory_order_relaxed), m_capacity);
+		m_bytesLastFrame		= used + m_overflowBytes;
+		m_overflowsLastFrame	= (unsigned int)m_overflow.size();
+		m_offset				= 0;
+
+		if (m_overflow.empty())
+			return;
+
+		for (const auto& overflow : m_overflow)
+		{
+			::operator delete(overflow.first, align_val_t(overflow.second));
+		}
+		m_overflow.clear();
+		m_overflowBytes = 0;
+
+		// Grow, so next frame fits
+		::operator delete(m_buffer, align_val_t(_Frame_Arena::bufferAlignment));
+		m_capacity	= max(m_capacity * 2, m_bytesLastFrame);
+		m_buffer	= static_cast<uint8_t*>(::operator new(m_capacity, align_val_t(_Frame_Arena::bufferAlignment)));
+	}
+	//=========================================================================================================
+}
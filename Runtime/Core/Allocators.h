@@ -0,0 +1,212 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "EngineDefs.h"
+//=========================
+
+// Count every allocation which goes through the global operator new. It replaces operator new and delete for
+// the whole executable the engine is linked into, so it's opt-in, define it as 1 when building to measure allocations.
+#ifndef ALLOCATION_TRACKING
+#define ALLOCATION_TRACKING 0
+#endif
+
+namespace Directus
+{
+	// Cumulative allocation counts, the Profiler turns them into per frame counts
+	class ENGINE_CLASS Allocation_Counters
+	{
+	public:
+		static uint64_t GetHeapAllocations()			{ return m_heapAllocations.load(std::memory_order_relaxed); }
+		static uint64_t GetHeapBytes()					{ return m_heapBytes.load(std::memory_order_relaxed); }
+		static uint64_t GetPoolAllocations()			{ return m_poolAllocations.load(std::memory_order_relaxed); }
+		static uint64_t GetPoolChunkAllocations()		{ return m_poolChunkAllocations.load(std::memory_order_relaxed); }
+		// Heap counts stay at zero unless the engine is built with ALLOCATION_TRACKING
+		static bool IsHeapTracked()						{ return ALLOCATION_TRACKING == 1; }
+
+		static void OnHeapAllocation(size_t size)
+		{
+			m_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+			m_heapBytes.fetch_add(size, std::memory_order_relaxed);
+		}
+		static void OnPoolAllocation()					{ m_poolAllocations.fetch_add(1, std::memory_order_relaxed); }
+		static void OnPoolChunkAllocation()				{ m_poolChunkAllocations.fetch_add(1, std::memory_order_relaxed); }
+
+	private:
+		static std::atomic<uint64_t> m_heapAllocations;
+		static std::atomic<uint64_t> m_heapBytes;
+		static std::atomic<uint64_t> m_poolAllocations;
+		static std::atomic<uint64_t> m_poolChunkAllocations;
+	};
+
+	// Hands out fixed-size blocks, which are carved out of chunks and recycled through a free list.
+	// Chunks are only allocated when the pool runs dry, so a pool which has settled never touches the heap.
+	class ENGINE_CLASS Pool_Allocator
+	{
+	public:
+		Pool_Allocator(size_t blockSize, size_t blockAlignment, unsigned int blocksPerChunk = 256);
+		~Pool_Allocator();
+
+		void* Allocate();
+		void Deallocate(void* block);
+
+		size_t GetBlockSize()				{ return m_blockSize; }
+		unsigned int GetBlocksInUse()		{ return m_blocksInUse; }
+		unsigned int GetChunkCount()		{ return (unsigned int)m_chunks.size(); }
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		void AllocateChunk();
+
+		size_t m_blockSize;
+		size_t m_blockAlignment;
+		unsigned int m_blocksPerChunk;
+		unsigned int m_blocksInUse;
+		FreeBlock* m_free;
+		std::vector<void*> m_chunks;
+		std::mutex m_mutex;
+	};
+
+	// An STL allocator backed by a pool per type, e.g. std::allocate_shared<Actor>(Pool_Allocator_Stl<Actor>(), ...) puts
+	// the actor and its reference counts in one block. Array allocations are rare and go to the heap (aligned for T, e.g. Matrix).
+	template <typename T>
+	class Pool_Allocator_Stl
+	{
+	public:
+		typedef T value_type;
+
+		Pool_Allocator_Stl() = default;
+		template <typename U>
+		Pool_Allocator_Stl(const Pool_Allocator_Stl<U>&) {}
+
+		T* allocate(size_t count)
+		{
+			if (count == 1)
+				return static_cast<T*>(GetPool().Allocate());
+
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+		}
+
+		void deallocate(T* ptr, size_t count)
+		{
+			if (count == 1)
+			{
+				GetPool().Deallocate(ptr);
+				return;
+			}
+
+			::operator delete(ptr, std::align_val_t(alignof(T)));
+		}
+
+		static Pool_Allocator& GetPool()
+		{
+			static Pool_Allocator pool(sizeof(T), alignof(T));
+			return pool;
+		}
+
+		template <typename U>
+		bool operator==(const Pool_Allocator_Stl<U>&) const { return true; }
+		template <typename U>
+		bool operator!=(const Pool_Allocator_Stl<U>&) const { return false; }
+	};
+
+	// A make_shared which allocates from the pool of T
+	template <typename T, typename... Args>
+	std::shared_ptr<T> Pool_MakeShared(Args&&... args)
+	{
+		return std::allocate_shared<T>(Pool_Allocator_Stl<T>(), std::forward<Args>(args)...);
+	}
+
+	// A linear allocator for scratch data which only lives for a frame. Allocating is a single atomic add,
+	// the whole arena is released at once by Reset(). Requests which don't fit go to the heap and the arena
+	// grows to fit them on the next Reset().
+	// The global arena belongs to the simulation side and the Engine resets it on EVENT_FRAME_END, while the
+	// render thread may still be drawing an older frame. Anything the render thread touches goes to the arena
+	// of its snapshot instead (see RenderSnapshot_Pipeline), which is bound to the thread while it's used.
+	class ENGINE_CLASS Frame_Arena
+	{
+	public:
+		// The arena bound to the calling thread, or the global one
+		static Frame_Arena& Get();
+		// Binds an arena to the calling thread (null for the global one), returns the previous one
+		static Frame_Arena* Bind(Frame_Arena* arena);
+
+		Frame_Arena(size_t capacity = 1024 * 1024);
+		~Frame_Arena();
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		template <typename T>
+		T* Allocate(unsigned int count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+		// Everything allocated since the previous reset becomes invalid
+		void Reset();
+
+		size_t GetCapacity()			{ return m_capacity; }
+		size_t GetBytesLastFrame()		{ return m_bytesLastFrame; }
+		unsigned int GetOverflowsLastFrame()	{ return m_overflowsLastFrame; }
+
+	private:
+		uint8_t* m_buffer;
+		size_t m_capacity;
+		std::atomic<size_t> m_offset;
+		size_t m_bytesLastFrame;
+		unsigned int m_overflowsLastFrame;
+
+		// Requests which didn't fit, along with their alignment
+		std::vector<std::pair<void*, size_t>> m_overflow;
+		size_t m_overflowBytes;
+		std::mutex m_overflowMutex;
+	};
+
+	// An STL allocator on top of the frame arena, e.g. std::vector<int, Frame_Allocator<int>>, the container must not outlive the frame
+	template <typename T>
+	class Frame_Allocator
+	{
+	public:
+		typedef T value_type;
+
+		Frame_Allocator() = default;
+		template <typename U>
+		Frame_Allocator(const Frame_Allocator<U>&) {}
+
+		T* allocate(size_t count)			{ return static_cast<T*>(Frame_Arena::Get().Allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t)			{}
+
+		template <typename U>
+		bool operator==(const Frame_Allocator<U>&) const { return true; }
+		template <typename U>
+		bool operator!=(const Frame_Allocator<U>&) const { return false; }
+	};
+}
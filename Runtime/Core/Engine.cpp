@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Timer.h"
 #include "Settings.h"
 #include "Stopwatch.h"
+#include "Allocators.h"
 #include "../Rendering/Renderer.h"
 #include "../Core/EventSystem.h"
 #include "../Logging/Log.h"
@@ -63,6 +64,9 @@ namespace Directus
 		FileSystem::Initialize();
 		Settings::Get().Initialize();
 
+		// Scratch memory only lives for a frame
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_END, [](const Variant&) { Frame_Arena::Get().Reset(); });
+
 		// Register subsystems
 		m_context->RegisterSubsystem(new Timer(m_context));
 		m_context->RegisterSubsystem(new Input(m_context));
@@ -80,6 +84,9 @@ namespace Directus
 		// The context will deallocate the subsystems
 		// in the reverse order in which they were registered.
 		SafeDelete(m_context);
+
+		// Write out whatever is still queued
+		Log::Shutdown();
 	}
 
 	bool Engine::Initialize()
@@ -92,8 +99,16 @@ namespace Directus
 			return false;
 		}
 	
+		// Headless runs are driven by a fixed delta time, so that they are reproducible
+		const bool headless = EngineMode_IsSet(Engine_Headless);
+		if (headless)
+		{
+			m_timer->SetFixedDeltaTimeMs(1000.0f / 60.0f);
+			LOG_INFO("Running headless, input, audio and the GPU device are disabled");
+		}
+
 		// Input
-		if (!m_context->GetSubsystem<Input>()->Initialize())
+		if (!headless && !m_context->GetSubsystem<Input>()->Initialize())
 		{
 			LOG_ERROR("Failed to initialize Input");
 			return false;
@@ -121,7 +136,7 @@ namespace Directus
 		}
 
 		// Audio
-		if (!m_context->GetSubsystem<Audio>()->Initialize())
+		if (!headless && !m_context->GetSubsystem<Audio>()->Initialize())
 		{
 			LOG_ERROR("Failed to initialize Audio");
 			return false;
@@ -157,8 +172,12 @@ namespace Directus
 	void Engine::Tick()
 	{
 		m_timer->Tick();
+		Log::Tick();
 		FIRE_EVENT(EVENT_FRAME_START);
 
+		// Events which other threads posted since the last frame
+		EventSystem::Get().Deferred_Dispatch();
+
 		if (EngineMode_IsSet(Engine_Update))
 		{
 			FIRE_EVENT_DATA(EVENT_TICK, m_timer->GetDeltaTimeSec());
@@ -172,6 +191,14 @@ namespace Directus
 		FIRE_EVENT(EVENT_FRAME_END);
 	}
 
+	void Engine::Tick(unsigned int frameCount)
+	{
+		for (unsigned int i = 0; i < frameCount; i++)
+		{
+			Tick();
+		}
+	}
+
 	void Engine::SetHandles(void* drawHandle, void* windowHandle, void* windowInstance)
 	{
 		Settings::Get().SetHandles(drawHandle, windowHandle, windowInstance);
@@ -25,10 +25,12 @@ namespace Directus
 {
 	enum Engine_Mode : unsigned long
 	{
-		Engine_Update	= 1UL << 0,	// Should the engine update?
-		Engine_Physics	= 1UL << 1, // Should the physics update?	
-		Engine_Render	= 1UL << 2,	// Should the engine render?
-		Engine_Game		= 1UL << 3,	// Is the engine running in game or editor mode?
+		Engine_Update		= 1UL << 0,	// Should the engine update?
+		Engine_Physics		= 1UL << 1, // Should the physics update?	
+		Engine_Render		= 1UL << 2,	// Should the engine render?
+		Engine_Game			= 1UL << 3,	// Is the engine running in game or editor mode?
+		Engine_Headless		= 1UL << 4,	// No window, input, audio or GPU, only the CPU-side work runs (must be set before the engine is created)
+		Engine_RenderThread	= 1UL << 5,	// Draw on a dedicated thread which consumes snapshots of the world (must be set before the engine is initialized)
 	};
 
 	class Timer;
@@ -45,6 +47,8 @@ namespace Directus
 
 		// Performs a complete simulation cycle
 		void Tick();
+		// Performs frameCount simulation cycles, with a fixed delta time if one is set (see Timer::SetFixedDeltaTimeMs)
+		void Tick(unsigned int frameCount);
 
 		//= ENGINE MODE FLAGS  =====================================================================================================
 		// Returns all engine mode flags
@@ -22,19 +22,28 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===============
-#include <map>
+#include <array>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include <functional>
 #include "../Core/Variant.h"
+#include "../Core/Allocators.h"
 //==========================
 
 /*
 HOW TO USE
-=============================================================================
-To subscribe a function to an event	-> SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
-To fire an event					-> FIRE_EVENT(EVENT_ID);
-To fire an event with data			-> FIRE_EVENT_DATA(EVENT_ID, Variant)
-=============================================================================
+=============================================================================================
+To subscribe a function to an event		-> SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
+To fire an event						-> FIRE_EVENT(EVENT_ID);
+To fire an event with data				-> FIRE_EVENT_DATA(EVENT_ID, Variant)
+To fire an event from any thread		-> FIRE_EVENT_DEFERRED(EVENT_ID) or
+										   FIRE_EVENT_DATA_DEFERRED(EVENT_ID, Variant)
+										   (dispatched on the main thread, at the start of the next frame)
+To fire/subscribe to a typed event		-> EventSystem::Get().Fire<Event_X>(payload)
+										   EventSystem::Get().Subscribe<Event_X>(handler)
+=============================================================================================
 */
 
 //= EVENTS =============================================================================================
@@ -50,20 +59,40 @@ To fire an event with data			-> FIRE_EVENT_DATA(EVENT_ID, Variant)
 #define EVENT_WORLD_SUBMIT			8	// Signifies that the World is submitting actors to the Renderer
 #define EVENT_WORLD_STOP			9	// Signifies that The World should stop ticking
 #define EVENT_WORLD_START			10	// Signifies that The World should start ticking
+
+#define EVENT_COUNT					11
 //======================================================================================================
 
-//= MACROS ===============================================================================================
-#define EVENT_HANDLER_STATIC(function)			[](Directus::Variant var)		{ function(); }
-#define EVENT_HANDLER(function)					[this](Directus::Variant var)	{ function(); }
-#define EVENT_HANDLER_VARIANT(function)			[this](Directus::Variant var)	{ function(var); }
-#define EVENT_HANDLER_VARIANT_STATIC(function)	[](Directus::Variant var)		{ function(var); }
-#define SUBSCRIBE_TO_EVENT(eventID, function)	Directus::EventSystem::Get().Subscribe(eventID, function);
-#define FIRE_EVENT(eventID)						Directus::EventSystem::Get().Fire(eventID)
-#define FIRE_EVENT_DATA(eventID, data)			Directus::EventSystem::Get().Fire(eventID, data)
-//========================================================================================================
+//= MACROS =====================================================================================================
+#define EVENT_HANDLER_STATIC(function)					[](const Directus::Variant& var)		{ function(); }
+#define EVENT_HANDLER(function)							[this](const Directus::Variant& var)	{ function(); }
+#define EVENT_HANDLER_VARIANT(function)					[this](const Directus::Variant& var)	{ function(var); }
+#define EVENT_HANDLER_VARIANT_STATIC(function)			[](const Directus::Variant& var)		{ function(var); }
+#define SUBSCRIBE_TO_EVENT(eventID, function)			Directus::EventSystem::Get().Subscribe(eventID, function);
+#define FIRE_EVENT(eventID)								Directus::EventSystem::Get().Fire(eventID)
+#define FIRE_EVENT_DATA(eventID, data)					Directus::EventSystem::Get().Fire(eventID, data)
+#define FIRE_EVENT_DEFERRED(eventID)					Directus::EventSystem::Get().Deferred_Fire(eventID)
+#define FIRE_EVENT_DATA_DEFERRED(eventID, data)			Directus::EventSystem::Get().Deferred_Fire(eventID, data)
+//==============================================================================================================
 
 namespace Directus
 {
+	// A compile-time typed event, the payload is passed by reference (no copies) and only has to outlive Fire()
+	template <int ID, class T>
+	struct Event
+	{
+		static const int id = ID;
+		typedef T Payload;
+	};
+	typedef Event<EVENT_WORLD_SUBMIT, std::vector<std::shared_ptr<Actor>>> Event_WorldSubmit;
+
+	// Returned by Subscribe(), can be used to unsubscribe
+	struct EventHandle
+	{
+		int eventID		= -1;
+		unsigned int id	= 0;
+	};
+
 	class ENGINE_CLASS EventSystem
 	{
 	public:
@@ -73,26 +102,215 @@ namespace Directus
 			return instance;
 		}
 
-		typedef std::function<void(Variant)> subscriber;
+		EventSystem() = default;
+		~EventSystem() { Clear(); }
+
+		typedef std::function<void(const Variant&)> subscriber;
+
+		// Subscribing and unsubscribing is meant for the main thread. It's safe from within a handler, a function
+		// subscribed while an event is firing only gets called by events fired after the outermost Fire() returns.
+		EventHandle Subscribe(int eventID, subscriber&& func)
+		{
+			EventHandle handle;
+			if (eventID < 0 || eventID >= EVENT_COUNT)
+				return handle;
+
+			handle.eventID	= eventID;
+			handle.id		= ++m_subscriberID;
+
+			// The vectors can't change while they are being iterated over (and their functions are executing)
+			std::lock_guard<std::mutex> lock(m_pendingMutex);
+			if (m_firing.load(std::memory_order_acquire) != 0)
+			{
+				m_pending.push_back({ eventID, { handle.id, std::forward<subscriber>(func) } });
+				m_pendingCount.store((unsigned int)m_pending.size(), std::memory_order_release);
+				return handle;
+			}
+
+			Subscribe_Insert(eventID, { handle.id, std::forward<subscriber>(func) });
+			return handle;
+		}
+
+		template <class T>
+		EventHandle Subscribe(std::function<void(const typename T::Payload&)>&& func)
+		{
+			return Subscribe(T::id, [func](const Variant& var) { func(*static_cast<const typename T::Payload*>(var.Get<void*>())); });
+		}
 
-		void Subscribe(int eventID, subscriber&& func)
+		// Safe to call from within a handler, the function is kept alive until its slot gets re-used
+		void Unsubscribe(const EventHandle& handle)
 		{
-			m_subscribers[eventID].push_back(std::forward<subscriber>(func));
+			if (handle.eventID < 0 || handle.eventID >= EVENT_COUNT)
+				return;
+
+			for (auto& subscriber : m_subscribers[handle.eventID])
+			{
+				if (subscriber.id == handle.id)
+				{
+					subscriber.id = 0;
+					return;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(m_pendingMutex);
+			for (auto& pending : m_pending)
+			{
+				if (pending.second.id == handle.id)
+				{
+					pending.second.id = 0;
+					return;
+				}
+			}
 		}
 
-		void Fire(int eventID, const Variant& data = 0)
+		void Fire(int eventID) { Fire(eventID, m_empty); }
+
+		void Fire(int eventID, const Variant& data)
 		{
-			if (m_subscribers.find(eventID) == m_subscribers.end())
+			if (eventID < 0 || eventID >= EVENT_COUNT)
 				return;
 
-			for (const auto& subscriber : m_subscribers[eventID])
+			m_firing.fetch_add(1, std::memory_order_acq_rel);
+			const auto& subscribers = m_subscribers[eventID];
+			for (size_t i = 0; i < subscribers.size(); i++)
+			{
+				if (subscribers[i].id != 0)
+				{
+					subscribers[i].function(data);
+				}
+			}
+
+			if (m_firing.fetch_sub(1, std::memory_order_acq_rel) == 1 && m_pendingCount.load(std::memory_order_acquire) != 0)
+			{
+				Subscribe_Pending();
+			}
+		}
+
+		template <class T>
+		void Fire(const typename T::Payload& payload)
+		{
+			Fire(T::id, Variant(const_cast<void*>(static_cast<const void*>(&payload))));
+		}
+
+		//= DEFERRED ========================================================================================
+		// Can be called from any thread, the data is copied into a pooled node and the event is fired by Deferred_Dispatch()
+		void Deferred_Fire(int eventID, const Variant& data = Variant())
+		{
+			auto event			= new (m_deferredPool.Allocate()) Deferred{ eventID, data, m_deferred.load(std::memory_order_relaxed) };
+			while (!m_deferred.compare_exchange_weak(event->next, event, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+
+		// Fires all the deferred events, in the order they were posted (the engine calls this at the start of every frame)
+		void Deferred_Dispatch()
+		{
+			// Take the whole list at once and reverse it, it was built newest first
+			Deferred* event		= m_deferred.exchange(nullptr, std::memory_order_acquire);
+			Deferred* ordered	= nullptr;
+			while (event)
+			{
+				auto next		= event->next;
+				event->next		= ordered;
+				ordered			= event;
+				event			= next;
+			}
+
+			while (ordered)
 			{
-				subscriber(data);
+				auto next = ordered->next;
+				Fire(ordered->eventID, ordered->data);
+				Deferred_Free(ordered);
+				ordered = next;
+			}
+		}
+		//===================================================================================================
+
+		void Clear()
+		{
+			for (auto& subscribers : m_subscribers)
+			{
+				subscribers.clear();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_pendingMutex);
+				m_pending.clear();
+				m_pendingCount = 0;
+			}
+
+			Deferred* event = m_deferred.exchange(nullptr);
+			while (event)
+			{
+				auto next = event->next;
+				Deferred_Free(event);
+				event = next;
 			}
 		}
-		void Clear() { m_subscribers.clear(); }
 
 	private:
-		std::map<uint8_t, std::vector<subscriber>> m_subscribers;
+		struct Subscriber
+		{
+			unsigned int id;	// 0 when unsubscribed
+			subscriber function;
+		};
+
+		struct Deferred
+		{
+			int eventID;
+			Variant data;
+			Deferred* next;
+		};
+
+		void Subscribe_Insert(int eventID, Subscriber&& _subscriber)
+		{
+			// Re-use the slot of an unsubscribed function, if any
+			auto& subscribers = m_subscribers[eventID];
+			for (auto& slot : subscribers)
+			{
+				if (slot.id == 0)
+				{
+					slot = std::move(_subscriber);
+					return;
+				}
+			}
+			subscribers.push_back(std::move(_subscriber));
+		}
+
+		// Subscribes the functions which were subscribed while firing
+		void Subscribe_Pending()
+		{
+			std::lock_guard<std::mutex> lock(m_pendingMutex);
+			if (m_firing.load(std::memory_order_acquire) != 0)
+				return;
+
+			for (auto& pending : m_pending)
+			{
+				if (pending.second.id != 0)
+				{
+					Subscribe_Insert(pending.first, std::move(pending.second));
+				}
+			}
+			m_pending.clear();
+			m_pendingCount.store(0, std::memory_order_release);
+		}
+
+		void Deferred_Free(Deferred* event)
+		{
+			event->~Deferred();
+			m_deferredPool.Deallocate(event);
+		}
+
+		std::array<std::vector<Subscriber>, EVENT_COUNT> m_subscribers;
+		std::atomic<Deferred*> m_deferred	= nullptr;
+		unsigned int m_subscriberID			= 0;
+		Variant m_empty;
+
+		// Functions subscribed while firing
+		std::vector<std::pair<int, Subscriber>> m_pending;
+		std::mutex m_pendingMutex;
+		std::atomic<unsigned int> m_pendingCount	= 0;
+		std::atomic<unsigned int> m_firing			= 0;
+
+		// Deferred events come and go every frame, so their nodes are recycled (declared last, it outlives Clear())
+		Pool_Allocator m_deferredPool{ sizeof(Deferred), alignof(Deferred), 64 };
 	};
 }
\ No newline at end of file
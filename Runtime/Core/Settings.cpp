@@ -90,6 +90,7 @@ namespace Directus
 			ReadSetting(SettingsIO::fin, "iAnisotropy",				m_anisotropy);
 			ReadSetting(SettingsIO::fin, "fFPSLimit",				m_fpsLimit);
 			ReadSetting(SettingsIO::fin, "iMaxThreadCount",			m_maxThreadCount);
+			ReadSetting(SettingsIO::fin, "iMaxFramesInFlight",		m_maxFramesInFlight);
 
 			m_resolution = Vector2(resolutionX, resolutionY);
 
@@ -125,6 +126,7 @@ namespace Directus
 			WriteSetting(SettingsIO::fout, "iAnisotropy",			m_anisotropy);
 			WriteSetting(SettingsIO::fout, "fFPSLimit",				m_fpsLimit);
 			WriteSetting(SettingsIO::fout, "iMaxThreadCount",		m_maxThreadCount);
+			WriteSetting(SettingsIO::fout, "iMaxFramesInFlight",	m_maxFramesInFlight);
 
 			// Close the file.
 			SettingsIO::fout.close();
@@ -135,6 +137,7 @@ namespace Directus
 		LOGF_INFO("Anisotropy: %d",			m_anisotropy);
 		LOGF_INFO("Max fps: %f",			m_fpsLimit);
 		LOGF_INFO("Max threads: %d",		m_maxThreadCount);
+		LOGF_INFO("Max frames in flight: %d",	m_maxFramesInFlight);
 	}
 
 	void Settings::DisplayMode_Add(unsigned int width, unsigned int height, unsigned int refreshRateNumerator, unsigned int refreshRateDenominator)
@@ -143,11 +143,14 @@ namespace Directus
 		const std::vector<DisplayAdapter>& DisplayAdapters_Get() { return m_displayAdapters; }
 		//==========================================================================================================
 
-		//= FPS =====================================
+		//= FPS ===========================================================================================
 		void FPS_SetLimit(float fps);
 		float FPS_GetLimit() { return m_fpsLimit; }
 		float FPS_GetTarget() { return m_fpsTarget; }
-		//===========================================
+		// How many frames the CPU may queue ahead of the GPU (lower means less input latency)
+		void FPS_SetMaxFramesInFlight(unsigned int frames)	{ m_maxFramesInFlight = frames < 1 ? 1 : frames; }
+		unsigned int FPS_GetMaxFramesInFlight()				{ return m_maxFramesInFlight; }
+		//=================================================================================================
 
 		//= MISC =====================================================================================
 		bool FullScreen_Get()									{ return m_isFullScreen; }
@@ -161,6 +164,12 @@ namespace Directus
 		unsigned int Gpu_GetMemory()							{ return m_primaryAdapter->memory; }
 		//============================================================================================
 
+		//= PHYSICS ==========================================================================================
+		// Bullet's multithreaded world (parallel narrowphase and constraint solving), read when physics initializes
+		void Physics_SetMultithreaded(bool multithreaded)	{ m_physicsMultithreaded = multithreaded; }
+		bool Physics_GetMultithreaded()						{ return m_physicsMultithreaded; }
+		//====================================================================================================
+
 		// Third party lib versions
 		std::string m_versionAngelScript;
 		std::string m_versionAssimp;
@@ -187,6 +196,8 @@ namespace Directus
 		float m_fpsLimit					= -1.0f;
 		float m_fpsTarget					= 165.0f;
 		FPS_Policy m_fpsPolicy				= FPS_MonitorMatch;
+		unsigned int m_maxFramesInFlight	= 2;
+		bool m_physicsMultithreaded			= false;
 
 		const DisplayAdapter* m_primaryAdapter = nullptr;
 		std::vector<DisplayMode> m_displayModes;
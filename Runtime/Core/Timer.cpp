@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Engine.h"
 #include "Settings.h"
 #include <thread>
+#include <cfloat>
 //===================
 
 //= NAMESPACES ========
@@ -35,29 +36,87 @@ namespace Directus
 {
 	Timer::Timer(Context* context) : Subsystem(context)
 	{
-		time_a			= high_resolution_clock::now();
-		time_b			= high_resolution_clock::now();
-		m_deltaTimeMs	= 0.0f;
+		m_frameStart	= steady_clock::now();
+		m_deadline		= m_frameStart;
 	}
 
 	void Timer::Tick()
 	{
-		// Compute work time
-		time_a								= high_resolution_clock::now();
-		duration<double, milli> time_work	= time_a - time_b;
-		
-		// Compute sleep time (fps limiting)
-		double maxFPS		= Settings::Get().FPS_GetLimit();
-		double minDt		= 1000.0 / maxFPS;
-		double dtRemaining	= minDt - time_work.count();
-		if (dtRemaining >  0)
+		if (m_fixedDeltaTimeMs > 0.0)
 		{
-			this_thread::sleep_for(milliseconds((int64_t)dtRemaining));
+			m_deltaTimeMs		= m_fixedDeltaTimeMs;
+			m_deltaTimeRawMs	= m_fixedDeltaTimeMs;
+			m_pacingErrorMs		= 0.0;
+			return;
+		}
+
+		// Fps limiting, the deadline advances by a fixed step so that errors don't accumulate
+		const double maxFPS	= Settings::Get().FPS_GetLimit();
+		const bool limited	= maxFPS > 0.0 && maxFPS < FLT_MAX;
+		if (limited)
+		{
+			const auto minDt = duration_cast<steady_clock::duration>(duration<double, milli>(1000.0 / maxFPS));
+			m_deadline += minDt;
+
+			// Too far behind (a hitch or a breakpoint), start over instead of rushing to catch up
+			const auto now = steady_clock::now();
+			if (now > m_deadline + minDt)
+			{
+				m_deadline = now;
+			}
+
+			Wait(m_deadline);
 		}
 
 		// Compute delta
-		time_b								= high_resolution_clock::now();
-		duration<double, milli> time_sleep	= time_b - time_a;
-		m_deltaTimeMs						= (time_work + time_sleep).count();
+		const auto frameStart	= steady_clock::now();
+		m_deltaTimeRawMs		= duration<double, milli>(frameStart - m_frameStart).count();
+		m_pacingErrorMs			= limited ? duration<double, milli>(frameStart - m_deadline).count() : 0.0;
+		m_frameStart			= frameStart;
+		m_deadline				= limited ? m_deadline : frameStart;
+
+		// Smooth delta
+		m_history[m_historyIndex]	= m_deltaTimeRawMs;
+		m_historyIndex				= (m_historyIndex + 1) % m_smoothingFrames;
+		m_historyCount				= m_historyCount < m_smoothingFrames ? m_historyCount + 1 : m_smoothingFrames;
+		double sum = 0.0;
+		for (unsigned int i = 0; i < m_historyCount; i++)
+		{
+			sum += m_history[i];
+		}
+		m_deltaTimeMs = sum / m_historyCount;
+	}
+
+	void Timer::SetDeltaSmoothing(unsigned int frames)
+	{
+		m_smoothingFrames	= frames < 1 ? 1 : (frames > m_smoothingFramesMax ? m_smoothingFramesMax : frames);
+		m_historyIndex		= 0;
+		m_historyCount		= 0;
+	}
+
+	void Timer::Wait(const steady_clock::time_point& deadline)
+	{
+		// Sleep in 1 ms slices while there is enough time left to absorb a late wake up
+		while (true)
+		{
+			const double remainingMs = duration<double, milli>(deadline - steady_clock::now()).count();
+			if (remainingMs <= GetSpinThresholdMs())
+				break;
+
+			const auto sleepStart = steady_clock::now();
+			this_thread::sleep_for(milliseconds(1));
+			const double sleptMs = duration<double, milli>(steady_clock::now() - sleepStart).count();
+
+			// Exponentially weighted mean and variance, so the estimate follows changes of the scheduler's resolution
+			const double delta	= sleptMs - m_sleepMeanMs;
+			m_sleepMeanMs		+= 0.05 * delta;
+			m_sleepVarianceMs	= 0.95 * (m_sleepVarianceMs + 0.05 * delta * delta);
+		}
+
+		// Spin for the remainder
+		while (steady_clock::now() < deadline)
+		{
+			this_thread::yield();
+		}
 	}
-}
+}
\ No newline at end of file
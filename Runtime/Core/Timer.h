@@ -24,10 +24,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =========
 #include "SubSystem.h"
 #include <chrono>
+#include <cmath>
 //====================
 
 namespace Directus
 {
+	// Measures the frame delta time and paces frames to the fps limit. Waiting is done against an absolute
+	// deadline on a monotonic clock, the thread sleeps while the remaining time is comfortably larger than
+	// what a sleep tends to overshoot by (estimated at runtime) and spins for the rest.
 	class ENGINE_CLASS Timer : public Subsystem
 	{
 	public:
@@ -35,12 +39,45 @@ namespace Directus
 		~Timer() {}
 
 		void Tick();
-		float GetDeltaTimeMs()	{ return (float)m_deltaTimeMs; }
-		float GetDeltaTimeSec() { return (float)m_deltaTimeMs / 1000.0f; }
 
-	private:		
-		std::chrono::high_resolution_clock::time_point time_a;
-		std::chrono::high_resolution_clock::time_point time_b;
-		double m_deltaTimeMs;
+		// Smoothed delta time (what the simulation should consume)
+		float GetDeltaTimeMs()		{ return (float)m_deltaTimeMs; }
+		float GetDeltaTimeSec()		{ return (float)m_deltaTimeMs / 1000.0f; }
+		// Measured delta time of the last frame
+		float GetDeltaTimeRawMs()	{ return (float)m_deltaTimeRawMs; }
+
+		// A non-zero fixed delta time replaces the measured one and disables fps limiting (deterministic runs, benchmarks)
+		void SetFixedDeltaTimeMs(float deltaTimeMs)	{ m_fixedDeltaTimeMs = deltaTimeMs; }
+		float GetFixedDeltaTimeMs()					{ return (float)m_fixedDeltaTimeMs; }
+
+		//= PACING ====================================================================================
+		// Number of frames the delta time is averaged over, 1 disables smoothing
+		void SetDeltaSmoothing(unsigned int frames);
+		unsigned int GetDeltaSmoothing()	{ return m_smoothingFrames; }
+		// How late (positive) or early (negative) the last frame started compared to its deadline
+		float GetPacingErrorMs()			{ return (float)m_pacingErrorMs; }
+		// Remaining time below which the pacer stops sleeping and spins
+		float GetSpinThresholdMs()			{ return (float)(m_sleepMeanMs + 2.0 * std::sqrt(m_sleepVarianceMs)); }
+		//=============================================================================================
+
+	private:
+		void Wait(const std::chrono::steady_clock::time_point& deadline);
+
+		static const unsigned int m_smoothingFramesMax = 16;
+
+		std::chrono::steady_clock::time_point m_frameStart;
+		std::chrono::steady_clock::time_point m_deadline;
+		double m_deltaTimeMs		= 0.0;
+		double m_deltaTimeRawMs		= 0.0;
+		double m_fixedDeltaTimeMs	= 0.0;
+		double m_pacingErrorMs		= 0.0;
+		// Running statistics of how long a 1 ms sleep actually takes
+		double m_sleepMeanMs		= 1.0;
+		double m_sleepVarianceMs	= 0.0;
+		// Delta time history
+		double m_history[m_smoothingFramesMax] = {};
+		unsigned int m_historyIndex		= 0;
+		unsigned int m_historyCount		= 0;
+		unsigned int m_smoothingFrames	= 4;
 	};
 }
\ No newline at end of file
@@ -253,6 +253,23 @@ namespace Directus
 		return result;
 	}
 
+	long long FileSystem::GetLastWriteTime(const string& filePath)
+	{
+		long long result = 0;
+		try
+		{
+			error_code error;
+			auto time = last_write_time(filePath, error);
+			result = error ? 0 : (long long)time.time_since_epoch().count();
+		}
+		catch (filesystem_error& e)
+		{
+			LOGF_ERROR("FileSystem::GetLastWriteTime: %s, %s", e.what(), filePath.c_str());
+		}
+
+		return result;
+	}
+
 	bool FileSystem::DeleteFile_(const string& filePath)
 	{
 		// If this is a directory path, return
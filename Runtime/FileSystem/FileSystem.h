@@ -41,6 +41,7 @@ static const char* EXTENSION_PREFAB			= ".prefab";
 static const char* EXTENSION_SHADER			= ".shader";
 static const char* EXTENSION_TEXTURE		= ".texture";
 static const char* EXTENSION_MESH			= ".mesh";
+static const char* EXTENSION_COLLISION		= ".collision";
 //=========================================================
 
 namespace Directus
@@ -62,6 +63,8 @@ namespace Directus
 		static bool FileExists(const std::string& filePath);
 		static bool DeleteFile_(const std::string& filePath);
 		static bool CopyFileFromTo(const std::string& source, const std::string& destination);
+		// Returns 0 if the file doesn't exist, only meaningful when compared against another call
+		static long long GetLastWriteTime(const std::string& filePath);
 		//====================================================================================
 
 		//= DIRECTORY PARSING  =================================================================
@@ -0,0 +1,248 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==========
+#include "Compression.h"
+#include <cstring>
+#include <cstdint>
+#include <vector>
+//=====================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _Compression
+	{
+		static const size_t minMatch		= 4;
+		static const size_t windowSize		= 65535;
+		// The format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+		static const size_t lastLiterals	= 5;
+		static const size_t matchLimit		= 12;
+		static const unsigned int hashBits	= 16;
+		static const unsigned int chainMax	= 64;
+		static const uint32_t empty			= 0xFFFFFFFF;
+
+		inline uint32_t Read32(const uint8_t* p)
+		{
+			uint32_t value;
+			memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t Hash(uint32_t sequence) { return (sequence * 2654435761U) >> (32 - hashBits); }
+
+		inline size_t MatchLength(const uint8_t* a, const uint8_t* b, const uint8_t* end)
+		{
+			const uint8_t* start = a;
+			while (a < end && *a == *b) { a++; b++; }
+			return a - start;
+		}
+
+		inline void WriteLength(uint8_t*& op, size_t length)
+		{
+			for (; length >= 255; length -= 255) { *op++ = 255; }
+			*op++ = (uint8_t)length;
+		}
+
+		// One sequence: token, literal run, back reference (none for the last sequence)
+		inline void WriteSequence(uint8_t*& op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+		{
+			uint8_t* token = op++;
+			*token = (uint8_t)((literalLength >= 15 ? 15 : literalLength) << 4);
+			if (literalLength >= 15) WriteLength(op, literalLength - 15);
+			if (literalLength) memcpy(op, literals, literalLength);
+			op += literalLength;
+
+			if (matchLength == 0)
+				return;
+
+			*op++ = (uint8_t)(offset & 0xFF);
+			*op++ = (uint8_t)(offset >> 8);
+			matchLength -= minMatch;
+			*token |= (uint8_t)(matchLength >= 15 ? 15 : matchLength);
+			if (matchLength >= 15) WriteLength(op, matchLength - 15);
+		}
+
+		inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+		{
+			uint8_t value;
+			do
+			{
+				if (ip >= end)
+					return false;
+
+				value	= *ip++;
+				length	+= value;
+			} while (value == 255);
+
+			return true;
+		}
+	}
+
+	size_t Compression::Compress(const std::byte* source, size_t size, std::byte* destination, Compression_Level level)
+	{
+		using namespace _Compression;
+
+		const auto src		= reinterpret_cast<const uint8_t*>(source);
+		auto op				= reinterpret_cast<uint8_t*>(destination);
+		const auto opStart	= op;
+		size_t anchor		= 0;
+
+		if (size > matchLimit)
+		{
+			const size_t ipLimit	= size - matchLimit;
+			const uint8_t* matchEnd	= src + size - lastLiterals;
+			vector<uint32_t> head(size_t(1) << hashBits, empty);
+			vector<uint32_t> chain(level == Compression_High ? windowSize + 1 : 0, empty);
+
+			auto Insert = [&](size_t position)
+			{
+				uint32_t& slot = head[Hash(Read32(src + position))];
+				if (!chain.empty()) chain[position % chain.size()] = slot;
+				slot = (uint32_t)position;
+			};
+
+			size_t ip		= 0;
+			unsigned misses	= 0;
+			while (ip < ipLimit)
+			{
+				// Find the longest match among the candidates (just one in fast mode)
+				size_t matchLength		= 0;
+				size_t matchPosition	= 0;
+				uint32_t candidate		= head[Hash(Read32(src + ip))];
+				for (unsigned int attempt = 0; candidate != empty && ip - candidate <= windowSize && attempt < chainMax; attempt++)
+				{
+					if (Read32(src + candidate) == Read32(src + ip))
+					{
+						size_t length = minMatch + MatchLength(src + ip + minMatch, src + candidate + minMatch, matchEnd);
+						if (length > matchLength)
+						{
+							matchLength		= length;
+							matchPosition	= candidate;
+						}
+					}
+
+					if (chain.empty())
+						break;
+
+					uint32_t next = chain[candidate % chain.size()];
+					if (next == empty || next >= candidate)
+						break;
+					candidate = next;
+				}
+
+				if (matchLength < minMatch)
+				{
+					Insert(ip);
+					// Skip faster through data that doesn't compress
+					ip += level == Compression_Fast ? 1 + (misses++ >> 6) : 1;
+					continue;
+				}
+
+				misses = 0;
+				WriteSequence(op, src + anchor, ip - anchor, ip - matchPosition, matchLength);
+
+				// Positions covered by the match become candidates too (all of them in high mode, the last one in fast mode)
+				size_t matchStop = ip + matchLength;
+				if (level == Compression_High)
+				{
+					for (; ip < matchStop && ip < ipLimit; ip++) { Insert(ip); }
+				}
+				else
+				{
+					Insert(ip);
+					if (matchStop - 2 < ipLimit) Insert(matchStop - 2);
+				}
+				ip		= matchStop;
+				anchor	= ip;
+			}
+		}
+
+		// Last literals
+		WriteSequence(op, src + anchor, size - anchor, 0, 0);
+
+		return op - opStart;
+	}
+
+	bool Compression::Decompress(const std::byte* source, size_t size, std::byte* destination, size_t sizeDecompressed)
+	{
+		using namespace _Compression;
+
+		auto ip			= reinterpret_cast<const uint8_t*>(source);
+		const auto end	= ip + size;
+		auto op			= reinterpret_cast<uint8_t*>(destination);
+		const auto opStart	= op;
+		const auto opEnd	= op + sizeDecompressed;
+
+		while (ip < end)
+		{
+			// Literals
+			const uint8_t token		= *ip++;
+			size_t literalLength	= token >> 4;
+			if (literalLength == 15 && !ReadLength(ip, end, literalLength))
+				return false;
+
+			if (literalLength > (size_t)(end - ip) || literalLength > (size_t)(opEnd - op))
+				return false;
+
+			if (literalLength) memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// The last sequence has no back reference
+			if (ip == end)
+				break;
+
+			// Back reference
+			if (end - ip < 2)
+				return false;
+
+			size_t offset = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > (size_t)(op - opStart))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(ip, end, matchLength))
+				return false;
+			matchLength += minMatch;
+
+			if (matchLength > (size_t)(opEnd - op))
+				return false;
+
+			// When the match overlaps what it produces, the pattern is copied in doubling chunks so no copy overlaps
+			const uint8_t* match = op - offset;
+			while (matchLength > 0)
+			{
+				size_t length = (size_t)(op - match) < matchLength ? (size_t)(op - match) : matchLength;
+				memcpy(op, match, length);
+				op			+= length;
+				matchLength	-= length;
+			}
+		}
+
+		return op == opEnd;
+	}
+}
@@ -0,0 +1,54 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <cstddef>
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	enum Compression_Level
+	{
+		// Single probe match search, compresses at hundreds of MB/s
+		Compression_Fast,
+		// Searches chains of previous matches, several times slower to compress but smaller, decompresses just as fast
+		Compression_High
+	};
+
+	// Block compression in the LZ4 block format (literal runs and back references within a 64 KB window).
+	// Decompression is bounds checked, so corrupted or truncated data fails instead of reading or writing out of range.
+	class ENGINE_CLASS Compression
+	{
+	public:
+		// The largest size compressing "size" bytes can produce
+		static size_t Bound(size_t size) { return size + size / 255 + 16; }
+
+		// Returns the compressed size, "destination" has to hold at least Bound(size) bytes
+		static size_t Compress(const std::byte* source, size_t size, std::byte* destination, Compression_Level level);
+
+		// Succeeds only if the data decompresses to exactly "sizeDecompressed" bytes
+		static bool Decompress(const std::byte* source, size_t size, std::byte* destination, size_t sizeDecompressed);
+	};
+}
@@ -19,9 +19,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+
 //= INCLUDES ===================
 #include "FileStream.h"
-#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include "Compression.h"
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -39,38 +43,150 @@ using namespace Directus::Math;
 
 namespace Directus
 {
-	FileStream::FileStream(const string& path, FileStreamMode mode)
+	namespace _FileStream
 	{
-		m_isOpen = false;
-		m_mode = mode;
+		static const uint32_t magic			= 0x31534644; // "DFS1"
+		static const size_t bufferSize		= 1024 * 1024;
+		// Containers grow by at most this much per step while reading, so a corrupted length
+		// runs out of data and fails instead of allocating everything it claims up front
+		static const uint64_t readStepBytes	= 16 * 1024 * 1024;
+
+		struct BlockHeader
+		{
+			uint32_t sizeRaw;
+			// Equal to sizeRaw when the block didn't compress and is stored as is
+			uint32_t sizeStored;
+		};
+
+		template <typename Container>
+		void ReadContainer(FileStream* stream, Container* container)
+		{
+			using T = typename Container::value_type;
+
+			uint64_t length = 0;
+			stream->Read(&length);
+
+			container->clear();
+			const uint64_t step = max<uint64_t>(1, readStepBytes / sizeof(T));
+			for (uint64_t done = 0; done < length && !stream->HasFailed();)
+			{
+				auto count = (size_t)min(step, length - done);
+				container->resize((size_t)done + count);
+				stream->Read(container->data() + done, count * sizeof(T));
+				done += count;
+			}
+
+			if (stream->HasFailed())
+			{
+				container->clear();
+			}
+		}
+	}
+
+	FileStream::FileStream(const string& path, FileStreamMode mode, FileStreamCompression compression)
+	{
+		m_path	= path;
+		m_mode	= mode;
 
 		if (mode == FileStreamMode_Write)
 		{
-			out.open(path, ios::out | ios::binary);
+			out.open(filesystem::u8path(path), ios::out | ios::binary);
 			if (out.fail())
 			{
 				LOGF_ERROR("Failed to open \"%s\" for writing", path.c_str());
 				return;
 			}
+
+			m_compression = compression;
+			const uint32_t header[2] = { _FileStream::magic, (uint32_t)compression };
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
 		}
 		else if (mode == FileStreamMode_Read)
 		{
-			in.open(path, ios::in | ios::binary);
+			in.open(filesystem::u8path(path), ios::in | ios::binary);
 			if(in.fail())
 			{
 				LOGF_ERROR("Failed to open \"%s\" for reading", path.c_str());
 				return;
 			}
+
+			uint32_t header[2] = { 0, 0 };
+			in.read(reinterpret_cast<char*>(header), sizeof(header));
+			if (in.gcount() != sizeof(header) || header[0] != _FileStream::magic || header[1] > FileStreamCompression_High)
+			{
+				LOGF_ERROR("\"%s\" is not a supported file", path.c_str());
+				return;
+			}
+			m_compression = (FileStreamCompression)header[1];
 		}
+		else if (mode == FileStreamMode_Append)
+		{
+			// An existing file keeps its header, blocks are self-contained so they can simply follow the existing ones
+			uint32_t header[2]	= { _FileStream::magic, (uint32_t)compression };
+			bool exists			= false;
+			{
+				ifstream existing(filesystem::u8path(path), ios::in | ios::binary);
+				if (existing.is_open())
+				{
+					existing.read(reinterpret_cast<char*>(header), sizeof(header));
+					auto count = existing.gcount();
+					if (count != 0 && (count != sizeof(header) || header[0] != _FileStream::magic || header[1] > FileStreamCompression_High))
+					{
+						LOGF_ERROR("\"%s\" is not a supported file", path.c_str());
+						return;
+					}
+					exists = count != 0;
+				}
+			}
 
+			out.open(filesystem::u8path(path), ios::out | ios::binary | ios::app);
+			if (out.fail())
+			{
+				LOGF_ERROR("Failed to open \"%s\" for appending", path.c_str());
+				return;
+			}
+
+			m_compression = (FileStreamCompression)header[1];
+			if (!exists)
+			{
+				out.write(reinterpret_cast<const char*>(header), sizeof(header));
+			}
+		}
+
+		m_buffer.resize(_FileStream::bufferSize);
+		if (m_compression != FileStreamCompression_None)
+		{
+			m_bufferCompressed.resize(Compression::Bound(_FileStream::bufferSize));
+		}
 		m_isOpen = true;
 	}
 
+	FileStream::FileStream(vector<std::byte>* buffer)
+	{
+		m_mode		= FileStreamMode_Write;
+		m_memoryOut	= buffer;
+		m_isOpen	= buffer != nullptr;
+	}
+
+	FileStream::FileStream(const std::byte* data, size_t size)
+	{
+		m_mode			= FileStreamMode_Read;
+		m_memoryIn		= data;
+		m_memorySize	= data ? size : 0;
+		m_isOpen		= data != nullptr;
+	}
+
 	FileStream::~FileStream()
 	{
-		if (m_mode == FileStreamMode_Write)
+		if (m_memoryOut || m_memoryIn)
+			return;
+
+		if (m_mode == FileStreamMode_Write || m_mode == FileStreamMode_Append)
 		{
-			out.flush();
+			if (m_isOpen && !Buffer_Flush())
+			{
+				LOGF_ERROR("Failed to write \"%s\"", m_path.c_str());
+			}
 			out.close();
 		}
 		else if (m_mode == FileStreamMode_Read)
@@ -80,110 +196,262 @@ namespace Directus
 		}
 	}
 
-	void FileStream::Write(const string& value)
+	bool FileStream::IsAtEnd()
 	{
-		auto length = (unsigned int)value.length();
-		Write(length);
+		if (m_memoryIn)
+			return m_failed || m_memoryPosition == m_memorySize;
+
+		if (m_mode != FileStreamMode_Read || !m_isOpen || m_failed)
+			return true;
 
-		out.write(const_cast<char*>(value.c_str()), length);
+		return m_bufferPosition == m_bufferEnd && in.peek() == char_traits<char>::eof();
 	}
 
-	void FileStream::Write(const vector<string>& value)
+	void FileStream::Write(const void* data, size_t size)
+	{
+		auto bytes = reinterpret_cast<const std::byte*>(data);
+
+		if (m_memoryOut)
+		{
+			m_memoryOut->insert(m_memoryOut->end(), bytes, bytes + size);
+			return;
+		}
+
+		if (!m_isOpen)
+			return;
+
+		while (size > 0)
+		{
+			// Large uncompressed writes skip the buffer
+			if (m_compression == FileStreamCompression_None && m_bufferPosition == 0 && size >= m_buffer.size())
+			{
+				out.write(reinterpret_cast<const char*>(bytes), size);
+				return;
+			}
+
+			size_t count = min(size, m_buffer.size() - m_bufferPosition);
+			memcpy(m_buffer.data() + m_bufferPosition, bytes, count);
+			m_bufferPosition	+= count;
+			bytes				+= count;
+			size				-= count;
+
+			if (m_bufferPosition == m_buffer.size())
+			{
+				Buffer_Flush();
+			}
+		}
+	}
+
+	void FileStream::Read(void* data, size_t size)
 	{
-		auto size = (unsigned int)value.size();
-		Write(size);
+		auto bytes = reinterpret_cast<std::byte*>(data);
 
-		for (unsigned int i = 0; i < size; i++)
+		if (m_memoryIn && !m_failed)
 		{
-			Write(value[i]);
+			if (size <= m_memorySize - m_memoryPosition)
+			{
+				memcpy(bytes, m_memoryIn + m_memoryPosition, size);
+				m_memoryPosition += size;
+				return;
+			}
+			Fail();
+		}
+
+		while (size > 0 && m_isOpen && !m_failed)
+		{
+			if (m_bufferPosition == m_bufferEnd)
+			{
+				// Large uncompressed reads skip the buffer
+				if (m_compression == FileStreamCompression_None && size >= m_buffer.size())
+				{
+					in.read(reinterpret_cast<char*>(bytes), size);
+					auto count	= (size_t)in.gcount();
+					bytes		+= count;
+					size		-= count;
+					if (size > 0) Fail();
+					break;
+				}
+
+				if (!Buffer_Fill())
+				{
+					Fail();
+					break;
+				}
+			}
+
+			size_t count = min(size, m_bufferEnd - m_bufferPosition);
+			memcpy(bytes, m_buffer.data() + m_bufferPosition, count);
+			m_bufferPosition	+= count;
+			bytes				+= count;
+			size				-= count;
+		}
+
+		// Whatever couldn't be read
+		if (size > 0)
+		{
+			memset(bytes, 0, size);
+		}
+	}
+
+	bool FileStream::Buffer_Flush()
+	{
+		if (m_bufferPosition == 0)
+			return true;
+
+		if (m_compression == FileStreamCompression_None)
+		{
+			out.write(reinterpret_cast<const char*>(m_buffer.data()), m_bufferPosition);
+		}
+		else
+		{
+			auto level		= m_compression == FileStreamCompression_High ? Compression_High : Compression_Fast;
+			auto sizeStored	= Compression::Compress(m_buffer.data(), m_bufferPosition, m_bufferCompressed.data(), level);
+			auto stored		= sizeStored < m_bufferPosition;
+
+			_FileStream::BlockHeader header = { (uint32_t)m_bufferPosition, (uint32_t)(stored ? sizeStored : m_bufferPosition) };
+			out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			out.write(reinterpret_cast<const char*>(stored ? m_bufferCompressed.data() : m_buffer.data()), header.sizeStored);
+		}
+
+		m_bufferPosition = 0;
+		return !out.fail();
+	}
+
+	bool FileStream::Buffer_Fill()
+	{
+		m_bufferPosition	= 0;
+		m_bufferEnd			= 0;
+
+		if (m_compression == FileStreamCompression_None)
+		{
+			in.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+			m_bufferEnd = (size_t)in.gcount();
+			return m_bufferEnd > 0;
+		}
+
+		_FileStream::BlockHeader header;
+		in.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (in.gcount() != sizeof(header) || header.sizeRaw == 0 || header.sizeRaw > m_buffer.size() || header.sizeStored > header.sizeRaw)
+			return false;
+
+		// Blocks which didn't compress are read straight into the buffer
+		const bool compressed	= header.sizeStored < header.sizeRaw;
+		auto destination		= compressed ? m_bufferCompressed.data() : m_buffer.data();
+		in.read(reinterpret_cast<char*>(destination), header.sizeStored);
+		if ((size_t)in.gcount() != header.sizeStored)
+			return false;
+
+		if (compressed && !Compression::Decompress(m_bufferCompressed.data(), header.sizeStored, m_buffer.data(), header.sizeRaw))
+			return false;
+
+		m_bufferEnd = header.sizeRaw;
+		return true;
+	}
+
+	void FileStream::Fail()
+	{
+		if (!m_failed)
+		{
+			LOGF_ERROR("Failed to read \"%s\", the data is truncated or corrupted", m_memoryIn ? "memory" : m_path.c_str());
+		}
+		m_failed = true;
+	}
+
+	void FileStream::Write(const string& value)
+	{
+		Write((uint64_t)value.length());
+		Write(value.data(), value.length());
+	}
+
+	void FileStream::Write(const vector<string>& value)
+	{
+		Write((uint64_t)value.size());
+		for (const auto& str : value)
+		{
+			Write(str);
 		}
 	}
 
 	void FileStream::Write(const Vector2& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector2));
+		Write(&value, sizeof(Vector2));
 	}
 
 	void FileStream::Write(const Vector3& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector3));
+		Write(&value, sizeof(Vector3));
 	}
 
 	void FileStream::Write(const Vector4& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector4));
+		Write(&value, sizeof(Vector4));
 	}
 
 	void FileStream::Write(const Quaternion& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Quaternion));
+		Write(&value, sizeof(Quaternion));
 	}
 
 	void FileStream::Write(const BoundingBox& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(BoundingBox));
+		Write(&value, sizeof(BoundingBox));
 	}
 
 	void FileStream::Write(const vector<RHI_Vertex_PosUvNorTan>& value)
 	{
-		auto length = (unsigned int)value.size();
-		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosUvNorTan) * length);
+		Write((uint64_t)value.size());
+		Write(value.data(), sizeof(RHI_Vertex_PosUvNorTan) * value.size());
 	}
 
 	void FileStream::Write(const vector<unsigned int>& value)
 	{
-		auto length = (unsigned int)value.size();
-		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned int) * length);
+		Write((uint64_t)value.size());
+		Write(value.data(), sizeof(unsigned int) * value.size());
 	}
 
 	void FileStream::Write(const vector<unsigned char>& value)
 	{
-		auto size = (unsigned int)value.size();
-		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
+		Write((uint64_t)value.size());
+		Write(value.data(), sizeof(unsigned char) * value.size());
 	}
 
 	void FileStream::Write(const vector<std::byte>& value)
 	{
-		auto size = (unsigned int)value.size();
-		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+		Write((uint64_t)value.size());
+		Write(value.data(), sizeof(std::byte) * value.size());
 	}
 
 	void FileStream::Read(string* value)
 	{
-		unsigned int length = 0;
-		Read(&length);
+		if (!value)
+			return;
 
-		value->resize(length);
-		in.read(const_cast<char*>(value->c_str()), length);
+		_FileStream::ReadContainer(this, value);
 	}
 
 	void FileStream::Read(Vector2* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector2));
+		Read(value, sizeof(Vector2));
 	}
 
 	void FileStream::Read(Vector3* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector3));
+		Read(value, sizeof(Vector3));
 	}
 
 	void FileStream::Read(Vector4* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector4));
+		Read(value, sizeof(Vector4));
 	}
 
 	void FileStream::Read(Quaternion* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Quaternion));
+		Read(value, sizeof(Quaternion));
 	}
 
 	void FileStream::Read(BoundingBox* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(BoundingBox));
+		Read(value, sizeof(BoundingBox));
 	}
 
 	void FileStream::Read(vector<string>* vec)
@@ -192,16 +460,19 @@ namespace Directus
 			return;
 
 		vec->clear();
-		vec->shrink_to_fit();
 
-		unsigned int size = 0;
+		uint64_t size = 0;
 		Read(&size);
 
-		string str;
-		for (unsigned int i = 0; i < size; i++)
+		for (uint64_t i = 0; i < size && !m_failed; i++)
+		{
+			vec->emplace_back();
+			Read(&vec->back());
+		}
+
+		if (m_failed)
 		{
-			Read(&str);
-			vec->emplace_back(str);
+			vec->clear();
 		}
 	}
 
@@ -210,15 +481,7 @@ namespace Directus
 		if (!vec)
 			return;
 
-		vec->clear();
-		vec->shrink_to_fit();
-
-		unsigned int length = ReadUInt();
-
-		vec->reserve(length);
-		vec->resize(length);
-
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosUvNorTan) * length);
+		_FileStream::ReadContainer(this, vec);
 	}
 
 	void FileStream::Read(vector<unsigned int>* vec)
@@ -226,15 +489,7 @@ namespace Directus
 		if (!vec)
 			return;
 
-		vec->clear();
-		vec->shrink_to_fit();
-
-		unsigned int length = ReadUInt();
-
-		vec->reserve(length);
-		vec->resize(length);
-
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned int) * length);
+		_FileStream::ReadContainer(this, vec);
 	}
 
 	void FileStream::Read(vector<unsigned char>* vec)
@@ -242,15 +497,7 @@ namespace Directus
 		if (!vec)
 			return;
 
-		vec->clear();
-		vec->shrink_to_fit();
-
-		unsigned int length = ReadUInt();
-
-		vec->reserve(length);
-		vec->resize(length);
-
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+		_FileStream::ReadContainer(this, vec);
 	}
 
 	void FileStream::Read(vector<std::byte>* vec)
@@ -258,14 +505,6 @@ namespace Directus
 		if (!vec)
 			return;
 
-		vec->clear();
-		vec->shrink_to_fit();
-
-		unsigned int length = ReadUInt();
-
-		vec->reserve(length);
-		vec->resize(length);
-
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+		_FileStream::ReadContainer(this, vec);
 	}
 }
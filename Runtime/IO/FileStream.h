@@ -21,10 +21,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES =====
+//= INCLUDES ======
 #include <vector>
+#include <string>
 #include <fstream>
-//================
+#include <cstdint>
+//=================
 
 namespace Directus
 {
@@ -42,16 +44,43 @@ namespace Directus
 	enum FileStreamMode
 	{
 		FileStreamMode_Read,
-		FileStreamMode_Write
+		FileStreamMode_Write,
+		// Writes to the end of an existing file (or creates it), keeping the compression the file was created with
+		FileStreamMode_Append
 	};
 
+	// Selected per file when writing, stored in the file so reading picks it up
+	enum FileStreamCompression
+	{
+		FileStreamCompression_None,
+		// Fast to write and read, for files that are saved often
+		FileStreamCompression_Fast,
+		// Slower to write but smaller and just as fast to read, for files that are written once and read many times
+		FileStreamCompression_High
+	};
+
+	// Binary stream, file I/O goes through a large buffer and, if compressed, is compressed in blocks of that size.
+	// Lengths are 64-bit. Reading past the end of the data (e.g. a truncated file) fails the stream, the read
+	// and every read after it yield zeros or empty containers and HasFailed() returns true.
+
 	class FileStream
 	{
 	public:
-		FileStream(const std::string& path, FileStreamMode mode);
+		FileStream(const std::string& path, FileStreamMode mode, FileStreamCompression compression = FileStreamCompression_None);
+		// Memory stream which appends everything written to it to the buffer
+		FileStream(std::vector<std::byte>* buffer);
+		// Memory stream which reads from the data, the data has to outlive the stream
+		FileStream(const std::byte* data, size_t size);
 		~FileStream();
 
-		bool IsOpen() { return m_isOpen; }
+		bool IsOpen()		{ return m_isOpen; }
+		bool HasFailed()	{ return m_failed; }
+		// True once a reading stream has consumed all of its data
+		bool IsAtEnd();
+		// Version of the format the data was written in, for readers of older data.
+		// Streams whose owner doesn't set it are read as the latest format.
+		void SetVersion(unsigned int version)	{ m_version = version; }
+		unsigned int GetVersion()				{ return m_version; }
 
 		//= WRITING ==================================================
 		template <class T, class = typename std::enable_if<
@@ -70,9 +99,11 @@ namespace Directus
 		>::type>
 		void Write(T value)
 		{
-			out.write(reinterpret_cast<char*>(&value), sizeof(value));
+			Write(&value, sizeof(value));
 		}
 
+		void Write(const void* data, size_t size);
+
 		void Write(const std::string& value);
 		void Write(const Math::Vector2& value);
 		void Write(const Math::Vector3& value);
@@ -103,9 +134,11 @@ namespace Directus
 		>::type>
 			void Read(T* value)
 		{
-			in.read(reinterpret_cast<char*>(value), sizeof(T));
+			Read(value, sizeof(T));
 		}
 
+		void Read(void* data, size_t size);
+
 		void Read(std::string* value);	
 		void Read(Math::Vector2* value);
 		void Read(Math::Vector3* value);
@@ -135,9 +168,29 @@ namespace Directus
 		//==========================================================
 
 	private:
+		bool Buffer_Flush();
+		bool Buffer_Fill();
+		void Fail();
+
 		std::ofstream out;
 		std::ifstream in;
+		std::string m_path;
 		FileStreamMode m_mode;
-		bool m_isOpen;
+		FileStreamCompression m_compression	= FileStreamCompression_None;
+		bool m_isOpen						= false;
+		bool m_failed						= false;
+		unsigned int m_version				= 4294967295;
+
+		// File buffer, holds written bytes which haven't been flushed yet or read bytes which haven't been consumed yet
+		std::vector<std::byte> m_buffer;
+		std::vector<std::byte> m_bufferCompressed;
+		size_t m_bufferPosition	= 0;
+		size_t m_bufferEnd		= 0;
+
+		// Memory streams
+		std::vector<std::byte>* m_memoryOut	= nullptr;
+		const std::byte* m_memoryIn			= nullptr;
+		size_t m_memorySize					= 0;
+		size_t m_memoryPosition				= 0;
 	};
 }
@@ -185,6 +185,9 @@ namespace Directus
 
 	void Input::Tick()
 	{
+		if (Engine::EngineMode_IsSet(Engine_Headless))
+			return;
+
 		m_keys_previous = m_keys;
 		HWND windowHandle = (HWND)Settings::Get().GetWindowHandle();
 
@@ -24,8 +24,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ILogger.h"
 #include <fstream>
 #include <stdarg.h>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
 #include "../World/Actor.h"
-#include "../FileSystem/FileSystem.h"
 //===================================
 
 //= NAMESPACES ================
@@ -35,49 +39,348 @@ using namespace Directus::Math;
 
 namespace Directus
 {
-	weak_ptr<ILogger> Log::m_logger;
-	ofstream Log::m_fout;
-	mutex Log::m_mutex;
-	string Log::m_callerName;
-	string Log::m_logFileName	= "log.txt";
-	bool Log::m_firstLog		= true;
+	namespace Log_Async
+	{
+		struct Entry
+		{
+			Log_Type type		= Log_Info;
+			unsigned int thread	= 0;
+			uint64_t frame		= 0;
+			double timeSec		= 0.0;
+			const char* caller	= nullptr;
+			string text;
+		};
+
+		// Bounded multi-producer queue, every cell carries a sequence number which tells
+		// producers and the consumer whose turn it is, so neither side ever takes a lock.
+		static const size_t CAPACITY = 8192;
+		struct Cell
+		{
+			atomic<size_t> sequence;
+			Entry entry;
+		};
+
+		struct Backend
+		{
+			Backend()
+			{
+				for (size_t i = 0; i < CAPACITY; i++)
+				{
+					cells[i].sequence.store(i, memory_order_relaxed);
+				}
+				start = chrono::steady_clock::now();
+			}
+
+			void Push(Entry&& entry)
+			{
+				size_t pos = enqueue.load(memory_order_relaxed);
+				Cell* cell = nullptr;
+				while (true)
+				{
+					cell				= &cells[pos & (CAPACITY - 1)];
+					const size_t seq	= cell->sequence.load(memory_order_acquire);
+					const intptr_t diff	= (intptr_t)seq - (intptr_t)pos;
+					if (diff == 0)
+					{
+						if (enqueue.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+							break;
+					}
+					else if (diff < 0)
+					{
+						// Full, let the writer catch up
+						condition.notify_one();
+						this_thread::yield();
+						pos = enqueue.load(memory_order_relaxed);
+					}
+					else
+					{
+						pos = enqueue.load(memory_order_relaxed);
+					}
+				}
+
+				cell->entry = move(entry);
+				cell->sequence.store(pos + 1, memory_order_release);
+
+				// Only pay for a wake up when the writer is actually waiting
+				if (sleeping.load(memory_order_relaxed) && sleeping.exchange(false, memory_order_acq_rel))
+				{
+					condition.notify_one();
+				}
+			}
+
+			// Consumer side, only called by the writer thread
+			bool Pop(Entry& entry)
+			{
+				Cell& cell = cells[dequeue & (CAPACITY - 1)];
+				if (cell.sequence.load(memory_order_acquire) != dequeue + 1)
+					return false;
+
+				entry = move(cell.entry);
+				cell.sequence.store(dequeue + CAPACITY, memory_order_release);
+				dequeue++;
+				return true;
+			}
+
+			// Fails once stopped, the writer thread only runs once
+			bool Start()
+			{
+				lock_guard<mutex> guard(threadMutex);
+				if (running.load(memory_order_acquire))
+					return true;
+
+				if (stopped)
+					return false;
+
+				// Start with a fresh log file every run (the file isn't deleted through the FileSystem as that could log)
+				file.open(fileName, ofstream::out | (fileOpened ? ofstream::app : ofstream::trunc));
+				fileOpened = true;
+
+				running.store(true, memory_order_release);
+				thread = std::thread(&Backend::Run, this);
+				return true;
+			}
+
+			void Stop()
+			{
+				lock_guard<mutex> guard(threadMutex);
+				stopped = true;
+				if (!running.load(memory_order_acquire))
+					return;
+
+				running.store(false, memory_order_release);
+				condition.notify_one();
+				thread.join();
+				file.close();
+			}
+
+			void Run()
+			{
+				vector<Entry> batch;
+				string text;
+				while (true)
+				{
+					// Take everything which is available
+					Entry entry;
+					while (Pop(entry))
+					{
+						batch.emplace_back(move(entry));
+					}
+
+					if (batch.empty())
+					{
+						if (!running.load(memory_order_acquire))
+							break;
+
+						// A missed wake up only costs the timeout
+						unique_lock<mutex> lock(conditionMutex);
+						sleeping.store(true, memory_order_release);
+						condition.wait_for(lock, chrono::milliseconds(10));
+						sleeping.store(false, memory_order_relaxed);
+						continue;
+					}
+
+					// Format and write the whole batch at once
+					text.clear();
+					for (const auto& e : batch)
+					{
+						char prefix[96];
+						snprintf(prefix, sizeof(prefix), "[%08.3f][%llu][T%u] %s ", e.timeSec, (unsigned long long)e.frame, e.thread, (e.type == Log_Info) ? "Info:" : (e.type == Log_Warning) ? "Warning:" : "Error:");
+						text += prefix;
+						if (e.caller)
+						{
+							text += e.caller;
+							text += ": ";
+						}
+						text += e.text;
+						text += '\n';
+					}
+					file << text;
+					file.flush();
+
+					// Entries for the logger are handed over by Tick()
+					if (hasLogger.load(memory_order_acquire))
+					{
+						lock_guard<mutex> guard(loggerMutex);
+						for (auto& e : batch)
+						{
+							pending.emplace_back(e.caller ? string(e.caller) + ": " + e.text : move(e.text), e.type);
+						}
+					}
+
+					written.fetch_add(batch.size(), memory_order_release);
+					batch.clear();
+				}
+			}
+
+			Cell cells[CAPACITY];
+			atomic<size_t> enqueue		= 0;
+			size_t dequeue				= 0;
+			atomic<uint64_t> pushed		= 0;
+			atomic<uint64_t> written	= 0;
+			atomic<bool> running		= false;
+			atomic<bool> sleeping		= false;
+			mutex threadMutex;
+			mutex conditionMutex;
+			condition_variable condition;
+			std::thread thread;
+			bool stopped = false;
+			ofstream file;
+			string fileName	= "log.txt";
+			bool fileOpened	= false;
+			chrono::steady_clock::time_point start;
+
+			// Logger hand over
+			weak_ptr<ILogger> logger;
+			atomic<bool> hasLogger = false;
+			mutex loggerMutex;
+			vector<pair<string, Log_Type>> pending;
+		};
+
+		// Never destroyed, stopping joins the writer thread and that can't happen during static destruction
+		// (it deadlocks under the loader lock when the engine is unloaded). The Engine stops it via Log::Shutdown().
+		Backend& Get()
+		{
+			static Backend* backend = new Backend();
+			return *backend;
+		}
+
+		atomic<uint64_t> g_frame						= 0;
+		atomic<unsigned int> g_threadCount				= 0;
+		thread_local const char* t_caller				= nullptr;
+		thread_local unsigned int t_thread				= 0;
+		thread_local bool t_threadAssigned				= false;
+
+		inline void FormatAndWrite(const char* text, va_list args, Log_Type type)
+		{
+			char buffer[1024];
+			vsnprintf(buffer, sizeof(buffer), text, args);
+			Log::Write(buffer, type);
+		}
+	}
+
+	atomic<int> Log::m_level = Log_Info;
 
 	void Log::SetLogger(const weak_ptr<ILogger>& logger)
 	{
-		m_logger = logger;
+		auto& backend = Log_Async::Get();
+		lock_guard<mutex> guard(backend.loggerMutex);
+		backend.logger = logger;
+		backend.hasLogger.store(!logger.expired(), memory_order_release);
+	}
+
+	void Log::SetCaller(const char* caller)
+	{
+		Log_Async::t_caller = caller;
+	}
+
+	void Log::Tick()
+	{
+		Log_Async::g_frame.fetch_add(1, memory_order_relaxed);
+
+		auto& backend = Log_Async::Get();
+		if (!backend.hasLogger.load(memory_order_acquire))
+			return;
+
+		vector<pair<string, Log_Type>> pending;
+		shared_ptr<ILogger> logger;
+		{
+			lock_guard<mutex> guard(backend.loggerMutex);
+			pending.swap(backend.pending);
+			logger = backend.logger.lock();
+		}
+
+		if (!logger)
+			return;
+
+		for (const auto& entry : pending)
+		{
+			logger->Log(entry.first, entry.second);
+		}
+	}
+
+	void Log::Flush()
+	{
+		auto& backend		= Log_Async::Get();
+		const auto target	= backend.pushed.load(memory_order_acquire);
+		while (backend.running.load(memory_order_acquire) && backend.written.load(memory_order_acquire) < target)
+		{
+			backend.condition.notify_one();
+			this_thread::yield();
+		}
+	}
+
+	void Log::Shutdown()
+	{
+		Flush();
+		Log_Async::Get().Stop();
+	}
+
+	void Log::Write(const char* text, Log_Type type)
+	{
+		if (!IsEnabled(type))
+		{
+			Log_Async::t_caller = nullptr;
+			return;
+		}
+
+		if (!Log_Async::t_threadAssigned)
+		{
+			Log_Async::t_thread			= Log_Async::g_threadCount.fetch_add(1, memory_order_relaxed);
+			Log_Async::t_threadAssigned	= true;
+		}
+
+		// Entries written after Shutdown() are discarded
+		auto& backend = Log_Async::Get();
+		if (!backend.running.load(memory_order_acquire) && !backend.Start())
+		{
+			Log_Async::t_caller = nullptr;
+			return;
+		}
+
+		Log_Async::Entry entry;
+		entry.type		= type;
+		entry.thread	= Log_Async::t_thread;
+		entry.frame		= Log_Async::g_frame.load(memory_order_relaxed);
+		entry.timeSec	= chrono::duration<double>(chrono::steady_clock::now() - backend.start).count();
+		entry.caller	= Log_Async::t_caller;
+		entry.text		= text;
+		Log_Async::t_caller = nullptr;
+
+		backend.pushed.fetch_add(1, memory_order_relaxed);
+		backend.Push(move(entry));
 	}
 
 	void Log::WriteFInfo(const char* text, ...)
 	{
-		char buffer[1024];
+		if (!IsEnabled(Log_Info))
+			return;
+
 		va_list args;
 		va_start(args, text);
-		int w = vsnprintf(buffer, sizeof(buffer), text, args);
+		Log_Async::FormatAndWrite(text, args, Log_Info);
 		va_end(args);
-
-		Write(buffer, Log_Info);
 	}
 
 	void Log::WriteFWarning(const char* text, ...)
 	{
-		char buffer[1024];
+		if (!IsEnabled(Log_Warning))
+			return;
+
 		va_list args;
 		va_start(args, text);
-		int w = vsnprintf(buffer, sizeof(buffer), text, args);
+		Log_Async::FormatAndWrite(text, args, Log_Warning);
 		va_end(args);
-
-		Write(buffer, Log_Warning);
 	}
 
 	void Log::WriteFError(const char* text, ...)
 	{
-		char buffer[1024];
+		if (!IsEnabled(Log_Error))
+			return;
+
 		va_list args;
 		va_start(args, text);
-		int w = vsnprintf(buffer, sizeof(buffer), text, args);
+		Log_Async::FormatAndWrite(text, args, Log_Error);
 		va_end(args);
-
-		Write(buffer, Log_Error);
 	}
 
 	void Log::Write(const weak_ptr<Actor>& actor, Log_Type type)
@@ -87,56 +390,26 @@ namespace Directus
 
 	void Log::Write(const Math::Vector2& value, Log_Type type)
 	{
-		Write(value.ToString(), type);
+		if (IsEnabled(type)) Write(value.ToString(), type);
 	}
 
 	void Log::Write(const Math::Vector3& value, Log_Type type)
 	{
-		Write(value.ToString(), type);
+		if (IsEnabled(type)) Write(value.ToString(), type);
 	}
 
 	void Log::Write(const Math::Vector4& value, Log_Type type)
 	{
-		Write(value.ToString(), type);
+		if (IsEnabled(type)) Write(value.ToString(), type);
 	}
 
 	void Log::Write(const Math::Quaternion& value, Log_Type type)
 	{
-		Write(value.ToString(), type);
+		if (IsEnabled(type)) Write(value.ToString(), type);
 	}
 
 	void Log::Write(const Math::Matrix& value, Log_Type type)
 	{
-		Write(value.ToString(), type);
-	}
-
-	void Log::LogString(const char* text, Log_Type type)
-	{
-		lock_guard<mutex> guard(m_mutex);
-		m_logger.lock()->Log(string(text), type);
-	}
-
-	void Log::LogToFile(const char* text, Log_Type type)
-	{
-		lock_guard<mutex> guard(m_mutex);
-
-		string prefix		= (type == Log_Info) ? "Info:" : (type == Log_Warning) ? "Warning:" : "Error:";
-		string finalText	= prefix + " " + text;
-
-		// Delete the previous log file (if it exists)
-		if (m_firstLog)
-		{
-			FileSystem::DeleteFile_(m_logFileName);
-			m_firstLog = false;
-		}
-
-		// Open/Create a log file to write the error message to.
-		m_fout.open(m_logFileName, ofstream::out | ofstream::app);
-
-		// Write out the error message.
-		m_fout << finalText << endl;
-
-		// Close the file.
-		m_fout.close();
+		if (IsEnabled(type)) Write(value.ToString(), type);
 	}
-}
\ No newline at end of file
+}
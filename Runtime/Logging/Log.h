@@ -24,25 +24,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <string>
 #include <memory>
-#include <mutex>
+#include <atomic>
 #include "../Core/EngineDefs.h"
 //=============================
 
 namespace Directus
 {
-	// Macros
-	#define LOG_INFO(text)			{ Log::m_callerName = __FUNCTION__; Log::Write(text, Log_Type::Log_Info); }
-	#define LOG_WARNING(text)		{ Log::m_callerName = __FUNCTION__; Log::Write(text, Log_Type::Log_Warning); }
-	#define LOG_ERROR(text)			{ Log::m_callerName = __FUNCTION__; Log::Write(text, Log_Type::Log_Error); }
-	#define LOGF_INFO(text, ...)	{ Log::m_callerName = __FUNCTION__; Log::WriteFInfo(text, __VA_ARGS__); }
-	#define LOGF_WARNING(text, ...)	{ Log::m_callerName = __FUNCTION__; Log::WriteFWarning(text, __VA_ARGS__); }
-	#define LOGF_ERROR(text, ...)	{ Log::m_callerName = __FUNCTION__; Log::WriteFError(text, __VA_ARGS__); }
+	// Macros, the severity is checked before the text is evaluated or formatted
+	#define LOG_INFO(text)			{ if (Log::IsEnabled(Log_Info))		{ Log::SetCaller(__FUNCTION__); Log::Write(text, Log_Type::Log_Info); } }
+	#define LOG_WARNING(text)		{ if (Log::IsEnabled(Log_Warning))	{ Log::SetCaller(__FUNCTION__); Log::Write(text, Log_Type::Log_Warning); } }
+	#define LOG_ERROR(text)			{ if (Log::IsEnabled(Log_Error))	{ Log::SetCaller(__FUNCTION__); Log::Write(text, Log_Type::Log_Error); } }
+	#define LOGF_INFO(text, ...)	{ if (Log::IsEnabled(Log_Info))		{ Log::SetCaller(__FUNCTION__); Log::WriteFInfo(text, __VA_ARGS__); } }
+	#define LOGF_WARNING(text, ...)	{ if (Log::IsEnabled(Log_Warning))	{ Log::SetCaller(__FUNCTION__); Log::WriteFWarning(text, __VA_ARGS__); } }
+	#define LOGF_ERROR(text, ...)	{ if (Log::IsEnabled(Log_Error))	{ Log::SetCaller(__FUNCTION__); Log::WriteFError(text, __VA_ARGS__); } }
 
 	// Pre-Made
 	#define LOG_ERROR_INVALID_PARAMETER() LOG_ERROR("Invalid parameter.")
 
 	// Forward declarations
 	class Actor;
+	class ILogger;
 	namespace Math
 	{
 		class Quaternion;
@@ -59,20 +60,33 @@ namespace Directus
 		Log_Error
 	};
 
+	// Logging is asynchronous. Write() pushes an entry (severity, thread, frame, timestamp, caller and text)
+	// into a lock-free queue, a background thread formats the entries and appends them to the log file
+	// in batches. Entries for an ILogger are handed over on the thread which calls Tick().
 	class ENGINE_CLASS Log
 	{
 		friend class ILogger;
 	public:
-		// Set a logger to be used (if not set, logging will done in a text file.
+		// Set a logger to be used (entries are always written to the log file as well)
 		static void SetLogger(const std::weak_ptr<ILogger>& logger);
 
+		// Entries below this severity are discarded before they are formatted
+		static void SetLevel(Log_Type level)	{ m_level = level; }
+		static Log_Type GetLevel()				{ return (Log_Type)m_level.load(std::memory_order_relaxed); }
+		static bool IsEnabled(Log_Type type)	{ return type >= m_level.load(std::memory_order_relaxed); }
+
+		// The function name which the next entry of the calling thread is attributed to
+		static void SetCaller(const char* caller);
+
+		// Advances the frame number and hands pending entries over to the logger (main thread, once per frame)
+		static void Tick();
+		// Blocks until every entry written so far is in the log file
+		static void Flush();
+		// Flushes and stops the writer thread for good, entries written afterwards are discarded (the Engine calls it on teardown)
+		static void Shutdown();
+
 		// const char*
-		static void Write(const char* text, Log_Type type) 
-		{ 
-			std::string formatedText = !m_callerName.empty() ? m_callerName + ": " + std::string(text) : std::string(text);
-			!m_logger.expired() ? LogString(formatedText.c_str(), type) : LogToFile(formatedText.c_str(), type);
-			m_callerName.clear();
-		}
+		static void Write(const char* text, Log_Type type);
 		static void WriteFInfo(const char* text, ...);
 		static void WriteFWarning(const char* text, ...);
 		static void WriteFError(const char* text, ...);
@@ -94,7 +108,10 @@ namespace Directus
 		>::type>
 		static void Write(T value, Log_Type type)
 		{
-			Write(to_string(value), type);
+			if (!IsEnabled(type))
+				return;
+
+			Write(std::to_string(value), type);
 		}
 
 		// Math
@@ -105,21 +122,12 @@ namespace Directus
 		static void Write(const Math::Matrix& value, Log_Type type);
 
 		// Manually handled types
-		static void Log::Write(bool value, Log_Type type)								{ Write(value ? "True" : "False", type); }
+		static void Write(bool value, Log_Type type)									{ Write(value ? "True" : "False", type); }
 		template<typename T> static void Write(std::weak_ptr<T> ptr, Log_Type type)		{ Write(ptr.expired() ? "Expired" : typeid(ptr).name(), type); }
 		template<typename T> static void Write(std::shared_ptr<T> ptr, Log_Type type)	{ Write(ptr ? typeid(ptr).name() : "Null", type); }
 		static void Write(const std::weak_ptr<Actor>& actor, Log_Type type);
 
-		static std::string m_callerName;
-
 	private:
-		static void LogString(const char* text, Log_Type type);
-		static void LogToFile(const char* text, Log_Type type);
-
-		static std::weak_ptr<ILogger> m_logger;
-		static std::ofstream m_fout;
-		static std::mutex m_mutex;
-		static std::string m_logFileName;
-		static bool m_firstLog;
+		static std::atomic<int> m_level;
 	};
-}
+}
\ No newline at end of file
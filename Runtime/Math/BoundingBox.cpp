@@ -47,19 +47,84 @@ namespace Directus::Math
 
 	BoundingBox::BoundingBox(const std::vector<RHI_Vertex_PosUvNorTan>& vertices)
 	{
-		m_min = Vector3::Infinity;
-		m_max = Vector3::InfinityNeg;
+		*this = vertices.empty() ? BoundingBox() : FromPoints(&vertices[0].pos[0], (unsigned int)vertices.size(), sizeof(RHI_Vertex_PosUvNorTan));
+	}
+
+	BoundingBox BoundingBox::FromPoints(const float* positions, unsigned int count, unsigned int stride)
+	{
+		BoundingBox box;
+		if (!positions || count == 0)
+			return box;
+
+		const uint8_t* stream = reinterpret_cast<const uint8_t*>(positions);
+
+		#if MATH_SIMD == 1
+		// Two sets of accumulators, to hide the latency of min/max
+		__m128 min0 = _mm_set1_ps(INFINITY);
+		__m128 max0 = _mm_set1_ps(-INFINITY);
+		__m128 min1 = min0;
+		__m128 max1 = max0;
 
-		for (const auto& vertex : vertices)
+		// With a stride of at least 16 bytes, a full register can be loaded without reading past the stream
+		// (the fourth lane is garbage, it's never stored)
+		auto Load = [stride](const uint8_t* position)
 		{
-			m_max.x = Max(m_max.x, vertex.pos[0]);
-			m_max.y = Max(m_max.y, vertex.pos[1]);
-			m_max.z = Max(m_max.z, vertex.pos[2]);
+			if (stride >= 16)
+				return _mm_loadu_ps(reinterpret_cast<const float*>(position));
 
-			m_min.x = Min(m_min.x, vertex.pos[0]);
-			m_min.y = Min(m_min.y, vertex.pos[1]);
-			m_min.z = Min(m_min.z, vertex.pos[2]);
+			return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(position)), _mm_load_ss(reinterpret_cast<const float*>(position) + 2));
+		};
+
+		unsigned int i = 0;
+		for (; i + 1 < count; i += 2)
+		{
+			__m128 p0 = Load(stream + (size_t)i * stride);
+			__m128 p1 = Load(stream + (size_t)(i + 1) * stride);
+			min0 = _mm_min_ps(min0, p0);
+			max0 = _mm_max_ps(max0, p0);
+			min1 = _mm_min_ps(min1, p1);
+			max1 = _mm_max_ps(max1, p1);
+		}
+		if (i < count)
+		{
+			__m128 p = Load(stream + (size_t)i * stride);
+			min0 = _mm_min_ps(min0, p);
+			max0 = _mm_max_ps(max0, p);
 		}
+
+		float min[4], max[4];
+		_mm_storeu_ps(min, _mm_min_ps(min0, min1));
+		_mm_storeu_ps(max, _mm_max_ps(max0, max1));
+		box.m_min = Vector3(min[0], min[1], min[2]);
+		box.m_max = Vector3(max[0], max[1], max[2]);
+		#else
+		box = FromPoints_Scalar(positions, count, stride);
+		#endif
+
+		return box;
+	}
+
+	BoundingBox BoundingBox::FromPoints_Scalar(const float* positions, unsigned int count, unsigned int stride)
+	{
+		BoundingBox box;
+		if (!positions || count == 0)
+			return box;
+
+		const uint8_t* stream = reinterpret_cast<const uint8_t*>(positions);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const float* position = reinterpret_cast<const float*>(stream + (size_t)i * stride);
+
+			box.m_max.x = Max(box.m_max.x, position[0]);
+			box.m_max.y = Max(box.m_max.y, position[1]);
+			box.m_max.z = Max(box.m_max.z, position[2]);
+
+			box.m_min.x = Min(box.m_min.x, position[0]);
+			box.m_min.y = Min(box.m_min.y, position[1]);
+			box.m_min.z = Min(box.m_min.z, position[2]);
+		}
+
+		return box;
 	}
 
 	Intersection BoundingBox::IsInside(const Vector3& point) const
@@ -97,18 +162,71 @@ namespace Directus::Math
 		}
 	}
 
-	BoundingBox BoundingBox::Transformed(const Matrix& transform)
+	BoundingBox BoundingBox::Transformed(const Matrix& transform) const
 	{
-		Vector3 newCenter = transform * GetCenter();
-		Vector3 oldEdge = GetSize() * 0.5f;
-		Vector3 newEdge = Vector3
-		(
-			Abs(transform.m00) * oldEdge.x + Abs(transform.m10) * oldEdge.y + Abs(transform.m20) * oldEdge.z,
-			Abs(transform.m01) * oldEdge.x + Abs(transform.m11) * oldEdge.y + Abs(transform.m21) * oldEdge.z,
-			Abs(transform.m02) * oldEdge.x + Abs(transform.m12) * oldEdge.y + Abs(transform.m22) * oldEdge.z
-		);
-
-		return BoundingBox(newCenter - newEdge, newCenter + newEdge);
+		BoundingBox result;
+		Transform(this, &transform, &result, 1);
+		return result;
+	}
+
+	void BoundingBox::Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, unsigned int count)
+	{
+		#if MATH_SIMD == 1
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto& transform = transforms[i];
+
+			// Rows of the matrix
+			__m128 r0 = _mm_load_ps(transform.Data());
+			__m128 r1 = _mm_load_ps(transform.Data() + 4);
+			__m128 r2 = _mm_load_ps(transform.Data() + 8);
+			__m128 r3 = _mm_load_ps(transform.Data() + 12);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			const auto& box	= boxes[i];
+			__m128 min		= _mm_setr_ps(box.m_min.x, box.m_min.y, box.m_min.z, 0.0f);
+			__m128 max		= _mm_setr_ps(box.m_max.x, box.m_max.y, box.m_max.z, 0.0f);
+			__m128 half		= _mm_set1_ps(0.5f);
+			__m128 center	= _mm_mul_ps(_mm_add_ps(max, min), half);
+			__m128 extent	= _mm_mul_ps(_mm_sub_ps(max, min), half);
+
+			// The center is transformed as a point, the extent by the absolute value of the 3x3 part
+			__m128 center_new = _mm_mul_ps(_mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+			center_new = _mm_add_ps(center_new, _mm_mul_ps(_mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+			center_new = _mm_add_ps(center_new, _mm_mul_ps(_mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+			center_new = _mm_add_ps(center_new, r3);
+
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 extent_new = _mm_mul_ps(_mm_andnot_ps(signMask, r0), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(0, 0, 0, 0)));
+			extent_new = _mm_add_ps(extent_new, _mm_mul_ps(_mm_andnot_ps(signMask, r1), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(1, 1, 1, 1))));
+			extent_new = _mm_add_ps(extent_new, _mm_mul_ps(_mm_andnot_ps(signMask, r2), _mm_shuffle_ps(extent, extent, _MM_SHUFFLE(2, 2, 2, 2))));
+
+			float min_new[4], max_new[4];
+			_mm_storeu_ps(min_new, _mm_sub_ps(center_new, extent_new));
+			_mm_storeu_ps(max_new, _mm_add_ps(center_new, extent_new));
+			out[i] = BoundingBox(Vector3(min_new[0], min_new[1], min_new[2]), Vector3(max_new[0], max_new[1], max_new[2]));
+		}
+		#else
+		Transform_Scalar(boxes, transforms, out, count);
+		#endif
+	}
+
+	void BoundingBox::Transform_Scalar(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto& transform	= transforms[i];
+			Vector3 center_new		= transform.TransformPoint(boxes[i].GetCenter());
+			Vector3 extent			= boxes[i].GetSize() * 0.5f;
+			Vector3 extent_new		= Vector3
+			(
+				Abs(transform.m00) * extent.x + Abs(transform.m10) * extent.y + Abs(transform.m20) * extent.z,
+				Abs(transform.m01) * extent.x + Abs(transform.m11) * extent.y + Abs(transform.m21) * extent.z,
+				Abs(transform.m02) * extent.x + Abs(transform.m12) * extent.y + Abs(transform.m22) * extent.z
+			);
+
+			out[i] = BoundingBox(center_new - extent_new, center_new + extent_new);
+		}
 	}
 
 	void BoundingBox::Merge(const BoundingBox& box)
@@ -120,4 +238,33 @@ namespace Directus::Math
 		m_max.y = Max(m_max.x, box.m_max.x);
 		m_max.z = Max(m_max.x, box.m_max.x);
 	}
-}
\ No newline at end of file
+
+	//= SOA =================================================================================
+	void BoundingBox_SoA::Add(const BoundingBox& box)
+	{
+		// Grow by a group of four undefined boxes (min > max)
+		if (m_count == (unsigned int)m_minX.size())
+		{
+			for (auto vector : { &m_minX, &m_minY, &m_minZ })	{ vector->insert(vector->end(), 4, INFINITY); }
+			for (auto vector : { &m_maxX, &m_maxY, &m_maxZ })	{ vector->insert(vector->end(), 4, -INFINITY); }
+		}
+
+		m_minX[m_count] = box.GetMin().x;
+		m_minY[m_count] = box.GetMin().y;
+		m_minZ[m_count] = box.GetMin().z;
+		m_maxX[m_count] = box.GetMax().x;
+		m_maxY[m_count] = box.GetMax().y;
+		m_maxZ[m_count] = box.GetMax().z;
+		m_count++;
+	}
+
+	void BoundingBox_SoA::Clear()
+	{
+		for (auto vector : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ })
+		{
+			vector->clear();
+		}
+		m_count = 0;
+	}
+	//=======================================================================================
+}
@@ -47,15 +47,9 @@ namespace Directus
 			// Construct from vertices
 			BoundingBox(const std::vector<RHI_Vertex_PosUvNorTan>& vertices);
 
-			~BoundingBox() {}
-
-			// Assign from bounding box
-			BoundingBox& operator =(const BoundingBox& rhs)
-			{
-				m_min = rhs.m_min;
-				m_max = rhs.m_max;
-				return *this;
-			}
+			// Construct from a strided stream of positions (three floats, every stride bytes)
+			static BoundingBox FromPoints(const float* positions, unsigned int count, unsigned int stride);
+			static BoundingBox FromPoints_Scalar(const float* positions, unsigned int count, unsigned int stride);
 
 			// Returns the center
 			Vector3 GetCenter() const	{ return (m_max + m_min) * 0.5f; }
@@ -73,7 +67,11 @@ namespace Directus
 			Helper::Intersection IsInside (const BoundingBox& box) const;
 
 			// Returns a transformed bounding box
-			BoundingBox Transformed(const Matrix& transform);
+			BoundingBox Transformed(const Matrix& transform) const;
+
+			// Transforms every box by the matrix at the same index, "boxes" and "out" can be the same array
+			static void Transform(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, unsigned int count);
+			static void Transform_Scalar(const BoundingBox* boxes, const Matrix* transforms, BoundingBox* out, unsigned int count);
 
 			// Merge with another bounding box
 			void Merge(const BoundingBox& box);
@@ -90,5 +88,28 @@ namespace Directus
 			Vector3 m_min;
 			Vector3 m_max;	
 		};
+
+		// Boxes in structure of arrays layout, so that many of them can be tested at once.
+		// Storage is padded to a multiple of 4 with undefined boxes, which can't be hit.
+		class ENGINE_CLASS BoundingBox_SoA
+		{
+		public:
+			void Add(const BoundingBox& box);
+			void Clear();
+
+			unsigned int GetCount() const			{ return m_count; }
+			unsigned int GetCountPadded() const		{ return (unsigned int)m_minX.size(); }
+			const float* GetMinX() const			{ return m_minX.data(); }
+			const float* GetMinY() const			{ return m_minY.data(); }
+			const float* GetMinZ() const			{ return m_minZ.data(); }
+			const float* GetMaxX() const			{ return m_maxX.data(); }
+			const float* GetMaxY() const			{ return m_maxY.data(); }
+			const float* GetMaxZ() const			{ return m_maxZ.data(); }
+
+		private:
+			std::vector<float> m_minX, m_minY, m_minZ;
+			std::vector<float> m_maxX, m_maxY, m_maxZ;
+			unsigned int m_count = 0;
+		};
 	}
 }
@@ -27,6 +27,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/EngineDefs.h"
 //=============================
 
+// SSE2 is part of every x64 CPU, other targets use the scalar code paths (defining MATH_SIMD as 0 forces them).
+// The scalar versions are compiled either way, e.g. Matrix::Multiply_Scalar(), so the two can be compared.
+#ifndef MATH_SIMD
+	#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+	#define MATH_SIMD 1
+	#else
+	#define MATH_SIMD 0
+	#endif
+#endif
+#if MATH_SIMD == 1
+#include <emmintrin.h>
+#endif
+
 namespace Directus::Math::Helper
 {
 	enum Intersection
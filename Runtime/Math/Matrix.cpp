@@ -37,6 +37,290 @@ namespace Directus::Math
 		0, 0, 0, 1
 	);
 
+	#if MATH_SIMD == 1
+	namespace _Matrix
+	{
+		// Result lanes are (v[x], v[y], v[z], v[w])
+		template <int x, int y, int z, int w>
+		inline __m128 Swizzle(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x)); }
+
+		// Result lanes are (a[x], a[y], b[z], b[w])
+		template <int x, int y, int z, int w>
+		inline __m128 Shuffle(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+
+		// 2x2 matrices, stored as (m00, m01, m10, m11)
+		// A * B
+		inline __m128 Mat2Mul(__m128 a, __m128 b)		{ return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+		// adj(A) * B
+		inline __m128 Mat2AdjMul(__m128 a, __m128 b)	{ return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b))); }
+		// A * adj(B)
+		inline __m128 Mat2MulAdj(__m128 a, __m128 b)	{ return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+
+		inline __m128 Cross(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)), _mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+		}
+
+		// The rows of a matrix (its columns are what's contiguous in memory)
+		inline void LoadRows(const Matrix& matrix, __m128& r0, __m128& r1, __m128& r2, __m128& r3)
+		{
+			r0 = _mm_load_ps(matrix.Data());
+			r1 = _mm_load_ps(matrix.Data() + 4);
+			r2 = _mm_load_ps(matrix.Data() + 8);
+			r3 = _mm_load_ps(matrix.Data() + 12);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		}
+
+		inline void StoreVector3(__m128 v, Vector3* out)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64*>(&out->x), v);
+			_mm_store_ss(&out->z, _mm_movehl_ps(v, v));
+		}
+	}
+	#endif
+
+	//= INVERT ================================================================================================================================
+	Matrix Matrix::Invert(const Matrix& matrix)
+	{
+		#if MATH_SIMD == 1
+		using namespace _Matrix;
+
+		// Block-wise inversion with 2x2 sub-matrices. Works on the transpose (the columns in memory),
+		// which is fine, since the inverse of the transpose is the transpose of the inverse.
+		__m128 r0 = _mm_load_ps(matrix.Data());
+		__m128 r1 = _mm_load_ps(matrix.Data() + 4);
+		__m128 r2 = _mm_load_ps(matrix.Data() + 8);
+		__m128 r3 = _mm_load_ps(matrix.Data() + 12);
+
+		// Sub-matrices
+		__m128 A = _mm_movelh_ps(r0, r1);
+		__m128 B = _mm_movehl_ps(r1, r0);
+		__m128 C = _mm_movelh_ps(r2, r3);
+		__m128 D = _mm_movehl_ps(r3, r2);
+
+		// Sub-matrix determinants (|A|, |B|, |C|, |D|)
+		__m128 detSub = _mm_sub_ps
+		(
+			_mm_mul_ps(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+			_mm_mul_ps(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3))
+		);
+		__m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+		__m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+		__m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+		__m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+		// The inverse is 1/|M| * | X Y |, computed as adjugates
+		//                        | Z W |
+		__m128 D_C	= Mat2AdjMul(D, C);
+		__m128 A_B	= Mat2AdjMul(A, B);
+		__m128 X_	= _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+		__m128 W_	= _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+		__m128 Y_	= _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+		__m128 Z_	= _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+		// |M| = |A| * |D| + |B| * |C| - tr(adj(A)B * adj(D)C)
+		__m128 trace	= _mm_mul_ps(A_B, Swizzle<0, 2, 1, 3>(D_C));
+		trace			= _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+		trace			= _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+		__m128 detM		= _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+		__m128 detM_inv	= _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+		X_ = _mm_mul_ps(X_, detM_inv);
+		Y_ = _mm_mul_ps(Y_, detM_inv);
+		Z_ = _mm_mul_ps(Z_, detM_inv);
+		W_ = _mm_mul_ps(W_, detM_inv);
+
+		// Apply the adjugate shuffle while storing
+		Matrix result;
+		_mm_store_ps(&result.m00, Shuffle<3, 1, 3, 1>(X_, Y_));
+		_mm_store_ps(&result.m01, Shuffle<2, 0, 2, 0>(X_, Y_));
+		_mm_store_ps(&result.m02, Shuffle<3, 1, 3, 1>(Z_, W_));
+		_mm_store_ps(&result.m03, Shuffle<2, 0, 2, 0>(Z_, W_));
+		return result;
+		#else
+		return Invert_Scalar(matrix);
+		#endif
+	}
+
+	Matrix Matrix::Invert_Scalar(const Matrix& matrix)
+	{
+		float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
+		float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
+		float v2 = matrix.m20 * matrix.m33 - matrix.m23 * matrix.m30;
+		float v3 = matrix.m21 * matrix.m32 - matrix.m22 * matrix.m31;
+		float v4 = matrix.m21 * matrix.m33 - matrix.m23 * matrix.m31;
+		float v5 = matrix.m22 * matrix.m33 - matrix.m23 * matrix.m32;
+
+		float i00 = (v5 * matrix.m11 - v4 * matrix.m12 + v3 * matrix.m13);
+		float i10 = -(v5 * matrix.m10 - v2 * matrix.m12 + v1 * matrix.m13);
+		float i20 = (v4 * matrix.m10 - v2 * matrix.m11 + v0 * matrix.m13);
+		float i30 = -(v3 * matrix.m10 - v1 * matrix.m11 + v0 * matrix.m12);
+
+		float invDet = 1.0f / (i00 * matrix.m00 + i10 * matrix.m01 + i20 * matrix.m02 + i30 * matrix.m03);
+
+		i00 *= invDet;
+		i10 *= invDet;
+		i20 *= invDet;
+		i30 *= invDet;
+
+		float i01 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
+		float i11 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
+		float i21 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
+		float i31 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
+
+		v0 = matrix.m10 * matrix.m31 - matrix.m11 * matrix.m30;
+		v1 = matrix.m10 * matrix.m32 - matrix.m12 * matrix.m30;
+		v2 = matrix.m10 * matrix.m33 - matrix.m13 * matrix.m30;
+		v3 = matrix.m11 * matrix.m32 - matrix.m12 * matrix.m31;
+		v4 = matrix.m11 * matrix.m33 - matrix.m13 * matrix.m31;
+		v5 = matrix.m12 * matrix.m33 - matrix.m13 * matrix.m32;
+
+		float i02 = (v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
+		float i12 = -(v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
+		float i22 = (v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
+		float i32 = -(v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
+
+		v0 = matrix.m21 * matrix.m10 - matrix.m20 * matrix.m11;
+		v1 = matrix.m22 * matrix.m10 - matrix.m20 * matrix.m12;
+		v2 = matrix.m23 * matrix.m10 - matrix.m20 * matrix.m13;
+		v3 = matrix.m22 * matrix.m11 - matrix.m21 * matrix.m12;
+		v4 = matrix.m23 * matrix.m11 - matrix.m21 * matrix.m13;
+		v5 = matrix.m23 * matrix.m12 - matrix.m22 * matrix.m13;
+
+		float i03 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
+		float i13 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
+		float i23 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
+		float i33 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
+
+		return Matrix(
+			i00, i01, i02, i03,
+			i10, i11, i12, i13,
+			i20, i21, i22, i23,
+			i30, i31, i32, i33);
+	}
+
+	Matrix Matrix::InvertAffine(const Matrix& matrix)
+	{
+		#if MATH_SIMD == 1
+		using namespace _Matrix;
+
+		// The columns of the 3x3 part, the last lane holds the translation
+		__m128 c0 = _mm_load_ps(matrix.Data());
+		__m128 c1 = _mm_load_ps(matrix.Data() + 4);
+		__m128 c2 = _mm_load_ps(matrix.Data() + 8);
+		__m128 translation_x = Swizzle<3, 3, 3, 3>(c0);
+		__m128 translation_y = Swizzle<3, 3, 3, 3>(c1);
+		__m128 translation_z = Swizzle<3, 3, 3, 3>(c2);
+		const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		c0 = _mm_and_ps(c0, maskXYZ);
+		c1 = _mm_and_ps(c1, maskXYZ);
+		c2 = _mm_and_ps(c2, maskXYZ);
+
+		// The rows of the inverted 3x3 part are the cross products of its columns, divided by the determinant
+		__m128 q0	= Cross(c1, c2);
+		__m128 q1	= Cross(c2, c0);
+		__m128 q2	= Cross(c0, c1);
+		__m128 det	= _mm_mul_ps(c0, q0);
+		det			= _mm_add_ps(_mm_add_ps(Swizzle<0, 0, 0, 0>(det), Swizzle<1, 1, 1, 1>(det)), Swizzle<2, 2, 2, 2>(det));
+		__m128 det_inv = _mm_div_ps(_mm_set1_ps(1.0f), det);
+		q0 = _mm_mul_ps(q0, det_inv);
+		q1 = _mm_mul_ps(q1, det_inv);
+		q2 = _mm_mul_ps(q2, det_inv);
+
+		// The inverted translation is the negated translation, transformed by the inverted 3x3 part
+		__m128 q3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(translation_x, q0), _mm_mul_ps(translation_y, q1)), _mm_mul_ps(translation_z, q2));
+		q3 = _mm_sub_ps(_mm_setzero_ps(), q3);
+		q3 = _mm_add_ps(_mm_and_ps(q3, maskXYZ), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+		// Rows to columns
+		_MM_TRANSPOSE4_PS(q0, q1, q2, q3);
+		Matrix result;
+		_mm_store_ps(&result.m00, q0);
+		_mm_store_ps(&result.m01, q1);
+		_mm_store_ps(&result.m02, q2);
+		_mm_store_ps(&result.m03, q3);
+		return result;
+		#else
+		return Invert(matrix);
+		#endif
+	}
+	//=========================================================================================================================================
+
+	//= BATCHED TRANSFORMS ====================================================================================================================
+	void Matrix::TransformPoints(const Vector3* points, Vector3* out, unsigned int count) const
+	{
+		#if MATH_SIMD == 1
+		__m128 r0, r1, r2, r3;
+		_Matrix::LoadRows(*this, r0, r1, r2, r3);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			__m128 result = _mm_mul_ps(_mm_set1_ps(points[i].x), r0);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(points[i].y), r1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(points[i].z), r2));
+			result = _mm_add_ps(result, r3);
+			_Matrix::StoreVector3(result, &out[i]);
+		}
+		#else
+		TransformPoints_Scalar(points, out, count);
+		#endif
+	}
+
+	void Matrix::TransformPoints_Scalar(const Vector3* points, Vector3* out, unsigned int count) const
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = TransformPoint(points[i]);
+		}
+	}
+
+	void Matrix::TransformPoints(const Vector3* points, Vector4* out, unsigned int count) const
+	{
+		#if MATH_SIMD == 1
+		__m128 r0, r1, r2, r3;
+		_Matrix::LoadRows(*this, r0, r1, r2, r3);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			__m128 result = _mm_mul_ps(_mm_set1_ps(points[i].x), r0);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(points[i].y), r1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(points[i].z), r2));
+			result = _mm_add_ps(result, r3);
+			_mm_storeu_ps(&out[i].x, result);
+		}
+		#else
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const auto& p = points[i];
+			out[i] = Vector4(
+				(p.x * m00) + (p.y * m10) + (p.z * m20) + m30,
+				(p.x * m01) + (p.y * m11) + (p.z * m21) + m31,
+				(p.x * m02) + (p.y * m12) + (p.z * m22) + m32,
+				(p.x * m03) + (p.y * m13) + (p.z * m23) + m33
+			);
+		}
+		#endif
+	}
+
+	void Matrix::TransformDirections(const Vector3* directions, Vector3* out, unsigned int count) const
+	{
+		#if MATH_SIMD == 1
+		__m128 r0, r1, r2, r3;
+		_Matrix::LoadRows(*this, r0, r1, r2, r3);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			__m128 result = _mm_mul_ps(_mm_set1_ps(directions[i].x), r0);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(directions[i].y), r1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(directions[i].z), r2));
+			_Matrix::StoreVector3(result, &out[i]);
+		}
+		#else
+		for (unsigned int i = 0; i < count; i++)
+		{
+			out[i] = TransformDirection(directions[i]);
+		}
+		#endif
+	}
+	//=========================================================================================================================================
+
 	string Matrix::ToString() const
 	{
 		char tempBuffer[200];
@@ -41,14 +41,6 @@ namespace Directus::Math
 			SetIdentity();
 		}
 
-		Matrix (const Matrix& rhs)
-		{
-			m00 = rhs.m00; m01 = rhs.m01; m02 = rhs.m02; m03 = rhs.m03;
-			m10 = rhs.m10; m11 = rhs.m11; m12 = rhs.m12; m13 = rhs.m13;
-			m20 = rhs.m20; m21 = rhs.m21; m22 = rhs.m22; m23 = rhs.m23;
-			m30 = rhs.m30; m31 = rhs.m31; m32 = rhs.m32; m33 = rhs.m33;
-		}
-
 		Matrix(
 			float m00, float m01, float m02, float m03,
 			float m10, float m11, float m12, float m13,
@@ -71,8 +63,6 @@ namespace Directus::Math
 			m30 = translation.x; m31 = translation.y; m32 = translation.z; m33 = 1.0f;
 		}
 
-		~Matrix() {}
-
 		//= TRANSLATION ===========================================
 		Vector3 GetTranslation() { return Vector3(m30, m31, m32); }
 
@@ -277,6 +267,26 @@ namespace Directus::Math
 		Matrix Transposed() const { return Transpose(*this); }
 		void Transpose() { *this = Transpose(*this); }
 		static Matrix Transpose(const Matrix& matrix)
+		{
+			#if MATH_SIMD == 1
+			__m128 c0 = _mm_load_ps(matrix.Data());
+			__m128 c1 = _mm_load_ps(matrix.Data() + 4);
+			__m128 c2 = _mm_load_ps(matrix.Data() + 8);
+			__m128 c3 = _mm_load_ps(matrix.Data() + 12);
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			Matrix result;
+			_mm_store_ps(&result.m00, c0);
+			_mm_store_ps(&result.m01, c1);
+			_mm_store_ps(&result.m02, c2);
+			_mm_store_ps(&result.m03, c3);
+			return result;
+			#else
+			return Transpose_Scalar(matrix);
+			#endif
+		}
+
+		static Matrix Transpose_Scalar(const Matrix& matrix)
 		{
 			return Matrix(
 				matrix.m00, matrix.m10, matrix.m20, matrix.m30,
@@ -289,62 +299,11 @@ namespace Directus::Math
 
 		//= INVERT =======================================================================================
 		Matrix Inverted() const { return Invert(*this); }
-		static Matrix Invert(const Matrix& matrix)
-		{
-			float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
-			float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
-			float v2 = matrix.m20 * matrix.m33 - matrix.m23 *matrix.m30;
-			float v3 = matrix.m21 * matrix.m32 - matrix.m22 * matrix.m31;
-			float v4 = matrix.m21 * matrix.m33 - matrix.m23 * matrix.m31;
-			float v5 = matrix.m22 * matrix.m33 - matrix.m23 * matrix.m32;
-
-			float i00 = (v5 * matrix.m11 - v4 * matrix.m12 + v3 * matrix.m13);
-			float i10 = -(v5 * matrix.m10 - v2 * matrix.m12 + v1 * matrix.m13);
-			float i20 = (v4 * matrix.m10 - v2 * matrix.m11 + v0 * matrix.m13);
-			float i30 = -(v3 * matrix.m10 - v1 * matrix.m11 + v0 * matrix.m12);
-
-			float invDet = 1.0f / (i00 * matrix.m00 + i10 * matrix.m01 + i20 * matrix.m02 + i30 * matrix.m03);
-
-			i00 *= invDet;
-			i10 *= invDet;
-			i20 *= invDet;
-			i30 *= invDet;
-
-			float i01 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i11 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i21 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i31 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m10 * matrix.m31 - matrix.m11 * matrix.m30;
-			v1 = matrix.m10 * matrix.m32 - matrix.m12 * matrix.m30;
-			v2 = matrix.m10 * matrix.m33 - matrix.m13 * matrix.m30;
-			v3 = matrix.m11 * matrix.m32 - matrix.m12 * matrix.m31;
-			v4 = matrix.m11 * matrix.m33 - matrix.m13 * matrix.m31;
-			v5 = matrix.m12 * matrix.m33 - matrix.m13 * matrix.m32;
-
-			float i02 = (v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i12 = -(v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i22 = (v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i32 = -(v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			v0 = matrix.m21 * matrix.m10 - matrix.m20 * matrix.m11;
-			v1 = matrix.m22 * matrix.m10 - matrix.m20 * matrix.m12;
-			v2 = matrix.m23 * matrix.m10 - matrix.m20 * matrix.m13;
-			v3 = matrix.m22 * matrix.m11 - matrix.m21 * matrix.m12;
-			v4 = matrix.m23 * matrix.m11 - matrix.m21 * matrix.m13;
-			v5 = matrix.m23 * matrix.m12 - matrix.m22 * matrix.m13;
-
-			float i03 = -(v5 * matrix.m01 - v4 * matrix.m02 + v3 * matrix.m03) * invDet;
-			float i13 = (v5 * matrix.m00 - v2 * matrix.m02 + v1 * matrix.m03) * invDet;
-			float i23 = -(v4 * matrix.m00 - v2 * matrix.m01 + v0 * matrix.m03) * invDet;
-			float i33 = (v3 * matrix.m00 - v1 * matrix.m01 + v0 * matrix.m02) * invDet;
-
-			return Matrix(
-				i00, i01, i02, i03,
-				i10, i11, i12, i13,
-				i20, i21, i22, i23,
-				i30, i31, i32, i33);
-		}
+		static Matrix Invert(const Matrix& matrix);
+		static Matrix Invert_Scalar(const Matrix& matrix);
+		// Faster, but only valid for matrices whose last column is (0, 0, 0, 1), e.g. world matrices
+		Matrix InvertedAffine() const { return InvertAffine(*this); }
+		static Matrix InvertAffine(const Matrix& matrix);
 		//================================================================================================
 
 		void Decompose(Vector3& scale, Quaternion& rotation, Vector3& translation)
@@ -364,24 +323,58 @@ namespace Directus::Math
 
 		//= MULTIPLICATION ================================================================================================================
 		Matrix operator*(const Matrix& rhs) const
+		{
+			#if MATH_SIMD == 1
+			// Every column of the result is a combination of the columns of this matrix,
+			// summed in the same order as the scalar version so both produce identical results.
+			__m128 c0 = _mm_load_ps(Data());
+			__m128 c1 = _mm_load_ps(Data() + 4);
+			__m128 c2 = _mm_load_ps(Data() + 8);
+			__m128 c3 = _mm_load_ps(Data() + 12);
+			auto Column = [c0, c1, c2, c3](const float* column_rhs)
+			{
+				__m128 column	= _mm_load_ps(column_rhs);
+				__m128 sum		= _mm_mul_ps(c0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+				sum				= _mm_add_ps(sum, _mm_mul_ps(c1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+				sum				= _mm_add_ps(sum, _mm_mul_ps(c2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+				return			  _mm_add_ps(sum, _mm_mul_ps(c3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+			};
+			__m128 r0 = Column(rhs.Data());
+			__m128 r1 = Column(rhs.Data() + 4);
+			__m128 r2 = Column(rhs.Data() + 8);
+			__m128 r3 = Column(rhs.Data() + 12);
+
+			// Stored only once everything is computed, so the identity the constructor writes can be discarded
+			Matrix result;
+			_mm_store_ps(&result.m00, r0);
+			_mm_store_ps(&result.m01, r1);
+			_mm_store_ps(&result.m02, r2);
+			_mm_store_ps(&result.m03, r3);
+			return result;
+			#else
+			return Multiply_Scalar(*this, rhs);
+			#endif
+		}
+
+		static Matrix Multiply_Scalar(const Matrix& lhs, const Matrix& rhs)
 		{
 			return Matrix(
-				m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
-				m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
-				m00 * rhs.m02 + m01 * rhs.m12 + m02 * rhs.m22 + m03 * rhs.m32,
-				m00 * rhs.m03 + m01 * rhs.m13 + m02 * rhs.m23 + m03 * rhs.m33,
-				m10 * rhs.m00 + m11 * rhs.m10 + m12 * rhs.m20 + m13 * rhs.m30,
-				m10 * rhs.m01 + m11 * rhs.m11 + m12 * rhs.m21 + m13 * rhs.m31,
-				m10 * rhs.m02 + m11 * rhs.m12 + m12 * rhs.m22 + m13 * rhs.m32,
-				m10 * rhs.m03 + m11 * rhs.m13 + m12 * rhs.m23 + m13 * rhs.m33,
-				m20 * rhs.m00 + m21 * rhs.m10 + m22 * rhs.m20 + m23 * rhs.m30,
-				m20 * rhs.m01 + m21 * rhs.m11 + m22 * rhs.m21 + m23 * rhs.m31,
-				m20 * rhs.m02 + m21 * rhs.m12 + m22 * rhs.m22 + m23 * rhs.m32,
-				m20 * rhs.m03 + m21 * rhs.m13 + m22 * rhs.m23 + m23 * rhs.m33,
-				m30 * rhs.m00 + m31 * rhs.m10 + m32 * rhs.m20 + m33 * rhs.m30,
-				m30 * rhs.m01 + m31 * rhs.m11 + m32 * rhs.m21 + m33 * rhs.m31,
-				m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
-				m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
+				lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20 + lhs.m03 * rhs.m30,
+				lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21 + lhs.m03 * rhs.m31,
+				lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22 + lhs.m03 * rhs.m32,
+				lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03 * rhs.m33,
+				lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20 + lhs.m13 * rhs.m30,
+				lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21 + lhs.m13 * rhs.m31,
+				lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22 + lhs.m13 * rhs.m32,
+				lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13 * rhs.m33,
+				lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20 + lhs.m23 * rhs.m30,
+				lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21 + lhs.m23 * rhs.m31,
+				lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22 + lhs.m23 * rhs.m32,
+				lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23 * rhs.m33,
+				lhs.m30 * rhs.m00 + lhs.m31 * rhs.m10 + lhs.m32 * rhs.m20 + lhs.m33 * rhs.m30,
+				lhs.m30 * rhs.m01 + lhs.m31 * rhs.m11 + lhs.m32 * rhs.m21 + lhs.m33 * rhs.m31,
+				lhs.m30 * rhs.m02 + lhs.m31 * rhs.m12 + lhs.m32 * rhs.m22 + lhs.m33 * rhs.m32,
+				lhs.m30 * rhs.m03 + lhs.m31 * rhs.m13 + lhs.m32 * rhs.m23 + lhs.m33 * rhs.m33
 			);
 		}
 
@@ -398,6 +391,36 @@ namespace Directus::Math
 
 			return Vector3(vWorking.x * vWorking.w, vWorking.y * vWorking.w, vWorking.z * vWorking.w);
 		}
+
+		// Transforms a point by an affine matrix, skipping the perspective divide
+		Vector3 TransformPoint(const Vector3& point) const
+		{
+			return Vector3(
+				(point.x * m00) + (point.y * m10) + (point.z * m20) + m30,
+				(point.x * m01) + (point.y * m11) + (point.z * m21) + m31,
+				(point.x * m02) + (point.y * m12) + (point.z * m22) + m32
+			);
+		}
+
+		// Transforms a direction, ignoring translation
+		Vector3 TransformDirection(const Vector3& direction) const
+		{
+			return Vector3(
+				(direction.x * m00) + (direction.y * m10) + (direction.z * m20),
+				(direction.x * m01) + (direction.y * m11) + (direction.z * m21),
+				(direction.x * m02) + (direction.y * m12) + (direction.z * m22)
+			);
+		}
+
+		//= BATCHED TRANSFORMS ========================================================================================================
+		// The matrix is transposed once for the whole batch, "points" and "out" can be the same array
+		void TransformPoints(const Vector3* points, Vector3* out, unsigned int count) const;
+		void TransformPoints_Scalar(const Vector3* points, Vector3* out, unsigned int count) const;
+		// Outputs homogeneous coordinates (no perspective divide), e.g. clip space positions
+		void TransformPoints(const Vector3* points, Vector4* out, unsigned int count) const;
+		void TransformDirections(const Vector3* directions, Vector3* out, unsigned int count) const;
+		//=============================================================================================================================
+
 		//=================================================================================================================================
 
 		//= COMPARISON =================================================
@@ -421,8 +444,9 @@ namespace Directus::Math
 		const float* Data() const { return &m00; }
 		std::string ToString() const;
 
-		// Column-major memory representation 
-		float m00{}, m10{}, m20{}, m30{};
+		// Column-major memory representation, aligned so that columns can be loaded as SIMD registers
+		alignas(16) float m00{};
+		float m10{}, m20{}, m30{};
 		float m01{}, m11{}, m21{}, m31{};
 		float m02{}, m12{}, m22{}, m32{};
 		float m03{}, m13{}, m23{}, m33{};
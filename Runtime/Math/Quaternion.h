@@ -47,7 +47,6 @@ namespace Directus::Math
 			this->z = z;
 			this->w = w;
 		}
-		~Quaternion() {}
 
 		// Creates a new Quaternion from the specified axis and angle.	
 		// The angle in radians.
@@ -231,18 +230,6 @@ namespace Directus::Math
 			);
 		}
 
-		//= ASSIGNMENT ==============================
-		Quaternion& operator =(const Quaternion& rhs)
-		{
-			w = rhs.w;
-			x = rhs.x;
-			y = rhs.y;
-			z = rhs.z;
-
-			return *this;
-		}
-		//===========================================
-
 		//= MULTIPLICATION ==============================================================================
 		Quaternion operator*(const Quaternion& rhs) const
 		{
@@ -23,8 +23,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Ray.h"
 #include "RayHit.h"
 #include "BoundingBox.h"
+#include "Matrix.h"
+#include <cfloat>
+#include <cstring>
 #include "../World/Actor.h"
 #include "../World/Components/Renderable.h"
+#include "../World/Components/Transform.h"
 #include "../World/Components/Skybox.h"
 //=========================================
 
@@ -32,6 +36,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 using namespace std;
 //==================
 
+namespace _Ray
+{
+	// Zero components get a huge finite inverse instead of infinity, which would produce NaNs for starts that lie on a slab
+	inline Directus::Math::Vector3 InverseDirection(const Directus::Math::Vector3& direction)
+	{
+		auto Inverse = [](float value) { return value != 0.0f ? 1.0f / value : (signbit(value) ? -FLT_MAX : FLT_MAX); };
+		return Directus::Math::Vector3(Inverse(direction.x), Inverse(direction.y), Inverse(direction.z));
+	}
+}
+
 namespace Directus::Math
 {
 	Ray::Ray()
@@ -53,27 +67,41 @@ namespace Directus::Math
 
 	vector<RayHit> Ray::Trace(Context* context)
 	{
-		// Find all the actors that the ray hits
-		vector<RayHit> hits;
-		const vector<shared_ptr<Actor>>& actors = context->GetSubsystem<World>()->Actors_GetAll();
-		for (const auto& actor : actors)
+		// Gather the actors that have a mesh, excluding the SkyBox
+		vector<Actor*> candidates;
+		vector<BoundingBox> boxes;
+		vector<Matrix> transforms;
+		for (const auto& actor : context->GetSubsystem<World>()->Actors_GetAll())
 		{
-			// Make sure there actor has a mesh and exclude the SkyBox
-			if (!actor->HasComponent<Renderable>() || actor->HasComponent<Skybox>())
+			const Renderable* renderable = actor->GetRenderable_PtrRaw();
+			if (!renderable || actor->HasComponent<Skybox>())
 				continue;
 
-			// Get bounding box
-			BoundingBox aabb = actor->GetComponent<Renderable>()->Geometry_AABB();
+			candidates.emplace_back(actor.get());
+			boxes.emplace_back(renderable->Geometry_AABB());
+			transforms.emplace_back(actor->GetTransform_PtrRaw()->GetMatrix());
+		}
 
-			// Compute hit distance
-			float hitDistance = HitDistance(aabb);
+		// Transform the bounding boxes to world space and test them all at once
+		BoundingBox::Transform(boxes.data(), transforms.data(), boxes.data(), (unsigned int)boxes.size());
+		BoundingBox_SoA boxes_soa;
+		for (const auto& box : boxes)
+		{
+			boxes_soa.Add(box);
+		}
+		vector<float> distances(boxes_soa.GetCount());
+		HitDistances(boxes_soa, distances.data());
 
+		// Find all the actors that the ray hits
+		vector<RayHit> hits;
+		for (unsigned int i = 0; i < (unsigned int)candidates.size(); i++)
+		{
 			// Don't store hit data if there was no hit
-			if (hitDistance == INFINITY)
+			if (distances[i] == INFINITY)
 				continue;
 
-			bool inside	= (hitDistance == 0.0f);
-			hits.emplace_back(actor, hitDistance, inside);
+			bool inside	= (distances[i] == 0.0f);
+			hits.emplace_back(candidates[i]->GetPtrShared(), distances[i], inside);
 		}
 
 		// Sort by distance (ascending)
@@ -85,96 +113,90 @@ namespace Directus::Math
 		return hits;
 	}
 
-	float Ray::HitDistance(const BoundingBox& box)
+	float Ray::HitDistance(const BoundingBox& box) const
 	{
 		// If undefined, no hit (infinite distance)
 		if (!box.Defined())
 			return INFINITY;
-		
-		// Check for ray origin being inside the box
-		if (box.IsInside(m_start))
-			return 0.0f;
 
-		float dist = INFINITY;
+		// Slab test, the ray enters the box at the furthest of the near planes and leaves it at the nearest of the far planes
+		const Vector3 direction_inv	= _Ray::InverseDirection(m_direction);
+		const Vector3 t0			= (box.GetMin() - m_start) * direction_inv;
+		const Vector3 t1			= (box.GetMax() - m_start) * direction_inv;
+		const float t_near			= Max(Max(Min(t0.x, t1.x), Min(t0.y, t1.y)), Min(t0.z, t1.z));
+		const float t_far			= Min(Min(Max(t0.x, t1.x), Max(t0.y, t1.y)), Max(t0.z, t1.z));
 
-		// Check for intersecting in the X-direction
-		if (m_start.x < box.GetMin().x && m_direction.x > 0.0f)
-		{
-			float x = (box.GetMin().x - m_start.x) / m_direction.x;
-			if (x < dist)
-			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.y >= box.GetMin().y && point.y <= box.GetMax().y && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
-			}
-		}
-		if (m_start.x > box.GetMax().x && m_direction.x < 0.0f)
-		{
-			float x = (box.GetMax().x - m_start.x) / m_direction.x;
-			if (x < dist)
-			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.y >= box.GetMin().y && point.y <= box.GetMax().y && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
-			}
-		}
+		// A start inside the box (t_near < 0) is a hit at 0
+		return (t_near <= t_far && t_far >= 0.0f) ? Max(t_near, 0.0f) : INFINITY;
+	}
 
-		// Check for intersecting in the Y-direction
-		if (m_start.y < box.GetMin().y && m_direction.y > 0.0f)
+	void Ray::HitDistances(const BoundingBox_SoA& boxes, float* distances) const
+	{
+		#if MATH_SIMD == 1
+		const Vector3 direction_inv = _Ray::InverseDirection(m_direction);
+		const unsigned int count	= boxes.GetCount();
+
+		const __m128 start_x	= _mm_set1_ps(m_start.x);
+		const __m128 start_y	= _mm_set1_ps(m_start.y);
+		const __m128 start_z	= _mm_set1_ps(m_start.z);
+		const __m128 inv_x		= _mm_set1_ps(direction_inv.x);
+		const __m128 inv_y		= _mm_set1_ps(direction_inv.y);
+		const __m128 inv_z		= _mm_set1_ps(direction_inv.z);
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 infinity	= _mm_set1_ps(INFINITY);
+
+		// The storage is padded to a multiple of 4, only the output needs care
+		for (unsigned int i = 0; i < count; i += 4)
 		{
-			float x = (box.GetMin().y - m_start.y) / m_direction.y;
-			if (x < dist)
+			const __m128 min_x = _mm_load_ps(boxes.GetMinX() + i);
+			const __m128 max_x = _mm_load_ps(boxes.GetMaxX() + i);
+
+			__m128 t0		= _mm_mul_ps(_mm_sub_ps(min_x, start_x), inv_x);
+			__m128 t1		= _mm_mul_ps(_mm_sub_ps(max_x, start_x), inv_x);
+			__m128 t_near	= _mm_min_ps(t0, t1);
+			__m128 t_far	= _mm_max_ps(t0, t1);
+
+			t0		= _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.GetMinY() + i), start_y), inv_y);
+			t1		= _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.GetMaxY() + i), start_y), inv_y);
+			t_near	= _mm_max_ps(t_near, _mm_min_ps(t0, t1));
+			t_far	= _mm_min_ps(t_far, _mm_max_ps(t0, t1));
+
+			t0		= _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.GetMinZ() + i), start_z), inv_z);
+			t1		= _mm_mul_ps(_mm_sub_ps(_mm_load_ps(boxes.GetMaxZ() + i), start_z), inv_z);
+			t_near	= _mm_max_ps(t_near, _mm_min_ps(t0, t1));
+			t_far	= _mm_min_ps(t_far, _mm_max_ps(t0, t1));
+
+			// Hit if the slabs overlap in front of the start and the box is defined (padding isn't)
+			__m128 hit		= _mm_and_ps(_mm_cmple_ps(t_near, t_far), _mm_cmpge_ps(t_far, zero));
+			hit				= _mm_and_ps(hit, _mm_cmple_ps(min_x, max_x));
+			__m128 distance	= _mm_or_ps(_mm_and_ps(hit, _mm_max_ps(t_near, zero)), _mm_andnot_ps(hit, infinity));
+
+			if (i + 4 <= count)
 			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
+				_mm_storeu_ps(distances + i, distance);
 			}
-		}
-		if (m_start.y > box.GetMax().y && m_direction.y < 0.0f)
-		{
-			float x = (box.GetMax().y - m_start.y) / m_direction.y;
-			if (x < dist)
+			else
 			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.z >= box.GetMin().z && point.z <= box.GetMax().z)
-				{
-					dist = x;
-				}
+				float tail[4];
+				_mm_storeu_ps(tail, distance);
+				memcpy(distances + i, tail, (count - i) * sizeof(float));
 			}
 		}
+		#else
+		HitDistances_Scalar(boxes, distances);
+		#endif
+	}
 
-		// Check for intersecting in the Z-direction
-		if (m_start.z < box.GetMin().z && m_direction.z > 0.0f)
-		{
-			float x = (box.GetMin().z - m_start.z) / m_direction.z;
-			if (x < dist)
-			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.y >= box.GetMin().y && point.y <= box.GetMax().y)
-				{
-					dist = x;
-				}
-			}
-		}
-		if (m_start.z > box.GetMax().z && m_direction.z < 0.0f)
+	void Ray::HitDistances_Scalar(const BoundingBox_SoA& boxes, float* distances) const
+	{
+		for (unsigned int i = 0; i < boxes.GetCount(); i++)
 		{
-			float x = (box.GetMax().z - m_start.z) / m_direction.z;
-			if (x < dist)
-			{
-				Vector3 point = m_start + x * m_direction;
-				if (point.x >= box.GetMin().x && point.x <= box.GetMax().x && point.y >= box.GetMin().y && point.y <= box.GetMax().y)
-				{
-					dist = x;
-				}
-			}
+			BoundingBox box
+			(
+				Vector3(boxes.GetMinX()[i], boxes.GetMinY()[i], boxes.GetMinZ()[i]),
+				Vector3(boxes.GetMaxX()[i], boxes.GetMaxY()[i], boxes.GetMaxZ()[i])
+			);
+			distances[i] = HitDistance(box);
 		}
-
-		return dist;
 	}
-}
\ No newline at end of file
+}
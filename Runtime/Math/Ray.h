@@ -35,6 +35,7 @@ namespace Directus
 	{
 		class RayHit;
 		class BoundingBox;
+		class BoundingBox_SoA;
 
 		class ENGINE_CLASS Ray
 		{
@@ -47,7 +48,12 @@ namespace Directus
 			std::vector<RayHit> Trace(Context* context);
 
 			// Returns hit distance to a bounding box, or infinity if there is no hit.
-			float HitDistance(const BoundingBox& box);
+			float HitDistance(const BoundingBox& box) const;
+
+			// Writes the hit distance to every box (GetCount() floats), four boxes at a time.
+			void HitDistances(const BoundingBox_SoA& boxes, float* distances) const;
+			// Same as HitDistances(), one box at a time
+			void HitDistances_Scalar(const BoundingBox_SoA& boxes, float* distances) const;
 
 			const Vector3& GetStart() const		{ return m_start; }
 			const Vector3& GetEnd()	const		{ return m_end; }
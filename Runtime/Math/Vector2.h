@@ -37,12 +37,6 @@ namespace Directus::Math
 			y = 0;
 		}
 
-		Vector2(const Vector2& vector)
-		{
-			this->x = vector.x;
-			this->y = vector.y;
-		}
-
 		Vector2(float x, float y)
 		{
 			this->x = x;
@@ -67,8 +61,6 @@ namespace Directus::Math
 			this->y = x;
 		}
 
-		~Vector2() {}
-
 		//= ADDITION ===============================
 		Vector2 operator+(const Vector2& b)
 		{
@@ -40,14 +40,6 @@ namespace Directus::Math
 			z = 0;
 		}
 
-		// Copy-constructor
-		Vector3(const Vector3& vector)
-		{
-			x = vector.x;
-			y = vector.y;
-			z = vector.z;
-		}
-
 		// Construct from coordinates.
 		Vector3(float x, float y, float z)
 		{
@@ -61,8 +61,6 @@ namespace Directus::Math
 		Vector4(const Vector3& value, float w);
 		Vector4(const Vector3& value);
 
-		~Vector4(){}
-
 		//= COMPARISON ================================================
 		bool operator==(const Vector4& rhs) const
 		{
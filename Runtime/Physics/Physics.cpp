@@ -20,20 +20,40 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 //= INCLUDES ===================================================================
+#include <algorithm>
 #include "Physics.h"
 #include "../Core/Engine.h"
 #include "../Core/EventSystem.h"
 #include "../Core/Settings.h"
 #include "../Profiling/Profiler.h"
+#include "../Threading/Threading.h"
+#include "../World/Components/Transform.h"
+#include "../World/Components/RigidBody.h"
 #include "PhysicsDebugDraw.h"
+#include "ShapeCache.h"
 #include "BulletPhysicsHelper.h"
 #include "../Rendering/Renderer.h"
 #pragma warning(push, 0) // Hide warnings which belong to Bullet
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletDynamics/ConstraintSolver/btConstraintSolver.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btConcaveShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleCallback.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
+#include <LinearMath/btThreads.h>
 #pragma warning(pop)
 //==============================================================================
 
@@ -42,46 +62,251 @@ using namespace std;
 using namespace Directus::Math;
 //=============================
 
-static const int MAX_SOLVER_ITERATIONS	= 256;
+static const int SOLVER_ITERATIONS		= 256;
 static const float INTERNAL_FPS			= 60.0f;
 static const Vector3 GRAVITY			= Vector3(0.0f, -9.81f, 0.0f);
 
 namespace Directus
-{ 
+{
+	namespace _Physics
+	{
+		// Runs Bullet's parallel loops on the engine's thread pool, the calling thread takes part
+		class TaskScheduler : public btITaskScheduler
+		{
+		public:
+			TaskScheduler(Threading* threading) : btITaskScheduler("Directus")
+			{
+				m_threading		= threading;
+				// Bullet indexes per-thread data by thread, up to BT_MAX_THREAD_COUNT threads (including the calling one)
+				m_threadsMax	= (int)min(threading->GetThreadCount() + 1, BT_MAX_THREAD_COUNT);
+				m_threads		= m_threadsMax;
+			}
+
+			int getMaxNumThreads() const override		{ return m_threadsMax; }
+			int getNumThreads() const override			{ return m_threads; }
+			void setNumThreads(int numThreads) override	{ m_threads = max(1, min(numThreads, m_threadsMax)); }
+
+			void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+			{
+				auto chunk	= Chunk(iBegin, iEnd, grainSize);
+				auto count	= (unsigned int)((iEnd - iBegin + chunk - 1) / chunk);
+				m_threading->ParallelFor(count, [&](unsigned int i)
+				{
+					int begin = iBegin + (int)i * chunk;
+					body.forLoop(begin, min(begin + chunk, iEnd));
+				});
+			}
+
+			btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+			{
+				auto chunk	= Chunk(iBegin, iEnd, grainSize);
+				auto count	= (unsigned int)((iEnd - iBegin + chunk - 1) / chunk);
+				vector<btScalar> sums(count, btScalar(0));
+				m_threading->ParallelFor(count, [&](unsigned int i)
+				{
+					int begin	= iBegin + (int)i * chunk;
+					sums[i]		= body.sumLoop(begin, min(begin + chunk, iEnd));
+				});
+
+				btScalar sum = btScalar(0);
+				for (const auto& value : sums) { sum += value; }
+				return sum;
+			}
+
+		private:
+			// Large enough for every thread to get a few chunks, never below the grain size Bullet asks for
+			int Chunk(int iBegin, int iEnd, int grainSize) const
+			{
+				return max(max(grainSize, 1), (iEnd - iBegin + m_threads * 4 - 1) / (m_threads * 4));
+			}
+
+			Threading* m_threading;
+			int m_threadsMax;
+			int m_threads;
+		};
+
+		// Bit of the layer a collision object was put in by its RigidBody
+		inline bool InLayers(const btCollisionObject* object, unsigned int mask)
+		{
+			int layer = object->getUserIndex();
+			return (mask & (1u << (layer < 0 ? 0 : layer))) != 0;
+		}
+
+		// Calls back with the collision object of every broadphase leaf the ray, or a box of the given bounds swept along it, passes through.
+		// The traversal stack belongs to the caller, so many threads can do this at once (btDbvtBroadphase::rayTest can't).
+		template <typename Function>
+		void Traverse(btDbvtBroadphase* broadphase, const btVector3& from, const btVector3& to, const btVector3& aabbMin, const btVector3& aabbMax, btAlignedObjectArray<const btDbvtNode*>& stack, Function function)
+		{
+			struct Collector : btDbvt::ICollide
+			{
+				Collector(Function& function) : function(function) {}
+				void Process(const btDbvtNode* leaf) { function(static_cast<btCollisionObject*>(static_cast<btBroadphaseProxy*>(leaf->data)->m_clientObject)); }
+				Function& function;
+			} collector(function);
+
+			btVector3 direction	= to - from;
+			btScalar length		= direction.length();
+			direction			= length > btScalar(0) ? direction / length : btVector3(1, 0, 0);
+
+			btVector3 directionInverse;
+			for (int i = 0; i < 3; i++)
+			{
+				directionInverse[i] = direction[i] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / direction[i];
+			}
+			unsigned int signs[3] = { directionInverse[0] < 0, directionInverse[1] < 0, directionInverse[2] < 0 };
+
+			// Dynamic and static bodies live in separate trees
+			for (auto& set : broadphase->m_sets)
+			{
+				set.rayTestInternal(set.m_root, from, to, directionInverse, signs, length, aabbMin, aabbMax, stack, collector);
+			}
+		}
+
+		inline unique_ptr<btConvexShape> CreateShape(const PhysicsShape& shape)
+		{
+			switch (shape.type)
+			{
+				case PhysicsShape_Box:		return make_unique<btBoxShape>(ToBtVector3(shape.size));
+				case PhysicsShape_Capsule:	return make_unique<btCapsuleShape>(shape.size.x, shape.size.y);
+				default:					return make_unique<btSphereShape>(shape.size.x);
+			}
+		}
+
+		inline void ToHit(const btCollisionObject* object, const btVector3& position, const btVector3& normal, btScalar fraction, PhysicsHit* hit)
+		{
+			hit->body		= object ? static_cast<RigidBody*>(object->getUserPointer()) : nullptr;
+			hit->position	= object ? ToVector3(position) : Vector3::Zero;
+			hit->normal		= object ? ToVector3(normal) : Vector3::Zero;
+			hit->fraction	= object ? fraction : 1.0f;
+		}
+
+		inline bool Intersects(const btConvexShape* shape, const btTransform& transform, const btConvexShape* other, const btTransform& otherTransform)
+		{
+			btVoronoiSimplexSolver simplexSolver;
+			btGjkEpaPenetrationDepthSolver penetrationSolver;
+			btGjkPairDetector detector(shape, other, &simplexSolver, &penetrationSolver);
+
+			btGjkPairDetector::ClosestPointInput input;
+			input.m_transformA = transform;
+			input.m_transformB = otherTransform;
+			btPointCollector result;
+			detector.getClosestPoints(input, result, nullptr);
+
+			return result.m_hasResult && result.m_distance <= btScalar(0);
+		}
+
+		// Exact test of a convex shape against any of the shapes colliders create
+		inline bool Intersects(const btConvexShape* shape, const btTransform& transform, const btCollisionShape* other, const btTransform& otherTransform)
+		{
+			if (other->isConvex())
+				return Intersects(shape, transform, static_cast<const btConvexShape*>(other), otherTransform);
+
+			if (other->isCompound())
+			{
+				auto compound = static_cast<const btCompoundShape*>(other);
+				for (int i = 0; i < compound->getNumChildShapes(); i++)
+				{
+					if (Intersects(shape, transform, compound->getChildShape(i), otherTransform * compound->getChildTransform(i)))
+						return true;
+				}
+				return false;
+			}
+
+			if (other->isConcave())
+			{
+				// Triangles within the bounds of the shape, in the space of the concave shape
+				struct Triangles : btTriangleCallback
+				{
+					void processTriangle(btVector3* triangle, int, int) override
+					{
+						if (!hit)
+						{
+							btTriangleShape triangleShape(triangle[0], triangle[1], triangle[2]);
+							hit = Intersects(shape, transform, &triangleShape, btTransform::getIdentity());
+						}
+					}
+
+					const btConvexShape* shape;
+					btTransform transform;
+					bool hit = false;
+				} triangles;
+				triangles.shape		= shape;
+				triangles.transform	= otherTransform.inverse() * transform;
+
+				btVector3 aabbMin, aabbMax;
+				shape->getAabb(triangles.transform, aabbMin, aabbMax);
+				static_cast<const btConcaveShape*>(other)->processAllTriangles(&triangles, aabbMin, aabbMax);
+				return triangles.hit;
+			}
+
+			return false;
+		}
+	}
+
 	Physics::Physics(Context* context) : Subsystem(context)
 	{
 		m_maxSubSteps	= 1;
 		m_simulating	= false;
+		m_async			= false;
 		m_renderer		= context->GetSubsystem<Renderer>();
+		m_threading		= nullptr;
+		m_shapeCache	= make_unique<ShapeCache>();
 
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(EVENT_TICK, EVENT_HANDLER_VARIANT(Step));
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_END, EVENT_HANDLER(Step_Launch));
 	}
 
 	Physics::~Physics()
 	{
+		Step_Wait();
+
 		SafeDelete(m_world);
+		SafeDelete(m_constraintSolverMt);
 		SafeDelete(m_constraintSolver);
 		SafeDelete(m_dispatcher);
 		SafeDelete(m_collisionConfiguration);
 		SafeDelete(m_broadphase);
 		SafeDelete(m_debugDraw);
+
+		if (m_taskScheduler && btGetTaskScheduler() == m_taskScheduler.get())
+		{
+			btSetTaskScheduler(btGetSequentialTaskScheduler());
+		}
 	}
 
 	bool Physics::Initialize()
 	{
+		m_threading					= m_context->GetSubsystem<Threading>();
 		m_broadphase				= new btDbvtBroadphase();
 		m_collisionConfiguration	= new btDefaultCollisionConfiguration();
-		m_dispatcher				= new btCollisionDispatcher(m_collisionConfiguration);
-		m_constraintSolver			= new btSequentialImpulseConstraintSolver();
 		m_debugDraw					= new PhysicsDebugDraw(m_context->GetSubsystem<Renderer>());
-		m_world						= new btDiscreteDynamicsWorld(m_dispatcher, m_broadphase, m_constraintSolver, m_collisionConfiguration);
+
+		if (Settings::Get().Physics_GetMultithreaded() && m_threading && m_threading->GetThreadCount() > 0)
+		{
+			// The scheduler has to be set before any of the multithreaded classes is created
+			m_taskScheduler = make_unique<_Physics::TaskScheduler>(m_threading);
+			btSetTaskScheduler(m_taskScheduler.get());
+
+			// Islands are solved in parallel by a pool of solvers, islands too large for that are solved by a single multithreaded solver
+			m_dispatcher			= new btCollisionDispatcherMt(m_collisionConfiguration);
+			auto solverPool			= new btConstraintSolverPoolMt(m_taskScheduler->getNumThreads());
+			m_constraintSolver		= solverPool;
+			m_constraintSolverMt	= new btSequentialImpulseConstraintSolverMt();
+			m_world					= new btDiscreteDynamicsWorldMt(m_dispatcher, m_broadphase, solverPool, m_constraintSolverMt, m_collisionConfiguration);
+		}
+		else
+		{
+			m_dispatcher		= new btCollisionDispatcher(m_collisionConfiguration);
+			m_constraintSolver	= new btSequentialImpulseConstraintSolver();
+			m_world				= new btDiscreteDynamicsWorld(m_dispatcher, m_broadphase, m_constraintSolver, m_collisionConfiguration);
+		}
 
 		// Setup world
 		m_world->setGravity(ToBtVector3(GRAVITY));
 		m_world->getDispatchInfo().m_useContinuous	= true;
 		m_world->getSolverInfo().m_splitImpulse		= false;
-		m_world->getSolverInfo().m_numIterations	= MAX_SOLVER_ITERATIONS;
+		m_world->getSolverInfo().m_numIterations	= SOLVER_ITERATIONS;
 		m_world->setDebugDrawer(m_debugDraw);
 
 		// Get version
@@ -96,7 +321,10 @@ namespace Directus
 	{
 		if (!m_world)
 			return;
-		
+
+		// The step which ran since the end of the previous frame is done before anything else touches the world
+		Step_Wait();
+
 		// Debug draw
 		if (m_renderer->Flags_IsSet(Render_Gizmo_Physics))
 		{
@@ -107,10 +335,65 @@ namespace Directus
 		if (!Engine::EngineMode_IsSet(Engine_Physics) || !Engine::EngineMode_IsSet(Engine_Game))
 			return;
 
-		TIME_BLOCK_START_CPU();
-
 		float timeStep = deltaTime.Get<float>();
 
+		// Asynchronous steps are launched once the frame is over
+		if (m_async && m_threading)
+		{
+			m_stepPending = timeStep;
+			return;
+		}
+
+		Step_Simulate(timeStep);
+		Sync_Apply();
+	}
+
+	Vector3 Physics::GetGravity()
+	{
+		return ToVector3(m_world->getGravity());
+	}
+
+	void Physics::SetSolverIterations(int iterations)
+	{
+		GetWorld()->getSolverInfo().m_numIterations = max(1, iterations);
+	}
+
+	int Physics::GetSolverIterations()
+	{
+		return m_world ? m_world->getSolverInfo().m_numIterations : SOLVER_ITERATIONS;
+	}
+
+	void Physics::SetAsync(bool async)
+	{
+		if (!async)
+		{
+			Step_Wait();
+		}
+
+		m_async = async;
+	}
+
+	void Physics::Step_Wait()
+	{
+		unique_lock<mutex> lock(m_stepMutex);
+		m_stepCondition.wait(lock, [this] { return !m_stepInFlight; });
+		lock.unlock();
+
+		Sync_Apply();
+	}
+
+	void Physics::Sync_Record(RigidBody* body, const Vector3& position, const Quaternion& rotation)
+	{
+		m_syncPoses.push_back({ body, position, rotation });
+	}
+
+	void Physics::Step_Simulate(float timeStep)
+	{
+		// Queries in flight finish first, new ones wait for the step
+		unique_lock<shared_mutex> lock(m_worldMutex);
+
+		TIME_BLOCK_START_CPU();
+
 		// This equation must be met: timeStep < maxSubSteps * fixedTimeStep
 		float internalTimeStep = 1.0f / INTERNAL_FPS;
 		int maxSubsteps = (int)(timeStep * INTERNAL_FPS) + 1;
@@ -134,8 +417,238 @@ namespace Directus
 		TIME_BLOCK_END_CPU();
 	}
 
-	Vector3 Physics::GetGravity()
+	void Physics::Step_Launch()
 	{
-		return ToVector3(m_world->getGravity());
+		if (m_stepPending <= 0.0f)
+			return;
+
+		float timeStep	= m_stepPending;
+		m_stepPending	= 0.0f;
+		{
+			lock_guard<mutex> lock(m_stepMutex);
+			m_stepInFlight = true;
+		}
+
+		m_threading->AddTask([this, timeStep]()
+		{
+			Step_Simulate(timeStep);
+
+			lock_guard<mutex> lock(m_stepMutex);
+			m_stepInFlight = false;
+			m_stepCondition.notify_all();
+		});
+	}
+
+	void Physics::Sync_Apply()
+	{
+		if (m_syncPoses.empty())
+			return;
+
+		PROFILE_FUNCTION();
+
+		// Parents go first so that bodies parented to other bodies are placed relative to where their parent ended up.
+		// Hierarchies of bodies are rare, most of the time this is a single pass over the poses and no sort.
+		auto depth = [](Transform* transform)
+		{
+			unsigned int depth = 0;
+			while (transform->HasParent())
+			{
+				transform = transform->GetParent();
+				depth++;
+			}
+			return depth;
+		};
+		bool hasParents = any_of(m_syncPoses.begin(), m_syncPoses.end(), [](const Sync_Pose& pose) { return pose.body->GetTransform()->HasParent(); });
+		if (hasParents)
+		{
+			stable_sort(m_syncPoses.begin(), m_syncPoses.end(), [&depth](const Sync_Pose& a, const Sync_Pose& b)
+			{
+				return depth(a.body->GetTransform()) < depth(b.body->GetTransform());
+			});
+		}
+
+		for (const auto& pose : m_syncPoses)
+		{
+			pose.body->GetTransform()->SetPositionAndRotation(pose.position, pose.rotation);
+			pose.body->m_hasSimulated = true;
+		}
+
+		m_syncPoses.clear();
+	}
+
+	//= QUERIES ==================================================================================================================
+	bool Physics::Raycast(const Vector3& from, const Vector3& to, PhysicsHit* hit, unsigned int mask)
+	{
+		vector<PhysicsHit> hits;
+		Raycast_Batch({ { from, to, mask } }, &hits, hit != nullptr);
+		if (hit)
+		{
+			*hit = hits.front();
+		}
+
+		return hits.front().HasHit();
+	}
+
+	void Physics::Raycast_Batch(const vector<PhysicsRay>& rays, vector<PhysicsHit>* hits, bool closest)
+	{
+		hits->assign(rays.size(), PhysicsHit());
+		if (!m_world)
+			return;
+
+		shared_lock<shared_mutex> lock(m_worldMutex);
+		auto broadphase = static_cast<btDbvtBroadphase*>(m_broadphase);
+		btAlignedObjectArray<const btDbvtNode*> stack;
+
+		for (unsigned int i = 0; i < (unsigned int)rays.size(); i++)
+		{
+			const PhysicsRay& ray = rays[i];
+			btVector3 from	= ToBtVector3(ray.from);
+			btVector3 to	= ToBtVector3(ray.to);
+			btTransform fromTransform(btQuaternion::getIdentity(), from);
+			btTransform toTransform(btQuaternion::getIdentity(), to);
+
+			btCollisionWorld::ClosestRayResultCallback result(from, to);
+			_Physics::Traverse(broadphase, from, to, btVector3(0, 0, 0), btVector3(0, 0, 0), stack, [&](btCollisionObject* object)
+			{
+				if ((!closest && result.hasHit()) || !_Physics::InLayers(object, ray.mask))
+					return;
+
+				btCollisionWorld::rayTestSingle(fromTransform, toTransform, object, object->getCollisionShape(), object->getWorldTransform(), result);
+			});
+
+			_Physics::ToHit(result.m_collisionObject, result.m_hitPointWorld, result.m_hitNormalWorld, result.m_closestHitFraction, &(*hits)[i]);
+		}
+	}
+
+	bool Physics::Sweep(const PhysicsShape& shape, const Vector3& from, const Vector3& to, PhysicsHit* hit, unsigned int mask)
+	{
+		vector<PhysicsHit> hits;
+		Sweep_Batch(shape, { { from, to, mask } }, &hits);
+		if (hit)
+		{
+			*hit = hits.front();
+		}
+
+		return hits.front().HasHit();
+	}
+
+	void Physics::Sweep_Batch(const PhysicsShape& shape, const vector<PhysicsRay>& sweeps, vector<PhysicsHit>* hits)
+	{
+		hits->assign(sweeps.size(), PhysicsHit());
+		if (!m_world)
+			return;
+
+		auto castShape		= _Physics::CreateShape(shape);
+		btQuaternion rotation	= ToBtQuaternion(shape.rotation);
+
+		// Bounds of the shape around its origin, it doesn't rotate during the sweep
+		btVector3 aabbMin, aabbMax;
+		castShape->getAabb(btTransform(rotation), aabbMin, aabbMax);
+
+		shared_lock<shared_mutex> lock(m_worldMutex);
+		auto broadphase = static_cast<btDbvtBroadphase*>(m_broadphase);
+		btAlignedObjectArray<const btDbvtNode*> stack;
+
+		for (unsigned int i = 0; i < (unsigned int)sweeps.size(); i++)
+		{
+			const PhysicsRay& sweep = sweeps[i];
+			btVector3 from	= ToBtVector3(sweep.from);
+			btVector3 to	= ToBtVector3(sweep.to);
+			btTransform fromTransform(rotation, from);
+			btTransform toTransform(rotation, to);
+
+			btCollisionWorld::ClosestConvexResultCallback result(from, to);
+			_Physics::Traverse(broadphase, from, to, aabbMin, aabbMax, stack, [&](btCollisionObject* object)
+			{
+				if (!_Physics::InLayers(object, sweep.mask))
+					return;
+
+				btCollisionWorld::objectQuerySingle(castShape.get(), fromTransform, toTransform, object, object->getCollisionShape(), object->getWorldTransform(), result, btScalar(0));
+			});
+
+			_Physics::ToHit(result.m_hitCollisionObject, result.m_hitPointWorld, result.m_hitNormalWorld, result.m_closestHitFraction, &(*hits)[i]);
+		}
+	}
+
+	bool Physics::Overlap(const PhysicsShape& shape, const Vector3& position, vector<RigidBody*>* bodies, unsigned int mask)
+	{
+		if (bodies)
+		{
+			bodies->clear();
+		}
+
+		if (!m_world)
+			return false;
+
+		auto testShape = _Physics::CreateShape(shape);
+		btTransform transform(ToBtQuaternion(shape.rotation), ToBtVector3(position));
+		btVector3 aabbMin, aabbMax;
+		testShape->getAabb(transform, aabbMin, aabbMax);
+
+		shared_lock<shared_mutex> lock(m_worldMutex);
+		auto broadphase = static_cast<btDbvtBroadphase*>(m_broadphase);
+		btAlignedObjectArray<const btDbvtNode*> stack;
+
+		struct Collector : btDbvt::ICollide
+		{
+			void Process(const btDbvtNode* leaf)
+			{
+				auto object = static_cast<btCollisionObject*>(static_cast<btBroadphaseProxy*>(leaf->data)->m_clientObject);
+				if ((!bodies && found) || !_Physics::InLayers(object, mask))
+					return;
+
+				if (_Physics::Intersects(shape, *transform, object->getCollisionShape(), object->getWorldTransform()))
+				{
+					found = true;
+					if (bodies)
+					{
+						bodies->emplace_back(static_cast<RigidBody*>(object->getUserPointer()));
+					}
+				}
+			}
+
+			const btConvexShape* shape;
+			const btTransform* transform;
+			vector<RigidBody*>* bodies;
+			unsigned int mask;
+			bool found = false;
+		} collector;
+		collector.shape		= testShape.get();
+		collector.transform	= &transform;
+		collector.bodies	= bodies;
+		collector.mask		= mask;
+
+		btDbvtVolume volume = btDbvtVolume::FromMM(aabbMin, aabbMax);
+		for (auto& set : broadphase->m_sets)
+		{
+			set.collideTVNoStackAlloc(set.m_root, volume, stack, collector);
+		}
+
+		return collector.found;
+	}
+	//============================================================================================================================
+
+	Physics_WorldLock::Physics_WorldLock(Physics* physics)
+	{
+		// Nested, e.g. a collider swapping its shape re-creates the body, which locks as well
+		if (physics->m_worldOwner == this_thread::get_id())
+		{
+			m_physics = nullptr;
+			return;
+		}
+
+		m_physics = physics;
+		m_physics->Step_Wait();
+		m_physics->m_worldMutex.lock();
+		m_physics->m_worldOwner = this_thread::get_id();
+	}
+
+	Physics_WorldLock::~Physics_WorldLock()
+	{
+		if (!m_physics)
+			return;
+
+		m_physics->m_worldOwner = thread::id();
+		m_physics->m_worldMutex.unlock();
 	}
 }
@@ -22,7 +22,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES =================
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
 #include "../Core/SubSystem.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
 //============================
 
 class btBroadphaseInterface;
@@ -30,17 +39,72 @@ class btCollisionDispatcher;
 class btConstraintSolver;
 class btDefaultCollisionConfiguration;
 class btDiscreteDynamicsWorld;
+class btITaskScheduler;
 
 namespace Directus
 {
 	class Renderer;
 	class Variant;
 	class PhysicsDebugDraw;
+	class Threading;
+	class RigidBody;
+	class ShapeCache;
+	class Physics;
 
-	namespace Math
+	//= QUERIES ================================================================================================
+	// Every layer, queries take a mask with a bit per RigidBody layer
+	static const unsigned int PhysicsLayer_All = 0xFFFFFFFF;
+
+	struct PhysicsRay
+	{
+		Math::Vector3 from;
+		Math::Vector3 to;
+		unsigned int mask = PhysicsLayer_All;
+	};
+
+	struct PhysicsHit
+	{
+		bool HasHit() const { return body != nullptr; }
+
+		// Nothing was hit when null
+		RigidBody* body = nullptr;
+		Math::Vector3 position;
+		Math::Vector3 normal;
+		// Where along the ray or sweep, from 0 to 1
+		float fraction = 1.0f;
+	};
+
+	enum PhysicsShape_Type
+	{
+		PhysicsShape_Sphere,
+		PhysicsShape_Box,
+		PhysicsShape_Capsule
+	};
+
+	// Shape to sweep or test for overlaps. The radius (sphere, capsule) is size.x,
+	// the half extents (box) are size and the height of the cylinder part (capsule) is size.y.
+	struct PhysicsShape
+	{
+		PhysicsShape_Type type		= PhysicsShape_Sphere;
+		Math::Vector3 size			= Math::Vector3(0.5f);
+		Math::Quaternion rotation	= Math::Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+	};
+	//==========================================================================================================
+
+	// Exclusive access to the world (see Physics::World_Lock), released when it goes out of scope
+	class Physics_WorldLock
 	{
-		class Vector3;
-	}	
+	public:
+		Physics_WorldLock(Physics* physics);
+		~Physics_WorldLock();
+		Physics_WorldLock(Physics_WorldLock&& other) noexcept : m_physics(other.m_physics) { other.m_physics = nullptr; }
+		Physics_WorldLock(const Physics_WorldLock&) = delete;
+		Physics_WorldLock& operator=(const Physics_WorldLock&) = delete;
+
+	private:
+		// Null when the thread already held the lock further up
+		Physics* m_physics;
+	};
 
 	class Physics : public Subsystem
 	{
@@ -54,23 +118,100 @@ namespace Directus
 
 		void Step(const Variant& deltaTime);
 		Math::Vector3 GetGravity();
-		btDiscreteDynamicsWorld* GetWorld()		{ return m_world; }
+		// Waits for an asynchronous step which is still in flight, so the world can be changed safely
+		// (no step runs while the calling thread holds World_Lock(), it already waited)
+		btDiscreteDynamicsWorld* GetWorld()
+		{
+			if (m_worldOwner != std::this_thread::get_id())
+			{
+				Step_Wait();
+			}
+			return m_world;
+		}
 		PhysicsDebugDraw* GetPhysicsDebugDraw() { return m_debugDraw; }
+		ShapeCache* GetShapeCache()				{ return m_shapeCache.get(); }
 		bool IsSimulating()						{ return m_simulating; }
 
+		// Constraint solver iterations per (sub)step
+		void SetSolverIterations(int iterations);
+		int GetSolverIterations();
+
+		// When enabled, a step runs on the thread pool from the end of the frame (after the renderer captured it)
+		// until the physics tick of the next frame, overlapping with drawing. Transforms are written when the step
+		// is joined, so nothing outside the frame should touch the world while IsSimulating().
+		void SetAsync(bool async);
+		bool GetAsync()	{ return m_async; }
+
+		// Joins an asynchronous step, if one is in flight, and applies the poses it produced
+		void Step_Wait();
+
+		// Called by bodies which moved during a step (Bullet only reports active bodies, sleeping ones cost nothing).
+		// The pose is applied to the body's transform once the step is done.
+		void Sync_Record(RigidBody* body, const Math::Vector3& position, const Math::Quaternion& rotation);
+
+		//= QUERIES =================================================================================================================================
+		// Run against the broadphase as it was left by the last step, from any thread. Batches amortize the locking and setup, split a large
+		// batch into jobs to spread it across threads. Steps and bodies being added or removed wait for the queries in flight, and the other
+		// way around, bodies moved directly (e.g. RigidBody::SetPosition) are not synchronized.
+		bool Raycast(const Math::Vector3& from, const Math::Vector3& to, PhysicsHit* hit = nullptr, unsigned int mask = PhysicsLayer_All);
+		// When only whether something was hit matters (e.g. line of sight), closest = false ends each ray at the first hit found
+		void Raycast_Batch(const std::vector<PhysicsRay>& rays, std::vector<PhysicsHit>* hits, bool closest = true);
+		bool Sweep(const PhysicsShape& shape, const Math::Vector3& from, const Math::Vector3& to, PhysicsHit* hit = nullptr, unsigned int mask = PhysicsLayer_All);
+		void Sweep_Batch(const PhysicsShape& shape, const std::vector<PhysicsRay>& sweeps, std::vector<PhysicsHit>* hits);
+		// Bodies touching the shape, without a list it returns as soon as one is found
+		bool Overlap(const PhysicsShape& shape, const Math::Vector3& position, std::vector<RigidBody*>* bodies = nullptr, unsigned int mask = PhysicsLayer_All);
+		//===========================================================================================================================================
+
+		// For changes to the world and its bodies which neither a step nor queries on other threads may see half done, waits for an
+		// asynchronous step first. Components take it around every change they make, it can be taken again by the thread holding it.
+		Physics_WorldLock World_Lock() { return Physics_WorldLock(this); }
+
 	private:
+		friend class Physics_WorldLock;
+		void Step_Simulate(float timeStep);
+		void Step_Launch();
+		void Sync_Apply();
+
 		btBroadphaseInterface* m_broadphase;
 		btCollisionDispatcher* m_dispatcher;
 		btConstraintSolver* m_constraintSolver;
+		// Solves large islands across threads (multithreaded world only)
+		btConstraintSolver* m_constraintSolverMt = nullptr;
 		btDefaultCollisionConfiguration* m_collisionConfiguration;
 		btDiscreteDynamicsWorld* m_world;
 		PhysicsDebugDraw* m_debugDraw;
+		// Backs Bullet's multithreaded world with the engine's thread pool
+		std::unique_ptr<btITaskScheduler> m_taskScheduler;
+		// Mesh shapes shared between colliders
+		std::unique_ptr<ShapeCache> m_shapeCache;
 
-		//= PROPERTIES ===
+		//= PROPERTIES =====================
 		int m_maxSubSteps;
-		bool m_simulating;
-		//================
+		std::atomic<bool> m_simulating;
+		bool m_async;
+		//==================================
+
+		// Asynchronous stepping
+		float m_stepPending	= 0.0f;
+		bool m_stepInFlight	= false;
+		std::mutex m_stepMutex;
+		std::condition_variable m_stepCondition;
+
+		// Poses recorded during the last step, kept around so the capacity is reused
+		struct Sync_Pose
+		{
+			RigidBody* body;
+			Math::Vector3 position;
+			Math::Quaternion rotation;
+		};
+		std::vector<Sync_Pose> m_syncPoses;
+
+		// Queries share it, steps and changes to the world take it exclusively
+		std::shared_mutex m_worldMutex;
+		// The thread which holds it through World_Lock()
+		std::atomic<std::thread::id> m_worldOwner = std::thread::id();
 
 		Renderer* m_renderer;
+		Threading* m_threading;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,345 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================================================================
+#include <algorithm>
+#include "ShapeCache.h"
+#include "BulletPhysicsHelper.h"
+#include "../Core/Stopwatch.h"
+#include "../IO/FileStream.h"
+#include "../FileSystem/FileSystem.h"
+#include "../Logging/Log.h"
+#include "../Rendering/Model.h"
+#include "../RHI/RHI_Vertex.h"
+#include "../World/Components/Renderable.h"
+#pragma warning(push, 0) // Hide warnings which belong to Bullet
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#pragma warning(pop)
+//================================================================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	namespace _ShapeCache
+	{
+		static const unsigned int fileMagic		= 0x4C4F4344; // "DCOL"
+		// 2: The BVH is stored with a checksum
+		static const unsigned int fileVersion	= 2;
+
+		// The quantized BVH stores the triangle index in 21 bits (the rest is the part index),
+		// larger meshes are split into parts which share the same vertices
+		static const unsigned int partTriangleLimit = (1u << (31 - MAX_NUM_PARTS_IN_BITS)) - 1;
+
+		// Fingerprint of the geometry, a saved BVH is only used if it was built from the same geometry (FNV-1a)
+		template <typename T>
+		void Hash(unsigned long long& hash, const vector<T>& data)
+		{
+			static_assert(sizeof(T) == sizeof(uint32_t), "Hashed in 32-bit words");
+			for (const T& value : data)
+			{
+				uint32_t word;
+				memcpy(&word, &value, sizeof(word));
+				hash = (hash ^ word) * 1099511628211ull;
+			}
+		}
+
+		// The saved BVH is used in place, so it's only trusted if it's exactly what was written (FNV-1a)
+		unsigned long long Checksum(const vector<std::byte>& data)
+		{
+			unsigned long long hash = 14695981039346656037ull;
+			for (const std::byte value : data)
+			{
+				hash = (hash ^ (unsigned long long)value) * 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+
+	// Everything a triangle mesh shape points to, the shape doesn't own any of it
+	struct ShapeCache::TriangleMesh
+	{
+		~TriangleMesh()
+		{
+			// The shape goes first, it references the BVH and the mesh
+			shape.reset();
+			if (bvhBuffer)
+			{
+				bvh->~btOptimizedBvh();
+				btAlignedFree(bvhBuffer);
+			}
+		}
+
+		// Positions only, tightly packed
+		vector<float> positions;
+		vector<int> indices;
+		unique_ptr<btTriangleIndexVertexArray> meshInterface;
+		unique_ptr<btBvhTriangleMeshShape> shape;
+
+		// A BVH loaded from a file lives in place, in this buffer
+		btOptimizedBvh* bvh	= nullptr;
+		void* bvhBuffer		= nullptr;
+	};
+
+	shared_ptr<btCollisionShape> ShapeCache::Acquire(Renderable* renderable, ShapeCache_Type type, const Vector3& scale, bool optimize)
+	{
+		shared_ptr<Model> model = renderable ? renderable->Geometry_Model() : nullptr;
+		if (!model || renderable->Geometry_IndexCount() == 0 || renderable->Geometry_VertexCount() == 0)
+			return nullptr;
+
+		GeometryKey geometryKey(model.get(), renderable->Geometry_IndexOffset(), renderable->Geometry_IndexCount(), renderable->Geometry_VertexOffset(), renderable->Geometry_VertexCount());
+		ShapeKey key(geometryKey, int(type), scale.x, scale.y, scale.z, type == ShapeCache_ConvexHull && optimize);
+
+		lock_guard<mutex> lock(m_mutex);
+
+		// Shared
+		auto it = m_shapes.find(key);
+		if (it != m_shapes.end() && !it->second.model.expired())
+		{
+			if (auto shape = it->second.value.lock())
+				return shape;
+		}
+
+		// Forget shapes which are no longer used by anyone
+		for (auto it = m_shapes.begin(); it != m_shapes.end();)
+		{
+			it = it->second.value.expired() ? m_shapes.erase(it) : next(it);
+		}
+		for (auto it = m_triangleMeshes.begin(); it != m_triangleMeshes.end();)
+		{
+			it = it->second.value.expired() ? m_triangleMeshes.erase(it) : next(it);
+		}
+
+		shared_ptr<btCollisionShape> shape;
+		if (type == ShapeCache_ConvexHull)
+		{
+			vector<unsigned int> indices;
+			vector<RHI_Vertex_PosUvNorTan> vertices;
+			renderable->Geometry_Get(&indices, &vertices);
+			if (vertices.empty())
+				return nullptr;
+
+			auto hull = new btConvexHullShape(
+				(btScalar*)&vertices[0],						// points
+				(int)vertices.size(),							// point count
+				(unsigned int)sizeof(RHI_Vertex_PosUvNorTan));	// stride
+
+			// Scaling has to be done before (potential) optimization
+			hull->setLocalScaling(ToBtVector3(scale));
+
+			if (optimize)
+			{
+				hull->optimizeConvexHull();
+				hull->initializePolyhedralFeatures();
+			}
+
+			shape = shared_ptr<btCollisionShape>(hull);
+		}
+		else
+		{
+			shared_ptr<TriangleMesh> mesh = TriangleMesh_Acquire(renderable, geometryKey);
+			if (!mesh)
+				return nullptr;
+
+			if (scale == Vector3::One)
+			{
+				// Shares ownership of the mesh
+				shape = shared_ptr<btCollisionShape>(mesh, mesh->shape.get());
+			}
+			else
+			{
+				// Scaled instance of the shared mesh, the mesh stays alive as long as the instance does
+				shape = shared_ptr<btCollisionShape>(new btScaledBvhTriangleMeshShape(mesh->shape.get(), ToBtVector3(scale)), [mesh](btCollisionShape* scaled) { delete scaled; });
+			}
+		}
+
+		m_shapes[key] = { model, shape };
+		return shape;
+	}
+
+	shared_ptr<ShapeCache::TriangleMesh> ShapeCache::TriangleMesh_Acquire(Renderable* renderable, const GeometryKey& key)
+	{
+		shared_ptr<Model> model = renderable->Geometry_Model();
+
+		// Shared
+		auto it = m_triangleMeshes.find(key);
+		if (it != m_triangleMeshes.end() && !it->second.model.expired())
+		{
+			if (auto mesh = it->second.value.lock())
+				return mesh;
+		}
+
+		vector<unsigned int> indices;
+		vector<RHI_Vertex_PosUvNorTan> vertices;
+		renderable->Geometry_Get(&indices, &vertices);
+		if (indices.size() < 3 || vertices.empty())
+		{
+			LOG_WARNING("ShapeCache::TriangleMesh_Acquire: No triangles.");
+			return nullptr;
+		}
+
+		auto mesh = make_shared<TriangleMesh>();
+		mesh->indices.assign(indices.begin(), indices.end());
+		mesh->positions.reserve(vertices.size() * 3);
+		for (const auto& vertex : vertices)
+		{
+			mesh->positions.emplace_back(vertex.pos[0]);
+			mesh->positions.emplace_back(vertex.pos[1]);
+			mesh->positions.emplace_back(vertex.pos[2]);
+		}
+
+		// Split into parts the BVH can address
+		mesh->meshInterface = make_unique<btTriangleIndexVertexArray>();
+		unsigned int triangleCount = (unsigned int)mesh->indices.size() / 3;
+		for (unsigned int triangleFirst = 0; triangleFirst < triangleCount; triangleFirst += _ShapeCache::partTriangleLimit)
+		{
+			btIndexedMesh part;
+			part.m_numTriangles			= (int)min(triangleCount - triangleFirst, _ShapeCache::partTriangleLimit);
+			part.m_triangleIndexBase	= (const unsigned char*)&mesh->indices[triangleFirst * 3];
+			part.m_triangleIndexStride	= 3 * sizeof(int);
+			part.m_numVertices			= (int)vertices.size();
+			part.m_vertexBase			= (const unsigned char*)mesh->positions.data();
+			part.m_vertexStride			= 3 * sizeof(float);
+			part.m_vertexType			= PHY_FLOAT;
+			mesh->meshInterface->addIndexedMesh(part, PHY_INTEGER);
+		}
+
+		unsigned long long hash = 14695981039346656037ull;
+		_ShapeCache::Hash(hash, mesh->indices);
+		_ShapeCache::Hash(hash, mesh->positions);
+
+		// Only models in the engine format get a file next to them (named after the part of the model)
+		string filePath = model->GetResourceFilePath();
+		if (FileSystem::IsEngineModelFile(filePath) && FileSystem::FileExists(filePath))
+		{
+			filePath = FileSystem::GetFilePathWithoutExtension(filePath) + "_" + to_string(get<1>(key)) + "_" + to_string(get<2>(key)) + EXTENSION_COLLISION;
+		}
+		else
+		{
+			filePath.clear();
+		}
+
+		if (!filePath.empty() && TriangleMesh_Load(mesh.get(), filePath, hash))
+		{
+			mesh->shape = make_unique<btBvhTriangleMeshShape>(mesh->meshInterface.get(), true, false);
+			mesh->shape->setOptimizedBvh(mesh->bvh);
+		}
+		else
+		{
+			Stopwatch timer;
+			mesh->shape = make_unique<btBvhTriangleMeshShape>(mesh->meshInterface.get(), true, true);
+			LOGF_INFO("Building the BVH of %d triangles took %d ms", (int)triangleCount, (int)timer.GetElapsedTimeMs());
+
+			if (!filePath.empty())
+			{
+				TriangleMesh_Save(mesh.get(), filePath, hash);
+			}
+		}
+
+		m_triangleMeshes[key] = { model, mesh };
+		return mesh;
+	}
+
+	bool ShapeCache::TriangleMesh_Load(TriangleMesh* mesh, const string& filePath, unsigned long long hash)
+	{
+		if (!FileSystem::FileExists(filePath))
+			return false;
+
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
+		if (!file->IsOpen())
+			return false;
+
+		unsigned int magic		= file->ReadUInt();
+		unsigned int version	= file->ReadUInt();
+		unsigned long long fileHash = 0;
+		file->Read(&fileHash);
+		if (magic != _ShapeCache::fileMagic || version != _ShapeCache::fileVersion || fileHash != hash)
+			return false;
+
+		// A corrupted length runs out of data and fails the stream instead of allocating what it claims
+		unsigned long long checksum = 0;
+		vector<std::byte> data;
+		file->Read(&checksum);
+		file->Read(&data);
+		if (file->HasFailed() || data.size() < sizeof(btOptimizedBvh) || _ShapeCache::Checksum(data) != checksum)
+		{
+			LOGF_WARNING("\"%s\" is invalid, rebuilding it.", filePath.c_str());
+			return false;
+		}
+
+		// The BVH is used in place, the buffer has to be aligned. Its header has to account for exactly the size that
+		// was saved, Bullet only checks that it isn't larger (and asserts, before returning null).
+		auto size		= (unsigned int)data.size();
+		void* buffer	= btAlignedAlloc(size, 16);
+		memcpy(buffer, data.data(), size);
+		btOptimizedBvh* bvh = nullptr;
+		if (static_cast<btOptimizedBvh*>(buffer)->calculateSerializeBufferSize() == size)
+		{
+			bvh = btOptimizedBvh::deSerializeInPlace(buffer, size, false);
+		}
+		if (!bvh)
+		{
+			LOGF_WARNING("\"%s\" is invalid, rebuilding it.", filePath.c_str());
+			btAlignedFree(buffer);
+			return false;
+		}
+
+		mesh->bvh		= bvh;
+		mesh->bvhBuffer	= buffer;
+		return true;
+	}
+
+	bool ShapeCache::TriangleMesh_Save(TriangleMesh* mesh, const string& filePath, unsigned long long hash)
+	{
+		btOptimizedBvh* bvh	= mesh->shape->getOptimizedBvh();
+		unsigned int size	= bvh->calculateSerializeBufferSize();
+		void* buffer		= btAlignedAlloc(size, 16);
+		bvh->serializeInPlace(buffer, size, false);
+		vector<std::byte> data((const std::byte*)buffer, (const std::byte*)buffer + size);
+		btAlignedFree(buffer);
+
+		// Written once, read every time the model is used for collision
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, FileStreamCompression_High);
+		if (file->IsOpen())
+		{
+			file->Write(_ShapeCache::fileMagic);
+			file->Write(_ShapeCache::fileVersion);
+			file->Write(hash);
+			file->Write(_ShapeCache::Checksum(data));
+			file->Write(data);
+		}
+
+		if (!file->IsOpen())
+		{
+			LOGF_WARNING("Failed to write \"%s\".", filePath.c_str());
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,84 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <string>
+#include <memory>
+#include "../Math/Vector3.h"
+//=========================
+
+class btCollisionShape;
+
+namespace Directus
+{
+	class Model;
+	class Renderable;
+
+	enum ShapeCache_Type
+	{
+		// Convex hull around the vertices, works with any body
+		ShapeCache_ConvexHull,
+		// Exact triangle mesh with a BVH, for static and kinematic bodies only
+		ShapeCache_TriangleMesh
+	};
+
+	// Mesh collision shapes, shared by every collider which uses the same part of a model at the same scale.
+	// Triangle meshes share their BVH across scales too, the BVH is saved next to the model so it's only built once.
+	// Shapes are released when the last collider using them lets go.
+	class ShapeCache
+	{
+	public:
+		ShapeCache() = default;
+		~ShapeCache() = default;
+
+		// The geometry (model and index/vertex range) of the renderable, nullptr if it has none
+		std::shared_ptr<btCollisionShape> Acquire(Renderable* renderable, ShapeCache_Type type, const Math::Vector3& scale, bool optimize);
+
+	private:
+		struct TriangleMesh;
+
+		// Model, index offset, index count, vertex offset, vertex count
+		typedef std::tuple<const Model*, unsigned int, unsigned int, unsigned int, unsigned int> GeometryKey;
+		// Geometry, type, scale, optimize
+		typedef std::tuple<GeometryKey, int, float, float, float, bool> ShapeKey;
+
+		// The model is tracked too, so an entry is never mistaken for one of a new model at the same address
+		template <typename T>
+		struct Entry
+		{
+			std::weak_ptr<Model> model;
+			std::weak_ptr<T> value;
+		};
+
+		std::shared_ptr<TriangleMesh> TriangleMesh_Acquire(Renderable* renderable, const GeometryKey& key);
+		bool TriangleMesh_Load(TriangleMesh* mesh, const std::string& filePath, unsigned long long hash);
+		bool TriangleMesh_Save(TriangleMesh* mesh, const std::string& filePath, unsigned long long hash);
+
+		std::map<ShapeKey, Entry<btCollisionShape>> m_shapes;
+		std::map<GeometryKey, Entry<TriangleMesh>> m_triangleMeshes;
+		std::mutex m_mutex;
+	};
+}
@@ -0,0 +1,828 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =================================
+#include "Benchmark.h"
+#include <cmath>
+#include <cfloat>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <fstream>
+#include <iomanip>
+#include "../Core/Context.h"
+#include "../Core/Engine.h"
+#include "../Core/Stopwatch.h"
+#include "../Core/EventSystem.h"
+#include "../Core/Variant.h"
+#include "../Core/Allocators.h"
+#include "../Core/Settings.h"
+#include "../World/World.h"
+#include "../World/Actor.h"
+#include "../World/Components/Transform.h"
+#include "../World/Components/Renderable.h"
+#include "../World/Components/Light.h"
+#include "../World/Components/Collider.h"
+#include "../World/Components/RigidBody.h"
+#include "../World/Components/Script.h"
+#include "../World/Components/Camera.h"
+#include "../Rendering/Renderer.h"
+#include "../Rendering/RenderGraph.h"
+#include "../Rendering/RenderSnapshot.h"
+#include "../Rendering/Model.h"
+#include "../Rendering/Utilities/Geometry.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Ray.h"
+#include "../Resource/ResourceCache.h"
+#include "../Threading/Threading.h"
+#include "../FileSystem/FileSystem.h"
+#include "../Logging/Log.h"
+#include "../Profiling/Profiler.h"
+//============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	namespace Benchmark_Helper
+	{
+		static const char* MODEL_NAME	= "Benchmark_Cube";
+		static const float DELTA_TIME	= 1.0f / 60.0f;
+		static const float SPACING		= 3.0f;
+
+		// Shared with the loading task, which can outlive a timed out benchmark
+		struct Load
+		{
+			atomic<bool> done	= false;
+			bool success		= false;
+			double time			= 0.0;
+		};
+
+		// Spreads a ratio evenly over the actors, e.g. 0.25 is true for every 4th actor
+		inline bool Pick(unsigned int index, float ratio)
+		{
+			return (unsigned int)((index + 1) * ratio) != (unsigned int)(index * ratio);
+		}
+
+		inline shared_ptr<Model> GetModel(Context* context, unsigned int* indexCount, unsigned int* vertexCount)
+		{
+			vector<RHI_Vertex_PosUvNorTan> vertices;
+			vector<unsigned int> indices;
+			Utility::Geometry::CreateCube(&vertices, &indices);
+			*indexCount		= (unsigned int)indices.size();
+			*vertexCount	= (unsigned int)vertices.size();
+
+			auto resourceCache = context->GetSubsystem<ResourceCache>();
+			if (auto model = resourceCache->GetByName<Model>(MODEL_NAME))
+				return model;
+
+			// All renderables share one model, like instances of an imported mesh would
+			auto model = make_shared<Model>(context);
+			model->SetResourceName(MODEL_NAME);
+			model->Geometry_Append(indices, vertices, nullptr, nullptr);
+			model->Geometry_Update();
+			resourceCache->Cache(model);
+
+			return model;
+		}
+
+		inline void Measure(vector<Benchmark_Metric>* metrics, const string& name, double value, const char* unit)
+		{
+			Benchmark_Metric metric;
+			metric.name		= name;
+			metric.value	= value;
+			metric.unit		= unit;
+			metrics->emplace_back(metric);
+		}
+
+		// Runs the operation once to warm up the caches, then returns the fastest of a few timed runs in ms.
+		// The fastest run is the one the least disturbed by the rest of the system.
+		template <typename Operation>
+		inline double Time(const Operation& operation, unsigned int runs = 5)
+		{
+			operation();
+			double fastest = DBL_MAX;
+			for (unsigned int i = 0; i < runs; i++)
+			{
+				Stopwatch stopwatch;
+				operation();
+				fastest = min(fastest, (double)stopwatch.GetElapsedTimeMs());
+			}
+			return fastest;
+		}
+
+		// A world matrix, like the ones transforms produce
+		inline Matrix RandomTransform(mt19937& random)
+		{
+			uniform_real_distribution<float> position(-100.0f, 100.0f);
+			uniform_real_distribution<float> angle(-180.0f, 180.0f);
+			uniform_real_distribution<float> scale(0.5f, 2.0f);
+			return Matrix
+			(
+				Vector3(position(random), position(random), position(random)),
+				Quaternion::FromEulerAngles(angle(random), angle(random), angle(random)),
+				Vector3(scale(random), scale(random), scale(random))
+			);
+		}
+
+		// A general (e.g. projective) matrix, kept diagonally dominant so that it's well conditioned
+		inline Matrix RandomMatrix(mt19937& random)
+		{
+			uniform_real_distribution<float> element(-1.0f, 1.0f);
+			Matrix matrix;
+			float* elements = &matrix.m00;
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				elements[i] = element(random) + ((i % 5 == 0) ? 4.0f : 0.0f);
+			}
+			return matrix;
+		}
+	}
+
+	Benchmark::Benchmark(Context* context)
+	{
+		m_context			= context;
+		m_scratchDirectory	= "Benchmark//";
+		m_frameCount		= 60;
+		m_timeoutSec		= 300.0f;
+	}
+
+	vector<Benchmark_Scene> Benchmark::GetDefaultScenes()
+	{
+		vector<Benchmark_Scene> scenes;
+		for (const auto count : { 1000u, 10000u, 100000u, 1000000u })
+		{
+			Benchmark_Scene scene;
+			scene.name			= "Flat_" + to_string(count);
+			scene.actorCount	= count;
+			scenes.emplace_back(scene);
+		}
+
+		for (const auto count : { 1000u, 10000u })
+		{
+			Benchmark_Scene scene;
+			scene.name				= "Deep_" + to_string(count);
+			scene.actorCount		= count;
+			scene.hierarchyDepth	= 32;
+			scenes.emplace_back(scene);
+		}
+
+		return scenes;
+	}
+
+	bool Benchmark::Run(const Benchmark_Scene& scene, Benchmark_Result* result)
+	{
+		if (!result || scene.actorCount == 0 || scene.hierarchyDepth == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		auto world		= m_context->GetSubsystem<World>();
+		auto renderer	= m_context->GetSubsystem<Renderer>();
+		result->scene	= scene;
+		LOGF_INFO("Benchmark::Run: %s (%d actors)", scene.name.c_str(), scene.actorCount);
+
+		// Create
+		world->Unload();
+		Stopwatch stopwatch;
+		CreateWorld(scene);
+		result->create = stopwatch.GetElapsedTimeMs();
+
+		// Tick (the first tick also submits the new world to the renderer, so it's left out)
+		FIRE_EVENT_DATA(EVENT_TICK, Benchmark_Helper::DELTA_TIME);
+		stopwatch.Start();
+		for (unsigned int i = 0; i < m_frameCount; i++)
+		{
+			FIRE_EVENT_DATA(EVENT_TICK, Benchmark_Helper::DELTA_TIME);
+		}
+		result->tick = stopwatch.GetElapsedTimeMs() / m_frameCount;
+
+		// Renderer acquisition and sorting
+		auto actors = world->Actors_GetAll();
+		stopwatch.Start();
+		EventSystem::Get().Fire<Event_WorldSubmit>(actors);
+		result->acquire = stopwatch.GetElapsedTimeMs();
+		actors.clear();
+
+		// Renderer (culling only, when headless)
+		stopwatch.Start();
+		for (unsigned int i = 0; i < m_frameCount; i++)
+		{
+			renderer->Render();
+		}
+		result->render					= stopwatch.GetElapsedTimeMs() / m_frameCount;
+		const auto& stats				= Profiler::Get().GetRenderStats();
+		result->graphPasses				= stats.rendererGraphPasses;
+		result->graphPassesCulled		= stats.rendererGraphPassesCulled;
+		result->graphMemoryTransient	= stats.rendererGraphMemoryTransient;
+		result->graphMemoryAliased		= stats.rendererGraphMemoryAliased;
+
+		// Picking through the center of the viewport
+		if (auto camera = renderer->GetCamera())
+		{
+			const auto& viewport	= Settings::Get().Viewport_Get();
+			Vector2 center			= Settings::Get().Viewport_GetTopLeft() + Vector2(viewport.GetWidth(), viewport.GetHeight()) * 0.5f;
+			stopwatch.Start();
+			for (unsigned int i = 0; i < m_frameCount; i++)
+			{
+				camera->Pick(center);
+			}
+			result->pick = stopwatch.GetElapsedTimeMs() / m_frameCount;
+		}
+
+		// Save
+		FileSystem::CreateDirectory_(m_scratchDirectory);
+		string filePath = m_scratchDirectory + scene.name + EXTENSION_WORLD;
+		stopwatch.Start();
+		if (!world->SaveToFile(filePath))
+		{
+			LOGF_ERROR("Benchmark::Run: Failed to save \"%s\"", filePath.c_str());
+			return false;
+		}
+		result->save = stopwatch.GetElapsedTimeMs();
+
+		// Load
+		if (!LoadWorld(filePath, &result->load))
+			return false;
+
+		// Clone every hierarchy once
+		auto roots = world->Actors_GetRoots();
+		stopwatch.Start();
+		for (const auto& root : roots)
+		{
+			root->Clone();
+		}
+		result->clone = stopwatch.GetElapsedTimeMs();
+
+		// Leave a default world behind
+		world->Unload();
+		world->Initialize();
+
+		return true;
+	}
+
+	bool Benchmark::LoadWorld(const string& filePath, double* time)
+	{
+		auto world		= m_context->GetSubsystem<World>();
+		auto threading	= m_context->GetSubsystem<Threading>();
+
+		// The world only lets go of its actors once it ticks, so the loading happens on another thread and is timed there.
+		// This thread keeps ticking without sleeping, so the hand-off adds at most one (empty) tick to the time.
+		auto load = make_shared<Benchmark_Helper::Load>();
+		threading->AddTask([world, filePath, load]()
+		{
+			Stopwatch stopwatch;
+			load->success	= world->LoadFromFile(filePath);
+			load->time		= stopwatch.GetElapsedTimeMs();
+			load->done		= true;
+		});
+		Stopwatch stopwatch;
+		while (!load->done)
+		{
+			if (stopwatch.GetElapsedTimeSec() > m_timeoutSec)
+			{
+				LOGF_ERROR("Benchmark::LoadWorld: Loading \"%s\" didn't finish within %.0f seconds", filePath.c_str(), m_timeoutSec);
+				return false;
+			}
+
+			world->Tick();
+			this_thread::yield();
+		}
+		*time = load->time;
+		if (!load->success)
+		{
+			LOGF_ERROR("Benchmark::LoadWorld: Failed to load \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Benchmark::Run(const vector<Benchmark_Scene>& scenes, const string& filePath)
+	{
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.good())
+		{
+			LOGF_ERROR("Benchmark::Run: Failed to open \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		out << fixed << setprecision(4);
+		out << "{\n\"frames\":" << m_frameCount << ",\n\"benchmarks\":[";
+
+		bool success = true;
+		for (unsigned int i = 0; i < (unsigned int)scenes.size(); i++)
+		{
+			Benchmark_Result result;
+			success = Run(scenes[i], &result) && success;
+
+			out << (i == 0 ? "\n" : ",\n")
+				<< "{\"name\":\"" << result.scene.name << "\",\"actors\":" << result.scene.actorCount << ",\"depth\":" << result.scene.hierarchyDepth
+				<< ",\"create_ms\":" << result.create << ",\"tick_ms\":" << result.tick << ",\"acquire_ms\":" << result.acquire << ",\"render_ms\":" << result.render
+				<< ",\"pick_ms\":" << result.pick << ",\"save_ms\":" << result.save << ",\"load_ms\":" << result.load << ",\"clone_ms\":" << result.clone
+				<< ",\"graph_passes\":" << result.graphPasses << ",\"graph_passes_culled\":" << result.graphPassesCulled
+				<< ",\"graph_bytes_transient\":" << result.graphMemoryTransient << ",\"graph_bytes_aliased\":" << result.graphMemoryAliased << "}";
+		}
+		out << "\n]\n}\n";
+
+		return success;
+	}
+
+	bool Benchmark::Run_Systems(vector<Benchmark_Metric>* metrics)
+	{
+		if (!metrics)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		bool success = true;
+		success = System_RenderGraph(metrics) && success;
+		success = System_Trace(metrics) && success;
+		success = System_Events(metrics) && success;
+		success = System_Snapshots(metrics) && success;
+		success = System_Allocations(metrics) && success;
+		success = System_Matrix(metrics) && success;
+		success = System_Bounds(metrics) && success;
+		success = System_WorldRoundTrip(metrics) && success;
+
+		return success;
+	}
+
+	bool Benchmark::Run_Systems(const string& filePath)
+	{
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.good())
+		{
+			LOGF_ERROR("Benchmark::Run_Systems: Failed to open \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		vector<Benchmark_Metric> metrics;
+		bool success = Run_Systems(&metrics);
+
+		out << fixed << setprecision(4);
+		out << "{\n\"success\":" << (success ? "true" : "false") << ",\n\"metrics\":[";
+		for (unsigned int i = 0; i < (unsigned int)metrics.size(); i++)
+		{
+			out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << metrics[i].name << "\",\"value\":" << metrics[i].value << ",\"unit\":\"" << metrics[i].unit << "\"}";
+		}
+		out << "\n]\n}\n";
+
+		return success;
+	}
+
+	bool Benchmark::System_RenderGraph(vector<Benchmark_Metric>* metrics)
+	{
+		// A 1080p deferred frame, shaped like the renderer's: shadows and SSAO at half resolution,
+		// a lighting target and a chain of full resolution post-processing effects
+		const unsigned int width	= 1920;
+		const unsigned int height	= 1080;
+		const unsigned int effects	= 6;
+
+		RenderGraph graph;
+		auto Build = [&graph, width, height, effects]()
+		{
+			graph.Clear();
+			auto res_frame		= graph.Resource_Import("Frame", nullptr);
+			auto res_gbuffer	= graph.Resource_Import("GBuffer", nullptr);
+			auto res_shadows	= graph.Resource_Create("Shadows", width / 2, height / 2, Texture_Format_R8_UNORM);
+			auto res_shadowsRaw	= graph.Resource_Create("Shadows_Raw", width / 2, height / 2, Texture_Format_R8_UNORM);
+			auto res_ssao		= graph.Resource_Create("SSAO", width / 2, height / 2, Texture_Format_R8_UNORM);
+			auto res_light		= graph.Resource_Create("HDR_Light", width, height, Texture_Format_R32G32B32A32_FLOAT);
+
+			auto pass = graph.Pass_Add("GBuffer", nullptr);
+			graph.Pass_Write(pass, res_gbuffer);
+
+			pass = graph.Pass_Add("Shadowing", nullptr);
+			graph.Pass_Read(pass, res_gbuffer);
+			graph.Pass_Write(pass, res_shadowsRaw);
+			graph.Pass_Write(pass, res_shadows);
+
+			// Nothing reads it, so it gets culled
+			pass = graph.Pass_Add("SSAO", nullptr);
+			graph.Pass_Read(pass, res_gbuffer);
+			graph.Pass_Write(pass, res_ssao);
+
+			pass = graph.Pass_Add("Light", nullptr);
+			graph.Pass_Read(pass, res_gbuffer);
+			graph.Pass_Read(pass, res_shadows);
+			graph.Pass_Write(pass, res_light);
+
+			auto res_in = res_light;
+			for (unsigned int i = 0; i < effects; i++)
+			{
+				auto res_out = graph.Resource_Create("Effect", width, height, Texture_Format_R32G32B32A32_FLOAT);
+				pass = graph.Pass_Add("Effect", nullptr);
+				graph.Pass_Read(pass, res_in);
+				graph.Pass_Write(pass, res_out);
+				res_in = res_out;
+			}
+
+			pass = graph.Pass_Add("Present", nullptr);
+			graph.Pass_Read(pass, res_in);
+			graph.Pass_Write(pass, res_frame);
+		};
+
+		Build();
+		if (!graph.Compile())
+		{
+			LOG_ERROR("Benchmark::Run_Systems: RenderGraph, failed to compile");
+			return false;
+		}
+
+		Benchmark_Helper::Measure(metrics, "render_graph_passes", graph.GetPassCount(), "passes");
+		Benchmark_Helper::Measure(metrics, "render_graph_passes_culled", graph.GetPassCulledCount(), "passes");
+		Benchmark_Helper::Measure(metrics, "render_graph_memory_transient", graph.GetMemoryTransient() / 1048576.0, "MB");
+		Benchmark_Helper::Measure(metrics, "render_graph_memory_aliased", graph.GetMemoryAliased() / 1048576.0, "MB");
+
+		// Building and compiling happens every frame
+		const unsigned int iterations = 1000;
+		Stopwatch stopwatch;
+		for (unsigned int i = 0; i < iterations; i++)
+		{
+			Build();
+			graph.Compile();
+		}
+		Benchmark_Helper::Measure(metrics, "render_graph_build_compile", stopwatch.GetElapsedTimeMs() * 1000.0 / iterations, "us");
+
+		return true;
+	}
+
+	bool Benchmark::System_Trace(vector<Benchmark_Metric>* metrics)
+	{
+		// Cost of a zone, recorded and with tracing disabled, against an empty loop. It's measured on
+		// a thread of its own, the main thread also collects its zones for the frame statistics.
+		thread([metrics]()
+		{
+			const unsigned int iterations = 1000000;
+			auto Measure = [iterations](bool zone)
+			{
+				Stopwatch stopwatch;
+				for (unsigned int i = 0; i < iterations; i++)
+				{
+					if (zone)
+					{
+						PROFILE_ZONE("Benchmark_Zone");
+					}
+				}
+				return stopwatch.GetElapsedTimeMs() * 1000000.0 / iterations;
+			};
+
+			const bool enabled	= Profiler::Trace_IsEnabled();
+			double baseline		= Measure(false);
+			Profiler::Trace_SetEnabled(true);
+			double recorded		= Measure(true);
+			Profiler::Trace_SetEnabled(false);
+			double disabled		= Measure(true);
+			Profiler::Trace_SetEnabled(enabled);
+
+			Benchmark_Helper::Measure(metrics, "trace_zone_recorded", recorded - baseline, "ns");
+			Benchmark_Helper::Measure(metrics, "trace_zone_disabled", disabled - baseline, "ns");
+		}).join();
+
+		return true;
+	}
+
+	bool Benchmark::System_Events(vector<Benchmark_Metric>* metrics)
+	{
+		// A private event system, so that the engine's subscribers don't take part
+		auto events = make_unique<EventSystem>();
+
+		// Dispatch overhead per event, direct and deferred (once their pool has settled, deferred events don't allocate)
+		const unsigned int iterations	= 100000;
+		const unsigned int batch		= 100;
+		unsigned int calls				= 0;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			events->Subscribe(EVENT_TICK, [&calls](const Variant&) { calls++; });
+		}
+
+		Stopwatch stopwatch;
+		for (unsigned int i = 0; i < iterations; i++)
+		{
+			events->Fire(EVENT_TICK, (int)i);
+		}
+		Benchmark_Helper::Measure(metrics, "event_fire_8_subscribers", stopwatch.GetElapsedTimeMs() * 1000000.0 / iterations, "ns");
+
+		for (unsigned int i = 0; i < batch; i++) { events->Deferred_Fire(EVENT_TICK, (int)i); }
+		events->Deferred_Dispatch();
+		stopwatch.Start();
+		for (unsigned int i = 0; i < iterations; i += batch)
+		{
+			for (unsigned int j = 0; j < batch; j++)
+			{
+				events->Deferred_Fire(EVENT_TICK, (int)j);
+			}
+			events->Deferred_Dispatch();
+		}
+		Benchmark_Helper::Measure(metrics, "event_deferred_8_subscribers", stopwatch.GetElapsedTimeMs() * 1000000.0 / iterations, "ns");
+
+		return true;
+	}
+
+	bool Benchmark::System_Snapshots(vector<Benchmark_Metric>* metrics)
+	{
+		// Hand-off cost per frame, from writing a snapshot to a reader standing in for the render thread releasing it
+		for (unsigned int depth = 1; depth <= 2; depth++)
+		{
+			const unsigned int frameCount	= 10000;
+			auto pipeline					= make_unique<RenderSnapshot_Pipeline>(depth);
+			thread reader([&pipeline]()
+			{
+				Profiler_RenderStats stats;
+				while (pipeline->Read_Begin())
+				{
+					pipeline->Read_End(&stats);
+				}
+			});
+
+			Profiler_RenderStats stats;
+			Stopwatch stopwatch;
+			for (unsigned int frame = 1; frame <= frameCount; frame++)
+			{
+				pipeline->Write_Begin()->frame = frame;
+				pipeline->Write_End();
+				pipeline->GetStats(&stats);
+			}
+			pipeline->Flush();
+			Benchmark_Helper::Measure(metrics, depth == 1 ? "snapshot_handoff_depth_1" : "snapshot_handoff_depth_2", stopwatch.GetElapsedTimeMs() * 1000000.0 / frameCount, "ns");
+			pipeline->Stop();
+			reader.join();
+		}
+
+		return true;
+	}
+
+	bool Benchmark::System_Allocations(vector<Benchmark_Metric>* metrics)
+	{
+		// Whole engine frames of the current world, once it has settled
+		auto engine = m_context->GetSubsystem<Engine>();
+		if (!engine)
+		{
+			LOG_ERROR("Benchmark::Run_Systems: Allocations, there is no engine to tick");
+			return false;
+		}
+
+		engine->Tick(m_frameCount);
+
+		uint64_t heapAllocations		= Allocation_Counters::GetHeapAllocations();
+		uint64_t heapBytes				= Allocation_Counters::GetHeapBytes();
+		uint64_t poolChunkAllocations	= Allocation_Counters::GetPoolChunkAllocations();
+		unsigned int arenaOverflows		= 0;
+		for (unsigned int i = 0; i < m_frameCount; i++)
+		{
+			engine->Tick();
+			arenaOverflows += Frame_Arena::Get().GetOverflowsLastFrame();
+		}
+		heapAllocations			= Allocation_Counters::GetHeapAllocations() - heapAllocations;
+		heapBytes				= Allocation_Counters::GetHeapBytes() - heapBytes;
+		poolChunkAllocations	= Allocation_Counters::GetPoolChunkAllocations() - poolChunkAllocations;
+
+		if (Allocation_Counters::IsHeapTracked())
+		{
+			Benchmark_Helper::Measure(metrics, "heap_allocations_per_frame", (double)heapAllocations / m_frameCount, "allocations");
+			Benchmark_Helper::Measure(metrics, "heap_bytes_per_frame", (double)heapBytes / m_frameCount, "bytes");
+		}
+		else
+		{
+			LOG_INFO("Benchmark::Run_Systems: Allocations, heap allocations aren't measured, the engine isn't built with ALLOCATION_TRACKING");
+		}
+		Benchmark_Helper::Measure(metrics, "pool_chunk_allocations_per_frame", (double)poolChunkAllocations / m_frameCount, "allocations");
+		Benchmark_Helper::Measure(metrics, "frame_arena_overflows_per_frame", (double)arenaOverflows / m_frameCount, "overflows");
+
+		return true;
+	}
+
+	bool Benchmark::System_Matrix(vector<Benchmark_Metric>* metrics)
+	{
+		// The SIMD paths against the scalar ones, which stay compiled for this
+		const unsigned int count = 10000;
+
+		mt19937 random(1234);
+		vector<Matrix> lhs(count), rhs(count), transforms(count), out(count);
+		vector<Vector3> points(count), pointsOut(count);
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			lhs[i]			= Benchmark_Helper::RandomMatrix(random);
+			rhs[i]			= Benchmark_Helper::RandomMatrix(random);
+			transforms[i]	= Benchmark_Helper::RandomTransform(random);
+			points[i]		= Vector3(position(random), position(random), position(random));
+		}
+
+		// Throughput, every result is stored so that none of the work can be skipped
+		auto Time = [&metrics, count](const char* metric, const auto& operation)
+		{
+			double time = Benchmark_Helper::Time([&operation, count]()
+			{
+				for (unsigned int i = 0; i < count; i++)
+				{
+					operation(i);
+				}
+			});
+			Benchmark_Helper::Measure(metrics, metric, time * 1000000.0 / count, "ns");
+		};
+		Time("matrix_multiply_simd",			[&](unsigned int i) { out[i] = lhs[i] * rhs[i]; });
+		Time("matrix_multiply_scalar",			[&](unsigned int i) { out[i] = Matrix::Multiply_Scalar(lhs[i], rhs[i]); });
+		Time("matrix_invert_simd",				[&](unsigned int i) { out[i] = Matrix::Invert(lhs[i]); });
+		Time("matrix_invert_scalar",			[&](unsigned int i) { out[i] = Matrix::Invert_Scalar(lhs[i]); });
+		Time("matrix_invert_affine_simd",		[&](unsigned int i) { out[i] = Matrix::InvertAffine(transforms[i]); });
+
+		// Batched transforms, a single call over all the points, so the time is per point as above
+		auto TimeBatch = [&metrics, count](const char* metric, const auto& operation)
+		{
+			double time = Benchmark_Helper::Time(operation);
+			Benchmark_Helper::Measure(metrics, metric, time * 1000000.0 / count, "ns");
+		};
+		TimeBatch("matrix_transform_points_scalar",	[&]() { transforms[0].TransformPoints_Scalar(points.data(), pointsOut.data(), count); });
+		TimeBatch("matrix_transform_points_simd",	[&]() { transforms[0].TransformPoints(points.data(), pointsOut.data(), count); });
+
+		return true;
+	}
+
+	bool Benchmark::System_Bounds(vector<Benchmark_Metric>* metrics)
+	{
+		// The bulk kernels against their scalar versions
+		const unsigned int count = 100001;
+
+		mt19937 random(1234);
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		uniform_real_distribution<float> size(0.1f, 10.0f);
+		vector<RHI_Vertex_PosUvNorTan> vertices(count);
+		vector<Vector3> points(count);
+		vector<BoundingBox> boxes(count), boxesOut(count);
+		vector<Matrix> transforms(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			points[i]			= Vector3(position(random), position(random), position(random));
+			vertices[i].pos[0]	= points[i].x;
+			vertices[i].pos[1]	= points[i].y;
+			vertices[i].pos[2]	= points[i].z;
+			Vector3 extent		= Vector3(size(random), size(random), size(random));
+			boxes[i]			= BoundingBox(points[i] - extent, points[i] + extent);
+			transforms[i]		= Benchmark_Helper::RandomTransform(random);
+		}
+
+		// A diagonal ray through the whole volume
+		Ray ray(Vector3(-200.0f, -150.0f, -100.0f), Vector3(200.0f, 150.0f, 100.0f));
+		BoundingBox_SoA boxesSoA;
+		for (const auto& box : boxes)
+		{
+			boxesSoA.Add(box);
+		}
+		vector<float> distances(boxesSoA.GetCount());
+
+		// Throughput, per point or box
+		auto Time = [&metrics, count](const char* metric, const auto& operation)
+		{
+			Benchmark_Helper::Measure(metrics, metric, Benchmark_Helper::Time(operation) * 1000000.0 / count, "ns");
+		};
+		BoundingBox box;
+		Time("bounds_from_vertices_simd",	[&]() { box = BoundingBox::FromPoints(&vertices[0].pos[0], count, sizeof(RHI_Vertex_PosUvNorTan)); });
+		Time("bounds_from_vertices_scalar",	[&]() { box = BoundingBox::FromPoints_Scalar(&vertices[0].pos[0], count, sizeof(RHI_Vertex_PosUvNorTan)); });
+		Time("bounds_transform_simd",		[&]() { BoundingBox::Transform(boxes.data(), transforms.data(), boxesOut.data(), count); });
+		Time("bounds_transform_scalar",		[&]() { BoundingBox::Transform_Scalar(boxes.data(), transforms.data(), boxesOut.data(), count); });
+		Time("bounds_ray_hit_simd",			[&]() { ray.HitDistances(boxesSoA, distances.data()); });
+		Time("bounds_ray_hit_scalar",		[&]() { ray.HitDistances_Scalar(boxesSoA, distances.data()); });
+
+		return true;
+	}
+
+	bool Benchmark::System_WorldRoundTrip(vector<Benchmark_Metric>* metrics)
+	{
+		// A synthetic world saved and loaded back
+		auto world = m_context->GetSubsystem<World>();
+
+		Benchmark_Scene scene;
+		scene.name				= "RoundTrip";
+		scene.actorCount		= 10000;
+		scene.hierarchyDepth	= 4;
+		world->Unload();
+		CreateWorld(scene);
+		auto actorCount = world->Actors_GetAll().size();
+
+		// Save
+		FileSystem::CreateDirectory_(m_scratchDirectory);
+		string filePath	= m_scratchDirectory + scene.name + EXTENSION_WORLD;
+		bool saveFailed	= false;
+		double saveTime	= Benchmark_Helper::Time([&]() { saveFailed = !world->SaveToFile(filePath) || saveFailed; });
+		bool success	= !saveFailed;
+		if (saveFailed)
+		{
+			LOGF_ERROR("Benchmark::Run_Systems: WorldRoundTrip, failed to save \"%s\"", filePath.c_str());
+		}
+		auto fileSize = (uint64_t)ifstream(filePath, ios::binary | ios::ate).tellg();
+
+		// Load, the fastest of a few
+		double loadTime = DBL_MAX;
+		for (unsigned int i = 0; i < 3 && success; i++)
+		{
+			double time = 0.0;
+			success		= LoadWorld(filePath, &time);
+			loadTime	= min(loadTime, time);
+		}
+
+		if (success)
+		{
+			Benchmark_Helper::Measure(metrics, "world_file_size",			(double)fileSize, "bytes");
+			Benchmark_Helper::Measure(metrics, "world_file_size_per_actor",	(double)fileSize / actorCount, "bytes");
+			Benchmark_Helper::Measure(metrics, "world_save",				saveTime, "ms");
+			Benchmark_Helper::Measure(metrics, "world_load",				loadTime, "ms");
+		}
+
+		// Leave a default world behind
+		world->Unload();
+		world->Initialize();
+
+		return success;
+	}
+
+	void Benchmark::CreateWorld(const Benchmark_Scene& scene)
+	{
+		auto world					= m_context->GetSubsystem<World>();
+		unsigned int indexCount		= 0;
+		unsigned int vertexCount	= 0;
+		auto model					= Benchmark_Helper::GetModel(m_context, &indexCount, &vertexCount);
+		string scriptDirectory		= m_context->GetSubsystem<ResourceCache>()->GetStandardResourceDirectory(Resource_Script);
+
+		// Hierarchies are laid out on a grid, children stack up along the y axis
+		unsigned int hierarchies	= (scene.actorCount + scene.hierarchyDepth - 1) / scene.hierarchyDepth;
+		unsigned int side			= (unsigned int)ceil(sqrt((double)hierarchies));
+
+		Transform* parent = nullptr;
+		for (unsigned int i = 0; i < scene.actorCount; i++)
+		{
+			auto& actor				= world->Actor_Create();
+			Transform* transform	= actor->GetTransform_PtrRaw();
+			actor->SetName("Actor_" + to_string(i));
+
+			unsigned int depth = i % scene.hierarchyDepth;
+			if (depth == 0)
+			{
+				unsigned int hierarchy = i / scene.hierarchyDepth;
+				transform->SetPositionLocal(Vector3((hierarchy % side) * Benchmark_Helper::SPACING, 0.0f, (hierarchy / side) * Benchmark_Helper::SPACING));
+			}
+			else
+			{
+				transform->SetParent(parent);
+				transform->SetPositionLocal(Vector3(0.0f, Benchmark_Helper::SPACING, 0.0f));
+			}
+			parent = transform;
+
+			if (Benchmark_Helper::Pick(i, scene.renderableRatio))
+			{
+				auto renderable = actor->AddComponent<Renderable>();
+				renderable->Geometry_Set("Default_Geometry", 0, indexCount, 0, vertexCount, model->Geometry_AABB(), model);
+				renderable->Material_UseDefault();
+			}
+
+			if (Benchmark_Helper::Pick(i, scene.lightRatio))
+			{
+				auto light = actor->AddComponent<Light>();
+				light->SetLightType(LightType_Point);
+				light->SetRange(Benchmark_Helper::SPACING * 2.0f);
+			}
+
+			if (Benchmark_Helper::Pick(i, scene.rigidBodyRatio))
+			{
+				actor->AddComponent<Collider>();
+				actor->AddComponent<RigidBody>()->SetMass(1.0f);
+			}
+
+			if (Benchmark_Helper::Pick(i, scene.scriptRatio))
+			{
+				actor->AddComponent<Script>()->SetScript(scriptDirectory + "RotateAroundSelf.as");
+			}
+		}
+
+		// A camera looking down the grid
+		auto& camera = world->Actor_Create();
+		camera->SetName("Camera");
+		camera->AddComponent<Camera>();
+		camera->GetTransform_PtrRaw()->SetPositionLocal(Vector3(side * Benchmark_Helper::SPACING * 0.5f, Benchmark_Helper::SPACING * 2.0f, -Benchmark_Helper::SPACING * 4.0f));
+	}
+}
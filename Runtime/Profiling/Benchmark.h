@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <string>
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	class Context;
+
+	// Describes a synthetic world
+	struct Benchmark_Scene
+	{
+		std::string name;
+		unsigned int actorCount		= 1000;
+		// 1 is flat, otherwise actors are chained into hierarchies this deep
+		unsigned int hierarchyDepth	= 1;
+		// Fraction of the actors which get each component
+		float renderableRatio		= 0.8f;
+		float lightRatio			= 0.01f;
+		float rigidBodyRatio		= 0.1f;
+		float scriptRatio			= 0.05f;
+	};
+
+	// Timings in milliseconds (tick, render and pick are averages, the rest are totals)
+	struct Benchmark_Result
+	{
+		Benchmark_Scene scene;
+		double create	= 0.0;
+		double tick		= 0.0;
+		double acquire	= 0.0;
+		double render	= 0.0;
+		double pick		= 0.0;
+		double save		= 0.0;
+		double load		= 0.0;
+		double clone	= 0.0;
+		// The renderer's frame graph (sizes in bytes)
+		unsigned int graphPasses		= 0;
+		unsigned int graphPassesCulled	= 0;
+		uint64_t graphMemoryTransient	= 0;
+		uint64_t graphMemoryAliased		= 0;
+	};
+
+	// A measurement taken by one of the system benchmarks
+	struct Benchmark_Metric
+	{
+		std::string name;
+		double value = 0.0;
+		std::string unit;
+	};
+
+	// Builds synthetic worlds through the public World/Actor API and times the operations that
+	// scale with the size of a world. It replaces the current world (and leaves a default one behind),
+	// so it's meant to be run from a headless engine (see Engine_Headless).
+	class ENGINE_CLASS Benchmark
+	{
+	public:
+		Benchmark(Context* context);
+		~Benchmark() = default;
+
+		// Flat worlds from 1k to 1M actors and deep ones up to 10k actors (re-parenting is O(n) per actor)
+		static std::vector<Benchmark_Scene> GetDefaultScenes();
+
+		bool Run(const Benchmark_Scene& scene, Benchmark_Result* result);
+		// Runs all the scenes and writes the results as JSON
+		bool Run(const std::vector<Benchmark_Scene>& scenes, const std::string& filePath);
+
+		// Measures engine systems in isolation, their correctness is covered by the Tests project. The world
+		// round trip replaces the current world (and leaves a default one behind), the rest don't need one.
+		// Returns false if a system couldn't be measured, e.g. the world failed to save or load.
+		bool Run_Systems(std::vector<Benchmark_Metric>* metrics);
+		// Runs the system benchmarks and writes the metrics as JSON
+		bool Run_Systems(const std::string& filePath);
+
+		// Where the worlds get saved to and loaded from
+		void SetScratchDirectory(const std::string& directory)	{ m_scratchDirectory = directory; }
+		// How many frames tick/render/pick are averaged over
+		void SetFrameCount(unsigned int frameCount)				{ m_frameCount = frameCount; }
+		// How long loading a world can take before the benchmark gives up on it
+		void SetTimeout(float seconds)							{ m_timeoutSec = seconds; }
+
+	private:
+		void CreateWorld(const Benchmark_Scene& scene);
+		// Loads on a worker thread while this one ticks the world, time is in ms
+		bool LoadWorld(const std::string& filePath, double* time);
+
+		//= SYSTEMS =========================================================
+		bool System_RenderGraph(std::vector<Benchmark_Metric>* metrics);
+		bool System_Trace(std::vector<Benchmark_Metric>* metrics);
+		bool System_Events(std::vector<Benchmark_Metric>* metrics);
+		bool System_Snapshots(std::vector<Benchmark_Metric>* metrics);
+		bool System_Allocations(std::vector<Benchmark_Metric>* metrics);
+		bool System_Matrix(std::vector<Benchmark_Metric>* metrics);
+		bool System_Bounds(std::vector<Benchmark_Metric>* metrics);
+		bool System_WorldRoundTrip(std::vector<Benchmark_Metric>* metrics);
+		//===================================================================
+
+		Context* m_context;
+		std::string m_scratchDirectory;
+		unsigned int m_frameCount;
+		float m_timeoutSec;
+	};
+}
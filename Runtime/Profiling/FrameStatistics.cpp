@@ -0,0 +1,236 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "FrameStatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include "../Logging/Log.h"
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace FrameStatistics_Helper
+	{
+		static const unsigned int HITCHES_MAX			= 32;
+		// Hitches are only detected once the window holds enough frames for a meaningful median
+		static const unsigned int HITCH_MIN_SAMPLES		= 30;
+
+		// Nearest-rank percentile of a sorted window
+		inline float Percentile(const vector<float>& sorted, float percentile)
+		{
+			if (sorted.empty())
+				return 0.0f;
+
+			auto rank = (size_t)ceil(percentile * sorted.size());
+			rank = rank == 0 ? 0 : rank - 1;
+			return sorted[min(rank, sorted.size() - 1)];
+		}
+
+		inline string Escape(const string& text)
+		{
+			string escaped;
+			for (const auto character : text)
+			{
+				if (character == '"' || character == '\\') escaped += '\\';
+				escaped += character;
+			}
+			return escaped;
+		}
+	}
+
+	FrameStatistics::FrameStatistics(unsigned int windowSize)
+	{
+		m_windowSize = max(windowSize, 1u);
+	}
+
+	void FrameStatistics::AddFrame(float frameMs, const vector<pair<const char*, float>>& zones)
+	{
+		// Detect against the window as it was before this frame
+		const float median = m_frame.summary.p50;
+		const bool isHitch = m_frame.summary.samples >= FrameStatistics_Helper::HITCH_MIN_SAMPLES && frameMs > m_hitchFactor * median;
+
+		// Sum zones which ran more than once
+		m_zonesFrame.clear();
+		for (const auto& zone : zones)
+		{
+			m_zonesFrame[zone.first] += zone.second;
+		}
+
+		m_frame.Add(frameMs, m_windowSize);
+		for (const auto& zone : m_zonesFrame)
+		{
+			m_zones[zone.first].Add(zone.second, m_windowSize);
+		}
+		m_frameCount++;
+
+		if (!isHitch)
+			return;
+
+		FrameStatistics_Hitch hitch;
+		hitch.frame		= m_frameCount;
+		hitch.frameMs	= frameMs;
+		hitch.medianMs	= median;
+		for (const auto& zone : m_zonesFrame)
+		{
+			hitch.zones.emplace_back(zone.first, zone.second);
+		}
+		sort(hitch.zones.begin(), hitch.zones.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+		m_hitches.emplace_back(move(hitch));
+		if (m_hitches.size() > FrameStatistics_Helper::HITCHES_MAX)
+		{
+			m_hitches.pop_front();
+		}
+		m_hitchCount++;
+	}
+
+	void FrameStatistics::Clear()
+	{
+		m_frame = Series();
+		m_zones.clear();
+		m_hitches.clear();
+		m_frameCount = 0;
+		m_hitchCount = 0;
+	}
+
+	map<string, FrameStatistics_Summary> FrameStatistics::GetZoneSummaries() const
+	{
+		map<string, FrameStatistics_Summary> summaries;
+		for (const auto& zone : m_zones)
+		{
+			summaries[zone.first] = zone.second.summary;
+		}
+		return summaries;
+	}
+
+	bool FrameStatistics::Export_CSV(const string& filePath) const
+	{
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.good())
+		{
+			LOGF_ERROR("FrameStatistics::Export_CSV: Failed to open \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		auto Write = [&out](const string& name, const FrameStatistics_Summary& summary)
+		{
+			out << "\"" << name << "\"," << summary.samples << "," << summary.min << "," << summary.avg << "," << summary.max << "," << summary.p50 << "," << summary.p95 << "," << summary.p99 << "\n";
+		};
+
+		out << fixed << setprecision(4);
+		out << "zone,samples,min_ms,avg_ms,max_ms,p50_ms,p95_ms,p99_ms\n";
+		Write("Frame", m_frame.summary);
+		for (const auto& zone : GetZoneSummaries())
+		{
+			Write(zone.first, zone.second);
+		}
+
+		return true;
+	}
+
+	bool FrameStatistics::Export_JSON(const string& filePath) const
+	{
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.good())
+		{
+			LOGF_ERROR("FrameStatistics::Export_JSON: Failed to open \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		auto Write = [&out](const FrameStatistics_Summary& summary)
+		{
+			out << "{\"samples\":" << summary.samples << ",\"min\":" << summary.min << ",\"avg\":" << summary.avg << ",\"max\":" << summary.max
+				<< ",\"p50\":" << summary.p50 << ",\"p95\":" << summary.p95 << ",\"p99\":" << summary.p99 << "}";
+		};
+
+		out << fixed << setprecision(4);
+		out << "{\n\"frames\":" << m_frameCount << ",\n\"window\":" << m_windowSize << ",\n\"frame\":";
+		Write(m_frame.summary);
+
+		out << ",\n\"zones\":{";
+		bool first = true;
+		for (const auto& zone : GetZoneSummaries())
+		{
+			out << (first ? "\n" : ",\n") << "\"" << FrameStatistics_Helper::Escape(zone.first) << "\":";
+			Write(zone.second);
+			first = false;
+		}
+
+		out << "\n},\n\"hitchFactor\":" << m_hitchFactor << ",\n\"hitchCount\":" << m_hitchCount << ",\n\"hitches\":[";
+		first = true;
+		for (const auto& hitch : m_hitches)
+		{
+			out << (first ? "\n" : ",\n") << "{\"frame\":" << hitch.frame << ",\"frameMs\":" << hitch.frameMs << ",\"medianMs\":" << hitch.medianMs << ",\"zones\":{";
+			for (unsigned int i = 0; i < (unsigned int)hitch.zones.size(); i++)
+			{
+				out << (i == 0 ? "" : ",") << "\"" << FrameStatistics_Helper::Escape(hitch.zones[i].first) << "\":" << hitch.zones[i].second;
+			}
+			out << "}}";
+			first = false;
+		}
+		out << "\n]\n}\n";
+
+		return true;
+	}
+
+	void FrameStatistics::Series::Add(float value, unsigned int windowSize)
+	{
+		if (ring.size() < windowSize)
+		{
+			ring.emplace_back(value);
+		}
+		else
+		{
+			// Evict the oldest sample
+			const float oldest = ring[head];
+			sorted.erase(lower_bound(sorted.begin(), sorted.end(), oldest));
+			sum -= oldest;
+			ring[head] = value;
+			head = (head + 1) % windowSize;
+		}
+
+		sorted.insert(upper_bound(sorted.begin(), sorted.end(), value), value);
+		sum += value;
+
+		Summarize();
+	}
+
+	void FrameStatistics::Series::Summarize()
+	{
+		summary.samples = (unsigned int)sorted.size();
+		if (sorted.empty())
+			return;
+
+		summary.min = sorted.front();
+		summary.max = sorted.back();
+		summary.avg = (float)(sum / sorted.size());
+		summary.p50 = FrameStatistics_Helper::Percentile(sorted, 0.50f);
+		summary.p95 = FrameStatistics_Helper::Percentile(sorted, 0.95f);
+		summary.p99 = FrameStatistics_Helper::Percentile(sorted, 0.99f);
+	}
+}
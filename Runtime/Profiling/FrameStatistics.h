@@ -0,0 +1,110 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <map>
+#include <deque>
+#include <vector>
+#include <string>
+#include "../Core/EngineDefs.h"
+//================================
+
+namespace Directus
+{
+	struct FrameStatistics_Summary
+	{
+		unsigned int samples	= 0;
+		float min				= 0.0f;
+		float avg				= 0.0f;
+		float max				= 0.0f;
+		float p50				= 0.0f;
+		float p95				= 0.0f;
+		float p99				= 0.0f;
+	};
+
+	struct FrameStatistics_Hitch
+	{
+		uint64_t frame		= 0;
+		float frameMs		= 0.0f;
+		float medianMs		= 0.0f;
+		// Main thread zones of the offending frame, slowest first
+		std::vector<std::pair<std::string, float>> zones;
+	};
+
+	// Keeps the CPU timings of the last N frames (per zone and for the whole frame) in ring buffers.
+	// Every window is also kept sorted, so that min/max and percentiles are available in constant time
+	// and each new sample only costs a binary search and a short move.
+	class ENGINE_CLASS FrameStatistics
+	{
+	public:
+		FrameStatistics(unsigned int windowSize = 512);
+		~FrameStatistics() = default;
+
+		// Adds a frame, zones are (name, duration in ms) pairs, a zone which ran more than once is summed
+		void AddFrame(float frameMs, const std::vector<std::pair<const char*, float>>& zones);
+		void Clear();
+
+		//= SUMMARIES ===========================================================
+		const FrameStatistics_Summary& GetFrameSummary() const	{ return m_frame.summary; }
+		std::map<std::string, FrameStatistics_Summary> GetZoneSummaries() const;
+		uint64_t GetFrameCount() const							{ return m_frameCount; }
+		//=======================================================================
+
+		//= HITCHES ==================================================================================
+		// A frame is a hitch when it takes longer than factor x the median frame time of the window
+		void SetHitchFactor(float factor)							{ m_hitchFactor = factor; }
+		float GetHitchFactor() const								{ return m_hitchFactor; }
+		const std::deque<FrameStatistics_Hitch>& GetHitches() const	{ return m_hitches; }
+		uint64_t GetHitchCount() const								{ return m_hitchCount; }
+		//============================================================================================
+
+		//= EXPORT ============================================
+		bool Export_CSV(const std::string& filePath) const;
+		bool Export_JSON(const std::string& filePath) const;
+		//=====================================================
+
+	private:
+		struct Series
+		{
+			void Add(float value, unsigned int windowSize);
+			void Summarize();
+
+			std::vector<float> ring;
+			std::vector<float> sorted;
+			unsigned int head		= 0;
+			double sum				= 0.0;
+			FrameStatistics_Summary summary;
+		};
+
+		unsigned int m_windowSize;
+		Series m_frame;
+		std::map<const char*, Series> m_zones;
+		std::map<const char*, float> m_zonesFrame;
+		uint64_t m_frameCount	= 0;
+
+		// Hitches
+		float m_hitchFactor		= 2.0f;
+		uint64_t m_hitchCount	= 0;
+		std::deque<FrameStatistics_Hitch> m_hitches;
+	};
+}
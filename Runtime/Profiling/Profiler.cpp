@@ -23,14 +23,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Profiler.h"
 #include "../Core/Timer.h"
 #include "../Core/Settings.h"
+#include "../Core/Engine.h"
 #include "../Core/EventSystem.h"
+#include "../Core/Allocators.h"
 #include "../World/World.h"
 #include "../Rendering/Renderer.h"
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <vector>
+#include <mutex>
+#include <cmath>
 #include "../RHI/RHI_Device.h"
 #include "../Core/Variant.h"
 #include "../Resource/ResourceCache.h"
+#include "../Logging/Log.h"
 //====================================
 
 //= NAMESPACES =============
@@ -40,6 +47,77 @@ using namespace std::chrono;
 
 namespace Directus
 {
+	namespace Profiler_Trace
+	{
+		struct Event
+		{
+			const char* name;
+			int64_t start;
+			int64_t end;
+			unsigned int depth;
+			unsigned int frame;
+		};
+
+		static const uint64_t	CAPACITY	= 65536;	// events per thread
+		static const unsigned int MAX_DEPTH	= 64;
+
+		struct ThreadBuffer
+		{
+			std::vector<Event> events = std::vector<Event>(CAPACITY);
+			std::atomic<uint64_t> head	= 0;	// written by the owning thread only
+			unsigned int id				= 0;
+			std::string name;
+
+			// Open zones
+			const char* stackName[MAX_DEPTH];
+			int64_t stackStart[MAX_DEPTH];
+			unsigned int depth = 0;
+
+			// Completed zones (name, duration in ns) of the current frame, only collected on the main thread
+			bool collect = false;
+			std::vector<std::pair<const char*, int64_t>> collected;
+		};
+
+		// Buffers outlive their threads, so a trace can still show work of threads that are gone
+		static mutex g_buffersMutex;
+		static vector<shared_ptr<ThreadBuffer>> g_buffers;
+		static atomic<unsigned int> g_frame = 0;
+		static const char* FRAME			= "Frame";
+		thread_local ThreadBuffer* t_buffer	= nullptr;
+
+		inline ThreadBuffer* GetBuffer()
+		{
+			if (!t_buffer)
+			{
+				auto buffer = make_shared<ThreadBuffer>();
+				lock_guard<mutex> lock(g_buffersMutex);
+				buffer->id		= (unsigned int)g_buffers.size();
+				buffer->name	= "Thread " + to_string(buffer->id);
+				g_buffers.emplace_back(buffer);
+				t_buffer = buffer.get();
+			}
+			return t_buffer;
+		}
+
+		inline int64_t Now()
+		{
+			return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+
+		inline string Escape(const string& text)
+		{
+			string escaped;
+			for (const auto character : text)
+			{
+				if (character == '"' || character == '\\') escaped += '\\';
+				escaped += character;
+			}
+			return escaped;
+		}
+	}
+
+	atomic<bool> Profiler::m_traceEnabled = true;
+
 	Profiler::Profiler()
 	{
 		m_metrics					= NOT_ASSIGNED;
@@ -53,6 +131,25 @@ namespace Directus
 		m_fps						= 0.0f;
 		m_timePassed				= 0.0f;
 		m_frameCount				= 0;
+		m_pacingErrorAvgMs			= 0.0f;
+		m_pacingErrorMaxMs			= 0.0f;
+		m_pacingErrorSum			= 0.0f;
+		m_pacingErrorMax			= 0.0f;
+		m_pacingSamples				= 0;
+		m_rendererOcclusionOccluders	= 0;
+		m_rendererOcclusionTriangles	= 0;
+		m_rendererOcclusionTested		= 0;
+		m_rendererOcclusionCulled		= 0;
+		m_memoryHeapAllocations			= 0;
+		m_memoryHeapBytes				= 0;
+		m_memoryPoolAllocations			= 0;
+		m_memoryPoolChunkAllocations	= 0;
+		m_memoryFrameArenaBytes			= 0;
+		m_heapAllocationsLast			= 0;
+		m_heapBytesLast					= 0;
+		m_poolAllocationsLast			= 0;
+		m_poolChunkAllocationsLast		= 0;
+		m_mainThreadID					= this_thread::get_id();
 	}
 
 	void Profiler::Initialize(Context* context)
@@ -63,6 +160,10 @@ namespace Directus
 		m_rhiDevice					= context->GetSubsystem<Renderer>()->GetRHIDevice();
 		m_profilingFrequencySec		= 0.35f;
 		m_profilingLastUpdateTime	= m_profilingFrequencySec;
+		Trace_SetThreadName("Main");
+		m_gpuProfiling				= m_gpuProfiling && m_rhiDevice->IsInitialized(); // headless
+		m_gpuProfiling				= m_gpuProfiling && !Engine::EngineMode_IsSet(Engine_RenderThread); // the immediate context belongs to the render thread
+		Profiler_Trace::GetBuffer()->collect = true;
 
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(EVENT_FRAME_START, EVENT_HANDLER(OnFrameStart));
@@ -71,7 +172,9 @@ namespace Directus
 
 	void Profiler::TimeBlockStart_CPU(const char* funcName)
 	{
-		if (!m_cpuProfiling || !m_shouldUpdate)
+		Trace_Begin(funcName);
+
+		if (!m_cpuProfiling || !m_shouldUpdate || this_thread::get_id() != m_mainThreadID)
 			return;
 
 		m_timeBlocks_cpu[funcName].start = high_resolution_clock::now();
@@ -79,7 +182,9 @@ namespace Directus
 
 	void Profiler::TimeBlockEnd_CPU(const char* funcName)
 	{
-		if (!m_cpuProfiling || !m_shouldUpdate)
+		Trace_End();
+
+		if (!m_cpuProfiling || !m_shouldUpdate || this_thread::get_id() != m_mainThreadID)
 			return;
 
 		auto timeBlock = &m_timeBlocks_cpu[funcName];
@@ -132,11 +237,143 @@ namespace Directus
 		TimeBlockEnd_GPU(funcName);
 	}
 
+	//= TRACE ==================================================================================================
+	void Profiler::Trace_Begin(const char* name)
+	{
+		auto buffer = Profiler_Trace::GetBuffer();
+
+		// Zones are pushed even when disabled (with no timestamp), so that toggling never unbalances the stack
+		if (buffer->depth < Profiler_Trace::MAX_DEPTH)
+		{
+			buffer->stackName[buffer->depth]	= name;
+			buffer->stackStart[buffer->depth]	= m_traceEnabled.load(memory_order_relaxed) ? Profiler_Trace::Now() : 0;
+		}
+		buffer->depth++;
+	}
+
+	void Profiler::Trace_End()
+	{
+		auto buffer = Profiler_Trace::GetBuffer();
+		if (buffer->depth == 0)
+			return;
+
+		buffer->depth--;
+		if (buffer->depth >= Profiler_Trace::MAX_DEPTH || buffer->stackStart[buffer->depth] == 0 || !m_traceEnabled.load(memory_order_relaxed))
+			return;
+
+		uint64_t head	= buffer->head.load(memory_order_relaxed);
+		auto& event		= buffer->events[head % Profiler_Trace::CAPACITY];
+		event.name		= buffer->stackName[buffer->depth];
+		event.start		= buffer->stackStart[buffer->depth];
+		event.end		= Profiler_Trace::Now();
+		event.depth		= buffer->depth;
+		event.frame		= Profiler_Trace::g_frame.load(memory_order_relaxed);
+
+		// Publish
+		buffer->head.store(head + 1, memory_order_release);
+
+		if (buffer->collect)
+		{
+			buffer->collected.emplace_back(event.name, event.end - event.start);
+		}
+	}
+
+	unsigned int Profiler::Trace_GetDepth()
+	{
+		return Profiler_Trace::GetBuffer()->depth;
+	}
+
+	void Profiler::Trace_SetThreadName(const string& name)
+	{
+		auto buffer = Profiler_Trace::GetBuffer();
+		lock_guard<mutex> lock(Profiler_Trace::g_buffersMutex);
+		buffer->name = name;
+	}
+
+	bool Profiler::Trace_Export(const string& filePath)
+	{
+		// Snapshot every thread's ring buffer
+		vector<pair<shared_ptr<Profiler_Trace::ThreadBuffer>, vector<Profiler_Trace::Event>>> threads;
+		{
+			lock_guard<mutex> lock(Profiler_Trace::g_buffersMutex);
+			for (const auto& buffer : Profiler_Trace::g_buffers)
+			{
+				threads.emplace_back(buffer, vector<Profiler_Trace::Event>());
+			}
+		}
+
+		int64_t origin = INT64_MAX;
+		for (auto& thread : threads)
+		{
+			auto& buffer = *thread.first;
+			uint64_t head	= buffer.head.load(memory_order_acquire);
+			uint64_t first	= head > Profiler_Trace::CAPACITY ? head - Profiler_Trace::CAPACITY : 0;
+			for (uint64_t i = first; i < head; i++)
+			{
+				thread.second.emplace_back(buffer.events[i % Profiler_Trace::CAPACITY]);
+			}
+
+			// The owning thread kept writing while we copied, drop whatever it may have overwritten
+			uint64_t headNow		= buffer.head.load(memory_order_acquire);
+			uint64_t firstValid		= headNow > Profiler_Trace::CAPACITY ? headNow - Profiler_Trace::CAPACITY : 0;
+			uint64_t overwritten	= firstValid > first ? firstValid - first : 0;
+			thread.second.erase(thread.second.begin(), thread.second.begin() + (size_t)min<uint64_t>(overwritten, thread.second.size()));
+
+			for (const auto& event : thread.second)
+			{
+				origin = min(origin, event.start);
+			}
+		}
+
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.good())
+		{
+			LOGF_ERROR("Profiler::Trace_Export: Failed to open \"%s\"", filePath.c_str());
+			return false;
+		}
+
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		out << fixed << setprecision(3);
+		bool first = true;
+		for (const auto& thread : threads)
+		{
+			const auto& buffer = *thread.first;
+			{
+				lock_guard<mutex> lock(Profiler_Trace::g_buffersMutex);
+				out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer.id << ",\"args\":{\"name\":\"" << Profiler_Trace::Escape(buffer.name) << "\"}}";
+				first = false;
+			}
+
+			for (const auto& event : thread.second)
+			{
+				out << ",\n{\"name\":\"" << Profiler_Trace::Escape(event.name ? event.name : "") << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.id
+					<< ",\"ts\":" << (event.start - origin) / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0
+					<< ",\"args\":{\"frame\":" << event.frame << ",\"depth\":" << event.depth << "}}";
+			}
+		}
+		out << "\n]}\n";
+
+		LOGF_INFO("Profiler::Trace_Export: Exported trace to \"%s\"", filePath.c_str());
+		return true;
+	}
+	//==========================================================================================================
+
 	void Profiler::OnFrameStart()
 	{
-		// Get delta time
-		m_frameTimeMs	= m_timer->GetDeltaTimeMs();
-		m_frameTimeSec	= m_timer->GetDeltaTimeSec();
+		// Frame marker, spans until EVENT_FRAME_END
+		Profiler_Trace::g_frame++;
+		Profiler_Trace::GetBuffer()->collected.clear();
+		Trace_Begin(Profiler_Trace::FRAME);
+
+		// Get delta time (as measured, not smoothed)
+		m_frameTimeMs	= m_timer->GetDeltaTimeRawMs();
+		m_frameTimeSec	= m_frameTimeMs / 1000.0f;
+
+		// Accumulate pacing error
+		const float pacingError	= std::fabs(m_timer->GetPacingErrorMs());
+		m_pacingErrorSum		+= pacingError;
+		m_pacingErrorMax		= pacingError > m_pacingErrorMax ? pacingError : m_pacingErrorMax;
+		m_pacingSamples++;
 
 		// Compute FPS
 		ComputeFPS(m_frameTimeSec);
@@ -149,6 +386,12 @@ namespace Directus
 		m_profilingLastUpdateTime += m_frameTimeSec;
 		if (m_profilingLastUpdateTime >= m_profilingFrequencySec)
 		{
+			m_pacingErrorAvgMs	= m_pacingErrorSum / m_pacingSamples;
+			m_pacingErrorMaxMs	= m_pacingErrorMax;
+			m_pacingErrorSum	= 0.0f;
+			m_pacingErrorMax	= 0.0f;
+			m_pacingSamples		= 0;
+
 			UpdateMetrics(m_fps);
 			m_shouldUpdate				= true;
 			m_profilingLastUpdateTime	= 0.0f;
@@ -157,6 +400,36 @@ namespace Directus
 
 	void Profiler::OnFrameEnd()
 	{
+		Trace_End();
+
+		// Allocations since the previous frame ended
+		uint64_t heapAllocations		= Allocation_Counters::GetHeapAllocations();
+		uint64_t heapBytes				= Allocation_Counters::GetHeapBytes();
+		uint64_t poolAllocations		= Allocation_Counters::GetPoolAllocations();
+		uint64_t poolChunkAllocations	= Allocation_Counters::GetPoolChunkAllocations();
+		m_memoryHeapAllocations			= (unsigned int)(heapAllocations - m_heapAllocationsLast);
+		m_memoryHeapBytes				= heapBytes - m_heapBytesLast;
+		m_memoryPoolAllocations			= (unsigned int)(poolAllocations - m_poolAllocationsLast);
+		m_memoryPoolChunkAllocations	= (unsigned int)(poolChunkAllocations - m_poolChunkAllocationsLast);
+		m_memoryFrameArenaBytes			= Frame_Arena::Get().GetBytesLastFrame();
+		m_heapAllocationsLast			= heapAllocations;
+		m_heapBytesLast					= heapBytes;
+		m_poolAllocationsLast			= poolAllocations;
+		m_poolChunkAllocationsLast		= poolChunkAllocations;
+
+		// Feed the rolling statistics, the last zone to complete is the frame itself (unless tracing was toggled mid-frame)
+		auto& collected = Profiler_Trace::GetBuffer()->collected;
+		if (!collected.empty() && collected.back().first == Profiler_Trace::FRAME)
+		{
+			m_frameZones.clear();
+			for (unsigned int i = 0; i < (unsigned int)collected.size() - 1; i++)
+			{
+				m_frameZones.emplace_back(collected[i].first, collected[i].second / 1000000.0f);
+			}
+			m_frameStatistics.AddFrame(collected.back().second / 1000000.0f, m_frameZones);
+		}
+		collected.clear();
+
 		if (!m_shouldUpdate)
 			return;
 
@@ -179,6 +452,7 @@ namespace Directus
 		int textures	= m_resourceManager->GetResourceCountByType(Resource_Texture);
 		int materials	= m_resourceManager->GetResourceCountByType(Resource_Material);
 		int shaders		= m_resourceManager->GetResourceCountByType(Resource_Shader);
+		const auto& frameSummary = m_frameStatistics.GetFrameSummary();
 
 		m_metrics =
 			// Performance
@@ -186,26 +460,38 @@ namespace Directus
 			"Frame time:\t\t\t\t\t" + to_string_precision(m_frameTimeMs, 2) + " ms\n"
 			"CPU time:\t\t\t\t\t\t" + to_string_precision(m_cpuTime, 2) + " ms\n"
 			"GPU time:\t\t\t\t\t\t" + to_string_precision(m_gpuTime, 2) + " ms\n"
+			"Frame p50/p95/p99:\t\t\t"	+ to_string_precision(frameSummary.p50, 2) + "/" + to_string_precision(frameSummary.p95, 2) + "/" + to_string_precision(frameSummary.p99, 2) + " ms\n"
+			"Hitches:\t\t\t\t\t\t"		+ to_string(m_frameStatistics.GetHitchCount()) + "\n"
+			"Pacing error avg/max:\t\t"	+ to_string_precision(m_pacingErrorAvgMs, 3) + "/" + to_string_precision(m_pacingErrorMaxMs, 3) + " ms\n"
 			"GPU:\t\t\t\t\t\t\t"	+ Settings::Get().Gpu_GetName() + "\n"
 			"VRAM:\t\t\t\t\t\t\t"	+ to_string(Settings::Get().Gpu_GetMemory()) + " MB\n"
 
 			// Renderer
 			"Resolution:\t\t\t\t\t"				+ to_string(int(Settings::Get().Resolution_GetWidth())) + "x" + to_string(int(Settings::Get().Resolution_GetHeight())) + "\n"
-			"Meshes rendered:\t\t\t\t"			+ to_string(m_rendererMeshesRendered) + "\n"
+			"Meshes rendered:\t\t\t\t"			+ to_string(m_renderStats.rendererMeshesRendered) + "\n"
+			"Render graph passes:\t\t\t"		+ to_string(m_renderStats.rendererGraphPasses) + " (" + to_string(m_renderStats.rendererGraphPassesCulled) + " culled)\n"
+			"Render targets (transient):\t"		+ to_string_precision(m_renderStats.rendererGraphMemoryAliased / 1048576.0f, 2) + " MB (" + to_string_precision(m_renderStats.rendererGraphMemoryTransient / 1048576.0f, 2) + " MB without aliasing)\n"
+			"Occlusion culled:\t\t\t"			+ to_string(m_rendererOcclusionCulled) + "/" + to_string(m_rendererOcclusionTested) + " (" + to_string(m_rendererOcclusionOccluders) + " occluders, " + to_string(m_rendererOcclusionTriangles) + " triangles)\n"
 			"Textures:\t\t\t\t\t\t"				+ to_string(textures) + "\n"
 			"Materials:\t\t\t\t\t\t"			+ to_string(materials) + "\n"
 			"Shaders:\t\t\t\t\t\t"				+ to_string(shaders) + "\n"
 
+			// Memory
+			"Heap allocations:\t\t\t"		+ to_string(m_memoryHeapAllocations) + " (" + to_string_precision(m_memoryHeapBytes / 1024.0f, 2) + " KB)\n"
+			"Pool allocations:\t\t\t"		+ to_string(m_memoryPoolAllocations) + " (" + to_string(m_memoryPoolChunkAllocations) + " new chunks)\n"
+			"Frame arena:\t\t\t\t\t"		+ to_string_precision(m_memoryFrameArenaBytes / 1024.0f, 2) + " KB\n"
+
 			// RHI
-			"RHI Draw calls:\t\t\t\t\t"			+ to_string(m_rhiDrawCalls) + "\n"
-			"RHI Index buffer bindings:\t\t"	+ to_string(m_rhiBindingsBufferIndex) + "\n"
-			"RHI Vertex buffer bindings:\t"		+ to_string(m_rhiBindingsBufferVertex) + "\n"
-			"RHI Constant buffer bindings:\t"	+ to_string(m_rhiBindingsBufferConstant) + "\n"
-			"RHI Sampler bindings:\t\t\t"		+ to_string(m_rhiBindingsSampler) + "\n"
-			"RHI Texture bindings:\t\t\t"		+ to_string(m_rhiBindingsTexture) + "\n"
-			"RHI Vertex Shader bindings:\t"		+ to_string(m_rhiBindingsVertexShader) + "\n"
-			"RHI Pixel Shader bindings:\t\t"	+ to_string(m_rhiBindingsPixelShader) + "\n"
-			"RHI Render Target bindings:\t"		+ to_string(m_rhiBindingsRenderTarget) + "\n";
+			"RHI Draw calls:\t\t\t\t\t"			+ to_string(m_renderStats.rhiDrawCalls) + "\n"
+			"RHI Index buffer bindings:\t\t"	+ to_string(m_renderStats.rhiBindingsBufferIndex) + "\n"
+			"RHI Vertex buffer bindings:\t"		+ to_string(m_renderStats.rhiBindingsBufferVertex) + "\n"
+			"RHI Constant buffer bindings:\t"	+ to_string(m_renderStats.rhiBindingsBufferConstant) + "\n"
+			"RHI Sampler bindings:\t\t\t"		+ to_string(m_renderStats.rhiBindingsSampler) + "\n"
+			"RHI Texture bindings:\t\t\t"		+ to_string(m_renderStats.rhiBindingsTexture) + "\n"
+			"RHI Vertex Shader bindings:\t"		+ to_string(m_renderStats.rhiBindingsVertexShader) + "\n"
+			"RHI Pixel Shader bindings:\t\t"	+ to_string(m_renderStats.rhiBindingsPixelShader) + "\n"
+			"RHI Render Target bindings:\t"		+ to_string(m_renderStats.rhiBindingsRenderTarget) + "\n"
+			"RHI Pipeline state changes:\t"		+ to_string(m_renderStats.rhiPipelineStateChanges) + "\n";
 	}
 
 	void Profiler::ComputeFPS(float deltaTime)
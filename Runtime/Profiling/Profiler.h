@@ -27,6 +27,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <map>
 #include <chrono>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include "FrameStatistics.h"
 //=============================
 
 // Multi (CPU + GPU)
@@ -36,8 +39,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define TIME_BLOCK_START_CPU()		Directus::Profiler::Get().TimeBlockStart_CPU(__FUNCTION__);
 #define TIME_BLOCK_END_CPU()		Directus::Profiler::Get().TimeBlockEnd_CPU(__FUNCTION__);
 // GPU
-#define TIME_BLOCK_START_GPU()		Directus::Profiler::Get().TimeBlockStart_CPU(__FUNCTION__);
+#define TIME_BLOCK_START_GPU()		Directus::Profiler::Get().TimeBlockStart_GPU(__FUNCTION__);
 #define TIME_BLOCK_END_GPU()		Directus::Profiler::Get().TimeBlockEnd_GPU(__FUNCTION__);
+// Scoped trace zones (any thread, can nest, name must outlive the trace, e.g. a string literal)
+#define PROFILE_ZONE_CONCAT_IMPL(a, b)	a##b
+#define PROFILE_ZONE_CONCAT(a, b)		PROFILE_ZONE_CONCAT_IMPL(a, b)
+#define PROFILE_ZONE(name)				Directus::ProfilerZone PROFILE_ZONE_CONCAT(_profilerZone, __LINE__)(name);
+#define PROFILE_FUNCTION()				PROFILE_ZONE(__FUNCTION__)
 
 namespace Directus
 {
@@ -48,6 +56,27 @@ namespace Directus
 	class RHI_Device;
 	class Variant;
 
+	// Counted while a frame is drawn, by the renderer and the RHI. That's the render thread when there is one, so
+	// the counts are handed back to the main thread along with the drawn snapshot (see RenderSnapshot_Pipeline).
+	struct Profiler_RenderStats
+	{
+		unsigned int rhiDrawCalls				= 0;
+		unsigned int rhiBindingsBufferIndex		= 0;
+		unsigned int rhiBindingsBufferVertex	= 0;
+		unsigned int rhiBindingsBufferConstant	= 0;
+		unsigned int rhiBindingsSampler			= 0;
+		unsigned int rhiBindingsTexture			= 0;
+		unsigned int rhiBindingsVertexShader	= 0;
+		unsigned int rhiBindingsPixelShader		= 0;
+		unsigned int rhiBindingsRenderTarget	= 0;
+		unsigned int rhiPipelineStateChanges	= 0;
+		unsigned int rendererMeshesRendered		= 0;
+		unsigned int rendererGraphPasses		= 0;
+		unsigned int rendererGraphPassesCulled	= 0;
+		uint64_t rendererGraphMemoryTransient	= 0;
+		uint64_t rendererGraphMemoryAliased		= 0;
+	};
+
 	struct TimeBlock_CPU
 	{
 		std::chrono::steady_clock::time_point start;
@@ -103,40 +132,56 @@ namespace Directus
 		float GetRenderTime_GPU()						{ return m_gpuTime; }
 		float GetFPS()									{ return m_fps; }
 		float GetFrameTimeSec()							{ return m_frameTimeSec; }
-
-		void Reset()
-		{
-			m_rhiDrawCalls				= 0;
-			m_rendererMeshesRendered	= 0;
-			m_rhiBindingsBufferIndex	= 0;
-			m_rhiBindingsBufferVertex	= 0;
-			m_rhiBindingsBufferConstant	= 0;
-			m_rhiBindingsSampler		= 0;
-			m_rhiBindingsTexture		= 0;
-			m_rhiBindingsVertexShader	= 0;
-			m_rhiBindingsPixelShader	= 0;
-			m_rhiBindingsRenderTarget	= 0;
-		}
-
-		// Metrics - RHI
-		unsigned int m_rhiDrawCalls;
-		unsigned int m_rhiBindingsBufferIndex;
-		unsigned int m_rhiBindingsBufferVertex;
-		unsigned int m_rhiBindingsBufferConstant;
-		unsigned int m_rhiBindingsSampler;
-		unsigned int m_rhiBindingsTexture;
-		unsigned int m_rhiBindingsVertexShader;
-		unsigned int m_rhiBindingsPixelShader;
-		unsigned int m_rhiBindingsRenderTarget;
-
-		// Metrics - Renderer
-		unsigned int m_rendererMeshesRendered;
+		float GetPacingErrorAvgMs()						{ return m_pacingErrorAvgMs; }
+		float GetPacingErrorMaxMs()						{ return m_pacingErrorMaxMs; }
+
+		//= TRACE ==================================================================================================
+		// Every thread records its zones into its own ring buffer, without locking. The most recent
+		// events of every thread can be exported as Chrome Trace Event JSON (chrome://tracing, Perfetto).
+		static void Trace_Begin(const char* name);
+		static void Trace_End();
+		// Names the calling thread in exported traces
+		static void Trace_SetThreadName(const std::string& name);
+		static void Trace_SetEnabled(bool enabled)		{ m_traceEnabled = enabled; }
+		static bool Trace_IsEnabled()					{ return m_traceEnabled; }
+		// Zones the calling thread has open
+		static unsigned int Trace_GetDepth();
+		bool Trace_Export(const std::string& filePath);
+		//==========================================================================================================
+
+		// Rolling CPU timings of the main thread zones, fed every frame while tracing is enabled
+		FrameStatistics& GetFrameStatistics()			{ return m_frameStatistics; }
+
+		// Clears the counts of the frame which is about to be drawn (called by the thread which draws)
+		void Reset() { m_renderStatsDrawing = Profiler_RenderStats(); }
+		// The counts of the most recently drawn frame, published on the main thread
+		void SetRenderStats(const Profiler_RenderStats& stats)	{ m_renderStats = stats; }
+		const Profiler_RenderStats& GetRenderStats()			{ return m_renderStats; }
+
+		// Metrics - Drawing (only the thread which draws touches these, see Profiler_RenderStats)
+		Profiler_RenderStats m_renderStatsDrawing;
+
+		// Metrics - Renderer (occlusion culling happens during the capture, on the main thread)
+		unsigned int m_rendererOcclusionOccluders;
+		unsigned int m_rendererOcclusionTriangles;
+		unsigned int m_rendererOcclusionTested;
+		unsigned int m_rendererOcclusionCulled;
+
+		// Metrics - Memory (during the last frame)
+		unsigned int m_memoryHeapAllocations;
+		uint64_t m_memoryHeapBytes;
+		unsigned int m_memoryPoolAllocations;
+		unsigned int m_memoryPoolChunkAllocations;
+		uint64_t m_memoryFrameArenaBytes;
 
 		// Metrics - Time
 		float m_frameTimeMs;
 		float m_frameTimeSec;
 		float m_cpuTime;
 		float m_gpuTime;
+		// Frame pacing error (how far from its deadline a frame started), over the last profiling interval
+		float m_pacingErrorAvgMs;
+		float m_pacingErrorMaxMs;
 
 	private:
 		void UpdateMetrics(float fps);
@@ -150,12 +195,19 @@ namespace Directus
 		float m_profilingFrequencySec;
 		float m_profilingLastUpdateTime;
 
-		// Time blocks
+		// Trace
+		static std::atomic<bool> m_traceEnabled;
+		std::thread::id m_mainThreadID;
+		FrameStatistics m_frameStatistics;
+		std::vector<std::pair<const char*, float>> m_frameZones;
+
+		// Time blocks (main thread only)
 		std::map<const char*, TimeBlock_CPU> m_timeBlocks_cpu;
 		std::map<const char*, TimeBlock_GPU> m_timeBlocks_gpu;
 
 		// Misc
 		std::string m_metrics;
+		Profiler_RenderStats m_renderStats;
 		bool m_shouldUpdate;
 	
 		//= FPS ===========
@@ -164,10 +216,30 @@ namespace Directus
 		int m_frameCount;
 		//=================
 
+		//= ALLOCATIONS =========================
+		uint64_t m_heapAllocationsLast;
+		uint64_t m_heapBytesLast;
+		uint64_t m_poolAllocationsLast;
+		uint64_t m_poolChunkAllocationsLast;
+		//=======================================
+
+		//= PACING ==================
+		float m_pacingErrorSum;
+		float m_pacingErrorMax;
+		unsigned int m_pacingSamples;
+		//===========================
+
 		// Dependencies
 		World* m_scene;
 		Timer* m_timer;
 		ResourceCache* m_resourceManager;
 		std::shared_ptr<RHI_Device> m_rhiDevice;
 	};
+
+	class ProfilerZone
+	{
+	public:
+		ProfilerZone(const char* name)	{ Profiler::Trace_Begin(name); }
+		~ProfilerZone()					{ Profiler::Trace_End(); }
+	};
 }
@@ -181,6 +181,13 @@ namespace Directus
 		m_alphaBlendingEnabled	= false;
 		m_initialized			= false;
 
+		// Headless, the device is never initialized and everything that needs it skips its GPU work
+		if (!drawHandle)
+		{
+			m_viewport = make_shared<RHI_Viewport>();
+			return;
+		}
+
 		if (!IsWindow((HWND)drawHandle))
 		{
 			LOG_ERROR("Invalid draw handle.");
@@ -330,6 +337,9 @@ namespace Directus
 			}
 		}
 
+		// Limit how many frames can be queued up ahead of the GPU
+		Set_MaximumFrameLatency(Settings::Get().FPS_GetMaxFramesInFlight());
+
 		// RENDER TARGET VIEW
 		{
 			// Get the pointer to the back buffer.
@@ -506,7 +516,7 @@ namespace Directus
 			return;
 
 		_D3D11_Device::deviceContext->Draw(vertexCount, 0);
-		Profiler::Get().m_rhiDrawCalls++;
+		Profiler::Get().m_renderStatsDrawing.rhiDrawCalls++;
 	}
 
 	void RHI_Device::DrawIndexed(unsigned int indexCount, unsigned int indexOffset, unsigned int vertexOffset)
@@ -515,7 +525,7 @@ namespace Directus
 			return;
 
 		_D3D11_Device::deviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
-		Profiler::Get().m_rhiDrawCalls++;
+		Profiler::Get().m_renderStatsDrawing.rhiDrawCalls++;
 	}
 
 	void RHI_Device::ClearBackBuffer(const Vector4& color)
@@ -759,22 +769,17 @@ namespace Directus
 		return true;
 	}
 
-	void RHI_Device::EventBegin(const std::string& name)
+	void RHI_Device::EventBegin(const char* name)
 	{
 		#ifdef DEBUG
-		auto s2ws = [](const std::string& s)
-		{
-			int len;
-			int slength = (int)s.length() + 1;
-			len = MultiByteToWideChar(CP_ACP, 0, s.c_str(), slength, 0, 0);
-			auto buf = new wchar_t[len];
-			MultiByteToWideChar(CP_ACP, 0, s.c_str(), slength, buf, len);
-			std::wstring r(buf);
-			delete[] buf;
-			return r;
-		};
+		// Event names are short, convert them on the stack
+		wchar_t nameWide[128];
+		if (MultiByteToWideChar(CP_ACP, 0, name, -1, nameWide, 128) == 0)
+		{
+			nameWide[0] = 0;
+		}
 
-		_D3D11_Device::eventReporter->BeginEvent(s2ws(name).c_str());
+		_D3D11_Device::eventReporter->BeginEvent(nameWide);
 		#endif
 	}
 
@@ -885,6 +890,34 @@ namespace Directus
 		return true;
 	}
 
+	bool RHI_Device::Set_MaximumFrameLatency(unsigned int frames)
+	{
+		if (!_D3D11_Device::device)
+		{
+			LOG_ERROR("Invalid device");
+			return false;
+		}
+
+		IDXGIDevice1* dxgiDevice = nullptr;
+		if (FAILED(_D3D11_Device::device->QueryInterface(__uuidof(IDXGIDevice1), (void**)&dxgiDevice)))
+		{
+			LOG_ERROR("Failed to get the DXGI device");
+			return false;
+		}
+
+		// DXGI accepts 1 to 16 frames
+		frames			= frames < 1 ? 1 : (frames > 16 ? 16 : frames);
+		auto result		= dxgiDevice->SetMaximumFrameLatency(frames);
+		dxgiDevice->Release();
+		if (FAILED(result))
+		{
+			LOGF_ERROR("Failed to set maximum frame latency, %s.", _D3D11_Device::DxgiErrorToString(result));
+			return false;
+		}
+
+		return true;
+	}
+
 	bool RHI_Device::Set_CullMode(Cull_Mode cullMode)
 	{
 		if (!_D3D11_Device::deviceContext)
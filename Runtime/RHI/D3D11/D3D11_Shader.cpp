@@ -39,13 +39,29 @@ namespace Directus
 {
 	namespace D3D11_Shader
 	{
-		inline bool CompileShader(const string& filePath, D3D_SHADER_MACRO* macros, const char* entryPoint, const char* shaderModel, ID3DBlob** shaderBlobOut)
+		inline bool CompileShader(const string& filePath, D3D_SHADER_MACRO* macros, const char* entryPoint, const char* shaderModel, const string& cacheKey, ID3DBlob** shaderBlobOut)
 		{
 			unsigned compileFlags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_OPTIMIZATION_LEVEL3;
 			#ifdef DEBUG
 			compileFlags |= D3DCOMPILE_DEBUG | D3DCOMPILE_PREFER_FLOW_CONTROL;
 			#endif
 
+			// Debug and release bytecode differ, so they are cached separately
+			const string key = cacheKey.empty() ? cacheKey : cacheKey + "_" + to_string(compileFlags);
+
+			// Load from the bytecode cache
+			vector<char> bytecode;
+			if (RHI_Shader::Cache_Load(key, &bytecode))
+			{
+				ID3DBlob* cachedBlob = nullptr;
+				if (SUCCEEDED(D3DCreateBlob(bytecode.size(), &cachedBlob)))
+				{
+					memcpy(cachedBlob->GetBufferPointer(), bytecode.data(), bytecode.size());
+					*shaderBlobOut = cachedBlob;
+					return true;
+				}
+			}
+
 			// Load and compile from file
 			ID3DBlob* errorBlob		= nullptr;
 			ID3DBlob* shaderBlob	= nullptr;
@@ -89,13 +105,19 @@ namespace Directus
 				}
 			}
 
+			// Store in the bytecode cache
+			if (SUCCEEDED(result) && shaderBlob)
+			{
+				RHI_Shader::Cache_Save(key, shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+			}
+
 			// Write to blob out
 			*shaderBlobOut = shaderBlob;
 
 			return SUCCEEDED(result);
 		}
 
-		inline bool CompileVertexShader(ID3D11Device* device, ID3D10Blob** vsBlob, ID3D11VertexShader** vertexShader, const string& path, const char* entrypoint, const char* shaderModel, D3D_SHADER_MACRO* macros)
+		inline bool CompileVertexShader(ID3D11Device* device, ID3D10Blob** vsBlob, ID3D11VertexShader** vertexShader, const string& path, const char* entrypoint, const char* shaderModel, D3D_SHADER_MACRO* macros, const string& cacheKey)
 		{
 			if (!device)
 			{
@@ -103,7 +125,7 @@ namespace Directus
 				return false;
 			}
 			// Compile shader
-			if (!CompileShader(path, macros, entrypoint, shaderModel, vsBlob))
+			if (!CompileShader(path, macros, entrypoint, shaderModel, cacheKey, vsBlob))
 				return false;
 
 			// Create the shader from the buffer.
@@ -117,7 +139,7 @@ namespace Directus
 			return true;
 		}
 
-		inline bool CompilePixelShader(ID3D11Device* device, ID3D10Blob** psBlob, ID3D11PixelShader** pixelShader, const string& path, const char* entrypoint, const char* shaderModel, D3D_SHADER_MACRO* macros)
+		inline bool CompilePixelShader(ID3D11Device* device, ID3D10Blob** psBlob, ID3D11PixelShader** pixelShader, const string& path, const char* entrypoint, const char* shaderModel, D3D_SHADER_MACRO* macros, const string& cacheKey)
 		{
 			if (!device)
 			{
@@ -126,7 +148,7 @@ namespace Directus
 			}
 
 			// Compile the shader
-			if (!CompileShader(path, macros, entrypoint, shaderModel, psBlob))
+			if (!CompileShader(path, macros, entrypoint, shaderModel, cacheKey, psBlob))
 				return false;
 
 			// Create the shader from the buffer.
@@ -162,79 +184,111 @@ namespace Directus
 
 	RHI_Shader::~RHI_Shader()
 	{
-		SafeRelease((ID3D11VertexShader*)m_vertexShader);
-		SafeRelease((ID3D11PixelShader*)m_pixelShader);
+		SafeRelease((ID3D11VertexShader*)m_vertexShader.load());
+		SafeRelease((ID3D11PixelShader*)m_pixelShader.load());
+		SafeRelease((ID3D11VertexShader*)m_vertexShaderRetired);
+		SafeRelease((ID3D11PixelShader*)m_pixelShaderRetired);
 	}
 
 	bool RHI_Shader::API_CompileVertex(const string& filePath, Input_Layout inputLayout)
 	{
-		m_filePath = filePath;
-
-		vector<D3D_SHADER_MACRO> vsMacros = D3D11_Shader::GetD3DMacros(m_macros);
-		vsMacros.push_back(D3D_SHADER_MACRO{ "COMPILE_VS", "1" });
-		vsMacros.push_back(D3D_SHADER_MACRO{ "COMPILE_PS", "0" });
+		auto macros				= m_macros;
+		macros["COMPILE_VS"]	= "1";
+		macros["COMPILE_PS"]	= "0";
+		vector<D3D_SHADER_MACRO> vsMacros = D3D11_Shader::GetD3DMacros(macros);
 		vsMacros.push_back(D3D_SHADER_MACRO{ nullptr, nullptr });
 
-		ID3D10Blob* blobVS	= nullptr;
-		auto shaderPtr		= (ID3D11VertexShader**)&m_vertexShader;
+		vector<string> dependencies;
+		string cacheKey = Cache_ComputeKey(filePath, macros, VERTEX_SHADER_ENTRYPOINT, VERTEX_SHADER_MODEL, &dependencies);
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_dependencies = dependencies;
+		}
+
+		ID3D10Blob* blobVS					= nullptr;
+		ID3D11VertexShader* vertexShader	= nullptr;
 
 		// Compile the shader
-		if (D3D11_Shader::CompileVertexShader(
+		if (!D3D11_Shader::CompileVertexShader(
 			m_rhiDevice->GetDevice<ID3D11Device>(),
 			&blobVS,
-			shaderPtr,
-			m_filePath,
+			&vertexShader,
+			filePath,
 			VERTEX_SHADER_ENTRYPOINT,
 			VERTEX_SHADER_MODEL,
-			&vsMacros.front()))
+			&vsMacros.front(),
+			cacheKey))
 		{
-			// Create input layout
-			if (!m_inputLayout->Create(blobVS, inputLayout))
-			{
-				LOGF_ERROR("Failed to create vertex input layout for %s", FileSystem::GetFileNameFromFilePath(m_filePath).c_str());
-			}
-
 			SafeRelease(blobVS);
-			m_hasVertexShader	= true;
+			SafeRelease(vertexShader);
+			return false;
 		}
-		else
+
+		// Create input layout (a recompilation is expected to keep the same vertex input)
+		if (!m_inputLayout->GetBuffer() && !m_inputLayout->Create(blobVS, inputLayout))
 		{
-			m_hasVertexShader	= false;
+			LOGF_ERROR("Failed to create vertex input layout for %s", FileSystem::GetFileNameFromFilePath(filePath).c_str());
 		}
 
-		return m_hasVertexShader;
+		SafeRelease(blobVS);
+		PublishVertexShader(vertexShader);
+		m_hasVertexShader = true;
+
+		return true;
 	}
 
 	bool RHI_Shader::API_CompilePixel(const string& filePath)
 	{
-		m_filePath = filePath;
-
-		vector<D3D_SHADER_MACRO> psMacros = D3D11_Shader::GetD3DMacros(m_macros);
-		psMacros.push_back(D3D_SHADER_MACRO{ "COMPILE_VS", "0" });
-		psMacros.push_back(D3D_SHADER_MACRO{ "COMPILE_PS", "1" });
+		auto macros				= m_macros;
+		macros["COMPILE_VS"]	= "0";
+		macros["COMPILE_PS"]	= "1";
+		vector<D3D_SHADER_MACRO> psMacros = D3D11_Shader::GetD3DMacros(macros);
 		psMacros.push_back(D3D_SHADER_MACRO{ nullptr, nullptr });
 
-		ID3D10Blob* blobPS	= nullptr;
-		auto shaderPtr		= (ID3D11PixelShader**)&m_pixelShader;	
+		vector<string> dependencies;
+		string cacheKey = Cache_ComputeKey(filePath, macros, PIXEL_SHADER_ENTRYPOINT, PIXEL_SHADER_MODEL, &dependencies);
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_dependencies = dependencies;
+		}
+
+		ID3D10Blob* blobPS				= nullptr;
+		ID3D11PixelShader* pixelShader	= nullptr;
 
-		if (D3D11_Shader::CompilePixelShader(
+		if (!D3D11_Shader::CompilePixelShader(
 			m_rhiDevice->GetDevice<ID3D11Device>(),
 			&blobPS,
-			shaderPtr,
-			m_filePath,
+			&pixelShader,
+			filePath,
 			PIXEL_SHADER_ENTRYPOINT,
 			PIXEL_SHADER_MODEL,
-			&psMacros.front()
+			&psMacros.front(),
+			cacheKey
 		))
 		{
 			SafeRelease(blobPS);
-			m_hasPixelShader = true;
-		}
-		else
-		{
-			m_hasPixelShader = false;
+			SafeRelease(pixelShader);
+			return false;
 		}
 
-		return m_hasPixelShader;
+		SafeRelease(blobPS);
+		PublishPixelShader(pixelShader);
+		m_hasPixelShader = true;
+
+		return true;
+	}
+
+	void RHI_Shader::PublishVertexShader(void* shader)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		SafeRelease((ID3D11VertexShader*)m_vertexShaderRetired);
+		m_vertexShaderRetired = m_vertexShader.exchange(shader);
+	}
+
+	void RHI_Shader::PublishPixelShader(void* shader)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		SafeRelease((ID3D11PixelShader*)m_pixelShaderRetired);
+		m_pixelShaderRetired = m_pixelShader.exchange(shader);
 	}
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
 #include "RHI_RenderTexture.h"
+#include "../Rendering/RenderSnapshot.h"
 //=====================================
 
 namespace Directus
@@ -172,20 +173,19 @@ namespace Directus
 
 	struct Struct_ShadowMapping
 	{
-		Struct_ShadowMapping(const Math::Matrix& mViewProjectionInverted, Light* dirLight, Camera* camera)
+		Struct_ShadowMapping(const Math::Matrix& mViewProjectionInverted, const RenderSnapshot_Light* dirLight)
 		{
 			// Fill the buffer
 			m_viewprojectionInverted = mViewProjectionInverted;
 
 			if (dirLight)
 			{
-				auto mLightView				= dirLight->GetViewMatrix();
-				m_mLightViewProjection[0]	= mLightView * dirLight->ShadowMap_GetProjectionMatrix(0);
-				m_mLightViewProjection[1]	= mLightView * dirLight->ShadowMap_GetProjectionMatrix(1);
-				m_mLightViewProjection[2]	= mLightView * dirLight->ShadowMap_GetProjectionMatrix(2);
-				m_biases					= Math::Vector2(dirLight->GetBias(), dirLight->GetNormalBias());
-				m_lightDir					= dirLight->GetDirection();
-				m_shadowMapResolution		= (float)dirLight->GetShadowMap()->GetWidth();
+				m_mLightViewProjection[0]	= dirLight->view * dirLight->shadowProjection[0];
+				m_mLightViewProjection[1]	= dirLight->view * dirLight->shadowProjection[1];
+				m_mLightViewProjection[2]	= dirLight->view * dirLight->shadowProjection[2];
+				m_biases					= Math::Vector2(dirLight->bias, dirLight->normalBias);
+				m_lightDir					= dirLight->direction;
+				m_shadowMapResolution		= dirLight->shadowMap ? (float)dirLight->shadowMap->GetWidth() : 0.0f;
 			}
 		}
 
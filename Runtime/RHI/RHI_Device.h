@@ -33,55 +33,58 @@ namespace Directus
 		class Vector4;
 	}
 
+	// The drawing, binding and state functions are virtual so that a device which records
+	// what reaches it can stand in for the real one (the pipeline tests do this)
 	class ENGINE_CLASS RHI_Device
 	{
 	public:
 		RHI_Device(void* drawHandle);
-		~RHI_Device();
+		virtual ~RHI_Device();
 
-		//= DRAW ========================================================================================
-		void Draw(unsigned int vertexCount);
-		void DrawIndexed(unsigned int indexCount, unsigned int indexOffset, unsigned int vertexOffset);
+		//= DRAW ================================================================================================
+		virtual void Draw(unsigned int vertexCount);
+		virtual void DrawIndexed(unsigned int indexCount, unsigned int indexOffset, unsigned int vertexOffset);
 		void ClearBackBuffer(const Math::Vector4& color);
-		void ClearRenderTarget(void* renderTarget, const Math::Vector4& color);
-		void ClearDepthStencil(void* depthStencil, unsigned int flags, float depth, uint8_t stencil = 0);
+		virtual void ClearRenderTarget(void* renderTarget, const Math::Vector4& color);
+		virtual void ClearDepthStencil(void* depthStencil, unsigned int flags, float depth, uint8_t stencil = 0);
 		void Present();
-		//===============================================================================================
+		//=======================================================================================================
 
-		//= BIND ============================================================================================================
+		//= BIND ===================================================================================================================
 		void Set_BackBufferAsRenderTarget();
-		void Set_VertexShader(void* buffer);
-		void Set_PixelShader(void* buffer);
-		void Set_ConstantBuffers(unsigned int startSlot, unsigned int bufferCount, Buffer_Scope scope, void* const* buffer);
-		void Set_Samplers(unsigned int startSlot, unsigned int samplerCount, void* const* samplers);
-		void Set_RenderTargets(unsigned int renderTargetCount, void* const* renderTargets, void* depthStencil);
-		void Set_Textures(unsigned int startSlot, unsigned int resourceCount, void* const* shaderResources);
-		//===================================================================================================================
+		virtual void Set_VertexShader(void* buffer);
+		virtual void Set_PixelShader(void* buffer);
+		virtual void Set_ConstantBuffers(unsigned int startSlot, unsigned int bufferCount, Buffer_Scope scope, void* const* buffer);
+		virtual void Set_Samplers(unsigned int startSlot, unsigned int samplerCount, void* const* samplers);
+		virtual void Set_RenderTargets(unsigned int renderTargetCount, void* const* renderTargets, void* depthStencil);
+		virtual void Set_Textures(unsigned int startSlot, unsigned int resourceCount, void* const* shaderResources);
+		//==========================================================================================================================
 
 		//= RESOLUTION ==============================================
 		bool Set_Resolution(unsigned int width, unsigned int height);
 		//===========================================================
 
-		//= VIEWPORT ======================================================
+		//= VIEWPORT ============================================================
 		std::shared_ptr<RHI_Viewport> Get_Viewport() { return m_viewport; }
-		void Set_Viewport(const std::shared_ptr<RHI_Viewport>& viewport);
-		//=================================================================
-
-		//= MISC ============================================================
-		bool Set_DepthEnabled(bool enable);
-		bool Set_AlphaBlendingEnabled(bool enable);
-		bool Set_CullMode(Cull_Mode cullMode);
-		bool Set_PrimitiveTopology(PrimitiveTopology_Mode primitiveTopology);
-		bool Set_FillMode(Fill_Mode fillMode);
-		bool Set_InputLayout(void* inputLayout);
-		//===================================================================
+		virtual void Set_Viewport(const std::shared_ptr<RHI_Viewport>& viewport);
+		//=======================================================================
+
+		//= MISC ====================================================================
+		virtual bool Set_DepthEnabled(bool enable);
+		virtual bool Set_AlphaBlendingEnabled(bool enable);
+		virtual bool Set_CullMode(Cull_Mode cullMode);
+		virtual bool Set_PrimitiveTopology(PrimitiveTopology_Mode primitiveTopology);
+		virtual bool Set_FillMode(Fill_Mode fillMode);
+		virtual bool Set_InputLayout(void* inputLayout);
+		bool Set_MaximumFrameLatency(unsigned int frames);
+		//===========================================================================
 
 		//= EVENTS ==============================
-		void EventBegin(const std::string& name);
+		void EventBegin(const char* name);
 		void EventEnd();
 		//=======================================
 
-		//= PROFILING ====================================================================
+		//= PROFILING =====================================================================
 		bool Profiling_CreateQuery(void** buffer, Query_Type type);
 		void Profiling_QueryStart(void* queryObject);
 		void Profiling_QueryEnd(void* queryObject);
@@ -44,7 +44,9 @@ namespace Directus
 {
 	RHI_Pipeline::RHI_Pipeline(shared_ptr<RHI_Device> rhiDevice)
 	{
-		m_rhiDevice	= rhiDevice;
+		m_rhiDevice			= rhiDevice;
+		m_stateBoundValid	= false;
+		m_inputLayoutBuffer	= nullptr;
 		ClearPendingStates();
 	}
 
@@ -62,26 +64,40 @@ namespace Directus
 		return bindResult;
 	}
 
-	bool RHI_Pipeline::SetState(RHI_PipelineState& pipelineState)
+	shared_ptr<RHI_PipelineState> RHI_Pipeline::State_Get(const shared_ptr<RHI_Shader>& vertexShader, const shared_ptr<RHI_Shader>& pixelShader, PrimitiveTopology_Mode primitiveTopology, Cull_Mode cullMode, Fill_Mode fillMode, bool alphaBlending)
 	{
-		SetPrimitiveTopology(pipelineState.primitiveTopology);
-		SetCullMode(pipelineState.cullMode);
-		SetFillMode(pipelineState.fillMode);
-		if (pipelineState.vertexShader)		SetVertexShader(pipelineState.vertexShader);
-		if (pipelineState.pixelShader)		SetPixelShader(pipelineState.pixelShader);
-		if (pipelineState.constantBuffer)	SetConstantBuffer(pipelineState.constantBuffer, 0, Buffer_Global);
-		if (pipelineState.sampler)			SetSampler(pipelineState.sampler);
+		auto key = RHI_PipelineState::ComputeKey(vertexShader, pixelShader, primitiveTopology, cullMode, fillMode, alphaBlending);
+
+		auto it = m_stateCache.find(key);
+		if (it != m_stateCache.end())
+			return it->second;
+
+		auto state = make_shared<RHI_PipelineState>(vertexShader, pixelShader, primitiveTopology, cullMode, fillMode, alphaBlending);
+		m_stateCache[key] = state;
+		return state;
+	}
+
+	bool RHI_Pipeline::SetState(const RHI_PipelineState& pipelineState)
+	{
+		const auto& key = pipelineState.GetKey();
+
+		if (pipelineState.GetVertexShader())	SetVertexShader(pipelineState.GetVertexShader());
+		if (pipelineState.GetPixelShader())		SetPixelShader(pipelineState.GetPixelShader());
+		SetPrimitiveTopology((PrimitiveTopology_Mode)key.primitiveTopology);
+		SetCullMode((Cull_Mode)key.cullMode);
+		SetFillMode((Fill_Mode)key.fillMode);
+		SetAlphaBlending(key.alphaBlending);
 
 		return true;
 	}
 
-	void RHI_Pipeline::SetShader(shared_ptr<RHI_Shader>& shader)
+	void RHI_Pipeline::SetShader(const shared_ptr<RHI_Shader>& shader)
 	{
 		SetVertexShader(shader);
 		SetPixelShader(shader);	
 	}
 
-	bool RHI_Pipeline::SetVertexShader(shared_ptr<RHI_Shader>& shader)
+	bool RHI_Pipeline::SetVertexShader(const shared_ptr<RHI_Shader>& shader)
 	{
 		if (!shader)
 		{
@@ -89,18 +105,17 @@ namespace Directus
 			return false;
 		}
 
-		if (shader->HasVertexShader() && m_boundVertexShaderID != shader->RHI_GetID())
+		if (shader->HasVertexShader() && m_statePending.vertexShader != shader->RHI_GetID())
 		{
 			SetInputLayout(shader->GetInputLayout()); // TODO: this has to be done outside of this function 
-			m_vertexShader			= shader;
-			m_boundVertexShaderID	= m_vertexShader->RHI_GetID();
-			m_vertexShaderDirty		= true;
+			m_vertexShader				= shader;
+			m_statePending.vertexShader	= shader->RHI_GetID();
 		}
 
 		return true;
 	}
 
-	bool RHI_Pipeline::SetPixelShader(shared_ptr<RHI_Shader>& shader)
+	bool RHI_Pipeline::SetPixelShader(const shared_ptr<RHI_Shader>& shader)
 	{
 		if (!shader)
 		{
@@ -108,11 +123,10 @@ namespace Directus
 			return false;
 		}
 
-		if (shader->HasPixelShader() && m_boundPixelShaderID != shader->RHI_GetID())
+		if (shader->HasPixelShader() && m_statePending.pixelShader != shader->RHI_GetID())
 		{
-			m_pixelShader			= shader;
-			m_boundPixelShaderID	= m_pixelShader->RHI_GetID();
-			m_pixelShaderDirty		= true;
+			m_pixelShader				= shader;
+			m_statePending.pixelShader	= shader->RHI_GetID();
 		}
 
 		return true;
@@ -253,50 +267,33 @@ namespace Directus
 
 	void RHI_Pipeline::SetPrimitiveTopology(PrimitiveTopology_Mode primitiveTopology)
 	{
-		if (m_primitiveTopology == primitiveTopology)
-			return;
-	
-		m_primitiveTopology			= primitiveTopology;
-		m_primitiveTopologyDirty	= true;
+		m_statePending.primitiveTopology = (uint8_t)primitiveTopology;
 	}
 
 	bool RHI_Pipeline::SetInputLayout(const shared_ptr<RHI_InputLayout>& inputLayout)
 	{
-		if (m_inputLayout == inputLayout->GetInputLayout())
+		if (!inputLayout || m_statePending.inputLayout == inputLayout->GetInputLayout())
 			return false;
 
-		m_inputLayout		= inputLayout->GetInputLayout();
-		m_inputLayoutBuffer	= inputLayout->GetBuffer();
-		m_inputLayoutDirty	= true;
+		m_statePending.inputLayout	= (uint8_t)inputLayout->GetInputLayout();
+		m_inputLayoutBuffer			= inputLayout->GetBuffer();
 
 		return true;
 	}
 
 	void RHI_Pipeline::SetCullMode(Cull_Mode cullMode)
 	{
-		if (m_cullMode == cullMode)
-			return;
-
-		m_cullMode		= cullMode;
-		m_cullModeDirty = true;
+		m_statePending.cullMode = (uint8_t)cullMode;
 	}
 
 	void RHI_Pipeline::SetFillMode(Fill_Mode fillMode)
 	{
-		if (m_fillMode == fillMode)
-			return;
-
-		m_fillMode		= fillMode;
-		m_fillModeDirty = true;
+		m_statePending.fillMode = (uint8_t)fillMode;
 	}
 
 	void RHI_Pipeline::SetAlphaBlending(bool enabled)
 	{
-		if (m_alphaBlending == enabled)
-			return;
-
-		m_alphaBlending			= enabled;
-		m_alphaBlendingDirty	= true;
+		m_statePending.alphaBlending = enabled;
 	}
 
 	void RHI_Pipeline::SetViewport(const shared_ptr<RHI_Viewport>& viewport)
@@ -333,7 +330,7 @@ namespace Directus
 
 			m_rhiDevice->Set_DepthEnabled(m_depthStencil != nullptr);
 			m_rhiDevice->Set_RenderTargets((unsigned int)m_renderTargetViews.size(), &m_renderTargetViews[0], m_depthStencil);
-			Profiler::Get().m_rhiBindingsRenderTarget++;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsRenderTarget++;
 
 			if (m_renderTargetsClear)
 			{
@@ -352,27 +349,13 @@ namespace Directus
 			m_renderTargetsDirty = false;
 		}
 
-		// Vertex shader
-		if (m_vertexShaderDirty)
+		// Pipeline state
+		bool resultState = true;
+		// Shaders are also compared by their GPU objects, since a hot reload swaps those without changing the shader's identity
+		bool shadersSwapped = (m_vertexShader && m_vertexShader->GetVertexShaderBuffer() != m_vertexShaderBound) || (m_pixelShader && m_pixelShader->GetPixelShaderBuffer() != m_pixelShaderBound);
+		if (!m_stateBoundValid || m_statePending != m_stateBound || shadersSwapped)
 		{
-			m_rhiDevice->Set_VertexShader(m_vertexShader->GetVertexShaderBuffer());
-			Profiler::Get().m_rhiBindingsVertexShader++;
-			m_vertexShaderDirty = false;
-		}
-
-		// Pixel shader
-		if (m_pixelShaderDirty)
-		{
-			m_rhiDevice->Set_PixelShader(m_pixelShader->GetPixelShaderBuffer());
-			Profiler::Get().m_rhiBindingsPixelShader++;
-			m_pixelShaderDirty = false;
-		}
-
-		// Input layout
-		if (m_inputLayoutDirty)
-		{
-			m_rhiDevice->Set_InputLayout(m_inputLayoutBuffer);
-			m_inputLayoutDirty = false;
+			resultState = BindState();
 		}
 
 		// Viewport
@@ -382,27 +365,6 @@ namespace Directus
 			m_viewportDirty = false;
 		}
 
-		// Primitive topology
-		if (m_primitiveTopologyDirty)
-		{
-			m_rhiDevice->Set_PrimitiveTopology(m_primitiveTopology);
-			m_primitiveTopologyDirty = false;
-		}
-
-		// Cull mode
-		if (m_cullModeDirty)
-		{
-			m_rhiDevice->Set_CullMode(m_cullMode);
-			m_cullModeDirty = false;
-		}
-
-		// Fill mode
-		if (m_fillModeDirty)
-		{
-			m_rhiDevice->Set_FillMode(m_fillMode);
-			m_fillModeDirty = false;
-		}
-
 		// Sampler
 		if (m_samplersDirty)
 		{
@@ -410,7 +372,7 @@ namespace Directus
 			unsigned int samplerCount	= (unsigned int)m_samplers.size();
 			void* const* samplers		= samplerCount != 0 ? &m_samplers[0] : nullptr;
 			m_rhiDevice->Set_Samplers(startSlot, samplerCount, samplers);
-			Profiler::Get().m_rhiBindingsSampler++;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsSampler++;
 			m_samplers.clear();
 			m_samplersDirty = false;
 		}
@@ -423,25 +385,25 @@ namespace Directus
 			void* const* textures		= textureCount != 0 ? &m_textures[0] : nullptr;
 			m_rhiDevice->Set_Textures(startSlot, textureCount, textures);
 			m_textures.clear();
-			Profiler::Get().m_rhiBindingsTexture++;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsTexture++;
 			m_texturesDirty = false;
 		}
 
 		// Index buffer
 		bool resultIndexBuffer = false;
-		if (m_indexBufferDirty)
+		if (m_indexBufferDirty && m_indexBuffer)
 		{
 			resultIndexBuffer = m_indexBuffer->Bind();
-			Profiler::Get().m_rhiBindingsBufferIndex++;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsBufferIndex++;
 			m_indexBufferDirty = false;
 		}
 
 		// Vertex buffer
 		bool resultVertexBuffer = false;
-		if (m_vertexBufferDirty)
+		if (m_vertexBufferDirty && m_vertexBuffer)
 		{
 			resultVertexBuffer = m_vertexBuffer->Bind();
-			Profiler::Get().m_rhiBindingsBufferVertex++;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsBufferVertex++;
 			m_vertexBufferDirty = false;
 		}
 
@@ -451,47 +413,99 @@ namespace Directus
 			for (const auto& constantBuffer : m_constantBuffers)
 			{
 				m_rhiDevice->Set_ConstantBuffers(constantBuffer.slot, 1, constantBuffer.scope, (void*const*)&constantBuffer.buffer);
-				Profiler::Get().m_rhiBindingsBufferConstant += (constantBuffer.scope == Buffer_Global) ? 2 : 1;
+				Profiler::Get().m_renderStatsDrawing.rhiBindingsBufferConstant += (constantBuffer.scope == Buffer_Global) ? 2 : 1;
 			}
 
 			m_constantBuffers.clear();
 			m_constantBufferDirty = false;
 		}
 
-		// Alpha blending
-		bool resultAlphaBlending = false;
-		if (m_alphaBlendingDirty)
+		return resultIndexBuffer && resultVertexBuffer && resultState;
+	}
+
+	bool RHI_Pipeline::BindState()
+	{
+		auto& pending	= m_statePending;
+		auto& bound		= m_stateBound;
+		bool bindAll	= !m_stateBoundValid;
+		bool result		= true;
+
+		// Unassigned states (e.g. right after ClearPendingStates()) keep whatever is currently bound
+		if (pending.inputLayout == Input_NotAssigned)					pending.inputLayout			= bound.inputLayout;
+		if (pending.primitiveTopology == PrimitiveTopology_NotAssigned)	pending.primitiveTopology	= bound.primitiveTopology;
+		if (pending.cullMode == Cull_NotAssigned)						pending.cullMode			= bound.cullMode;
+		if (pending.fillMode == Fill_NotAssigned)						pending.fillMode			= bound.fillMode;
+
+		// Only the fields which differ from the bound state reach the device
+		unsigned int changed = bindAll ? PipelineState_All : pending.Diff(bound);
+
+		// Vertex shader (its buffer changes when it's recompiled)
+		void* vertexShader = m_vertexShader ? m_vertexShader->GetVertexShaderBuffer() : nullptr;
+		if (((changed & PipelineState_VertexShader) || vertexShader != m_vertexShaderBound) && m_vertexShader)
 		{
-			resultAlphaBlending = m_rhiDevice->Set_AlphaBlendingEnabled(m_alphaBlending);
-			m_alphaBlendingDirty = false;
+			changed |= PipelineState_VertexShader;
+			m_rhiDevice->Set_VertexShader(vertexShader);
+			m_vertexShaderBound = vertexShader;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsVertexShader++;
 		}
 
-		return resultIndexBuffer && resultVertexBuffer && resultAlphaBlending;
-	}
+		// Pixel shader
+		void* pixelShader = m_pixelShader ? m_pixelShader->GetPixelShaderBuffer() : nullptr;
+		if (((changed & PipelineState_PixelShader) || pixelShader != m_pixelShaderBound) && m_pixelShader)
+		{
+			changed |= PipelineState_PixelShader;
+			m_rhiDevice->Set_PixelShader(pixelShader);
+			m_pixelShaderBound = pixelShader;
+			Profiler::Get().m_renderStatsDrawing.rhiBindingsPixelShader++;
+		}
+
+		// Input layout
+		if ((changed & PipelineState_InputLayout) && pending.inputLayout != Input_NotAssigned)
+		{
+			m_rhiDevice->Set_InputLayout(m_inputLayoutBuffer);
+		}
 
-	void RHI_Pipeline::ClearPendingStates()
-	{
 		// Primitive topology
-		m_primitiveTopology			= PrimitiveTopology_NotAssigned;
-		m_primitiveTopologyDirty	= true;
+		if ((changed & PipelineState_PrimitiveTopology) && pending.primitiveTopology != PrimitiveTopology_NotAssigned)
+		{
+			m_rhiDevice->Set_PrimitiveTopology((PrimitiveTopology_Mode)pending.primitiveTopology);
+		}
+
+		// Cull mode
+		if ((changed & PipelineState_CullMode) && pending.cullMode != Cull_NotAssigned)
+		{
+			m_rhiDevice->Set_CullMode((Cull_Mode)pending.cullMode);
+		}
 
 		// Fill mode
-		m_fillMode		= Fill_NotAssigned;
-		m_fillModeDirty = true;
+		if ((changed & PipelineState_FillMode) && pending.fillMode != Fill_NotAssigned)
+		{
+			m_rhiDevice->Set_FillMode((Fill_Mode)pending.fillMode);
+		}
 
-		// Input layout
-		m_inputLayout		= Input_NotAssigned;
-		m_inputLayoutDirty	= true;
+		// Alpha blending
+		if (changed & PipelineState_AlphaBlending)
+		{
+			result = m_rhiDevice->Set_AlphaBlendingEnabled(pending.alphaBlending);
+		}
 
-		// Cull mode
-		m_cullMode			= Cull_NotAssigned;
-		m_cullModeDirty		= true;
+		m_stateBound		= pending;
+		m_stateBoundValid	= true;
+		if (changed != 0)
+		{
+			Profiler::Get().m_renderStatsDrawing.rhiPipelineStateChanges++;
+		}
+
+		return result;
+	}
 
-		// Vertex & Pixel shaders
-		m_vertexShader			= nullptr;	
-		m_pixelShader			= nullptr;	
-		m_vertexShaderDirty		= false;
-		m_pixelShaderDirty		= false;
+	void RHI_Pipeline::ClearPendingStates()
+	{
+		// Pipeline state (shaders are kept, they are only re-bound when a different one is set)
+		m_statePending.primitiveTopology	= PrimitiveTopology_NotAssigned;
+		m_statePending.fillMode				= Fill_NotAssigned;
+		m_statePending.cullMode				= Cull_NotAssigned;
+		m_statePending.alphaBlending		= false;
 
 		// Vertex & Index buffers
 		m_indexBufferDirty	= true;
@@ -514,12 +528,7 @@ namespace Directus
 		m_constantBuffers.clear();
 		m_constantBufferDirty = true;
 
-		// Alpha blending
-		m_alphaBlending			= false;
-		m_alphaBlendingDirty	= true;
-
 		// Misc
-		m_inputLayoutBuffer = nullptr;
 		m_viewportDirty = false;
 	}
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <memory>
 #include <vector>
+#include <unordered_map>
 #include "..\Core\EngineDefs.h"
 #include "RHI_Definition.h"
 #include "RHI_Viewport.h"
@@ -52,17 +53,28 @@ namespace Directus
 		RHI_Pipeline(std::shared_ptr<RHI_Device> rhiDevice);
 		~RHI_Pipeline(){}
 
-		// Experimental
-		bool SetState(RHI_PipelineState& pipelineState);
+		// Pipeline state
+		std::shared_ptr<RHI_PipelineState> State_Get(
+			const std::shared_ptr<RHI_Shader>& vertexShader,
+			const std::shared_ptr<RHI_Shader>& pixelShader,
+			PrimitiveTopology_Mode primitiveTopology,
+			Cull_Mode cullMode,
+			Fill_Mode fillMode,
+			bool alphaBlending
+		);
+		bool SetState(const RHI_PipelineState& pipelineState);
+		// Forgets what is bound, so that the next draw binds the whole pipeline state (for when something else has bound state on the device)
+		void State_Invalidate() { m_stateBoundValid = false; }
+		unsigned int State_GetCachedCount() { return (unsigned int)m_stateCache.size(); }
 
 		// Draw
 		bool Draw(unsigned int vertexCount);
 		bool DrawIndexed(unsigned int indexCount, unsigned int indexOffset, unsigned int vertexOffset);
 		
 		// Shader
-		void SetShader(std::shared_ptr<RHI_Shader>& shader);
-		bool SetVertexShader(std::shared_ptr<RHI_Shader>& shader);
-		bool SetPixelShader(std::shared_ptr<RHI_Shader>& shader);
+		void SetShader(const std::shared_ptr<RHI_Shader>& shader);
+		bool SetVertexShader(const std::shared_ptr<RHI_Shader>& shader);
+		bool SetPixelShader(const std::shared_ptr<RHI_Shader>& shader);
 
 		// Texture
 		bool SetTexture(const std::shared_ptr<RHI_RenderTexture>& texture);
@@ -106,23 +118,19 @@ namespace Directus
 	private:
 		// Bind to the GPU
 		bool Bind();
+		// Binds the parts of the pending pipeline state which differ from the bound one
+		bool BindState();
 
-		// Primitive topology
-		PrimitiveTopology_Mode m_primitiveTopology;
-		bool m_primitiveTopologyDirty;
-
-		// Input layout
-		Input_Layout m_inputLayout;
+		// Pipeline state (shaders, input layout, primitive topology, cull mode, fill mode, alpha blending)
+		RHI_PipelineState_Key m_statePending;
+		RHI_PipelineState_Key m_stateBound;
+		bool m_stateBoundValid;
+		std::shared_ptr<RHI_Shader> m_vertexShader;
+		std::shared_ptr<RHI_Shader> m_pixelShader;
+		void* m_vertexShaderBound	= nullptr;
+		void* m_pixelShaderBound	= nullptr;
 		void* m_inputLayoutBuffer;
-		bool m_inputLayoutDirty;
-
-		// Cull mode
-		Cull_Mode m_cullMode;
-		bool m_cullModeDirty;
-
-		// Fill mode
-		Fill_Mode m_fillMode;
-		bool m_fillModeDirty;
+		std::unordered_map<RHI_PipelineState_Key, std::shared_ptr<RHI_PipelineState>, RHI_PipelineState_Hasher> m_stateCache;
 
 		// Samplers
 		std::vector<void*> m_samplers;
@@ -144,22 +152,10 @@ namespace Directus
 		std::vector<ConstantBuffer> m_constantBuffers;
 		bool m_constantBufferDirty;
 
-		// Vertex shader
-		std::shared_ptr<RHI_Shader> m_vertexShader;
-		bool m_vertexShaderDirty;
-
-		// Pixel Shader
-		std::shared_ptr<RHI_Shader> m_pixelShader;
-		bool m_pixelShaderDirty;
-
 		// Viewport
 		std::shared_ptr<RHI_Viewport> m_viewport;
 		bool m_viewportDirty;
 
-		// Alpha blending
-		bool m_alphaBlending;
-		bool m_alphaBlendingDirty;
-
 		// Render targets
 		std::vector<void*> m_renderTargetViews;	
 		void* m_depthStencil;
@@ -168,9 +164,5 @@ namespace Directus
 
 		// Device
 		std::shared_ptr<RHI_Device> m_rhiDevice;
-
-		// IDs
-		unsigned int m_boundVertexShaderID;
-		unsigned int m_boundPixelShaderID;
 	};
 }
\ No newline at end of file
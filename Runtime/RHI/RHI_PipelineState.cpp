@@ -0,0 +1,68 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "RHI_PipelineState.h"
+#include "RHI_Shader.h"
+#include "RHI_InputLayout.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	RHI_PipelineState::RHI_PipelineState(
+		const shared_ptr<RHI_Shader>& vertexShader,
+		const shared_ptr<RHI_Shader>& pixelShader,
+		PrimitiveTopology_Mode primitiveTopology,
+		Cull_Mode cullMode,
+		Fill_Mode fillMode,
+		bool alphaBlending
+	)
+	{
+		m_vertexShader	= vertexShader;
+		m_pixelShader	= pixelShader;
+		m_key			= ComputeKey(vertexShader, pixelShader, primitiveTopology, cullMode, fillMode, alphaBlending);
+	}
+
+	RHI_PipelineState_Key RHI_PipelineState::ComputeKey(
+		const shared_ptr<RHI_Shader>& vertexShader,
+		const shared_ptr<RHI_Shader>& pixelShader,
+		PrimitiveTopology_Mode primitiveTopology,
+		Cull_Mode cullMode,
+		Fill_Mode fillMode,
+		bool alphaBlending
+	)
+	{
+		RHI_PipelineState_Key key;
+		key.vertexShader		= vertexShader	? vertexShader->RHI_GetID()	: 0;
+		key.pixelShader			= pixelShader	? pixelShader->RHI_GetID()	: 0;
+		key.inputLayout			= (vertexShader && vertexShader->GetInputLayout()) ? (uint8_t)vertexShader->GetInputLayout()->GetInputLayout() : (uint8_t)Input_NotAssigned;
+		key.primitiveTopology	= (uint8_t)primitiveTopology;
+		key.cullMode			= (uint8_t)cullMode;
+		key.fillMode			= (uint8_t)fillMode;
+		key.alphaBlending		= alphaBlending;
+
+		return key;
+	}
+}
@@ -21,25 +21,111 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ==============
+//= INCLUDES ==================
+#include <memory>
+#include "..\Core\EngineDefs.h"
 #include "RHI_Definition.h"
-//=========================
+//=============================
 
 namespace Directus
 {
-	struct RHI_PipelineState
+	// The fields of a pipeline state, as bits
+	enum RHI_PipelineState_Field
 	{
-		RHI_PipelineState() {}
-
-		PrimitiveTopology_Mode primitiveTopology;
-		Cull_Mode cullMode;
-		Fill_Mode fillMode;
-		std::shared_ptr<RHI_Shader> vertexShader;
-		std::shared_ptr<RHI_Shader> pixelShader;
-		std::shared_ptr<RHI_VertexBuffer> vertexBuffer;
-		std::shared_ptr<RHI_IndexBuffer> indexBuffer;
-		std::shared_ptr<RHI_Sampler> sampler;
-		std::shared_ptr<RHI_ConstantBuffer> constantBuffer;
-		std::shared_ptr<RHI_Viewport> viewport;
+		PipelineState_VertexShader		= 1 << 0,
+		PipelineState_PixelShader		= 1 << 1,
+		PipelineState_InputLayout		= 1 << 2,
+		PipelineState_PrimitiveTopology	= 1 << 3,
+		PipelineState_CullMode			= 1 << 4,
+		PipelineState_FillMode			= 1 << 5,
+		PipelineState_AlphaBlending		= 1 << 6,
+		PipelineState_All				= (1 << 7) - 1
 	};
-}
\ No newline at end of file
+
+	// Everything a pipeline state consists of, packed so that it's cheap to compare, diff and hash
+	struct RHI_PipelineState_Key
+	{
+		bool operator==(const RHI_PipelineState_Key& rhs) const
+		{
+			return
+				vertexShader		== rhs.vertexShader		&&
+				pixelShader			== rhs.pixelShader		&&
+				inputLayout			== rhs.inputLayout		&&
+				primitiveTopology	== rhs.primitiveTopology	&&
+				cullMode			== rhs.cullMode			&&
+				fillMode			== rhs.fillMode			&&
+				alphaBlending		== rhs.alphaBlending;
+		}
+		bool operator!=(const RHI_PipelineState_Key& rhs) const { return !(*this == rhs); }
+
+		// The fields (RHI_PipelineState_Field bits) which differ from rhs
+		unsigned int Diff(const RHI_PipelineState_Key& rhs) const
+		{
+			unsigned int diff = 0;
+			diff |= vertexShader		!= rhs.vertexShader			? PipelineState_VertexShader		: 0;
+			diff |= pixelShader			!= rhs.pixelShader			? PipelineState_PixelShader			: 0;
+			diff |= inputLayout			!= rhs.inputLayout			? PipelineState_InputLayout			: 0;
+			diff |= primitiveTopology	!= rhs.primitiveTopology	? PipelineState_PrimitiveTopology	: 0;
+			diff |= cullMode			!= rhs.cullMode				? PipelineState_CullMode			: 0;
+			diff |= fillMode			!= rhs.fillMode				? PipelineState_FillMode			: 0;
+			diff |= alphaBlending		!= rhs.alphaBlending		? PipelineState_AlphaBlending		: 0;
+			return diff;
+		}
+
+		size_t GetHash() const
+		{
+			size_t hash = 0;
+			auto Combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+			Combine(vertexShader);
+			Combine(pixelShader);
+			Combine(inputLayout | (primitiveTopology << 8) | (cullMode << 16) | (fillMode << 24) | ((size_t)alphaBlending << 32));
+			return hash;
+		}
+
+		unsigned int vertexShader	= 0; // RHI_GetID()
+		unsigned int pixelShader	= 0; // RHI_GetID()
+		uint8_t inputLayout			= Input_NotAssigned;
+		uint8_t primitiveTopology	= PrimitiveTopology_NotAssigned;
+		uint8_t cullMode			= Cull_NotAssigned;
+		uint8_t fillMode			= Fill_NotAssigned;
+		bool alphaBlending			= false;
+	};
+
+	struct RHI_PipelineState_Hasher
+	{
+		size_t operator()(const RHI_PipelineState_Key& key) const { return key.GetHash(); }
+	};
+
+	// An immutable pipeline state, create it via RHI_Pipeline::State_Get() so that it's cached and shared
+	class ENGINE_CLASS RHI_PipelineState
+	{
+	public:
+		RHI_PipelineState(
+			const std::shared_ptr<RHI_Shader>& vertexShader,
+			const std::shared_ptr<RHI_Shader>& pixelShader,
+			PrimitiveTopology_Mode primitiveTopology,
+			Cull_Mode cullMode,
+			Fill_Mode fillMode,
+			bool alphaBlending
+		);
+		~RHI_PipelineState() {}
+
+		const std::shared_ptr<RHI_Shader>& GetVertexShader() const	{ return m_vertexShader; }
+		const std::shared_ptr<RHI_Shader>& GetPixelShader() const	{ return m_pixelShader; }
+		const RHI_PipelineState_Key& GetKey() const					{ return m_key; }
+
+		static RHI_PipelineState_Key ComputeKey(
+			const std::shared_ptr<RHI_Shader>& vertexShader,
+			const std::shared_ptr<RHI_Shader>& pixelShader,
+			PrimitiveTopology_Mode primitiveTopology,
+			Cull_Mode cullMode,
+			Fill_Mode fillMode,
+			bool alphaBlending
+		);
+
+	private:
+		std::shared_ptr<RHI_Shader> m_vertexShader;
+		std::shared_ptr<RHI_Shader> m_pixelShader;
+		RHI_PipelineState_Key m_key;
+	};
+}
@@ -19,11 +19,19 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==================
+//= INCLUDES ========================
 #include "RHI_Shader.h"
 #include "RHI_ConstantBuffer.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <cstdio>
+#include <atomic>
+#include <thread>
 #include "..\Logging\Log.h"
-//=============================
+#include "..\FileSystem\FileSystem.h"
+//===================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -31,6 +39,159 @@ using namespace std;
 
 namespace Directus
 {
+	string RHI_Shader::m_cacheDirectory;
+
+	namespace RHI_Shader_Cache
+	{
+		// FNV-1a, stable across runs and platforms (unlike std::hash)
+		inline void Hash(uint64_t& hash, const string& data)
+		{
+			for (const auto character : data)
+			{
+				hash ^= (uint64_t)(unsigned char)character;
+				hash *= 1099511628211ull;
+			}
+		}
+
+		// Hashes a source file and every file it (recursively) includes
+		inline bool HashSource(uint64_t& hash, const string& filePath, set<string>& visited)
+		{
+			if (visited.count(filePath))
+				return true;
+			visited.insert(filePath);
+
+			ifstream in(filePath, ios::in | ios::binary);
+			if (!in.good())
+				return false;
+
+			stringstream buffer;
+			buffer << in.rdbuf();
+			const string source = buffer.str();
+			Hash(hash, source);
+
+			const string directory = FileSystem::GetDirectoryFromFilePath(filePath);
+			size_t position = 0;
+			while ((position = source.find("#include", position)) != string::npos)
+			{
+				size_t first	= source.find('"', position);
+				size_t newLine	= source.find('\n', position);
+				position		+= 8;
+				if (first == string::npos || (newLine != string::npos && first > newLine))
+					continue;
+
+				size_t last = source.find('"', first + 1);
+				if (last == string::npos)
+					break;
+
+				// Missing includes are left for the compiler to report
+				HashSource(hash, directory + source.substr(first + 1, last - first - 1), visited);
+			}
+
+			return true;
+		}
+
+		inline string GetFilePath(const string& key)
+		{
+			return RHI_Shader::Cache_GetDirectory() + key + ".cso";
+		}
+
+		// A temporary file only the calling writer uses, even if other threads write the same entry
+		inline string GetFilePathTemp(const string& filePath)
+		{
+			static atomic<unsigned int> counter = 0;
+			return filePath + "." + to_string(hash<thread::id>()(this_thread::get_id())) + "_" + to_string(counter++) + ".tmp";
+		}
+	}
+
+	void RHI_Shader::Compile(const string& filePath, bool vertex, bool pixel, Input_Layout inputLayout)
+	{
+		m_compiling = true;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_filePath				= filePath;
+			m_compiledVertex		= vertex;
+			m_compiledPixel			= pixel;
+			m_compiledInputLayout	= inputLayout;
+		}
+
+		// A built shader keeps rendering with its current bytecode while it recompiles
+		bool wasBuilt = m_shaderState == Shader_Built;
+		if (!wasBuilt)
+		{
+			m_shaderState = Shader_Compiling;
+		}
+
+		bool success = true;
+		success = (vertex	&& !API_CompileVertex(filePath, inputLayout))	? false : success;
+		success = (pixel	&& !API_CompilePixel(filePath))					? false : success;
+
+		if (success)
+		{
+			m_shaderState = Shader_Built;
+			LOGF_INFO("Successfully compiled %s", filePath.c_str());
+		}
+		else
+		{
+			m_shaderState = wasBuilt ? Shader_Built : Shader_Failed;
+			LOGF_ERROR("Failed to compile %s%s", filePath.c_str(), wasBuilt ? ", the previous version remains in use" : "");
+		}
+
+		m_compiling = false;
+	}
+
+	void RHI_Shader::Compile_Async(const string& filePath, bool vertex, bool pixel, Input_Layout inputLayout, Context* context)
+	{
+		if (!context)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Flag as compiling immediately, so nobody mistakes a queued shader for an uninitialized one
+		m_compiling = true;
+		if (m_shaderState != Shader_Built)
+		{
+			m_shaderState = Shader_Compiling;
+		}
+
+		context->GetSubsystem<Threading>()->AddTask([this, filePath, vertex, pixel, inputLayout]()
+		{
+			Compile(filePath, vertex, pixel, inputLayout);
+		});
+	}
+
+	bool RHI_Shader::Recompile_Async(Context* context)
+	{
+		string filePath;
+		bool vertex, pixel;
+		Input_Layout inputLayout;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			filePath	= m_filePath;
+			vertex		= m_compiledVertex;
+			pixel		= m_compiledPixel;
+			inputLayout	= m_compiledInputLayout;
+		}
+
+		if (filePath.empty() || m_compiling)
+			return false;
+
+		Compile_Async(filePath, vertex, pixel, inputLayout, context);
+		return true;
+	}
+
+	string RHI_Shader::GetFilePath()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_filePath;
+	}
+
+	vector<string> RHI_Shader::GetDependencies()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_dependencies;
+	}
+
 	void RHI_Shader::AddDefine(const std::string& define, const std::string& value /*= "1"*/)
 	{
 		m_macros[define] = value;
@@ -61,4 +222,96 @@ namespace Directus
 		m_constantBuffer = make_shared<RHI_ConstantBuffer>(m_rhiDevice);
 		m_constantBuffer->Create(size);
 	}
+
+	//= BYTECODE CACHE =========================================================================================================
+	void RHI_Shader::Cache_SetDirectory(const string& directory)
+	{
+		m_cacheDirectory = directory;
+		if (!m_cacheDirectory.empty() && !FileSystem::DirectoryExists(m_cacheDirectory))
+		{
+			FileSystem::CreateDirectory_(m_cacheDirectory);
+		}
+	}
+
+	string RHI_Shader::Cache_ComputeKey(const string& filePath, const map<string, string>& macros, const string& entryPoint, const string& shaderModel, vector<string>* dependencies /*= nullptr*/)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		set<string> visited;
+		bool sourceFound = RHI_Shader_Cache::HashSource(hash, filePath, visited);
+		if (dependencies)
+		{
+			dependencies->assign(visited.begin(), visited.end());
+		}
+
+		if (m_cacheDirectory.empty() || !sourceFound)
+			return "";
+
+		for (const auto& macro : macros)
+		{
+			RHI_Shader_Cache::Hash(hash, macro.first + "=" + macro.second + ";");
+		}
+		RHI_Shader_Cache::Hash(hash, entryPoint + ";" + shaderModel);
+
+		stringstream key;
+		key << FileSystem::GetFileNameNoExtensionFromFilePath(filePath) << "_" << hex << setw(16) << setfill('0') << hash;
+		return key.str();
+	}
+
+	bool RHI_Shader::Cache_Load(const string& key, vector<char>* bytecode)
+	{
+		if (key.empty() || !bytecode)
+			return false;
+
+		ifstream in(RHI_Shader_Cache::GetFilePath(key), ios::in | ios::binary | ios::ate);
+		if (!in.good())
+			return false;
+
+		auto size = (size_t)in.tellg();
+		if (size == 0)
+			return false;
+
+		bytecode->resize(size);
+		in.seekg(0, ios::beg);
+		in.read(bytecode->data(), size);
+
+		return in.good();
+	}
+
+	bool RHI_Shader::Cache_Save(const string& key, const void* bytecode, size_t size)
+	{
+		if (key.empty() || !bytecode || size == 0)
+			return false;
+
+		// Write to a temporary file of our own and rename it into place, so that a reader never sees a truncated
+		// entry. Writers of the same key (async compiles, hot reloads) produce identical bytecode, so the last one wins.
+		const string filePath		= RHI_Shader_Cache::GetFilePath(key);
+		const string filePathTemp	= RHI_Shader_Cache::GetFilePathTemp(filePath);
+		{
+			ofstream out(filePathTemp, ios::out | ios::binary | ios::trunc);
+			if (!out.good())
+			{
+				LOGF_WARNING("Failed to write shader cache entry \"%s\".", filePathTemp.c_str());
+				return false;
+			}
+			out.write((const char*)bytecode, size);
+			if (!out.good())
+			{
+				out.close();
+				remove(filePathTemp.c_str());
+				return false;
+			}
+		}
+
+		// Renaming onto an existing file fails on Windows, so remove it first. If another writer
+		// puts its entry back in between, the rename fails but that entry is just as good.
+		remove(filePath.c_str());
+		if (rename(filePathTemp.c_str(), filePath.c_str()) != 0)
+		{
+			remove(filePathTemp.c_str());
+			return FileSystem::FileExists(filePath);
+		}
+
+		return true;
+	}
+	//==========================================================================================================================
 }
\ No newline at end of file
@@ -25,6 +25,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
+#include <atomic>
+#include <mutex>
 #include "RHI_Definition.h"
 #include "RHI_Object.h"
 #include "..\Core\EngineDefs.h"
@@ -56,68 +59,22 @@ namespace Directus
 		~RHI_Shader();
 		//================================================
 
-		#define LOG_STATE(state, filePath)								\
-		if (state == Shader_Built)										\
-		{																\
-			LOGF_INFO("Successfully compiled %s", filePath.c_str());	\
-		}																\
-		else if (state == Shader_Failed)								\
-		{																\
-			LOGF_ERROR("Failed to compile %s", filePath.c_str());		\
-		}
-
-		virtual void CompileVertex(const std::string& filePath, Input_Layout inputLayout)
-		{
-			m_shaderState	= Shader_Compiling;
-			bool vertex		= API_CompileVertex(filePath, inputLayout);
-
-			m_shaderState = (vertex) ? Shader_Built : Shader_Failed;
-			LOG_STATE(m_shaderState, filePath);
-		}
-
-		virtual void CompileVertex_Async(const std::string& filePath, Input_Layout inputLayout, Context* context)
-		{
-			context->GetSubsystem<Threading>()->AddTask([this, filePath, inputLayout]()
-			{
-				CompileVertex(filePath, inputLayout);
-			});
-		}
-
-		virtual void CompilePixel(const std::string& filePath)
-		{
-			m_shaderState	= Shader_Compiling;
-			bool pixel		= API_CompilePixel(filePath);
-
-			m_shaderState= (pixel) ? Shader_Built : Shader_Failed;
-			LOG_STATE(m_shaderState, filePath);
-		}
-
-
-		virtual void CompilePixel_Async(const std::string& filePath, Context* context)
-		{
-			context->GetSubsystem<Threading>()->AddTask([this, filePath]()
-			{
-				CompilePixel(filePath);
-			});
-		}
-
-		virtual void CompileVertexPixel(const std::string& filePath, Input_Layout inputLayout)
-		{
-			m_shaderState	= Shader_Compiling;
-			bool vertex		= API_CompileVertex(filePath, inputLayout);
-			bool pixel		= API_CompilePixel(filePath);
-
-			m_shaderState = (vertex && pixel) ? Shader_Built : Shader_Failed;
-			LOG_STATE(m_shaderState, filePath);
-		}
-
-		virtual void CompileVertexPixel_Async(const std::string& filePath, Input_Layout inputLayout, Context* context)
-		{
-			context->GetSubsystem<Threading>()->AddTask([this, filePath, inputLayout]()
-			{
-				CompileVertexPixel(filePath, inputLayout);
-			});
-		}
+		//= COMPILATION ============================================================================================================================
+		// Compilation is either synchronous or a task on the thread pool. A shader which has been built once stays built, if a recompilation
+		// fails (e.g. a typo while hot reloading) the previous bytecode remains in use.
+		void CompileVertex(const std::string& filePath, Input_Layout inputLayout)								{ Compile(filePath, true, false, inputLayout); }
+		void CompileVertex_Async(const std::string& filePath, Input_Layout inputLayout, Context* context)		{ Compile_Async(filePath, true, false, inputLayout, context); }
+		void CompilePixel(const std::string& filePath)															{ Compile(filePath, false, true, Input_NotAssigned); }
+		void CompilePixel_Async(const std::string& filePath, Context* context)									{ Compile_Async(filePath, false, true, Input_NotAssigned, context); }
+		void CompileVertexPixel(const std::string& filePath, Input_Layout inputLayout)							{ Compile(filePath, true, true, inputLayout); }
+		void CompileVertexPixel_Async(const std::string& filePath, Input_Layout inputLayout, Context* context)	{ Compile_Async(filePath, true, true, inputLayout, context); }
+		// Repeats the last compilation on the thread pool, returns false if there is nothing to repeat or a compilation is already in flight
+		bool Recompile_Async(Context* context);
+		bool IsCompiling()						{ return m_compiling; }
+		std::string GetFilePath();
+		// The source file and every file it includes, as seen by the last compilation
+		std::vector<std::string> GetDependencies();
+		//==========================================================================================================================================
 
 		void AddDefine(const std::string& define, const std::string& value = "1");
 
@@ -128,14 +85,24 @@ namespace Directus
 			CreateConstantBuffer(m_bufferSize);
 		}
 		void UpdateBuffer(void* data);
-		void* GetVertexShaderBuffer()								{ return m_vertexShader; }
-		void* GetPixelShaderBuffer()								{ return m_pixelShader; }
+		void* GetVertexShaderBuffer()								{ return m_vertexShader.load(); }
+		void* GetPixelShaderBuffer()								{ return m_pixelShader.load(); }
 		std::shared_ptr<RHI_ConstantBuffer>& GetConstantBuffer()	{ return m_constantBuffer; }
 		void SetName(const std::string& name)						{ m_name = name; }
 		bool HasVertexShader()										{ return m_hasVertexShader; }
 		bool HasPixelShader()										{ return m_hasPixelShader; }
 		std::shared_ptr<RHI_InputLayout> GetInputLayout()			{ return m_inputLayout; }
-		Shader_State GetState()										{ return m_shaderState; }
+		Shader_State GetState()										{ return m_shaderState.load(); }
+
+		//= BYTECODE CACHE =========================================================================================================
+		// Compiled bytecode is stored on disk, keyed by the source (includes too), the defines, the entry point and the shader model.
+		// An empty directory disables the cache.
+		static void Cache_SetDirectory(const std::string& directory);
+		static const std::string& Cache_GetDirectory() { return m_cacheDirectory; }
+		static std::string Cache_ComputeKey(const std::string& filePath, const std::map<std::string, std::string>& macros, const std::string& entryPoint, const std::string& shaderModel, std::vector<std::string>* dependencies = nullptr);
+		static bool Cache_Load(const std::string& key, std::vector<char>* bytecode);
+		static bool Cache_Save(const std::string& key, const void* bytecode, size_t size);
+		//==========================================================================================================================
 
 	protected:
 		std::shared_ptr<RHI_Device> m_rhiDevice;
@@ -145,6 +112,12 @@ namespace Directus
 		virtual bool API_CompileVertex(const std::string& filePath, Input_Layout inputLayout);
 		virtual bool API_CompilePixel(const std::string& filePath);
 		//====================================================================================
+		void Compile(const std::string& filePath, bool vertex, bool pixel, Input_Layout inputLayout);
+		void Compile_Async(const std::string& filePath, bool vertex, bool pixel, Input_Layout inputLayout, Context* context);
+		// Publishes freshly compiled objects, the ones they replace are released on the next publish (or destruction)
+		// since the render thread may still be about to bind them.
+		void PublishVertexShader(void* shader);
+		void PublishPixelShader(void* shader);
 		void CreateConstantBuffer(unsigned int size);
 
 		unsigned int m_bufferSize;	
@@ -155,12 +128,22 @@ namespace Directus
 		std::string m_profile;
 		std::map<std::string, std::string> m_macros;
 		std::shared_ptr<RHI_InputLayout> m_inputLayout;	
-		bool m_hasVertexShader		= false;
-		bool m_hasPixelShader		= false;
-		Shader_State m_shaderState	= Shader_Uninitialized;
+		std::vector<std::string> m_dependencies;
+		std::mutex m_mutex;
+		bool m_hasVertexShader						= false;
+		bool m_hasPixelShader						= false;
+		std::atomic<Shader_State> m_shaderState		= Shader_Uninitialized;
+		std::atomic<bool> m_compiling				= false;
+		// Last compilation, for Recompile_Async()
+		bool m_compiledVertex						= false;
+		bool m_compiledPixel						= false;
+		Input_Layout m_compiledInputLayout			= Input_NotAssigned;
+		static std::string m_cacheDirectory;
 
 		// D3D11
-		void* m_vertexShader	= nullptr;
-		void* m_pixelShader		= nullptr;
+		std::atomic<void*> m_vertexShader			= nullptr;
+		std::atomic<void*> m_pixelShader			= nullptr;
+		void* m_vertexShaderRetired					= nullptr;
+		void* m_pixelShaderRetired					= nullptr;
 	};
 }
\ No newline at end of file
@@ -87,10 +87,10 @@ namespace Directus
 			return false;
 		}
 
-		// Create shader resource
-		bool srvCreated = HasMipChain() ?
+		// Create shader resource (headless, the texture data is all there is)
+		bool srvCreated = !m_rhiDevice->IsInitialized() || (HasMipChain() ?
 			ShaderResource_Create2D(m_width, m_height, m_channels, m_format, m_mipChain) :
-			ShaderResource_Create2D(m_width, m_height, m_channels, m_format, m_mipChain.front(), m_needsMipChain);
+			ShaderResource_Create2D(m_width, m_height, m_channels, m_format, m_mipChain.front(), m_needsMipChain));
 
 		// Only clear texture bytes if that's an engine texture, if not, they are not serialized yet.
 		if (FileSystem::IsEngineTextureFile(filePath)) { ClearTextureBytes(); }
@@ -182,7 +182,7 @@ namespace Directus
 		// If the texture bits are not cleared, no loading will take place.
 		GetTextureBytes(&m_mipChain);
 
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, FileStreamCompression_High);
 		if (!file->IsOpen())
 			return false;
 
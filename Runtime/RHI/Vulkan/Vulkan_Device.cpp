@@ -323,7 +323,7 @@ namespace Directus
 		return true;
 	}
 
-	void RHI_Device::EventBegin(const std::string& name)
+	void RHI_Device::EventBegin(const char* name)
 	{
 		
 	}
@@ -373,6 +373,11 @@ namespace Directus
 		return true;
 	}
 
+	bool RHI_Device::Set_MaximumFrameLatency(unsigned int frames)
+	{
+		return true;
+	}
+
 	bool RHI_Device::Set_CullMode(Cull_Mode cullMode)
 	{
 		return true;
@@ -46,7 +46,7 @@ namespace Directus
 		const Matrix& mViewProjection_Orthographic,
 		const Matrix& mView,
 		const Matrix& mProjection,
-		const vector<Actor*>& lights,
+		const vector<RenderSnapshot_Light>& lights,
 		bool doSSR
 	)
 	{
@@ -84,15 +84,13 @@ namespace Directus
 		// Fill with directional lights
 		for (const auto& light : lights)
 		{
-			auto component = light->GetComponent<Light>();
-
-			if (component->GetLightType() != LightType_Directional)
+			if (light.type != LightType_Directional)
 				continue;
 
-			Vector3 direction = component->GetDirection();
+			const Vector3& direction = light.direction;
 
-			buffer->dirLightColor = component->GetColor();
-			buffer->dirLightIntensity = Vector4(component->GetIntensity());
+			buffer->dirLightColor = light.color;
+			buffer->dirLightIntensity = Vector4(light.intensity);
 			buffer->dirLightDirection = Vector4(direction.x, direction.y, direction.z, 0.0f);
 		}
 
@@ -100,16 +98,14 @@ namespace Directus
 		int pointIndex = 0;
 		for (const auto& light : lights)
 		{
-			auto component = light->GetComponent<Light>();
-
-			if (component->GetLightType() != LightType_Point)
+			if (light.type != LightType_Point)
 				continue;
 
-			Vector3 pos = light->GetTransform_PtrRaw()->GetPosition();
+			const Vector3& pos = light.position;
 
 			buffer->pointLightPosition[pointIndex]		= Vector4(pos.x, pos.y, pos.z, 1.0f);
-			buffer->pointLightColor[pointIndex]			= component->GetColor();
-			buffer->pointLightIntenRange[pointIndex]	= Vector4(component->GetIntensity(), component->GetRange(), 0.0f, 0.0f);
+			buffer->pointLightColor[pointIndex]			= light.color;
+			buffer->pointLightIntenRange[pointIndex]	= Vector4(light.intensity, light.range, 0.0f, 0.0f);
 
 			pointIndex++;
 		}
@@ -118,18 +114,16 @@ namespace Directus
 		int spotIndex = 0;
 		for (const auto& light : lights)
 		{
-			auto component = light->GetComponent<Light>();
-
-			if (component->GetLightType() != LightType_Spot)
+			if (light.type != LightType_Spot)
 				continue;
 
-			Vector3 direction	= component->GetDirection();
-			Vector3 pos			= light->GetTransform_PtrRaw()->GetPosition();
+			const Vector3& direction	= light.direction;
+			const Vector3& pos			= light.position;
 
-			buffer->spotLightColor[spotIndex]			= component->GetColor();
+			buffer->spotLightColor[spotIndex]			= light.color;
 			buffer->spotLightPosition[spotIndex]		= Vector4(pos.x, pos.y, pos.z, 1.0f);
 			buffer->spotLightDirection[spotIndex]		= Vector4(direction.x, direction.y, direction.z, 0.0f);
-			buffer->spotLightIntenRangeAngle[spotIndex] = Vector4(component->GetIntensity(), component->GetRange(), component->GetAngle(), 0.0f);
+			buffer->spotLightIntenRangeAngle[spotIndex] = Vector4(light.intensity, light.range, light.angle, 0.0f);
 
 			spotIndex++;
 		}
@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../World/Components/Light.h"
 #include "../../Resource/ResourceCache.h"
 #include "../../RHI/RHI_Shader.h"
+#include "../RenderSnapshot.h"
 //========================================
 
 namespace Directus
@@ -43,7 +44,7 @@ namespace Directus
 			const Math::Matrix& mViewProjection_Orthographic,
 			const Math::Matrix& mView,
 			const Math::Matrix& mProjection,
-			const std::vector<Actor*>& lights,
+			const std::vector<RenderSnapshot_Light>& lights,
 			bool doSSR
 		);
 
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ================================
 #include "ShaderVariation.h"
 #include "../Renderer.h"
+#include "../ShaderWatcher.h"
 #include "../Material.h"
 #include "../../RHI/RHI_Implementation.h"
 #include "../../RHI/RHI_Shader.h"
@@ -29,6 +30,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../World/Components/Transform.h"
 #include "../../World/Components/Camera.h"
 #include "../../Core/Settings.h"
+#include "../../Resource/ResourceCache.h"
+#include <fstream>
 //===========================================
 
 //= NAMESPACES ================
@@ -39,9 +42,14 @@ using namespace Directus::Math;
 namespace Directus
 {
 	vector<shared_ptr<ShaderVariation>> ShaderVariation::m_variations;
+	set<unsigned long> ShaderVariation::m_manifest;
+	bool ShaderVariation::m_manifestLoaded = false;
+	mutex ShaderVariation::m_mutex;
 
 	shared_ptr<ShaderVariation> ShaderVariation::GetMatchingShader(unsigned long flags)
 	{
+		lock_guard<mutex> lock(m_mutex);
+
 		for (const auto& shader : m_variations)
 		{
 			if (shader->GetShaderFlags() == flags)
@@ -51,6 +59,96 @@ namespace Directus
 		return nullptr;
 	}
 
+	void ShaderVariation::Precompile(const shared_ptr<RHI_Device>& device, Context* context, const string& filePath)
+	{
+		if (!device || !context)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Gather the variations of previous runs and of the currently loaded materials
+		set<unsigned long> flags;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			Manifest_Load();
+			flags = m_manifest;
+		}
+		for (const auto& resource : context->GetSubsystem<ResourceCache>()->GetByType(Resource_Material))
+		{
+			auto material = dynamic_pointer_cast<Material>(resource);
+			if (material && material->GetShader())
+			{
+				flags.insert(material->GetShader()->GetShaderFlags());
+			}
+		}
+
+		// Compile what's missing, each variation is a separate task on the thread pool
+		unsigned int count = 0;
+		for (const auto variationFlags : flags)
+		{
+			if (GetMatchingShader(variationFlags))
+				continue;
+
+			make_shared<ShaderVariation>(device, context)->Compile(filePath, variationFlags);
+			count++;
+		}
+
+		if (count != 0)
+		{
+			LOGF_INFO("Precompiling %d shader variations", count);
+		}
+	}
+
+	void ShaderVariation::Register(const shared_ptr<ShaderVariation>& variation)
+	{
+		// Hot reload
+		if (auto renderer = variation->m_context->GetSubsystem<Renderer>())
+		{
+			renderer->GetShaderWatcher()->Watch(variation);
+		}
+
+		lock_guard<mutex> lock(m_mutex);
+
+		m_variations.emplace_back(variation);
+
+		// Remember this variation, so the next run can compile it ahead of time
+		Manifest_Load();
+		if (!m_manifest.insert(variation->GetShaderFlags()).second)
+			return;
+
+		const string filePath = Manifest_GetFilePath();
+		if (filePath.empty())
+			return;
+
+		ofstream out(filePath, ios::out | ios::app);
+		if (out.good())
+		{
+			out << variation->GetShaderFlags() << endl;
+		}
+	}
+
+	string ShaderVariation::Manifest_GetFilePath()
+	{
+		const string& directory = RHI_Shader::Cache_GetDirectory();
+		return directory.empty() ? directory : directory + "ShaderVariations.txt";
+	}
+
+	void ShaderVariation::Manifest_Load()
+	{
+		const string filePath = Manifest_GetFilePath();
+		if (m_manifestLoaded || filePath.empty())
+			return;
+		m_manifestLoaded = true;
+
+		ifstream in(filePath, ios::in);
+		unsigned long flags = 0;
+		while (in >> flags)
+		{
+			m_manifest.insert(flags);
+		}
+	}
+
 	ShaderVariation::ShaderVariation(shared_ptr<RHI_Device> device, Context* context) : RHI_Shader(device)
 	{
 		m_context			= context;
@@ -74,10 +172,10 @@ namespace Directus
 		m_constantBuffer = make_shared<RHI_ConstantBuffer>(m_rhiDevice);
 		m_constantBuffer->Create(sizeof(PerObjectBufferType));
 
-		m_variations.emplace_back(shared_from_this());
+		Register(shared_from_this());
 	}
 
-	void ShaderVariation::UpdatePerObjectBuffer(Transform* transform, Material* material, const Matrix& mView, const Matrix mProjection)
+	void ShaderVariation::UpdatePerObjectBuffer(const Matrix& mModel, const Matrix& mMVP_current, const Matrix& mMVP_previous, Material* material)
 	{
 		if (!material)
 		{
@@ -88,8 +186,6 @@ namespace Directus
 		if (GetState() != Shader_Built)
 			return;
 
-		Matrix mMVP_current = transform->GetMatrix() * mView * mProjection;
-
 		// Determine if the material buffer needs to update
 		bool update = false;
 		update = perObjectBufferCPU.matAlbedo		!= material->GetColorAlbedo()				? true : update;
@@ -99,9 +195,9 @@ namespace Directus
 		update = perObjectBufferCPU.matMetallicMul	!= material->GetMetallicMultiplier()		? true : update;
 		update = perObjectBufferCPU.matNormalMul	!= material->GetNormalMultiplier()			? true : update;
 		update = perObjectBufferCPU.matShadingMode	!= float(material->GetShadingMode())		? true : update;
-		update = perObjectBufferCPU.mModel			!= transform->GetMatrix()					? true : update;
+		update = perObjectBufferCPU.mModel			!= mModel									? true : update;
 		update = perObjectBufferCPU.mMVP_current	!= mMVP_current								? true : update;
-		update = perObjectBufferCPU.mMVP_previous	!= transform->GetWVP_Previous()				? true : update;
+		update = perObjectBufferCPU.mMVP_previous	!= mMVP_previous							? true : update;
 
 		if (!update)
 			return;
@@ -117,13 +213,11 @@ namespace Directus
 		buffer->matHeightMul	= perObjectBufferCPU.matNormalMul		= material->GetHeightMultiplier();
 		buffer->matShadingMode	= perObjectBufferCPU.matShadingMode		= float(material->GetShadingMode());
 		buffer->padding			= perObjectBufferCPU.padding			= Vector3::Zero;
-		buffer->mModel			= perObjectBufferCPU.mModel				= transform->GetMatrix();
+		buffer->mModel			= perObjectBufferCPU.mModel				= mModel;
 		buffer->mMVP_current	= perObjectBufferCPU.mMVP_current		= mMVP_current;
-		buffer->mMVP_previous	= perObjectBufferCPU.mMVP_previous		= transform->GetWVP_Previous();
+		buffer->mMVP_previous	= perObjectBufferCPU.mMVP_previous		= mMVP_previous;
 		
 		m_constantBuffer->Unmap();
-
-		transform->SetWVP_Previous(mMVP_current);
 	}
 
 	void ShaderVariation::AddDefinesBasedOnMaterial()
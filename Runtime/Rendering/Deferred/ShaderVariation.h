@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include <memory>
 #include <vector>
+#include <set>
+#include <mutex>
 #include "../../Math/Vector2.h"
 #include "../../Math/Matrix.h"
 #include "../../RHI/RHI_Definition.h"
@@ -54,7 +56,7 @@ namespace Directus
 		~ShaderVariation();
 
 		void Compile(const std::string& filePath, unsigned long shaderFlags);
-		void UpdatePerObjectBuffer(Transform* transform, Material* material, const Math::Matrix& mView, const Math::Matrix mProjection);
+		void UpdatePerObjectBuffer(const Math::Matrix& mModel, const Math::Matrix& mMVP_current, const Math::Matrix& mMVP_previous, Material* material);
 
 		unsigned long GetShaderFlags()	{ return m_variationFlags; }
 		bool HasAlbedoTexture()			{ return m_variationFlags & Variation_Albedo; }
@@ -70,15 +72,25 @@ namespace Directus
 
 		// Variation cache
 		static std::shared_ptr<ShaderVariation> GetMatchingShader(unsigned long flags);
+		// Compiles, in parallel, every variation used by the loaded materials and by the materials of previous runs (see manifest)
+		static void Precompile(const std::shared_ptr<RHI_Device>& device, Context* context, const std::string& filePath);
 
 	private:
 		void AddDefinesBasedOnMaterial();
+		static void Register(const std::shared_ptr<ShaderVariation>& variation);
+
+		// Manifest, a list of every variation ever used, stored next to the shader bytecode cache
+		static std::string Manifest_GetFilePath();
+		static void Manifest_Load();
 		
 		Context* m_context;
 		unsigned long m_variationFlags;
 
 		// Variation cache
 		static std::vector<std::shared_ptr<ShaderVariation>> m_variations;
+		static std::set<unsigned long> m_manifest;
+		static bool m_manifestLoaded;
+		static std::mutex m_mutex;
 		
 		// BUFFER
 		struct PerObjectBufferType
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Renderer.h"
 #include "Deferred/ShaderVariation.h"
 #include "../RHI/RHI_Implementation.h"
+#include "../RHI/RHI_Device.h"
 #include "../Resource/ResourceCache.h"
 #include "../IO/XmlDocument.h"
 #include "../RHI/RHI_Texture.h"
@@ -201,6 +202,7 @@ namespace Directus
 		type = 
 			(type == TextureType_Normal && texture->GetGrayscale()) ? TextureType_Height :
 			(type == TextureType_Height && !texture->GetGrayscale()) ? TextureType_Normal : type;
+		m_isModified = true;
 
 		// Assign - As a replacement (if there is a previous one)
 		bool replaced = false;
@@ -299,6 +301,10 @@ namespace Directus
 		if (auto existingShader = ShaderVariation::GetMatchingShader(shaderFlags))
 			return existingShader;
 
+		// Headless, there is nothing to compile for
+		if (!m_rhiDevice->IsInitialized())
+			return nullptr;
+
 		// Create and compile shader
 		auto shader = make_shared<ShaderVariation>(m_rhiDevice, m_context);
 		shader->Compile(m_context->GetSubsystem<ResourceCache>()->GetStandardResourceDirectory(Resource_Shader) + "GBuffer.hlsl", shaderFlags);
@@ -308,6 +314,8 @@ namespace Directus
 
 	void Material::SetMultiplier(TextureType type, float value)
 	{
+		m_isModified = true;
+
 		if (type == TextureType_Roughness)
 		{
 			m_roughnessMultiplier = value;
@@ -103,31 +103,31 @@ namespace Directus
 
 		//= PROPERTIES =======================================================================
 		Cull_Mode GetCullMode()							{ return m_cullMode; }
-		void SetCullMode(Cull_Mode cullMode)			{ m_cullMode = cullMode; }
+		void SetCullMode(Cull_Mode cullMode)			{ m_cullMode = cullMode; m_isModified = true; }
 
 		float& GetRoughnessMultiplier()					{ return m_roughnessMultiplier; }
-		void SetRoughnessMultiplier(float roughness)	{ m_roughnessMultiplier = roughness; }
+		void SetRoughnessMultiplier(float roughness)	{ m_roughnessMultiplier = roughness; m_isModified = true; }
 
 		float GetMetallicMultiplier()					{ return m_metallicMultiplier; }
-		void SetMetallicMultiplier(float metallic)		{ m_metallicMultiplier = metallic; }
+		void SetMetallicMultiplier(float metallic)		{ m_metallicMultiplier = metallic; m_isModified = true; }
 
 		float GetNormalMultiplier()						{ return m_normalMultiplier; }
-		void SetNormalMultiplier(float normal)			{ m_normalMultiplier = normal; }
+		void SetNormalMultiplier(float normal)			{ m_normalMultiplier = normal; m_isModified = true; }
 
 		float GetHeightMultiplier()						{ return m_heightMultiplier; }
-		void SetHeightMultiplier(float height)			{ m_heightMultiplier = height; }
+		void SetHeightMultiplier(float height)			{ m_heightMultiplier = height; m_isModified = true; }
 
 		ShadingMode GetShadingMode()					{ return m_shadingMode; }
-		void SetShadingMode(ShadingMode shadingMode)	{ m_shadingMode = shadingMode; }
+		void SetShadingMode(ShadingMode shadingMode)	{ m_shadingMode = shadingMode; m_isModified = true; }
 
 		const Math::Vector4& GetColorAlbedo()			{ return m_colorAlbedo; }
-		void SetColorAlbedo(const Math::Vector4& color) { m_colorAlbedo = color; }
+		void SetColorAlbedo(const Math::Vector4& color) { m_colorAlbedo = color; m_isModified = true; }
 
 		const Math::Vector2& GetTiling()				{ return m_uvTiling; }
-		void SetTiling(const Math::Vector2& tiling)		{ m_uvTiling = tiling; }
+		void SetTiling(const Math::Vector2& tiling)		{ m_uvTiling = tiling; m_isModified = true; }
 
 		const Math::Vector2& GetOffset()				{ return m_uvOffset; }
-		void SetOffset(const Math::Vector2& offset)		{ m_uvOffset = offset; }
+		void SetOffset(const Math::Vector2& offset)		{ m_uvOffset = offset; m_isModified = true; }
 
 		bool IsEditable()								{ return m_isEditable; }
 		void SetIsEditable(bool isEditable)				{ m_isEditable = isEditable; }
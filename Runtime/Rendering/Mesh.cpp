@@ -51,7 +51,8 @@ namespace Directus
 
 	void Mesh::Geometry_Get(unsigned int indexOffset, unsigned int indexCount, unsigned int vertexOffset, unsigned vertexCount, vector<unsigned int>* indices, vector<RHI_Vertex_PosUvNorTan>* vertices)
 	{
-		if (indexOffset == 0 || indexCount == 0 || vertexOffset == 0 || vertexCount == 0 || !vertices || !indices)
+		// Offsets can legitimately be zero (first geometry in the mesh), counts can't
+		if (indexCount == 0 || vertexCount == 0 || !vertices || !indices || indexOffset + indexCount > m_indices.size() || vertexOffset + vertexCount > m_vertices.size())
 		{
 			LOG_ERROR("Mesh::Geometry_Get: Invalid parameters");
 			return;
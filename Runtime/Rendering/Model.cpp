@@ -31,6 +31,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
 #include "../RHI/RHI_Implementation.h"
+#include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_IndexBuffer.h"
 #include "../RHI/RHI_Texture.h"
@@ -96,7 +97,7 @@ namespace Directus
 
 	bool Model::SaveToFile(const string& filePath)
 	{
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, FileStreamCompression_High);
 		if (!file->IsOpen())
 			return false;
 
@@ -282,6 +283,10 @@ namespace Directus
 
 	bool Model::Geometry_CreateBuffers()
 	{
+		// Headless, the geometry only lives on the CPU
+		if (!m_rhiDevice->IsInitialized())
+			return true;
+
 		bool success = true;
 
 		// Get geometry
@@ -0,0 +1,415 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ===================================
+#include "OcclusionCulling.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <emmintrin.h>
+#include "Model.h"
+#include "../Core/Context.h"
+#include "../Threading/Threading.h"
+#include "../World/Actor.h"
+#include "../World/Components/Renderable.h"
+#include "../World/Components/Transform.h"
+#include "../Logging/Log.h"
+//==============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	// Vertices closer than this (in view space) aren't projected, their triangles are simply not used as occluders
+	static const float NEAR_W = 0.01f;
+
+	OcclusionCulling::OcclusionCulling(Context* context)
+	{
+		m_context	= context;
+		m_threading	= context->GetSubsystem<Threading>();
+		SetResolution(256, 128);
+	}
+
+	void OcclusionCulling::SetResolution(unsigned int width, unsigned int height)
+	{
+		if (width == 0 || height == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// The rasterizer works on 4 pixels at a time
+		m_width		= (width + 3) & ~3u;
+		m_height	= height;
+		m_valid		= false;
+
+		m_hiZ.clear();
+		unsigned int levelWidth		= m_width;
+		unsigned int levelHeight	= m_height;
+		while (true)
+		{
+			HiZ_Level level;
+			level.width		= levelWidth;
+			level.height	= levelHeight;
+			level.depth.resize(levelWidth * levelHeight, 0.0f);
+			m_hiZ.emplace_back(level);
+
+			if (levelWidth == 1 && levelHeight == 1)
+				break;
+
+			levelWidth	= max(1u, (levelWidth + 1) / 2);
+			levelHeight	= max(1u, (levelHeight + 1) / 2);
+		}
+	}
+
+	void OcclusionCulling::Render(const Matrix& view, const Matrix& projection, const vector<Actor*>& actors)
+	{
+		m_frame++;
+		m_valid			= false;
+		m_statOccluders	= 0;
+		m_statTriangles	= 0;
+		m_statTested	= 0;
+		m_statCulled	= 0;
+		m_viewProjection = view * projection;
+
+		// Pick the occluders, the bigger they appear on screen the better
+		vector<pair<float, Renderable*>> candidates;
+		for (const auto& actor : actors)
+		{
+			auto renderable = actor ? actor->GetRenderable_PtrRaw() : nullptr;
+			if (!renderable || !renderable->Geometry_Model())
+				continue;
+
+			if (renderable->Geometry_IndexCount() / 3 > m_occluderMaxTriangles)
+				continue;
+
+			BoundingBox box	= renderable->Geometry_AABB();
+			float distance	= (box.GetCenter() * view).Length();
+			float size		= box.GetExtents().Length() / max(distance, 0.001f);
+			if (size < m_occluderMinScreenSize)
+				continue;
+
+			candidates.emplace_back(size, renderable);
+		}
+		sort(candidates.begin(), candidates.end(), [](const pair<float, Renderable*>& a, const pair<float, Renderable*>& b) { return a.first > b.first; });
+		if (candidates.size() > m_occluderMaxCount)
+		{
+			candidates.resize(m_occluderMaxCount);
+		}
+
+		vector<pair<OccluderMesh*, Matrix>> occluders;
+		for (const auto& candidate : candidates)
+		{
+			if (auto mesh = GetOccluderMesh(candidate.second))
+			{
+				occluders.emplace_back(mesh, candidate.second->GetTransform()->GetMatrix() * m_viewProjection);
+			}
+		}
+
+		// Forget the geometry of renderables which haven't been occluders for a while
+		for (auto it = m_occluderMeshes.begin(); it != m_occluderMeshes.end();)
+		{
+			it = (m_frame - it->second.lastUsedFrame > 300) ? m_occluderMeshes.erase(it) : next(it);
+		}
+
+		// Set up screen space triangles, in parallel per occluder
+		vector<vector<Triangle>> triangles(occluders.size());
+		float width		= (float)m_width;
+		float height	= (float)m_height;
+		m_threading->ParallelFor((unsigned int)occluders.size(), [&occluders, &triangles, width, height](unsigned int index)
+		{
+			const auto& mesh	= *occluders[index].first;
+			const auto& wvp		= occluders[index].second;
+			auto& output		= triangles[index];
+
+			// Project each vertex once
+			vector<Vector4> clip(mesh.positions.size());
+			wvp.TransformPoints(mesh.positions.data(), clip.data(), (unsigned int)clip.size());
+			vector<Vector3> projected(mesh.positions.size());
+			for (unsigned int i = 0; i < (unsigned int)mesh.positions.size(); i++)
+			{
+				float x			= clip[i].x;
+				float y			= clip[i].y;
+				float w			= clip[i].w;
+				if (w < NEAR_W)
+				{
+					projected[i] = Vector3(0.0f, 0.0f, -1.0f);
+					continue;
+				}
+
+				float inverseW	= 1.0f / w;
+				projected[i]	= Vector3((x * inverseW * 0.5f + 0.5f) * width, (0.5f - y * inverseW * 0.5f) * height, inverseW);
+			}
+
+			output.reserve(mesh.indices.size() / 3);
+			for (unsigned int i = 0; i + 2 < (unsigned int)mesh.indices.size(); i += 3)
+			{
+				const auto& v0 = projected[mesh.indices[i]];
+				const auto& v1 = projected[mesh.indices[i + 1]];
+				const auto& v2 = projected[mesh.indices[i + 2]];
+
+				// Crosses the near plane
+				if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f)
+					continue;
+
+				// Off screen
+				if (max(max(v0.x, v1.x), v2.x) < 0.0f || min(min(v0.x, v1.x), v2.x) > width ||
+					max(max(v0.y, v1.y), v2.y) < 0.0f || min(min(v0.y, v1.y), v2.y) > height)
+					continue;
+
+				output.push_back({ { v0.x, v1.x, v2.x }, { v0.y, v1.y, v2.y }, { v0.z, v1.z, v2.z } });
+			}
+		});
+
+		m_triangles.clear();
+		for (const auto& occluderTriangles : triangles)
+		{
+			m_triangles.insert(m_triangles.end(), occluderTriangles.begin(), occluderTriangles.end());
+		}
+
+		// Rasterize, in parallel per band of rows
+		auto& depth = m_hiZ.front().depth;
+		fill(depth.begin(), depth.end(), 0.0f);
+		unsigned int bandCount	= max(1u, min(m_threading->GetThreadCount() + 1, m_height / 8));
+		unsigned int bandHeight	= (m_height + bandCount - 1) / bandCount;
+		m_threading->ParallelFor(bandCount, [this, bandHeight](unsigned int band)
+		{
+			unsigned int rowStart	= band * bandHeight;
+			unsigned int rowEnd		= min(m_height, rowStart + bandHeight);
+			for (const auto& triangle : m_triangles)
+			{
+				Rasterize(triangle, rowStart, rowEnd);
+			}
+		});
+
+		BuildHiZ();
+
+		m_statOccluders	= (unsigned int)occluders.size();
+		m_statTriangles	= (unsigned int)m_triangles.size();
+		m_valid			= true;
+	}
+
+	bool OcclusionCulling::IsOccluded(const BoundingBox& box)
+	{
+		return IsOccluded(box.GetMin(), box.GetMax());
+	}
+
+	bool OcclusionCulling::IsShadowOccluded(const BoundingBox& box, const Vector3& direction, float length)
+	{
+		// Sweep the box along the direction, the result bounds every surface the box can cast a shadow on
+		Vector3 offset	= direction * length;
+		Vector3 min		= box.GetMin();
+		Vector3 max		= box.GetMax();
+		min				= Vector3(std::min(min.x, min.x + offset.x), std::min(min.y, min.y + offset.y), std::min(min.z, min.z + offset.z));
+		max				= Vector3(std::max(max.x, max.x + offset.x), std::max(max.y, max.y + offset.y), std::max(max.z, max.z + offset.z));
+
+		return IsOccluded(min, max);
+	}
+
+	OcclusionCulling::OccluderMesh* OcclusionCulling::GetOccluderMesh(Renderable* renderable)
+	{
+		auto key	= make_tuple((void*)renderable->Geometry_Model().get(), renderable->Geometry_IndexOffset(), renderable->Geometry_IndexCount());
+		auto it		= m_occluderMeshes.find(key);
+		if (it == m_occluderMeshes.end())
+		{
+			vector<unsigned int> indices;
+			vector<RHI_Vertex_PosUvNorTan> vertices;
+			renderable->Geometry_Get(&indices, &vertices);
+
+			OccluderMesh mesh;
+			mesh.positions.reserve(vertices.size());
+			for (const auto& vertex : vertices)
+			{
+				mesh.positions.emplace_back(vertex.pos[0], vertex.pos[1], vertex.pos[2]);
+			}
+
+			// Drop triangles which reference vertices outside of this renderable's range
+			mesh.indices.reserve(indices.size());
+			for (unsigned int i = 0; i + 2 < (unsigned int)indices.size(); i += 3)
+			{
+				if (indices[i] < vertices.size() && indices[i + 1] < vertices.size() && indices[i + 2] < vertices.size())
+				{
+					mesh.indices.insert(mesh.indices.end(), { indices[i], indices[i + 1], indices[i + 2] });
+				}
+			}
+
+			it = m_occluderMeshes.emplace(key, move(mesh)).first;
+		}
+
+		it->second.lastUsedFrame = m_frame;
+		return it->second.indices.empty() ? nullptr : &it->second;
+	}
+
+	void OcclusionCulling::Rasterize(const Triangle& triangle, unsigned int rowStart, unsigned int rowEnd)
+	{
+		float x0 = triangle.x[0], y0 = triangle.y[0], z0 = triangle.z[0];
+		float x1 = triangle.x[1], y1 = triangle.y[1], z1 = triangle.z[1];
+		float x2 = triangle.x[2], y2 = triangle.y[2], z2 = triangle.z[2];
+
+		// Both windings are rasterized, make this one counter-clockwise
+		float area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+		if (fabs(area) < 1e-6f)
+			return;
+		if (area < 0.0f)
+		{
+			swap(x1, x2); swap(y1, y2); swap(z1, z2);
+			area = -area;
+		}
+
+		// Bounds, clipped to the screen and to this band
+		int minX = max(0,					(int)floor(min(min(x0, x1), x2)));
+		int maxX = min((int)m_width - 1,	(int)ceil(max(max(x0, x1), x2)));
+		int minY = max((int)rowStart,		(int)floor(min(min(y0, y1), y2)));
+		int maxY = min((int)rowEnd - 1,		(int)ceil(max(max(y0, y1), y2)));
+		if (minX > maxX || minY > maxY)
+			return;
+
+		// Edge functions, E(x, y) = A * x + B * y + C, positive inside
+		float a0 = y0 - y1, b0 = x1 - x0, c0 = -(a0 * x0 + b0 * y0);	// v0 -> v1
+		float a1 = y1 - y2, b1 = x2 - x1, c1 = -(a1 * x1 + b1 * y1);	// v1 -> v2
+		float a2 = y2 - y0, b2 = x0 - x2, c2 = -(a2 * x2 + b2 * y2);	// v2 -> v0
+
+		// Depth plane, from the barycentric weights (v0 is weighted by edge v1 -> v2 and so on)
+		float inverseArea	= 1.0f / area;
+		float za			= (a1 * z0 + a2 * z1 + a0 * z2) * inverseArea;
+		float zb			= (b1 * z0 + b2 * z1 + b0 * z2) * inverseArea;
+		float zc			= (c1 * z0 + c2 * z1 + c0 * z2) * inverseArea;
+
+		const __m128 offsets	= _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero		= _mm_setzero_ps();
+		const __m128 a0_4 = _mm_set1_ps(a0), a1_4 = _mm_set1_ps(a1), a2_4 = _mm_set1_ps(a2), za_4 = _mm_set1_ps(za);
+
+		float* depth	= m_hiZ.front().depth.data();
+		int startX		= minX & ~3;
+		for (int y = minY; y <= maxY; y++)
+		{
+			float py		= (float)y + 0.5f;
+			__m128 row0		= _mm_set1_ps(b0 * py + c0);
+			__m128 row1		= _mm_set1_ps(b1 * py + c1);
+			__m128 row2		= _mm_set1_ps(b2 * py + c2);
+			__m128 rowZ		= _mm_set1_ps(zb * py + zc);
+			float* rowDepth	= depth + y * m_width;
+
+			for (int x = startX; x <= maxX; x += 4)
+			{
+				__m128 px	= _mm_add_ps(_mm_set1_ps((float)x), offsets);
+				__m128 e0	= _mm_add_ps(_mm_mul_ps(a0_4, px), row0);
+				__m128 e1	= _mm_add_ps(_mm_mul_ps(a1_4, px), row1);
+				__m128 e2	= _mm_add_ps(_mm_mul_ps(a2_4, px), row2);
+				__m128 mask	= _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(mask) == 0)
+					continue;
+
+				__m128 z		= _mm_add_ps(_mm_mul_ps(za_4, px), rowZ);
+				__m128 current	= _mm_loadu_ps(rowDepth + x);
+				__m128 closest	= _mm_max_ps(current, z);
+				_mm_storeu_ps(rowDepth + x, _mm_or_ps(_mm_and_ps(mask, closest), _mm_andnot_ps(mask, current)));
+			}
+		}
+	}
+
+	void OcclusionCulling::BuildHiZ()
+	{
+		// Each texel keeps the farthest depth below it, so a box in front of it is in front of everything it covers
+		for (unsigned int i = 1; i < (unsigned int)m_hiZ.size(); i++)
+		{
+			const auto& source	= m_hiZ[i - 1];
+			auto& target		= m_hiZ[i];
+			for (unsigned int y = 0; y < target.height; y++)
+			{
+				unsigned int sy0 = min(y * 2, source.height - 1);
+				unsigned int sy1 = min(y * 2 + 1, source.height - 1);
+				for (unsigned int x = 0; x < target.width; x++)
+				{
+					unsigned int sx0 = min(x * 2, source.width - 1);
+					unsigned int sx1 = min(x * 2 + 1, source.width - 1);
+					target.depth[y * target.width + x] = min(
+						min(source.depth[sy0 * source.width + sx0], source.depth[sy0 * source.width + sx1]),
+						min(source.depth[sy1 * source.width + sx0], source.depth[sy1 * source.width + sx1])
+					);
+				}
+			}
+		}
+	}
+
+	bool OcclusionCulling::IsOccluded(const Vector3& min, const Vector3& max)
+	{
+		if (!m_valid)
+			return false;
+
+		m_statTested++;
+
+		// Project the corners, keeping the screen rectangle and the closest depth
+		const auto& vp	= m_viewProjection;
+		float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX, closest = 0.0f;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			Vector3 p = Vector3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+			float x = (p.x * vp.m00) + (p.y * vp.m10) + (p.z * vp.m20) + vp.m30;
+			float y = (p.x * vp.m01) + (p.y * vp.m11) + (p.z * vp.m21) + vp.m31;
+			float w = (p.x * vp.m03) + (p.y * vp.m13) + (p.z * vp.m23) + vp.m33;
+
+			// Touches the camera
+			if (w < NEAR_W)
+				return false;
+
+			float inverseW	= 1.0f / w;
+			float sx		= (x * inverseW * 0.5f + 0.5f) * m_width;
+			float sy		= (0.5f - y * inverseW * 0.5f) * m_height;
+			minX			= std::min(minX, sx);
+			maxX			= std::max(maxX, sx);
+			minY			= std::min(minY, sy);
+			maxY			= std::max(maxY, sy);
+			closest			= std::max(closest, inverseW);
+		}
+
+		// Off screen, that's for frustum culling to decide
+		if (maxX < 0.0f || maxY < 0.0f || minX >= (float)m_width || minY >= (float)m_height)
+			return false;
+
+		int x0 = std::max(0, (int)minX), x1 = std::min((int)m_width - 1, (int)maxX);
+		int y0 = std::max(0, (int)minY), y1 = std::min((int)m_height - 1, (int)maxY);
+
+		// Pick the level where the rectangle covers at most 4x4 texels
+		unsigned int level = 0;
+		while (level + 1 < (unsigned int)m_hiZ.size() && (((x1 >> level) - (x0 >> level)) > 3 || ((y1 >> level) - (y0 >> level)) > 3))
+		{
+			level++;
+		}
+
+		const auto& hiZ = m_hiZ[level];
+		for (int y = y0 >> level; y <= (y1 >> level); y++)
+		{
+			for (int x = x0 >> level; x <= (x1 >> level); x++)
+			{
+				if (hiZ.depth[y * hiZ.width + x] <= closest)
+					return false;
+			}
+		}
+
+		m_statCulled++;
+		return true;
+	}
+}
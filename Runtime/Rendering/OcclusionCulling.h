@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include <map>
+#include <tuple>
+#include "../Core/EngineDefs.h"
+#include "../Math/Matrix.h"
+#include "../Math/Vector3.h"
+#include "../Math/BoundingBox.h"
+//=================================
+
+namespace Directus
+{
+	class Context;
+	class Actor;
+	class Renderable;
+	class Threading;
+
+	// CPU occlusion culling. Every frame the largest (on screen) opaque renderables are rasterized,
+	// on the thread pool, into a small depth buffer. A hierarchical-Z of that buffer is then used to
+	// conservatively reject bounding boxes which are fully hidden behind those occluders.
+	// Nothing here touches the GPU.
+	class ENGINE_CLASS OcclusionCulling
+	{
+	public:
+		OcclusionCulling(Context* context);
+		~OcclusionCulling() = default;
+
+		// Picks occluders among the given actors, rasterizes them and builds the hierarchical-Z
+		void Render(const Math::Matrix& view, const Math::Matrix& projection, const std::vector<Actor*>& actors);
+		// Until the next Render(), nothing is considered occluded
+		void Invalidate() { m_valid = false; }
+		// True if the box is fully hidden behind the occluders of the last Render()
+		bool IsOccluded(const Math::BoundingBox& box);
+		// True if everything a box casts a shadow on, along direction (up to length), is hidden too
+		bool IsShadowOccluded(const Math::BoundingBox& box, const Math::Vector3& direction, float length);
+
+		//= SETTINGS ================================================================================
+		// The width is rounded up to a multiple of 4
+		void SetResolution(unsigned int width, unsigned int height);
+		void SetOccluderMaxCount(unsigned int count)			{ m_occluderMaxCount = count; }
+		// Occluders with more triangles than this are skipped (keeps the rasterizer cheap)
+		void SetOccluderMaxTriangles(unsigned int triangles)	{ m_occluderMaxTriangles = triangles; }
+		// Minimum ratio of an occluder's bounding radius to its distance from the camera
+		void SetOccluderMinScreenSize(float size)				{ m_occluderMinScreenSize = size; }
+		//===========================================================================================
+
+		//= STATS ==========================================================
+		unsigned int GetOccluderCount()		{ return m_statOccluders; }
+		unsigned int GetTriangleCount()		{ return m_statTriangles; }
+		unsigned int GetTestedCount()		{ return m_statTested; }
+		unsigned int GetCulledCount()		{ return m_statCulled; }
+		const std::vector<float>& GetDepth()	{ return m_hiZ.front().depth; }
+		//==================================================================
+
+	private:
+		struct Triangle
+		{
+			// Screen space x, y and 1/w (linear in screen space, bigger is closer)
+			float x[3];
+			float y[3];
+			float z[3];
+		};
+
+		struct OccluderMesh
+		{
+			std::vector<Math::Vector3> positions;
+			std::vector<unsigned int> indices;
+			uint64_t lastUsedFrame = 0;
+		};
+
+		struct HiZ_Level
+		{
+			unsigned int width	= 0;
+			unsigned int height	= 0;
+			std::vector<float> depth;
+		};
+
+		OccluderMesh* GetOccluderMesh(Renderable* renderable);
+		void Rasterize(const Triangle& triangle, unsigned int rowStart, unsigned int rowEnd);
+		void BuildHiZ();
+		bool IsOccluded(const Math::Vector3& min, const Math::Vector3& max);
+
+		Context* m_context;
+		Threading* m_threading;
+		Math::Matrix m_viewProjection;
+		std::vector<HiZ_Level> m_hiZ;
+		std::vector<Triangle> m_triangles;
+		// Keyed by model, index offset and index count, so instances share their occluder
+		std::map<std::tuple<void*, unsigned int, unsigned int>, OccluderMesh> m_occluderMeshes;
+		uint64_t m_frame				= 0;
+		bool m_valid					= false;
+		unsigned int m_width			= 0;
+		unsigned int m_height			= 0;
+		unsigned int m_occluderMaxCount			= 32;
+		unsigned int m_occluderMaxTriangles		= 4096;
+		float m_occluderMinScreenSize			= 0.1f;
+		unsigned int m_statOccluders	= 0;
+		unsigned int m_statTriangles	= 0;
+		unsigned int m_statTested		= 0;
+		unsigned int m_statCulled		= 0;
+	};
+}
@@ -0,0 +1,343 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "RenderGraph.h"
+#include <algorithm>
+#include "../RHI/RHI_RenderTexture.h"
+#include "../Logging/Log.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	uint64_t RenderGraph_Descriptor::GetSize() const
+	{
+		unsigned int bytesPerPixel = 0;
+		switch (format)
+		{
+			case Texture_Format_R8_UNORM:				bytesPerPixel = 1;	break;
+			case Texture_Format_R16_FLOAT:				bytesPerPixel = 2;	break;
+			case Texture_Format_R32_FLOAT:				bytesPerPixel = 4;	break;
+			case Texture_Format_D32_FLOAT:				bytesPerPixel = 4;	break;
+			case Texture_Format_R8G8_UNORM:				bytesPerPixel = 2;	break;
+			case Texture_Format_R16G16_FLOAT:			bytesPerPixel = 4;	break;
+			case Texture_Format_R32G32_FLOAT:			bytesPerPixel = 8;	break;
+			case Texture_Format_R32G32B32_FLOAT:		bytesPerPixel = 12;	break;
+			case Texture_Format_R8G8B8A8_UNORM:			bytesPerPixel = 4;	break;
+			case Texture_Format_R16G16B16A16_FLOAT:		bytesPerPixel = 8;	break;
+			case Texture_Format_R32G32B32A32_FLOAT:		bytesPerPixel = 16;	break;
+		}
+
+		return (uint64_t)width * (uint64_t)height * bytesPerPixel;
+	}
+
+	void RenderGraph::Clear()
+	{
+		m_resources.clear();
+		m_passes.clear();
+		m_slots.clear();
+		m_passesCulled		= 0;
+		m_memoryTransient	= 0;
+		m_memoryAliased		= 0;
+		m_compiled			= false;
+	}
+
+	//= RESOURCES ================================================================================================
+	RenderGraph_Resource RenderGraph::Resource_Create(const string& name, unsigned int width, unsigned int height, Texture_Format format)
+	{
+		Resource resource;
+		resource.name		= name;
+		resource.descriptor = RenderGraph_Descriptor(width, height, format);
+		m_resources.emplace_back(resource);
+
+		return (RenderGraph_Resource)(m_resources.size() - 1);
+	}
+
+	RenderGraph_Resource RenderGraph::Resource_Import(const string& name, shared_ptr<RHI_RenderTexture>* texture)
+	{
+		Resource resource;
+		resource.name		= name;
+		resource.imported	= texture;
+		resource.isImported	= true;
+		if (texture && *texture)
+		{
+			resource.descriptor = RenderGraph_Descriptor((*texture)->GetWidth(), (*texture)->GetHeight(), (*texture)->GetFormat());
+		}
+		m_resources.emplace_back(resource);
+
+		return (RenderGraph_Resource)(m_resources.size() - 1);
+	}
+
+	shared_ptr<RHI_RenderTexture>& RenderGraph::Resource_Get(RenderGraph_Resource resource)
+	{
+		if (resource >= m_resources.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return m_null;
+		}
+
+		auto& _resource = m_resources[resource];
+		if (_resource.isImported)
+			return _resource.imported ? *_resource.imported : m_null;
+
+		// Transient resources which ended up unused (e.g. written by a culled pass) have no physical render target
+		if (!_resource.used || _resource.slot >= m_pool.size())
+			return m_null;
+
+		return m_pool[_resource.slot];
+	}
+	//============================================================================================================
+
+	//= PASSES ===================================================================================================
+	unsigned int RenderGraph::Pass_Add(const string& name, function<void()>&& execute)
+	{
+		Pass pass;
+		pass.name		= name;
+		pass.execute	= move(execute);
+		m_passes.emplace_back(move(pass));
+
+		return (unsigned int)(m_passes.size() - 1);
+	}
+
+	void RenderGraph::Pass_Read(unsigned int pass, RenderGraph_Resource resource)
+	{
+		if (pass >= m_passes.size() || resource >= m_resources.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		m_passes[pass].reads.emplace_back(resource);
+	}
+
+	void RenderGraph::Pass_Write(unsigned int pass, RenderGraph_Resource resource)
+	{
+		if (pass >= m_passes.size() || resource >= m_resources.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		m_passes[pass].writes.emplace_back(resource);
+		m_resources[resource].writers.emplace_back(pass);
+	}
+
+	void RenderGraph::Pass_SetSideEffects(unsigned int pass, bool sideEffects)
+	{
+		if (pass >= m_passes.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		m_passes[pass].sideEffects = sideEffects;
+	}
+	//============================================================================================================
+
+	bool RenderGraph::Compile()
+	{
+		Cull();
+		ComputeLifetimes();
+		Alias();
+
+		m_compiled = true;
+		return true;
+	}
+
+	void RenderGraph::Allocate(const shared_ptr<RHI_Device>& rhiDevice)
+	{
+		if (!m_compiled || !rhiDevice)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		m_pool.resize(m_slots.size());
+		for (unsigned int i = 0; i < (unsigned int)m_slots.size(); i++)
+		{
+			auto& texture			= m_pool[i];
+			const auto& descriptor	= m_slots[i].descriptor;
+
+			// Re-use what the previous frame left in this slot, if compatible
+			if (texture && texture->GetWidth() == descriptor.width && texture->GetHeight() == descriptor.height && texture->GetFormat() == descriptor.format)
+				continue;
+
+			texture = make_shared<RHI_RenderTexture>(rhiDevice, descriptor.width, descriptor.height, descriptor.format);
+		}
+	}
+
+	void RenderGraph::Execute()
+	{
+		if (!m_compiled)
+		{
+			LOG_ERROR("The graph has to be compiled before it can be executed.");
+			return;
+		}
+
+		for (auto& pass : m_passes)
+		{
+			if (pass.culled || !pass.execute)
+				continue;
+
+			pass.execute();
+		}
+	}
+
+	void RenderGraph::Cull()
+	{
+		// Reference counts
+		for (auto& resource : m_resources)
+		{
+			resource.refCount = 0;
+		}
+
+		for (auto& pass : m_passes)
+		{
+			pass.culled		= false;
+			pass.refCount	= (unsigned int)pass.writes.size() + (pass.sideEffects ? 1 : 0);
+			for (const auto resource : pass.reads)
+			{
+				m_resources[resource].refCount++;
+			}
+		}
+
+		// Imported resources are consumed outside of the graph, so they are always referenced
+		vector<RenderGraph_Resource> unreferenced;
+		for (unsigned int i = 0; i < (unsigned int)m_resources.size(); i++)
+		{
+			auto& resource = m_resources[i];
+			resource.refCount += resource.isImported ? 1 : 0;
+			if (resource.refCount == 0)
+			{
+				unreferenced.emplace_back(i);
+			}
+		}
+
+		// Walk from unreferenced resources back to their writers, culling every pass which ends up with nothing to contribute
+		m_passesCulled = 0;
+		while (!unreferenced.empty())
+		{
+			auto& resource = m_resources[unreferenced.back()];
+			unreferenced.pop_back();
+
+			for (const auto writer : resource.writers)
+			{
+				auto& pass = m_passes[writer];
+				if (pass.culled || --pass.refCount != 0)
+					continue;
+
+				pass.culled = true;
+				m_passesCulled++;
+				for (const auto read : pass.reads)
+				{
+					if (--m_resources[read].refCount == 0)
+					{
+						unreferenced.emplace_back(read);
+					}
+				}
+			}
+		}
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		for (auto& resource : m_resources)
+		{
+			resource.used = false;
+		}
+
+		auto Use = [this](RenderGraph_Resource index, unsigned int passIndex)
+		{
+			auto& resource = m_resources[index];
+			if (!resource.used)
+			{
+				resource.used		= true;
+				resource.firstUse	= passIndex;
+			}
+			resource.lastUse = passIndex;
+		};
+
+		for (unsigned int i = 0; i < (unsigned int)m_passes.size(); i++)
+		{
+			const auto& pass = m_passes[i];
+			if (pass.culled)
+				continue;
+
+			for (const auto resource : pass.reads)	{ Use(resource, i); }
+			for (const auto resource : pass.writes)	{ Use(resource, i); }
+		}
+	}
+
+	void RenderGraph::Alias()
+	{
+		m_slots.clear();
+		m_memoryTransient	= 0;
+		m_memoryAliased		= 0;
+
+		// Visit transient resources in the order they come to life
+		vector<RenderGraph_Resource> transients;
+		for (unsigned int i = 0; i < (unsigned int)m_resources.size(); i++)
+		{
+			if (m_resources[i].used && !m_resources[i].isImported)
+			{
+				transients.emplace_back(i);
+			}
+		}
+		stable_sort(transients.begin(), transients.end(), [this](RenderGraph_Resource a, RenderGraph_Resource b)
+		{
+			return m_resources[a].firstUse < m_resources[b].firstUse;
+		});
+
+		// Greedy interval allocation, a slot can be re-used once the last resource that lived in it is dead
+		for (const auto index : transients)
+		{
+			auto& resource = m_resources[index];
+			m_memoryTransient += resource.descriptor.GetSize();
+
+			bool aliased = false;
+			for (unsigned int i = 0; i < (unsigned int)m_slots.size(); i++)
+			{
+				auto& slot = m_slots[i];
+				if (slot.descriptor == resource.descriptor && slot.lastUse < resource.firstUse)
+				{
+					slot.lastUse	= resource.lastUse;
+					resource.slot	= i;
+					aliased			= true;
+					break;
+				}
+			}
+
+			if (!aliased)
+			{
+				Slot slot;
+				slot.descriptor	= resource.descriptor;
+				slot.lastUse	= resource.lastUse;
+				m_slots.emplace_back(slot);
+				resource.slot = (unsigned int)(m_slots.size() - 1);
+				m_memoryAliased += slot.descriptor.GetSize();
+			}
+		}
+	}
+}
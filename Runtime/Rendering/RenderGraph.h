@@ -0,0 +1,153 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <memory>
+#include <vector>
+#include <string>
+#include <functional>
+#include "../Core/EngineDefs.h"
+#include "../RHI/RHI_Definition.h"
+//================================
+
+namespace Directus
+{
+	// A handle to a virtual resource, only valid for the graph that created it
+	typedef unsigned int RenderGraph_Resource;
+	static const RenderGraph_Resource RenderGraph_Resource_Invalid = 4294967295;
+
+	struct RenderGraph_Descriptor
+	{
+		RenderGraph_Descriptor() = default;
+		RenderGraph_Descriptor(unsigned int width, unsigned int height, Texture_Format format)
+		{
+			this->width		= width;
+			this->height	= height;
+			this->format	= format;
+		}
+
+		bool operator==(const RenderGraph_Descriptor& rhs) const { return width == rhs.width && height == rhs.height && format == rhs.format; }
+		uint64_t GetSize() const;
+
+		unsigned int width		= 0;
+		unsigned int height		= 0;
+		Texture_Format format	= Texture_Format_R8G8B8A8_UNORM;
+	};
+
+	// A frame graph. Passes declare which virtual resources they read and write, compilation
+	// culls passes that don't contribute to an imported resource, computes the lifetime of every
+	// transient resource and aliases non-overlapping transient resources into a shared pool.
+	// Compile() doesn't touch the GPU, only Allocate() does, so a graph can be built and compiled headlessly.
+	class ENGINE_CLASS RenderGraph
+	{
+	public:
+		RenderGraph() = default;
+		~RenderGraph() = default;
+
+		// Removes all passes and resources (the physical pool is kept so it can be re-used by the next frame)
+		void Clear();
+
+		//= RESOURCES =================================================================================================================
+		// A transient render target which only lives during the frame and can share memory with other transient render targets
+		RenderGraph_Resource Resource_Create(const std::string& name, unsigned int width, unsigned int height, Texture_Format format);
+		// A render target which is owned by the caller (can be null, in which case it's only used to express a dependency)
+		RenderGraph_Resource Resource_Import(const std::string& name, std::shared_ptr<RHI_RenderTexture>* texture);
+		// Returns the physical render target of a resource, only valid after Allocate()
+		std::shared_ptr<RHI_RenderTexture>& Resource_Get(RenderGraph_Resource resource);
+		//=============================================================================================================================
+
+		//= PASSES =======================================================================================
+		unsigned int Pass_Add(const std::string& name, std::function<void()>&& execute);
+		void Pass_Read(unsigned int pass, RenderGraph_Resource resource);
+		void Pass_Write(unsigned int pass, RenderGraph_Resource resource);
+		// A pass with side effects (e.g. outputs which the graph doesn't know about) is never culled
+		void Pass_SetSideEffects(unsigned int pass, bool sideEffects);
+		bool Pass_IsCulled(unsigned int pass) { return pass < m_passes.size() ? m_passes[pass].culled : true; }
+		//================================================================================================
+
+		// Culls, computes lifetimes and assigns every transient resource to a pool slot
+		bool Compile();
+		// Creates (or re-uses) the physical render targets the pool slots need
+		void Allocate(const std::shared_ptr<RHI_Device>& rhiDevice);
+		// Executes all the passes which survived culling, in declaration order
+		void Execute();
+
+		//= STATS =============================================================================
+		unsigned int GetPassCount()			{ return (unsigned int)m_passes.size(); }
+		unsigned int GetPassCulledCount()	{ return m_passesCulled; }
+		unsigned int GetResourceCount()		{ return (unsigned int)m_resources.size(); }
+		unsigned int GetPoolSlotCount()		{ return (unsigned int)m_slots.size(); }
+		// Transient memory required if every transient resource had its own render target
+		uint64_t GetMemoryTransient()		{ return m_memoryTransient; }
+		// Transient memory actually required after aliasing
+		uint64_t GetMemoryAliased()			{ return m_memoryAliased; }
+		//=====================================================================================
+
+	private:
+		struct Resource
+		{
+			std::string name;
+			RenderGraph_Descriptor descriptor;
+			std::shared_ptr<RHI_RenderTexture>* imported	= nullptr;
+			bool isImported									= false;
+			std::vector<unsigned int> writers;
+			unsigned int refCount							= 0;
+			unsigned int firstUse							= 0;
+			unsigned int lastUse							= 0;
+			unsigned int slot								= 0;
+			bool used										= false;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			std::function<void()> execute;
+			std::vector<RenderGraph_Resource> reads;
+			std::vector<RenderGraph_Resource> writes;
+			bool sideEffects		= false;
+			bool culled				= false;
+			unsigned int refCount	= 0;
+		};
+
+		struct Slot
+		{
+			RenderGraph_Descriptor descriptor;
+			unsigned int lastUse = 0;
+		};
+
+		void Cull();
+		void ComputeLifetimes();
+		void Alias();
+
+		std::vector<Resource> m_resources;
+		std::vector<Pass> m_passes;
+		std::vector<Slot> m_slots;
+		// Physical pool, persists across frames
+		std::vector<std::shared_ptr<RHI_RenderTexture>> m_pool;
+		std::shared_ptr<RHI_RenderTexture> m_null;
+		unsigned int m_passesCulled	= 0;
+		uint64_t m_memoryTransient	= 0;
+		uint64_t m_memoryAliased	= 0;
+		bool m_compiled				= false;
+	};
+}
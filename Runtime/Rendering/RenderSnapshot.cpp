@@ -0,0 +1,158 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ================
+#include "RenderSnapshot.h"
+//===========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	void RenderSnapshot::Clear()
+	{
+		// Keep the capacity of the vectors, the slot will be written again
+		opaque.clear();
+		transparent.clear();
+		lights.clear();
+		lines.clear();
+		metrics.clear();
+		skybox				= nullptr;
+		hasCamera			= false;
+		lightDirectional	= -1;
+		transformGizmo		= false;
+
+		// Only the writer clears, once the reader is done with the slot, so nothing points into the arena anymore
+		if (!arena)
+		{
+			arena = make_unique<Frame_Arena>(64 * 1024);
+		}
+		arena->Reset();
+	}
+
+	RenderSnapshot_Pipeline::RenderSnapshot_Pipeline(unsigned int depth /*= 1*/)
+	{
+		m_depth = depth < 1 ? 1 : depth;
+		m_slots.resize(m_depth + 1);
+	}
+
+	RenderSnapshot* RenderSnapshot_Pipeline::Write_Begin()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_condition.wait(lock, [this] { return m_published < m_depth || m_stopped; });
+		if (m_stopped)
+			return nullptr;
+
+		// The slot after the published ones, the reader advancing doesn't move it
+		auto& snapshot = m_slots[(m_read + m_published) % m_slots.size()];
+		m_writing = true;
+		snapshot.Clear();
+		return &snapshot;
+	}
+
+	void RenderSnapshot_Pipeline::Write_End()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (!m_writing)
+				return;
+
+			m_writing = false;
+			m_published++;
+		}
+		m_condition.notify_all();
+	}
+
+	void RenderSnapshot_Pipeline::Flush()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_condition.wait(lock, [this] { return m_published == 0 || m_stopped; });
+	}
+
+	void RenderSnapshot_Pipeline::SetDepth(unsigned int depth)
+	{
+		depth = depth < 1 ? 1 : depth;
+		if (depth == m_depth)
+			return;
+
+		Flush();
+
+		lock_guard<mutex> lock(m_mutex);
+		m_depth		= depth;
+		m_read		= 0;
+		m_published	= 0;
+		m_slots.resize(m_depth + 1);
+	}
+
+	const RenderSnapshot* RenderSnapshot_Pipeline::Read_Begin()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_condition.wait(lock, [this] { return m_published != 0 || m_stopped; });
+		return m_published != 0 ? &m_slots[m_read] : nullptr;
+	}
+
+	void RenderSnapshot_Pipeline::Read_End(const Profiler_RenderStats* stats /*= nullptr*/)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_published == 0)
+				return;
+
+			m_read = (m_read + 1) % (unsigned int)m_slots.size();
+			m_published--;
+
+			if (stats)
+			{
+				m_stats		= *stats;
+				m_statsNew	= true;
+			}
+		}
+		m_condition.notify_all();
+	}
+
+	bool RenderSnapshot_Pipeline::GetStats(Profiler_RenderStats* stats)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_statsNew || !stats)
+			return false;
+
+		*stats		= m_stats;
+		m_statsNew	= false;
+		return true;
+	}
+
+	void RenderSnapshot_Pipeline::Stop()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopped = true;
+		}
+		m_condition.notify_all();
+	}
+
+	unsigned int RenderSnapshot_Pipeline::GetPublishedCount()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_published;
+	}
+}
@@ -0,0 +1,190 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===========================
+#include <memory>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include "../Core/EngineDefs.h"
+#include "../Core/Allocators.h"
+#include "../Math/Matrix.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector3.h"
+#include "../Math/Vector4.h"
+#include "../RHI/RHI_Definition.h"
+#include "../RHI/RHI_Vertex.h"
+#include "../World/Components/Light.h"
+#include "../Profiling/Profiler.h"
+//======================================
+
+namespace Directus
+{
+	class Model;
+	class Material;
+
+	struct RenderSnapshot_Renderable
+	{
+		std::shared_ptr<Model> model;
+		std::shared_ptr<Material> material;
+		Math::Matrix transform;
+		Math::Matrix mvpCurrent;
+		Math::Matrix mvpPrevious;
+		unsigned int indexOffset	= 0;
+		unsigned int indexCount		= 0;
+		unsigned int vertexOffset	= 0;
+		bool castShadows			= false;
+		// Inside the view frustum and not hidden behind occluders
+		bool visible				= false;
+		// Could cast a shadow on something the camera can see
+		bool shadowVisible			= false;
+	};
+
+	struct RenderSnapshot_Light
+	{
+		static const unsigned int cascadeCount = 3;
+
+		LightType type					= LightType_Point;
+		Math::Vector3 position;
+		Math::Vector3 direction;
+		Math::Vector4 color;
+		float intensity					= 0.0f;
+		float range						= 0.0f;
+		float angle						= 0.0f;
+		float bias						= 0.0f;
+		float normalBias				= 0.0f;
+		bool castShadows				= false;
+		Math::Matrix view;
+		Math::Matrix shadowProjection[cascadeCount];
+		std::shared_ptr<RHI_RenderTexture> shadowMap;
+		// Gizmo, only valid when gizmoVisible is true
+		bool gizmoVisible				= false;
+		Math::Vector2 gizmoScreenPosition;
+		float gizmoScale				= 0.0f;
+	};
+
+	struct RenderSnapshot_Camera
+	{
+		Math::Matrix view;
+		Math::Matrix viewBase;
+		// Jittered when TAA is enabled
+		Math::Matrix projection;
+		Math::Matrix projectionOrthographic;
+		Math::Matrix viewProjection;
+		Math::Matrix viewProjectionOrthographic;
+		Math::Vector3 position;
+		Math::Vector4 clearColor;
+		float nearPlane	= 0.0f;
+		float farPlane	= 0.0f;
+		Math::Vector2 taaJitter;
+		Math::Vector2 taaJitterPrevious;
+	};
+
+	// Everything the render passes need to draw a frame, copied out of the world by the simulation thread.
+	// Once published it's immutable, so it can be consumed by another thread while the world moves on.
+	struct RenderSnapshot
+	{
+		void Clear();
+
+		uint64_t frame		= 0;
+		// Render mode flags
+		unsigned long flags	= 0;
+		unsigned int width	= 0;
+		unsigned int height	= 0;
+		// False if there is no camera, in which case nothing else is valid
+		bool hasCamera		= false;
+		RenderSnapshot_Camera camera;
+		std::vector<RenderSnapshot_Renderable> opaque;
+		std::vector<RenderSnapshot_Renderable> transparent;
+		std::vector<RenderSnapshot_Light> lights;
+		// Index into lights, -1 if there is no directional light
+		int lightDirectional = -1;
+		std::shared_ptr<RHI_Texture> skybox;
+		// Scratch memory of the thread which draws the snapshot, it's reset when the slot is written again
+		std::unique_ptr<Frame_Arena> arena;
+
+		//= EDITOR ===========================================
+		std::vector<RHI_Vertex_PosCol> lines;
+		Math::Matrix gridTransform;
+		bool transformGizmo = false;
+		Math::Matrix transformGizmoHandles[3];
+		Math::Vector3 transformGizmoColors[3];
+		Math::Vector2 metricsPosition;
+		std::string metrics;
+		//====================================================
+
+		bool Flags_IsSet(unsigned long flag) const				{ return flags & flag; }
+		const RenderSnapshot_Light* GetLightDirectional() const	{ return lightDirectional != -1 ? &lights[lightDirectional] : nullptr; }
+	};
+
+	// A bounded queue of snapshots between the simulation thread (the only writer) and the
+	// render thread (the only reader). The writer can be at most "depth" published frames ahead
+	// of the reader, a depth of 1 is classic double buffering. Slots are recycled, so after the
+	// first few frames the snapshot vectors don't allocate. Nothing here touches the GPU.
+	class ENGINE_CLASS RenderSnapshot_Pipeline
+	{
+	public:
+		RenderSnapshot_Pipeline(unsigned int depth = 1);
+		~RenderSnapshot_Pipeline() = default;
+
+		//= WRITER =======================================================================
+		// Blocks while the pipeline is full, returns null once stopped
+		RenderSnapshot* Write_Begin();
+		// Publishes the snapshot returned by Write_Begin()
+		void Write_End();
+		// Blocks until every published snapshot has been consumed
+		void Flush();
+		// Flushes and resizes, only call it from the writer
+		void SetDepth(unsigned int depth);
+		unsigned int GetDepth() { return m_depth; }
+		//================================================================================
+
+		//= READER ==============================================================================
+		// Blocks until a snapshot is published, returns null once stopped and drained
+		const RenderSnapshot* Read_Begin();
+		// Releases the snapshot returned by Read_Begin(), so the writer can re-use its slot.
+		// The stats counted while drawing it (if any) are handed over to the writer.
+		void Read_End(const Profiler_RenderStats* stats = nullptr);
+		//=======================================================================================
+
+		// Writer side, returns true (and copies them) if the reader handed over new stats
+		bool GetStats(Profiler_RenderStats* stats);
+
+		// Wakes up both sides, further writes fail and reads fail once drained
+		void Stop();
+		unsigned int GetPublishedCount();
+
+	private:
+		std::vector<RenderSnapshot> m_slots;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		unsigned int m_depth		= 1;
+		unsigned int m_read			= 0;
+		unsigned int m_published	= 0;
+		bool m_writing				= false;
+		bool m_stopped				= false;
+		Profiler_RenderStats m_stats;
+		bool m_statsNew				= false;
+	};
+}
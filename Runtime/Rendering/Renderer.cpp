@@ -22,6 +22,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==============================
 #include "Renderer.h"
 #include "Rectangle.h"
+#include "RenderGraph.h"
+#include "RenderSnapshot.h"
+#include "ShaderWatcher.h"
+#include "OcclusionCulling.h"
 #include "Gizmos/Grid.h"
 #include "Gizmos/Transform_Gizmo.h"
 #include "Deferred/ShaderVariation.h"
@@ -44,6 +48,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Physics/PhysicsDebugDraw.h"
 #include "../Profiling/Profiler.h"
 #include "../Core/Context.h"
+#include "../Core/Engine.h"
+#include "../Core/Allocators.h"
 #include "../Math/BoundingBox.h"
 #include "../RHI/RHI_ConstantBuffer.h"
 //=========================================
@@ -82,22 +88,39 @@ namespace Directus
 		m_flags			|= Render_PostProcess_TAA;
 		m_flags			|= Render_PostProcess_Sharpening;
 		m_flags			|= Render_PostProcess_Dithering;
+		m_flags			|= Render_OcclusionCulling;
 		//m_flags		|= Render_PostProcess_ChromaticAberration;	// Disabled by default: It doesn't improve the image quality, it's more of a stylistic effect
 		//m_flags		|= Render_PostProcess_SSR;					// Disabled by default: Only plays nice if it has environmental probes for fallback
 		//m_flags		|= Render_PostProcess_FXAA;					// Disabled by default: TAA is superior
 		
 
-		// Create RHI device
-		m_rhiDevice		= make_shared<RHI_Device>(drawHandle);
+		// Headless, nothing is drawn, so debug geometry shouldn't be accumulated either
+		if (Engine::EngineMode_IsSet(Engine_Headless))
+		{
+			m_flags &= ~(Render_Gizmo_Transform | Render_Gizmo_Grid | Render_Gizmo_Lights | Render_Gizmo_Physics);
+		}
+
+		// Create RHI device (without a draw handle it stays uninitialized, which is what headless runs want)
+		m_rhiDevice		= make_shared<RHI_Device>(Engine::EngineMode_IsSet(Engine_Headless) ? nullptr : drawHandle);
 		m_rhiPipeline	= make_shared<RHI_Pipeline>(m_rhiDevice);
+		m_renderGraph	= make_unique<RenderGraph>();
+		m_snapshots		= make_unique<RenderSnapshot_Pipeline>();
+		m_shaderWatcher	= make_unique<ShaderWatcher>(m_context);
 
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(EVENT_RENDER, EVENT_HANDLER(Render));
-		SUBSCRIBE_TO_EVENT(EVENT_WORLD_SUBMIT, EVENT_HANDLER_VARIANT(Renderables_Acquire));
+		EventSystem::Get().Subscribe<Event_WorldSubmit>([this](const vector<shared_ptr<Actor>>& actors) { Renderables_Acquire(actors); });
 	}
 
 	Renderer::~Renderer()
 	{
+		// Let the render thread draw what's already published and exit
+		if (m_renderThread.joinable())
+		{
+			m_snapshots->Stop();
+			m_renderThread.join();
+		}
+
 		m_actors.clear();
 		m_camera = nullptr;
 	}
@@ -108,6 +131,13 @@ namespace Directus
 		g_resourceCache	= m_context->GetSubsystem<ResourceCache>();
 		m_viewport		= make_shared<RHI_Viewport>();
 
+		// Needs the Threading subsystem
+		m_occlusionCulling = make_unique<OcclusionCulling>(m_context);
+
+		// Headless, only the CPU-side work runs, so there are no GPU resources to create
+		if (Engine::EngineMode_IsSet(Engine_Headless))
+			return true;
+
 		// Editor specific
 		m_grid				= make_unique<Grid>(m_rhiDevice);
 		m_transformGizmo	= make_unique<Transform_Gizmo>(m_context);
@@ -123,14 +153,15 @@ namespace Directus
 		CreateSamplers();
 		CreateTextures();
 
-		// PIPELINE STATES - EXPERIMENTAL
-		m_pipelineLine.primitiveTopology	= PrimitiveTopology_LineList;
-		m_pipelineLine.cullMode				= Cull_Back;
-		m_pipelineLine.fillMode				= Fill_Solid;
-		m_pipelineLine.vertexShader			= m_shaderColor;
-		m_pipelineLine.pixelShader			= m_shaderColor;
-		m_pipelineLine.constantBuffer		= m_shaderColor->GetConstantBuffer();
-		m_pipelineLine.sampler				= m_samplerPointClamp;
+		// Pipeline states
+		m_pipelineLine = m_rhiPipeline->State_Get(m_shaderColor, m_shaderColor, PrimitiveTopology_LineList, Cull_Back, Fill_Solid, true);
+
+		// From now on, the simulation thread only captures snapshots and this thread draws them
+		if (Engine::EngineMode_IsSet(Engine_RenderThread))
+		{
+			m_snapshots->SetDepth(Settings::Get().FPS_GetMaxFramesInFlight());
+			m_renderThread = thread(&Renderer::RenderThread_Loop, this);
+		}
 
 		return true;
 	}
@@ -189,20 +220,10 @@ namespace Directus
 		m_quad		= make_unique<Rectangle>(m_context);
 		m_quad->Create(0, 0, (float)width, (float)height);
 
-		// Full res
-		m_renderTexFull_HDR_Light	= make_unique<RHI_RenderTexture>(m_rhiDevice, width, height, Texture_Format_R32G32B32A32_FLOAT);
+		// Full res (only what has to persist across frames, the rest is transient and allocated by the render graph)
 		m_renderTexFull_HDR_Light2	= make_unique<RHI_RenderTexture>(m_rhiDevice, width, height, Texture_Format_R32G32B32A32_FLOAT);
 		m_renderTexFull_TAA_Current = make_unique<RHI_RenderTexture>(m_rhiDevice, width, height, Texture_Format_R16G16B16A16_FLOAT);
 		m_renderTexFull_TAA_History = make_unique<RHI_RenderTexture>(m_rhiDevice, width, height, Texture_Format_R16G16B16A16_FLOAT);
-
-		// Half res
-		m_renderTexHalf_Shadows = make_unique<RHI_RenderTexture>(m_rhiDevice, width / 2, height / 2, Texture_Format_R8_UNORM);
-		m_renderTexHalf_SSAO	= make_unique<RHI_RenderTexture>(m_rhiDevice, width / 2, height / 2, Texture_Format_R8_UNORM);
-		m_renderTexHalf_Spare	= make_unique<RHI_RenderTexture>(m_rhiDevice, width / 2, height / 2, Texture_Format_R8_UNORM);
-
-		// Quarter res
-		m_renderTexQuarter_Blur1 = make_unique<RHI_RenderTexture>(m_rhiDevice, width / 4, height / 4, Texture_Format_R16G16B16A16_FLOAT);
-		m_renderTexQuarter_Blur2 = make_unique<RHI_RenderTexture>(m_rhiDevice, width / 4, height / 4, Texture_Format_R16G16B16A16_FLOAT);
 	}
 
 	void Renderer::CreateShaders()
@@ -210,126 +231,154 @@ namespace Directus
 		// Get standard shader directory
 		string shaderDirectory = g_resourceCache->GetStandardResourceDirectory(Resource_Shader);
 
+		// Compiled bytecode is cached on disk, so subsequent runs can skip compilation
+		RHI_Shader::Cache_SetDirectory(shaderDirectory + "Cache//");
+
 		// G-Buffer
 		m_shaderGBuffer = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderGBuffer->CompileVertex(shaderDirectory + "GBuffer.hlsl", Input_PositionTextureNormalTangent);
+		m_shaderGBuffer->CompileVertex_Async(shaderDirectory + "GBuffer.hlsl", Input_PositionTextureNormalTangent, m_context);
 
 		// Light
 		m_shaderLight = make_shared<LightShader>(m_rhiDevice);
-		m_shaderLight->CompileVertexPixel(shaderDirectory + "Light.hlsl", Input_PositionTexture);
+		m_shaderLight->CompileVertexPixel_Async(shaderDirectory + "Light.hlsl", Input_PositionTexture, m_context);
 
 		// Transparent
 		m_shaderTransparent = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderTransparent->CompileVertexPixel(shaderDirectory + "Transparent.hlsl", Input_PositionTextureNormalTangent);
+		m_shaderTransparent->CompileVertexPixel_Async(shaderDirectory + "Transparent.hlsl", Input_PositionTextureNormalTangent, m_context);
 		m_shaderTransparent->AddBuffer<Struct_Transparency>();
 
 		// Depth
 		m_shaderLightDepth = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderLightDepth->CompileVertexPixel(shaderDirectory + "ShadowingDepth.hlsl", Input_Position);
+		m_shaderLightDepth->CompileVertexPixel_Async(shaderDirectory + "ShadowingDepth.hlsl", Input_Position, m_context);
 
 		// Font
 		m_shaderFont = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderFont->CompileVertexPixel(shaderDirectory + "Font.hlsl", Input_PositionTexture);
+		m_shaderFont->CompileVertexPixel_Async(shaderDirectory + "Font.hlsl", Input_PositionTexture, m_context);
 		m_shaderFont->AddBuffer<Struct_Matrix_Vector4>();
 
 		// Transform gizmo
 		m_shaderTransformGizmo = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderTransformGizmo->CompileVertexPixel(shaderDirectory + "TransformGizmo.hlsl", Input_PositionTextureNormalTangent);
+		m_shaderTransformGizmo->CompileVertexPixel_Async(shaderDirectory + "TransformGizmo.hlsl", Input_PositionTextureNormalTangent, m_context);
 		m_shaderTransformGizmo->AddBuffer<Struct_Matrix_Vector3>();
 
 		// SSAO
 		m_shaderSSAO = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderSSAO->CompileVertexPixel(shaderDirectory + "SSAO.hlsl", Input_PositionTexture);
+		m_shaderSSAO->CompileVertexPixel_Async(shaderDirectory + "SSAO.hlsl", Input_PositionTexture, m_context);
 		m_shaderSSAO->AddBuffer<Struct_Matrix_Matrix>();
 
 		// Shadow mapping
 		m_shaderShadowMapping = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderShadowMapping->CompileVertexPixel(shaderDirectory + "ShadowMapping.hlsl", Input_PositionTexture);
+		m_shaderShadowMapping->CompileVertexPixel_Async(shaderDirectory + "ShadowMapping.hlsl", Input_PositionTexture, m_context);
 		m_shaderShadowMapping->AddBuffer<Struct_ShadowMapping>();
 
 		// Color
 		m_shaderColor = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderColor->CompileVertexPixel(shaderDirectory + "Color.hlsl", Input_PositionColor);
+		m_shaderColor->CompileVertexPixel_Async(shaderDirectory + "Color.hlsl", Input_PositionColor, m_context);
 		m_shaderColor->AddBuffer<Struct_Matrix_Matrix>();
 
 		// Quad
 		m_shaderQuad = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderQuad->CompileVertexPixel(shaderDirectory + "Quad.hlsl", Input_PositionTexture);
+		m_shaderQuad->CompileVertexPixel_Async(shaderDirectory + "Quad.hlsl", Input_PositionTexture, m_context);
 
 		// Texture
 		m_shaderQuad_texture = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_texture->AddDefine("PASS_TEXTURE");
-		m_shaderQuad_texture->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_texture->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// FXAA
 		m_shaderQuad_fxaa = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_fxaa->AddDefine("PASS_FXAA");
-		m_shaderQuad_fxaa->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_fxaa->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Luma
 		m_shaderQuad_luma = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_luma->AddDefine("PASS_LUMA");
-		m_shaderQuad_luma->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_luma->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Sharpening
 		m_shaderQuad_sharpening = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_sharpening->AddDefine("PASS_SHARPENING");
-		m_shaderQuad_sharpening->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_sharpening->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Chromatic aberration
 		m_shaderQuad_chromaticAberration = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_chromaticAberration->AddDefine("PASS_CHROMATIC_ABERRATION");
-		m_shaderQuad_chromaticAberration->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_chromaticAberration->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Blur Box
 		m_shaderQuad_blur_box = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_blur_box->AddDefine("PASS_BLUR_BOX");
-		m_shaderQuad_blur_box->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_blur_box->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Blur Gaussian Horizontal
 		m_shaderQuad_blur_gaussian = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_blur_gaussian->AddDefine("PASS_BLUR_GAUSSIAN");
-		m_shaderQuad_blur_gaussian->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_blur_gaussian->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Blur Bilateral Gaussian Horizontal
 		m_shaderQuad_blur_gaussianBilateral = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_blur_gaussianBilateral->AddDefine("PASS_BLUR_BILATERAL_GAUSSIAN");
-		m_shaderQuad_blur_gaussianBilateral->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_blur_gaussianBilateral->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Bloom - bright
 		m_shaderQuad_bloomBright = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_bloomBright->AddDefine("PASS_BRIGHT");
-		m_shaderQuad_bloomBright->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_bloomBright->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Bloom - blend
 		m_shaderQuad_bloomBLend = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_bloomBLend->AddDefine("PASS_BLEND_ADDITIVE");
-		m_shaderQuad_bloomBLend->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_bloomBLend->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Tone-mapping
 		m_shaderQuad_toneMapping = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_toneMapping->AddDefine("PASS_TONEMAPPING");
-		m_shaderQuad_toneMapping->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_toneMapping->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Gamma correction
 		m_shaderQuad_gammaCorrection = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_gammaCorrection->AddDefine("PASS_GAMMA_CORRECTION");
-		m_shaderQuad_gammaCorrection->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_gammaCorrection->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// TAA
 		m_shaderQuad_taa = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_taa->AddDefine("PASS_TAA_RESOLVE");
-		m_shaderQuad_taa->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_taa->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Motion Blur
 		m_shaderQuad_motionBlur = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_motionBlur->AddDefine("PASS_MOTION_BLUR");
-		m_shaderQuad_motionBlur->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_motionBlur->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
 
 		// Dithering
 		m_shaderQuad_dithering = make_shared<RHI_Shader>(m_rhiDevice);
 		m_shaderQuad_dithering->AddDefine("PASS_DITHERING");
-		m_shaderQuad_dithering->CompilePixel(shaderDirectory + "Quad.hlsl");
+		m_shaderQuad_dithering->CompilePixel_Async(shaderDirectory + "Quad.hlsl", m_context);
+
+		// G-Buffer fallback (no textures), used while a material's own variation compiles
+		m_shaderVariationFallback = make_shared<ShaderVariation>(m_rhiDevice, m_context);
+		m_shaderVariationFallback->Compile(shaderDirectory + "GBuffer.hlsl", 0);
+
+		// Everything above compiles in parallel on the thread pool, but the renderer can't work without it, so wait
+		vector<shared_ptr<RHI_Shader>> shaders =
+		{
+			m_shaderGBuffer, m_shaderLight, m_shaderTransparent, m_shaderLightDepth, m_shaderFont, m_shaderTransformGizmo, m_shaderSSAO,
+			m_shaderShadowMapping, m_shaderColor, m_shaderQuad, m_shaderQuad_texture, m_shaderQuad_fxaa, m_shaderQuad_luma,
+			m_shaderQuad_sharpening, m_shaderQuad_chromaticAberration, m_shaderQuad_blur_box, m_shaderQuad_blur_gaussian,
+			m_shaderQuad_blur_gaussianBilateral, m_shaderQuad_bloomBright, m_shaderQuad_bloomBLend, m_shaderQuad_toneMapping,
+			m_shaderQuad_gammaCorrection, m_shaderQuad_taa, m_shaderQuad_motionBlur, m_shaderQuad_dithering, m_shaderVariationFallback
+		};
+		for (const auto& shader : shaders)
+		{
+			while (shader->GetState() == Shader_Compiling)
+			{
+				this_thread::sleep_for(chrono::milliseconds(1));
+			}
+			m_shaderWatcher->Watch(shader);
+		}
+
+		// Material shader variations which were used in previous runs
+		ShaderVariation::Precompile(m_rhiDevice, m_context, shaderDirectory + "GBuffer.hlsl");
 	}
 
 	void Renderer::CreateSamplers()
@@ -358,98 +407,56 @@ namespace Directus
 
 	void Renderer::Present()
 	{
+		// The render thread presents what it draws
+		if (m_renderThread.joinable())
+			return;
+
 		m_rhiDevice->Present();
 	}
 
 	void Renderer::Render()
 	{
-		if (!m_rhiDevice || !m_rhiDevice->IsInitialized())
+		const bool headless = Engine::EngineMode_IsSet(Engine_Headless);
+		if (!headless && (!m_rhiDevice || !m_rhiDevice->IsInitialized()))
 			return;
 
-		// If there is no camera, do nothing
-		if (!m_camera)
+		TIME_BLOCK_START_CPU();
+
+		// How far the simulation thread can run ahead of the render thread
+		if (m_renderThread.joinable())
 		{
-			m_rhiDevice->ClearBackBuffer(Vector4(0.0f, 0.0f, 0.0f, 1.0f));
-			return;
+			m_snapshots->SetDepth(Settings::Get().FPS_GetMaxFramesInFlight());
 		}
 
-		// If there is nothing to render clear to camera's color and present
-		if (m_actors.empty())
+		// Blocks while the pipeline is full
+		if (RenderSnapshot* snapshot = m_snapshots->Write_Begin())
 		{
-			m_rhiDevice->ClearBackBuffer(m_camera->GetClearColor());
-			m_rhiDevice->Present();
+			m_isRendering = true;
+			Snapshot_Capture(*snapshot);
 			m_isRendering = false;
-			return;
+			m_snapshots->Write_End();
 		}
 
-		TIME_BLOCK_START_MULTI();
-		Profiler::Get().Reset();
-		m_isRendering = true;
-		m_frameNum++;
-		m_isOddFrame = (m_frameNum % 2) == 1;
+		TIME_BLOCK_END_CPU();
 
-		// Get camera matrices
+		// Without a render thread, the snapshot is drawn right away
+		if (!m_renderThread.joinable())
 		{
-			m_nearPlane		= m_camera->GetNearPlane();
-			m_farPlane		= m_camera->GetFarPlane();
-			m_view			= m_camera->GetViewMatrix();
-			m_viewBase		= m_camera->GetBaseViewMatrix();
-			m_projection	= m_camera->GetProjectionMatrix();
-
-			// TAA - Generate jitter
-			if (Flags_IsSet(Render_PostProcess_TAA))
+			if (const RenderSnapshot* snapshot = m_snapshots->Read_Begin())
 			{
-				m_taa_jitterPrevious = m_taa_jitter;
-
-				// Halton(2, 3) * 16 seems to work nice
-				uint64_t samples	= 16;
-				uint64_t index		= m_frameNum % samples;
-				m_taa_jitter		= Utility::Sampling::Halton2D(index, 2, 3) * 2.0f - 1.0f;
-				m_taa_jitter.x		= m_taa_jitter.x / (float)Settings::Get().Resolution_GetWidth();
-				m_taa_jitter.y		= m_taa_jitter.y / (float)Settings::Get().Resolution_GetHeight();
-				m_projection		*= Matrix::CreateTranslation(Vector3(m_taa_jitter.x, m_taa_jitter.y, 0.0f));
+				Frame_Arena* arena = Frame_Arena::Bind(snapshot->arena.get());
+				Snapshot_Render(*snapshot);
+				Frame_Arena::Bind(arena);
+				m_snapshots->Read_End(&Profiler::Get().m_renderStatsDrawing);
 			}
-			else
-			{
-				m_taa_jitter			= Vector2::Zero;
-				m_taa_jitterPrevious	= Vector2::Zero;		
-			}
-
-			m_viewProjection				= m_view * m_projection;
-			m_projectionOrthographic		= Matrix::CreateOrthographicLH((float)Settings::Get().Resolution_GetWidth(), (float)Settings::Get().Resolution_GetHeight(), m_nearPlane, m_farPlane);		
-			m_viewProjection_Orthographic	= m_viewBase * m_projectionOrthographic;
 		}
 
-		Pass_DepthDirectionalLight(GetLightDirectional());
-		
-		Pass_GBuffer();
-
-		Pass_PreLight(
-			m_renderTexHalf_Spare,		// IN:	
-			m_renderTexHalf_Shadows,	// OUT: Shadows
-			m_renderTexHalf_SSAO		// OUT: DO
-		);
-
-		Pass_Light(
-			m_renderTexHalf_Shadows,	// IN:	Shadows
-			m_renderTexHalf_SSAO,		// IN:	SSAO
-			m_renderTexFull_HDR_Light	// Out: Result
-		);
-
-		Pass_Transparent(m_renderTexFull_HDR_Light);
-		Pass_Lines(m_renderTexFull_HDR_Light);
-		Pass_Gizmos(m_renderTexFull_HDR_Light);
-
-		Pass_PostLight(
-			m_renderTexFull_HDR_Light,	// IN:	Light pass result
-			m_renderTexFull_HDR_Light2	// OUT: Result
-		);
-	
-		Pass_GBufferVisualize(m_renderTexFull_HDR_Light2);	
-		Pass_PerformanceMetrics(m_renderTexFull_HDR_Light2);
-
-		m_isRendering = false;
-		TIME_BLOCK_END_MULTI();
+		// Publish the stats of the last drawn frame, the profiler reads them on this thread
+		Profiler_RenderStats stats;
+		if (m_snapshots->GetStats(&stats))
+		{
+			Profiler::Get().SetRenderStats(stats);
+		}
 	}
 
 	void Renderer::SetBackBufferSize(unsigned int width, unsigned int height)
@@ -461,6 +468,9 @@ namespace Directus
 			return;
 		}
 
+		// The render thread has to be idle
+		m_snapshots->Flush();
+
 		m_rhiDevice->Set_Resolution(width, height);
 		m_viewport->SetWidth((float)width);
 		m_viewport->SetHeight((float)height);
@@ -484,6 +494,9 @@ namespace Directus
 		width	-= (width	% 2 != 0) ? 1 : 0;
 		height	-= (height	% 2 != 0) ? 1 : 0;
 
+		// The render thread has to be idle
+		m_snapshots->Flush();
+
 		Settings::Get().Resolution_Set(Vector2((float)width, (float)height));
 		CreateRenderTextures(width, height);
 		LOGF_INFO("Resolution set to %dx%d", width, height);
@@ -535,9 +548,9 @@ namespace Directus
 		buffer->mProjection				= m_projection;
 		buffer->mProjectionOrtho		= m_projectionOrthographic;
 		buffer->mViewProjection			= m_viewProjection;
-		buffer->camera_position			= m_camera->GetTransform()->GetPosition();
-		buffer->camera_near				= m_camera->GetNearPlane();
-		buffer->camera_far				= m_camera->GetFarPlane();
+		buffer->camera_position			= m_snapshot->camera.position;
+		buffer->camera_near				= m_nearPlane;
+		buffer->camera_far				= m_farPlane;
 		buffer->resolution				= Vector2((float)resolutionWidth, (float)resolutionHeight);
 		buffer->fxaa_subPixel			= m_fxaaSubPixel;
 		buffer->fxaa_edgeThreshold		= m_fxaaEdgeThreshold;
@@ -547,7 +560,7 @@ namespace Directus
 		buffer->bloom_intensity			= m_bloomIntensity;
 		buffer->sharpen_strength		= m_sharpenStrength;
 		buffer->sharpen_clamp			= m_sharpenClamp;
-		buffer->taa_jitterOffset		= m_taa_jitter - m_taa_jitterPrevious;
+		buffer->taa_jitterOffset		= m_snapshot->camera.taaJitter - m_snapshot->camera.taaJitterPrevious;
 		buffer->motionBlur_strength		= m_motionBlurStrength;
 		buffer->fps_current				= Profiler::Get().GetFPS();
 		buffer->fps_target				= Settings::Get().FPS_GetTarget();
@@ -557,8 +570,289 @@ namespace Directus
 		m_rhiPipeline->SetConstantBuffer(m_bufferGlobal, 0, Buffer_Global);
 	}
 
+	//= SNAPSHOT ===============================================================================================
+	void Renderer::Snapshot_Capture(RenderSnapshot& snapshot)
+	{
+		snapshot.flags		= m_flags;
+		snapshot.width		= Settings::Get().Resolution_GetWidth();
+		snapshot.height		= Settings::Get().Resolution_GetHeight();
+		snapshot.hasCamera	= m_camera != nullptr;
+		if (!snapshot.hasCamera)
+			return;
+
+		m_frameNum++;
+		snapshot.frame = m_frameNum;
+
+		// Camera
+		auto& camera = snapshot.camera;
+		{
+			camera.nearPlane	= m_camera->GetNearPlane();
+			camera.farPlane		= m_camera->GetFarPlane();
+			camera.view			= m_camera->GetViewMatrix();
+			camera.viewBase		= m_camera->GetBaseViewMatrix();
+			camera.projection	= m_camera->GetProjectionMatrix();
+			camera.position		= m_camera->GetTransform()->GetPosition();
+			camera.clearColor	= m_camera->GetClearColor();
+
+			// TAA - Generate jitter
+			if (Flags_IsSet(Render_PostProcess_TAA))
+			{
+				m_taa_jitterPrevious = m_taa_jitter;
+
+				// Halton(2, 3) * 16 seems to work nice
+				uint64_t samples	= 16;
+				uint64_t index		= m_frameNum % samples;
+				m_taa_jitter		= Utility::Sampling::Halton2D(index, 2, 3) * 2.0f - 1.0f;
+				m_taa_jitter.x		= m_taa_jitter.x / (float)snapshot.width;
+				m_taa_jitter.y		= m_taa_jitter.y / (float)snapshot.height;
+				camera.projection	*= Matrix::CreateTranslation(Vector3(m_taa_jitter.x, m_taa_jitter.y, 0.0f));
+			}
+			else
+			{
+				m_taa_jitter			= Vector2::Zero;
+				m_taa_jitterPrevious	= Vector2::Zero;		
+			}
+
+			camera.taaJitter					= m_taa_jitter;
+			camera.taaJitterPrevious			= m_taa_jitterPrevious;
+			camera.viewProjection				= camera.view * camera.projection;
+			camera.projectionOrthographic		= Matrix::CreateOrthographicLH((float)snapshot.width, (float)snapshot.height, camera.nearPlane, camera.farPlane);		
+			camera.viewProjectionOrthographic	= camera.viewBase * camera.projectionOrthographic;
+		}
+
+		// Rasterize the biggest occluders on the CPU, so that hidden objects can be skipped before they reach the GPU
+		if (Flags_IsSet(Render_OcclusionCulling))
+		{
+			m_occlusionCulling->Render(camera.view, m_camera->GetProjectionMatrix(), m_actors[Renderable_ObjectOpaque]);
+		}
+		else
+		{
+			m_occlusionCulling->Invalidate();
+		}
+
+		// Lights
+		for (const auto& actor : m_actors[Renderable_Light])
+		{
+			auto light = actor->GetComponent<Light>();
+			if (!light)
+				continue;
+
+			snapshot.lights.emplace_back();
+			auto& entry			= snapshot.lights.back();
+			entry.type			= light->GetLightType();
+			entry.position		= actor->GetTransform_PtrRaw()->GetPosition();
+			entry.direction		= light->GetDirection();
+			entry.color			= light->GetColor();
+			entry.intensity		= light->GetIntensity();
+			entry.range			= light->GetRange();
+			entry.angle			= light->GetAngle();
+			entry.bias			= light->GetBias();
+			entry.normalBias	= light->GetNormalBias();
+			entry.castShadows	= light->GetCastShadows();
+			entry.view			= light->GetViewMatrix();
+			entry.shadowMap		= light->GetShadowMap();
+
+			if (entry.type == LightType_Directional)
+			{
+				for (unsigned int i = 0; i < RenderSnapshot_Light::cascadeCount; i++)
+				{
+					entry.shadowProjection[i] = light->ShadowMap_GetProjectionMatrix(i);
+				}
+
+				if (snapshot.lightDirectional == -1)
+				{
+					snapshot.lightDirectional = (int)snapshot.lights.size() - 1;
+				}
+			}
+
+			// Gizmo, don't bother if out of view
+			if (Flags_IsSet(Render_Gizmo_Lights))
+			{
+				Vector3 direction_camera_to_light	= (entry.position - camera.position).Normalized();
+				float VdL							= Vector3::Dot(m_camera->GetTransform()->GetForward(), direction_camera_to_light);
+				if (VdL > 0.5f)
+				{
+					// Screen space position and scale (based on distance from the camera)
+					float distance				= (camera.position - entry.position).Length() + M_EPSILON;
+					entry.gizmoVisible			= true;
+					entry.gizmoScreenPosition	= m_camera->WorldToScreenPoint(entry.position);
+					entry.gizmoScale			= Clamp(GIZMO_MAX_SIZE / distance, GIZMO_MIN_SIZE, GIZMO_MAX_SIZE);
+				}
+			}
+		}
+
+		// Renderables, with the visibility tests already done
+		auto lightDirectional = snapshot.GetLightDirectional();
+		auto Capture = [this, &camera, lightDirectional](const vector<Actor*>& actors, vector<RenderSnapshot_Renderable>& renderables, bool opaque)
+		{
+			// World space bounding boxes, transformed in bulk before any of them is tested
+			vector<BoundingBox, Frame_Allocator<BoundingBox>> aabbs;
+			vector<Matrix, Frame_Allocator<Matrix>> transforms;
+			aabbs.reserve(actors.size());
+			transforms.reserve(actors.size());
+			for (const auto& actor : actors)
+			{
+				if (const Renderable* renderable = actor->GetRenderable_PtrRaw())
+				{
+					aabbs.emplace_back(renderable->Geometry_AABB());
+					transforms.emplace_back(actor->GetTransform_PtrRaw()->GetMatrix());
+				}
+			}
+			BoundingBox::Transform(aabbs.data(), transforms.data(), aabbs.data(), (unsigned int)aabbs.size());
+
+			renderables.reserve(renderables.size() + aabbs.size());
+			unsigned int index = 0;
+			for (const auto& actor : actors)
+			{
+				auto renderable = actor->GetRenderable_PtrRaw();
+				if (!renderable)
+					continue;
+
+				const BoundingBox& aabb = aabbs[index++];
+				renderables.emplace_back();
+				auto& entry			= renderables.back();
+				auto transform		= actor->GetTransform_PtrRaw();
+				entry.model			= renderable->Geometry_Model();
+				entry.material		= renderable->Material_Ptr();
+				entry.transform		= transform->GetMatrix();
+				entry.indexOffset	= renderable->Geometry_IndexOffset();
+				entry.indexCount	= renderable->Geometry_IndexCount();
+				entry.vertexOffset	= renderable->Geometry_VertexOffset();
+				entry.castShadows	= renderable->GetCastShadows();
+
+				entry.visible		= m_camera->IsInViewFrustrum(aabb.GetCenter(), aabb.GetExtents()) && !m_occlusionCulling->IsOccluded(aabb);
+				entry.shadowVisible	= lightDirectional && !m_occlusionCulling->IsShadowOccluded(aabb, lightDirectional->direction, camera.farPlane);
+
+				// Velocity, the previous matrix only advances when the object is drawn
+				if (opaque && entry.visible)
+				{
+					entry.mvpCurrent	= entry.transform * camera.view * camera.projection;
+					entry.mvpPrevious	= transform->GetWVP_Previous();
+					transform->SetWVP_Previous(entry.mvpCurrent);
+				}
+
+				if (Flags_IsSet(Render_Gizmo_AABB))
+				{
+					DrawBox(aabb, Vector4(0.41f, 0.86f, 1.0f, 1.0f));
+				}
+			}
+		};
+		Capture(m_actors[Renderable_ObjectOpaque], snapshot.opaque, true);
+		Capture(m_actors[Renderable_ObjectTransparent], snapshot.transparent, false);
+
+		snapshot.skybox = m_skybox ? m_skybox->GetTexture() : nullptr;
+
+		// Picking ray
+		if (Flags_IsSet(Render_Gizmo_PickingRay))
+		{
+			const Ray& ray = m_camera->GetPickingRay();
+			DrawLine(ray.GetStart(), ray.GetStart() + ray.GetDirection() * camera.farPlane, Vector4(0, 1, 0, 1));
+		}
+
+		// Lines (everything drawn since the last capture), the snapshot's cleared vector comes back to be filled again
+		snapshot.lines.swap(m_lineVertices);
+
+		// Grid
+		if (Flags_IsSet(Render_Gizmo_Grid) && m_grid)
+		{
+			snapshot.gridTransform = m_grid->ComputeWorldMatrix(m_camera->GetTransform());
+		}
+
+		// Transform gizmo, it also moves the selected actor so it has to run here
+		if (Flags_IsSet(Render_Gizmo_Transform) && m_transformGizmo)
+		{
+			snapshot.transformGizmo = m_transformGizmo->Update(m_context->GetSubsystem<World>()->GetSelectedActor().lock(), m_camera, m_gizmo_transform_size, m_gizmo_transform_speed);
+			if (snapshot.transformGizmo)
+			{
+				const Vector3 axes[3] = { Vector3::Right, Vector3::Up, Vector3::Forward };
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					snapshot.transformGizmoHandles[i]	= m_transformGizmo->GetHandle().GetTransform(axes[i]);
+					snapshot.transformGizmoColors[i]	= m_transformGizmo->GetHandle().GetColor(axes[i]);
+				}
+			}
+		}
+
+		// Performance metrics
+		if (Flags_IsSet(Render_Gizmo_PerformanceMetrics))
+		{
+			snapshot.metrics			= Profiler::Get().GetMetrics();
+			snapshot.metricsPosition	= Vector2(-(int)Settings::Get().Viewport_GetWidth() * 0.5f + 1.0f, (int)Settings::Get().Viewport_GetHeight() * 0.5f);
+		}
+
+		Profiler::Get().m_rendererOcclusionOccluders	= m_occlusionCulling->GetOccluderCount();
+		Profiler::Get().m_rendererOcclusionTriangles	= m_occlusionCulling->GetTriangleCount();
+		Profiler::Get().m_rendererOcclusionTested		= m_occlusionCulling->GetTestedCount();
+		Profiler::Get().m_rendererOcclusionCulled		= m_occlusionCulling->GetCulledCount();
+	}
+
+	void Renderer::Snapshot_Render(const RenderSnapshot& snapshot)
+	{
+		const bool headless = Engine::EngineMode_IsSet(Engine_Headless);
+		Profiler::Get().Reset();
+
+		// If there is no camera, do nothing
+		if (!snapshot.hasCamera)
+		{
+			if (!headless) m_rhiDevice->ClearBackBuffer(Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+			return;
+		}
+
+		TIME_BLOCK_START_MULTI();
+		m_shaderWatcher->Tick();
+		m_snapshot = &snapshot;
+
+		// Camera
+		m_nearPlane						= snapshot.camera.nearPlane;
+		m_farPlane						= snapshot.camera.farPlane;
+		m_view							= snapshot.camera.view;
+		m_viewBase						= snapshot.camera.viewBase;
+		m_projection					= snapshot.camera.projection;
+		m_projectionOrthographic		= snapshot.camera.projectionOrthographic;
+		m_viewProjection				= snapshot.camera.viewProjection;
+		m_viewProjection_Orthographic	= snapshot.camera.viewProjectionOrthographic;
+
+		// Declare this frame's passes, cull the ones which don't contribute to the frame, alias transient render targets and execute
+		RenderGraph_Build();
+		m_renderGraph->Compile();
+		if (!headless)
+		{
+			m_renderGraph->Allocate(m_rhiDevice);
+			m_renderGraph->Execute();
+		}
+		else
+		{
+			Renderables_Cull();
+		}
+
+		auto& stats							= Profiler::Get().m_renderStatsDrawing;
+		stats.rendererGraphPasses			= m_renderGraph->GetPassCount();
+		stats.rendererGraphPassesCulled		= m_renderGraph->GetPassCulledCount();
+		stats.rendererGraphMemoryTransient	= m_renderGraph->GetMemoryTransient();
+		stats.rendererGraphMemoryAliased	= m_renderGraph->GetMemoryAliased();
+
+		m_snapshot = nullptr;
+		TIME_BLOCK_END_MULTI();
+	}
+
+	void Renderer::RenderThread_Loop()
+	{
+		Profiler::Trace_SetThreadName("Render");
+
+		while (const RenderSnapshot* snapshot = m_snapshots->Read_Begin())
+		{
+			// The global frame arena is reset by the simulation thread, which can be a frame ahead
+			Frame_Arena::Bind(snapshot->arena.get());
+			Snapshot_Render(*snapshot);
+			Frame_Arena::Bind(nullptr);
+			m_rhiDevice->Present();
+			m_snapshots->Read_End(&Profiler::Get().m_renderStatsDrawing);
+		}
+	}
+	//==========================================================================================================
+
 	//= RENDERABLES ============================================================================================
-	void Renderer::Renderables_Acquire(const Variant& actorsVariant)
+	void Renderer::Renderables_Acquire(const vector<shared_ptr<Actor>>& actors)
 	{
 		TIME_BLOCK_START_CPU();
 
@@ -566,8 +860,7 @@ namespace Directus
 		m_actors.clear();
 		m_camera = nullptr;
 		
-		auto actorsVec = actorsVariant.Get<vector<shared_ptr<Actor>>>();
-		for (const auto& actorShared : actorsVec)
+		for (const auto& actorShared : actors)
 		{
 			auto actor = actorShared.get();
 			if (!actor)
@@ -611,6 +904,25 @@ namespace Directus
 		TIME_BLOCK_END_CPU();
 	}
 
+	void Renderer::Renderables_Cull()
+	{
+		TIME_BLOCK_START_CPU();
+
+		// The visibility tests were done during the capture, count what the passes would draw
+		for (const auto renderables : { &m_snapshot->opaque, &m_snapshot->transparent })
+		{
+			for (const auto& renderable : *renderables)
+			{
+				if (renderable.visible)
+				{
+					Profiler::Get().m_renderStatsDrawing.rendererMeshesRendered++;
+				}
+			}
+		}
+
+		TIME_BLOCK_END_CPU();
+	}
+
 	void Renderer::Renderables_Sort(vector<Actor*>* renderables)
 	{
 		if (renderables->size() <= 2)
@@ -661,21 +973,214 @@ namespace Directus
 	}
 	//==========================================================================================================
 
+	//= RENDER GRAPH ===========================================================================================
+	void Renderer::RenderGraph_Build()
+	{
+		auto& graph			= *m_renderGraph;
+		unsigned int width	= m_snapshot->width;
+		unsigned int height	= m_snapshot->height;
+		auto lightDir		= m_snapshot->GetLightDirectional();
+		graph.Clear();
+
+		// Imported resources, either persistent across frames or owned by something else (null ones only express a dependency)
+		auto res_frame		= graph.Resource_Import("Frame", &m_renderTexFull_HDR_Light2);
+		auto res_shadowMap	= graph.Resource_Import("ShadowMap", nullptr);
+		auto res_gbuffer	= graph.Resource_Import("GBuffer", nullptr);
+
+		// Transient resources
+		auto res_light		= graph.Resource_Create("HDR_Light", width, height, Texture_Format_R32G32B32A32_FLOAT);
+		auto res_shadowsRaw	= graph.Resource_Create("Shadows_Raw", width / 2, height / 2, Texture_Format_R8_UNORM);
+		auto res_shadows	= graph.Resource_Create("Shadows", width / 2, height / 2, Texture_Format_R8_UNORM);
+		auto res_ssaoRaw	= graph.Resource_Create("SSAO_Raw", width / 2, height / 2, Texture_Format_R8_UNORM);
+		auto res_ssao		= graph.Resource_Create("SSAO", width / 2, height / 2, Texture_Format_R8_UNORM);
+
+		// Full-screen passes draw the same quad
+		auto SetQuadStates = [this]()
+		{
+			m_rhiPipeline->SetIndexBuffer(m_quad->GetIndexBuffer());
+			m_rhiPipeline->SetVertexBuffer(m_quad->GetVertexBuffer());
+			m_rhiPipeline->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
+			m_rhiPipeline->SetCullMode(Cull_Back);
+		};
+
+		// Depth
+		auto pass = graph.Pass_Add("Pass_DepthDirectionalLight", [this, lightDir]() { Pass_DepthDirectionalLight(lightDir); });
+		graph.Pass_Write(pass, res_shadowMap);
+
+		// G-Buffer
+		pass = graph.Pass_Add("Pass_GBuffer", [this]() { Pass_GBuffer(); });
+		graph.Pass_Write(pass, res_gbuffer);
+
+		// Shadow mapping + Blur
+		pass = graph.Pass_Add("Pass_Shadowing", [this, &graph, lightDir, SetQuadStates, res_shadowsRaw, res_shadows]()
+		{
+			if (lightDir && lightDir->castShadows)
+			{
+				SetQuadStates();
+				Pass_ShadowMapping(graph.Resource_Get(res_shadowsRaw), lightDir);
+				float sigma			= 1.0f;
+				float pixelStride	= 1.0f;
+				Pass_BlurBilateralGaussian(graph.Resource_Get(res_shadowsRaw), graph.Resource_Get(res_shadows), sigma, pixelStride);
+			}
+			else
+			{
+				graph.Resource_Get(res_shadows)->Clear(1, 1, 1, 1);
+			}
+		});
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Read(pass, res_shadowMap);
+		graph.Pass_Write(pass, res_shadowsRaw);
+		graph.Pass_Write(pass, res_shadows);
+
+		// SSAO + Blur (culled when the light pass doesn't read it)
+		pass = graph.Pass_Add("Pass_SSAO", [this, &graph, SetQuadStates, res_ssaoRaw, res_ssao]()
+		{
+			SetQuadStates();
+			Pass_SSAO(graph.Resource_Get(res_ssaoRaw));
+			float sigma			= 2.0f;
+			float pixelStride	= 2.0f;
+			Pass_BlurBilateralGaussian(graph.Resource_Get(res_ssaoRaw), graph.Resource_Get(res_ssao), sigma, pixelStride);
+		});
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Write(pass, res_ssaoRaw);
+		graph.Pass_Write(pass, res_ssao);
+
+		// Light
+		pass = graph.Pass_Add("Pass_Light", [this, &graph, SetQuadStates, res_shadows, res_ssao, res_light]()
+		{
+			SetQuadStates();
+			Pass_Light(graph.Resource_Get(res_shadows), graph.Resource_Get(res_ssao), graph.Resource_Get(res_light));
+		});
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Read(pass, res_shadows);
+		graph.Pass_Read(pass, res_frame); // SSR
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_SSAO)) { graph.Pass_Read(pass, res_ssao); }
+		graph.Pass_Write(pass, res_light);
+
+		// Transparent, lines and gizmos, all drawn on top of the light pass result
+		pass = graph.Pass_Add("Pass_Transparent", [this, &graph, res_light]() { Pass_Transparent(graph.Resource_Get(res_light)); });
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Read(pass, res_light);
+		graph.Pass_Write(pass, res_light);
+
+		pass = graph.Pass_Add("Pass_Lines", [this, &graph, res_light]() { Pass_Lines(graph.Resource_Get(res_light)); });
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Read(pass, res_light);
+		graph.Pass_Write(pass, res_light);
+
+		pass = graph.Pass_Add("Pass_Gizmos", [this, &graph, res_light]() { Pass_Gizmos(graph.Resource_Get(res_light)); });
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Read(pass, res_light);
+		graph.Pass_Write(pass, res_light);
+
+		// Post-process, every effect writes to a new virtual target and aliasing takes care of the ping-ponging
+		auto res_postIn = res_light;
+		auto AddPostProcess = [this, &graph, &res_postIn, res_gbuffer, SetQuadStates, width, height](const char* name, RenderGraph_Resource res_out, const function<void(shared_ptr<RHI_RenderTexture>&, shared_ptr<RHI_RenderTexture>&)>& execute)
+		{
+			auto res_in = res_postIn;
+			if (res_out == RenderGraph_Resource_Invalid)
+			{
+				res_out = graph.Resource_Create(name, width, height, Texture_Format_R32G32B32A32_FLOAT);
+			}
+
+			auto pass = graph.Pass_Add(name, [this, &graph, SetQuadStates, execute, res_in, res_out]()
+			{
+				auto& texIn = graph.Resource_Get(res_in);
+				SetQuadStates();
+				m_rhiPipeline->SetVertexShader(m_shaderQuad);
+				SetGlobalBuffer(m_viewProjection_Orthographic, texIn->GetWidth(), texIn->GetHeight());
+				execute(texIn, graph.Resource_Get(res_out));
+			});
+			graph.Pass_Read(pass, res_gbuffer);
+			graph.Pass_Read(pass, res_in);
+			graph.Pass_Write(pass, res_out);
+			res_postIn = res_out;
+			return pass;
+		};
+
+		// TAA
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_TAA))
+		{
+			AddPostProcess("Pass_TAA", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_TAA(texIn, texOut); });
+		}
+
+		// Bloom
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_Bloom))
+		{
+			auto res_blur1	= graph.Resource_Create("Bloom_Blur1", width / 4, height / 4, Texture_Format_R16G16B16A16_FLOAT);
+			auto res_blur2	= graph.Resource_Create("Bloom_Blur2", width / 4, height / 4, Texture_Format_R16G16B16A16_FLOAT);
+			pass = AddPostProcess("Pass_Bloom", RenderGraph_Resource_Invalid, [this, &graph, res_blur1, res_blur2](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut)
+			{
+				Pass_Bloom(texIn, texOut, graph.Resource_Get(res_blur1), graph.Resource_Get(res_blur2));
+			});
+			graph.Pass_Write(pass, res_blur1);
+			graph.Pass_Write(pass, res_blur2);
+		}
+
+		// Motion Blur
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_MotionBlur))
+		{
+			AddPostProcess("Pass_MotionBlur", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_MotionBlur(texIn, texOut); });
+		}
+
+		// Dithering
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_Dithering))
+		{
+			AddPostProcess("Pass_Dithering", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_Dithering(texIn, texOut); });
+		}
+
+		// Tone-Mapping
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_ToneMapping))
+		{
+			AddPostProcess("Pass_ToneMapping", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_ToneMapping(texIn, texOut); });
+		}
+
+		// FXAA
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_FXAA))
+		{
+			AddPostProcess("Pass_FXAA", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_FXAA(texIn, texOut); });
+		}
+
+		// Sharpening
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_Sharpening))
+		{
+			AddPostProcess("Pass_Sharpening", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_Sharpening(texIn, texOut); });
+		}
+
+		// Chromatic aberration
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_ChromaticAberration))
+		{
+			AddPostProcess("Pass_ChromaticAberration", RenderGraph_Resource_Invalid, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_ChromaticAberration(texIn, texOut); });
+		}
+
+		// Gamma correction (always last, writes to the frame)
+		AddPostProcess("Pass_GammaCorrection", res_frame, [this](shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut) { Pass_GammaCorrection(texIn, texOut); });
+
+		// Debug views
+		pass = graph.Pass_Add("Pass_GBufferVisualize", [this, &graph, res_frame]() { Pass_GBufferVisualize(graph.Resource_Get(res_frame)); });
+		graph.Pass_Read(pass, res_gbuffer);
+		graph.Pass_Write(pass, res_frame);
+
+		pass = graph.Pass_Add("Pass_PerformanceMetrics", [this, &graph, res_frame]() { Pass_PerformanceMetrics(graph.Resource_Get(res_frame)); });
+		graph.Pass_Write(pass, res_frame);
+	}
+	//==========================================================================================================
+
 	//= PASSES =================================================================================================
-	void Renderer::Pass_DepthDirectionalLight(Light* light)
+	void Renderer::Pass_DepthDirectionalLight(const RenderSnapshot_Light* light)
 	{
 		// Validate light
-		if (!light || !light->GetCastShadows())
+		if (!light || !light->castShadows)
 			return;
 
 		// Validate light's shadow map
-		auto& shadowMap = light->GetShadowMap();
+		auto& shadowMap = light->shadowMap;
 		if (!shadowMap)
 			return;
 
-		// Validate actors
-		auto& actors = m_actors[Renderable_ObjectOpaque];
-		if (actors.empty())
+		// Validate renderables
+		auto& renderables = m_snapshot->opaque;
+		if (renderables.empty())
 			return;
 
 		TIME_BLOCK_START_MULTI();
@@ -685,33 +1190,39 @@ namespace Directus
 		m_rhiPipeline->SetShader(m_shaderLightDepth);
 		m_rhiPipeline->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
 		m_rhiPipeline->SetViewport(shadowMap->GetViewport());
-		
+
 		// Variables that help reduce state changes
 		unsigned int currentlyBoundGeometry = 0;
-		for (unsigned int i = 0; i < light->GetShadowMap()->GetArraySize(); i++)
+		unsigned int cascadeCount			= shadowMap->GetArraySize() < RenderSnapshot_Light::cascadeCount ? shadowMap->GetArraySize() : RenderSnapshot_Light::cascadeCount;
+		static const char* cascadeEvents[RenderSnapshot_Light::cascadeCount] =
+		{
+			"Pass_DepthDirectionalLight 0",
+			"Pass_DepthDirectionalLight 1",
+			"Pass_DepthDirectionalLight 2"
+		};
+		for (unsigned int i = 0; i < cascadeCount; i++)
 		{
-			m_rhiDevice->EventBegin(("Pass_DepthDirectionalLight " + to_string(i)).c_str());
+			m_rhiDevice->EventBegin(cascadeEvents[i]);
 			m_rhiPipeline->SetRenderTarget(shadowMap->GetRenderTargetView(i), shadowMap->GetDepthStencilView(), true);		
 
-			for (const auto& actor : actors)
+			for (const auto& renderable : renderables)
 			{
-				// Acquire renderable component
-				auto renderable = actor->GetRenderable_PtrRaw();
-				if (!renderable)
+				// Skip casters whose shadow can only land on surfaces the camera can't see (the largest cascade spans the camera's far plane)
+				if (!renderable.shadowVisible)
 					continue;
 
 				// Acquire material
-				auto material = renderable->Material_Ptr();
+				auto& material = renderable.material;
 				if (!material)
 					continue;
 
 				// Acquire geometry
-				auto geometry = renderable->Geometry_Model();
+				auto& geometry = renderable.model;
 				if (!geometry || !geometry->GetVertexBuffer() || !geometry->GetIndexBuffer())
 					continue;
 
 				// Skip meshes that don't cast shadows
-				if (!renderable->GetCastShadows())
+				if (!renderable.castShadows)
 					continue;
 
 				// Skip transparent meshes (for now)
@@ -726,8 +1237,8 @@ namespace Directus
 					currentlyBoundGeometry = geometry->Resource_GetID();
 				}
 
-				SetGlobalBuffer(actor->GetTransform_PtrRaw()->GetMatrix() * light->GetViewMatrix() * light->ShadowMap_GetProjectionMatrix(i));
-				m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
+				SetGlobalBuffer(renderable.transform * light->view * light->shadowProjection[i]);
+				m_rhiPipeline->DrawIndexed(renderable.indexCount, renderable.indexOffset, renderable.vertexOffset);
 			}
 			m_rhiDevice->EventEnd();
 		}
@@ -741,7 +1252,7 @@ namespace Directus
 		if (!m_rhiDevice)
 			return;
 
-		if (m_actors[Renderable_ObjectOpaque].empty())
+		if (m_snapshot->opaque.empty())
 		{
 			m_gbuffer->Clear(); // zeroed out material buffer causes skysphere to render
 		}
@@ -762,29 +1273,31 @@ namespace Directus
 		unsigned int currentlyBoundShader	= 0;
 		unsigned int currentlyBoundMaterial = 0;
 
-		for (auto actor : m_actors[Renderable_ObjectOpaque])
+		for (const auto& renderable : m_snapshot->opaque)
 		{
-			// Get renderable and material
-			Renderable* renderable	= actor->GetRenderable_PtrRaw();
-			Material* material		= renderable ? renderable->Material_Ptr().get() : nullptr;
-
-			if (!renderable || !material)
+			// Get material
+			Material* material = renderable.material.get();
+			if (!material)
 				continue;
 
 			// Get shader and geometry
 			auto shader	= material->GetShader();
-			auto model	= renderable->Geometry_Model();
+			auto& model	= renderable.model;
 
-			// Validate shader
+			// Validate shader (render with the fallback while the material's variation compiles, so objects don't pop in)
 			if (!shader || shader->GetState() != Shader_Built)
-				continue;
+			{
+				shader = m_shaderVariationFallback;
+				if (!shader || shader->GetState() != Shader_Built)
+					continue;
+			}
 
 			// Validate geometry
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
+			// Skip objects outside of the view frustum or hidden behind occluders
+			if (!renderable.visible)
 				continue;
 
 			// set face culling (changes only if required)
@@ -821,56 +1334,19 @@ namespace Directus
 			}
 
 			// UPDATE PER OBJECT BUFFER
-			shader->UpdatePerObjectBuffer(actor->GetTransform_PtrRaw(), material, m_view, m_projection);			
+			shader->UpdatePerObjectBuffer(renderable.transform, renderable.mvpCurrent, renderable.mvpPrevious, material);
 			m_rhiPipeline->SetConstantBuffer(shader->GetPerObjectBuffer(), 1, Buffer_Global);
 
 			// Render	
-			m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
-			Profiler::Get().m_rendererMeshesRendered++;
+			m_rhiPipeline->DrawIndexed(renderable.indexCount, renderable.indexOffset, renderable.vertexOffset);
+			Profiler::Get().m_renderStatsDrawing.rendererMeshesRendered++;
 
-		} // Actor/MESH ITERATION
+		} // MESH ITERATION
 
 		m_rhiDevice->EventEnd();
 		TIME_BLOCK_END_MULTI();
 	}
 
-	void Renderer::Pass_PreLight(shared_ptr<RHI_RenderTexture>& texIn_Spare, shared_ptr<RHI_RenderTexture>& texOut_Shadows, shared_ptr<RHI_RenderTexture>& texOut_SSAO)
-	{
-		m_rhiDevice->EventBegin("Pass_PreLight");
-
-		m_rhiPipeline->SetIndexBuffer(m_quad->GetIndexBuffer());
-		m_rhiPipeline->SetVertexBuffer(m_quad->GetVertexBuffer());
-		m_rhiPipeline->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
-		m_rhiPipeline->SetCullMode(Cull_Back);
-
-		// Shadow mapping + Blur
-		if (auto lightDir = GetLightDirectional())
-		{
-			if (lightDir->GetCastShadows())
-			{
-				Pass_ShadowMapping(texIn_Spare, GetLightDirectional());
-				float sigma			= 1.0f;
-				float pixelStride	= 1.0f;
-				Pass_BlurBilateralGaussian(texIn_Spare, texOut_Shadows, sigma, pixelStride);
-			}
-			else
-			{
-				texOut_Shadows->Clear(1, 1, 1, 1);
-			}
-		}
-
-		// SSAO + Blur
-		if (m_flags & Render_PostProcess_SSAO)
-		{
-			Pass_SSAO(texIn_Spare);
-			float sigma			= 2.0f;
-			float pixelStride	= 2.0f;
-			Pass_BlurBilateralGaussian(texIn_Spare, texOut_SSAO, sigma, pixelStride);
-		}
-
-		m_rhiDevice->EventEnd();
-	}
-
 	void Renderer::Pass_Light(shared_ptr<RHI_RenderTexture>& texShadows, shared_ptr<RHI_RenderTexture>& texSSAO, shared_ptr<RHI_RenderTexture>& texOut)
 	{
 		if (m_shaderLight->GetState() != Shader_Built)
@@ -885,8 +1361,8 @@ namespace Directus
 			m_viewProjection_Orthographic,
 			m_view,
 			m_projection,
-			m_actors[Renderable_Light],
-			Flags_IsSet(Render_PostProcess_SSR)
+			m_snapshot->lights,
+			m_snapshot->Flags_IsSet(Render_PostProcess_SSR)
 		);
 
 		m_rhiPipeline->SetRenderTarget(texOut);
@@ -897,9 +1373,9 @@ namespace Directus
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Depth));
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Material));
 		m_rhiPipeline->SetTexture(texShadows);
-		if (Flags_IsSet(Render_PostProcess_SSAO)) { m_rhiPipeline->SetTexture(texSSAO); } else { m_rhiPipeline->SetTexture(m_texWhite); }
+		if (m_snapshot->Flags_IsSet(Render_PostProcess_SSAO)) { m_rhiPipeline->SetTexture(texSSAO); } else { m_rhiPipeline->SetTexture(m_texWhite); }
 		m_rhiPipeline->SetTexture(m_renderTexFull_HDR_Light2); // SSR
-		m_rhiPipeline->SetTexture(m_skybox ? m_skybox->GetTexture() : m_texWhite);
+		m_rhiPipeline->SetTexture(m_snapshot->skybox ? m_snapshot->skybox : m_texWhite);
 		m_rhiPipeline->SetTexture(m_tex_lutIBL);
 		m_rhiPipeline->SetSampler(m_samplerTrilinearClamp);
 		m_rhiPipeline->SetSampler(m_samplerPointClamp);
@@ -912,11 +1388,12 @@ namespace Directus
 
 	void Renderer::Pass_Transparent(shared_ptr<RHI_RenderTexture>& texOut)
 	{
-		if (!GetLightDirectional())
+		auto lightDirectional = m_snapshot->GetLightDirectional();
+		if (!lightDirectional)
 			return;
 
-		auto& actors_transparent = m_actors[Renderable_ObjectTransparent];
-		if (actors_transparent.empty())
+		auto& renderables = m_snapshot->transparent;
+		if (renderables.empty())
 			return;
 
 		TIME_BLOCK_START_MULTI();
@@ -926,25 +1403,23 @@ namespace Directus
 		m_rhiPipeline->SetShader(m_shaderTransparent);
 		m_rhiPipeline->SetRenderTarget(texOut, m_gbuffer->GetTexture(GBuffer_Target_Depth)->GetDepthStencilView());
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Depth));
-		m_rhiPipeline->SetTexture(m_skybox ? m_skybox->GetTexture() : nullptr);
+		m_rhiPipeline->SetTexture(m_snapshot->skybox);
 		m_rhiPipeline->SetSampler(m_samplerBilinearClamp);
 
-		for (auto& actor : actors_transparent)
+		for (const auto& renderable : renderables)
 		{
-			// Get renderable and material
-			Renderable* renderable = actor->GetRenderable_PtrRaw();
-			Material* material = renderable ? renderable->Material_Ptr().get() : nullptr;
-
-			if (!renderable || !material)
+			// Get material
+			Material* material = renderable.material.get();
+			if (!material)
 				continue;
 
 			// Get geometry
-			auto model = renderable->Geometry_Model();
+			auto& model = renderable.model;
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
+			// Skip objects outside of the view frustum or hidden behind occluders
+			if (!renderable.visible)
 				continue;
 
 			// Set the following per object
@@ -954,21 +1429,21 @@ namespace Directus
 
 			// Constant buffer
 			auto buffer = Struct_Transparency(
-				actor->GetTransform_PtrRaw()->GetMatrix(),
+				renderable.transform,
 				m_view,
 				m_projection,
 				material->GetColorAlbedo(),
-				m_camera->GetTransform()->GetPosition(),
-				GetLightDirectional()->GetDirection(),
+				m_snapshot->camera.position,
+				lightDirectional->direction,
 				material->GetRoughnessMultiplier()
 			);
 			m_shaderTransparent->UpdateBuffer(&buffer);
 			m_rhiPipeline->SetConstantBuffer(m_shaderTransparent->GetConstantBuffer(), 1, Buffer_Global);
-			m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
+			m_rhiPipeline->DrawIndexed(renderable.indexCount, renderable.indexOffset, renderable.vertexOffset);
 
-			Profiler::Get().m_rendererMeshesRendered++;
+			Profiler::Get().m_renderStatsDrawing.rendererMeshesRendered++;
 
-		} // Actor/MESH ITERATION
+		} // MESH ITERATION
 
 		m_rhiPipeline->ClearPendingStates();
 
@@ -976,89 +1451,12 @@ namespace Directus
 		TIME_BLOCK_END_MULTI();
 	}
 
-	void Renderer::Pass_PostLight(shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut)
-	{
-		m_rhiDevice->EventBegin("Pass_PostLight");
-
-		// All post-process passes share the following, so set them once here
-		m_rhiPipeline->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
-		m_rhiPipeline->SetCullMode(Cull_Back);
-		m_rhiPipeline->SetVertexBuffer(m_quad->GetVertexBuffer());
-		m_rhiPipeline->SetIndexBuffer(m_quad->GetIndexBuffer());
-		m_rhiPipeline->SetVertexShader(m_shaderQuad);
-		SetGlobalBuffer(m_viewProjection_Orthographic, texIn->GetWidth(), texIn->GetHeight());
-
-		// Render target swapping
-		auto SwapTargets = [&texIn, &texOut]() { texOut.swap(texIn); };
-
-		// TAA	
-		if (Flags_IsSet(Render_PostProcess_TAA))
-		{
-			Pass_TAA(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Bloom
-		if (Flags_IsSet(Render_PostProcess_Bloom))
-		{
-			Pass_Bloom(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Motion Blur
-		if (Flags_IsSet(Render_PostProcess_MotionBlur))
-		{
-			Pass_MotionBlur(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Dithering
-		if (Flags_IsSet(Render_PostProcess_Dithering))
-		{
-			Pass_Dithering(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Tone-Mapping
-		if (Flags_IsSet(Render_PostProcess_ToneMapping))
-		{
-			Pass_ToneMapping(texIn, texOut);
-			SwapTargets();
-		}
-
-		// FXAA
-		if (Flags_IsSet(Render_PostProcess_FXAA))
-		{
-			Pass_FXAA(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Sharpening
-		if (Flags_IsSet(Render_PostProcess_Sharpening))
-		{
-			Pass_Sharpening(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Chromatic aberration
-		if (Flags_IsSet(Render_PostProcess_ChromaticAberration))
-		{
-			Pass_ChromaticAberration(texIn, texOut);
-			SwapTargets();
-		}
-
-		// Gamma correction
-		Pass_GammaCorrection(texIn, texOut);
-
-		m_rhiDevice->EventEnd();
-	}
-
-	void Renderer::Pass_ShadowMapping(shared_ptr<RHI_RenderTexture>& texOut, Light* inDirectionalLight)
+	void Renderer::Pass_ShadowMapping(shared_ptr<RHI_RenderTexture>& texOut, const RenderSnapshot_Light* inDirectionalLight)
 	{
 		if (!inDirectionalLight)
 			return;
 
-		if (!inDirectionalLight->GetCastShadows())
+		if (!inDirectionalLight->castShadows)
 			return;
 
 		TIME_BLOCK_START_MULTI();
@@ -1069,11 +1467,11 @@ namespace Directus
 		m_rhiPipeline->SetShader(m_shaderShadowMapping);
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Normal));
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Depth));
-		m_rhiPipeline->SetTexture(inDirectionalLight->GetShadowMap()); // Texture2DArray
+		m_rhiPipeline->SetTexture(inDirectionalLight->shadowMap); // Texture2DArray
 		m_rhiPipeline->SetSampler(m_samplerCompareDepth);
 		m_rhiPipeline->SetSampler(m_samplerBilinearClamp);
 		SetGlobalBuffer(m_viewProjection_Orthographic, texOut->GetWidth(), texOut->GetHeight());
-		auto buffer = Struct_ShadowMapping((m_viewProjection).Inverted(), inDirectionalLight, m_camera);
+		auto buffer = Struct_ShadowMapping((m_viewProjection).Inverted(), inDirectionalLight);
 		m_shaderShadowMapping->UpdateBuffer(&buffer);
 		m_rhiPipeline->SetConstantBuffer(m_shaderShadowMapping->GetConstantBuffer(), 1, Buffer_Global);
 		m_rhiPipeline->DrawIndexed(m_quad->GetIndexCount(), 0, 0);
@@ -1236,7 +1634,7 @@ namespace Directus
 		TIME_BLOCK_END_MULTI();
 	}
 
-	void Renderer::Pass_Bloom(shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut)
+	void Renderer::Pass_Bloom(shared_ptr<RHI_RenderTexture>& texIn, shared_ptr<RHI_RenderTexture>& texOut, shared_ptr<RHI_RenderTexture>& texBlur1, shared_ptr<RHI_RenderTexture>& texBlur2)
 	{
 		TIME_BLOCK_START_MULTI();
 		m_rhiDevice->EventBegin("Pass_Bloom");
@@ -1247,14 +1645,14 @@ namespace Directus
 		SetGlobalBuffer(m_viewProjection_Orthographic, texOut->GetWidth(), texOut->GetHeight());
 
 		// Bright pass
-		m_rhiPipeline->SetRenderTarget(m_renderTexQuarter_Blur1);
-		m_rhiPipeline->SetViewport(m_renderTexQuarter_Blur1->GetViewport());
+		m_rhiPipeline->SetRenderTarget(texBlur1);
+		m_rhiPipeline->SetViewport(texBlur1->GetViewport());
 		m_rhiPipeline->SetPixelShader(m_shaderQuad_bloomBright);
 		m_rhiPipeline->SetTexture(texIn);
 		m_rhiPipeline->DrawIndexed(m_quad->GetIndexCount(), 0, 0);
 
 		float sigma = 2.0f;
-		Pass_BlurGaussian(m_renderTexQuarter_Blur1, m_renderTexQuarter_Blur2, sigma);
+		Pass_BlurGaussian(texBlur1, texBlur2, sigma);
 
 		// Additive blending
 		SetGlobalBuffer(m_viewProjection_Orthographic, texOut->GetWidth(), texOut->GetHeight());
@@ -1262,7 +1660,7 @@ namespace Directus
 		m_rhiPipeline->SetViewport(texOut->GetViewport());
 		m_rhiPipeline->SetPixelShader(m_shaderQuad_bloomBLend);
 		m_rhiPipeline->SetTexture(texIn);
-		m_rhiPipeline->SetTexture(m_renderTexQuarter_Blur2);
+		m_rhiPipeline->SetTexture(texBlur2);
 		m_rhiPipeline->DrawIndexed(m_quad->GetIndexCount(), 0, 0);
 
 		m_rhiDevice->EventEnd();
@@ -1410,10 +1808,10 @@ namespace Directus
 
 	void Renderer::Pass_Lines(shared_ptr<RHI_RenderTexture>& texOut)
 	{
-		bool drawPhysics	= m_flags & Render_Gizmo_Physics;
-		bool drawPickingRay = m_flags & Render_Gizmo_PickingRay;
-		bool drawAABBs		= m_flags & Render_Gizmo_AABB;
-		bool drawGrid		= m_flags & Render_Gizmo_Grid;
+		bool drawPhysics	= m_snapshot->flags & Render_Gizmo_Physics;
+		bool drawPickingRay = m_snapshot->flags & Render_Gizmo_PickingRay;
+		bool drawAABBs		= m_snapshot->flags & Render_Gizmo_AABB;
+		bool drawGrid		= m_snapshot->flags & Render_Gizmo_Grid;
 		bool draw			= drawPhysics | drawPickingRay | drawAABBs | drawGrid;
 		if (!draw)
 			return;
@@ -1421,39 +1819,14 @@ namespace Directus
 		TIME_BLOCK_START_MULTI();
 		m_rhiDevice->EventBegin("Pass_Lines");
 
-		m_rhiPipeline->SetState(m_pipelineLine);
-		m_rhiPipeline->SetAlphaBlending(true);
+		m_rhiPipeline->SetState(*m_pipelineLine);
+		m_rhiPipeline->SetSampler(m_samplerPointClamp);
 		m_rhiPipeline->SetRenderTarget(texOut, m_gbuffer->GetTexture(GBuffer_Target_Depth)->GetDepthStencilView());
 		m_rhiPipeline->SetTexture(m_gbuffer->GetTexture(GBuffer_Target_Depth));
 		{
-			// Picking ray
-			if (drawPickingRay)
-			{
-				const Ray& ray = m_camera->GetPickingRay();
-				DrawLine(ray.GetStart(), ray.GetStart() + ray.GetDirection() * m_camera->GetFarPlane(), Vector4(0, 1, 0, 1));
-			}
-
-			// bounding boxes
-			if (drawAABBs)
-			{
-				for (const auto& actor : m_actors[Renderable_ObjectOpaque])
-				{
-					if (auto renderable = actor->GetRenderable_PtrRaw())
-					{
-						DrawBox(renderable->Geometry_AABB(), Vector4(0.41f, 0.86f, 1.0f, 1.0f));
-					}
-				}
-
-				for (const auto& actor : m_actors[Renderable_ObjectTransparent])
-				{
-					if (auto renderable = actor->GetRenderable_PtrRaw())
-					{
-						DrawBox(renderable->Geometry_AABB(), Vector4(0.41f, 0.86f, 1.0f, 1.0f));
-					}
-				}
-			}
-
-			auto lineVertexBufferSize = (unsigned int)m_lineVertices.size();
+			// Debug lines, picking ray and bounding boxes (all added during the capture)
+			auto& lineVertices			= m_snapshot->lines;
+			auto lineVertexBufferSize	= (unsigned int)lineVertices.size();
 			if (lineVertexBufferSize != 0)
 			{
 				if (lineVertexBufferSize > m_lineVertexCount)
@@ -1465,15 +1838,13 @@ namespace Directus
 
 				// Update line vertex buffer
 				void* data = m_lineVertexBuffer->Map();
-				memcpy(data, &m_lineVertices[0], sizeof(RHI_Vertex_PosCol) * lineVertexBufferSize);
+				memcpy(data, &lineVertices[0], sizeof(RHI_Vertex_PosCol) * lineVertexBufferSize);
 				m_lineVertexBuffer->Unmap();
 
 				// Set pipeline state
 				m_rhiPipeline->SetVertexBuffer(m_lineVertexBuffer);
 				SetGlobalBuffer(m_viewProjection);
 				m_rhiPipeline->Draw(lineVertexBufferSize);
-
-				m_lineVertices.clear();
 			}
 		}
 		
@@ -1482,7 +1853,7 @@ namespace Directus
 		{
 			m_rhiPipeline->SetIndexBuffer(m_grid->GetIndexBuffer());
 			m_rhiPipeline->SetVertexBuffer(m_grid->GetVertexBuffer());
-			SetGlobalBuffer(m_grid->ComputeWorldMatrix(m_camera->GetTransform()) * m_viewProjection);
+			SetGlobalBuffer(m_snapshot->gridTransform * m_viewProjection);
 			m_rhiPipeline->DrawIndexed(m_grid->GetIndexCount(), 0, 0);
 		}
 
@@ -1494,8 +1865,8 @@ namespace Directus
 
 	void Renderer::Pass_Gizmos(shared_ptr<RHI_RenderTexture>& texOut)
 	{
-		bool render_lights		= m_flags & Render_Gizmo_Lights;
-		bool render_transform	= m_flags & Render_Gizmo_Transform;
+		bool render_lights		= m_snapshot->flags & Render_Gizmo_Lights;
+		bool render_transform	= m_snapshot->flags & Render_Gizmo_Transform;
 		bool render				= render_lights || render_transform;
 		if (!render)
 			return;
@@ -1510,41 +1881,29 @@ namespace Directus
 		m_rhiPipeline->SetCullMode(Cull_Back);
 		m_rhiPipeline->SetFillMode(Fill_Solid);
 
-		auto& lights = m_actors[Renderable_Light];
-		if (lights.size() != 0)
+		auto& lights = m_snapshot->lights;
+		if (render_lights && lights.size() != 0)
 		{
 			m_rhiDevice->EventBegin("Gizmo_Lights");
 			m_rhiPipeline->SetShader(m_shaderQuad_texture);
 			m_rhiPipeline->SetSampler(m_samplerBilinearClamp);
 
-			for (const auto& actor : lights)
+			for (const auto& light : lights)
 			{
-				Vector3 position_light_world		= actor->GetTransform_PtrRaw()->GetPosition();
-				Vector3 position_camera_world		= m_camera->GetTransform()->GetPosition();
-				Vector3 direction_camera_to_light	= (position_light_world - position_camera_world).Normalized();
-				float VdL							= Vector3::Dot(m_camera->GetTransform()->GetForward(), direction_camera_to_light);
-
 				// Don't bother drawing if out of view
-				if (VdL <= 0.5f)
+				if (!light.gizmoVisible)
 					continue;
 
-				// Compute light screen space position and scale (based on distance from the camera)
-				Vector2 position_light_screen	= m_camera->WorldToScreenPoint(position_light_world);
-				float distance					= (position_camera_world - position_light_world).Length() + M_EPSILON;
-				float scale						= GIZMO_MAX_SIZE / distance;
-				scale							= Clamp(scale, GIZMO_MIN_SIZE, GIZMO_MAX_SIZE);
-
 				// Choose texture based on light type
 				shared_ptr<RHI_Texture> lightTex = nullptr;
-				LightType type = actor->GetComponent<Light>()->GetLightType();
-				if (type == LightType_Directional)	lightTex = m_gizmoTexLightDirectional;
-				else if (type == LightType_Point)	lightTex = m_gizmoTexLightPoint;
-				else if (type == LightType_Spot)	lightTex = m_gizmoTexLightSpot;
+				if (light.type == LightType_Directional)	lightTex = m_gizmoTexLightDirectional;
+				else if (light.type == LightType_Point)		lightTex = m_gizmoTexLightPoint;
+				else if (light.type == LightType_Spot)		lightTex = m_gizmoTexLightSpot;
 
 				// Construct appropriate rectangle
-				float texWidth	= lightTex->GetWidth()	* scale;
-				float texHeight = lightTex->GetHeight()	* scale;
-				m_gizmoRectLight->Create(position_light_screen.x - texWidth * 0.5f, position_light_screen.y - texHeight * 0.5f, texWidth, texHeight);
+				float texWidth	= lightTex->GetWidth()	* light.gizmoScale;
+				float texHeight = lightTex->GetHeight()	* light.gizmoScale;
+				m_gizmoRectLight->Create(light.gizmoScreenPosition.x - texWidth * 0.5f, light.gizmoScreenPosition.y - texHeight * 0.5f, texWidth, texHeight);
 			
 				SetGlobalBuffer(m_viewProjection_Orthographic);
 				m_rhiPipeline->SetTexture(lightTex);
@@ -1556,38 +1915,26 @@ namespace Directus
 			m_rhiDevice->EventEnd();
 		}
 
-		// Transform
-		if (render_transform)
+		// Transform (updated during the capture)
+		if (render_transform && m_snapshot->transformGizmo)
 		{
-			if (m_transformGizmo->Update(m_context->GetSubsystem<World>()->GetSelectedActor().lock(), m_camera, m_gizmo_transform_size, m_gizmo_transform_speed))
-			{
-				m_rhiDevice->EventBegin("Gizmo_Transform");
-
-				m_rhiPipeline->SetShader(m_shaderTransformGizmo);
-				m_rhiPipeline->SetIndexBuffer(m_transformGizmo->GetIndexBuffer());
-				m_rhiPipeline->SetVertexBuffer(m_transformGizmo->GetVertexBuffer());
-				SetGlobalBuffer();
+			m_rhiDevice->EventBegin("Gizmo_Transform");
 
-				// X - Axis		
-				auto buffer = Struct_Matrix_Vector3(m_transformGizmo->GetHandle().GetTransform(Vector3::Right), m_transformGizmo->GetHandle().GetColor(Vector3::Right));
-				m_shaderTransformGizmo->UpdateBuffer(&buffer);
-				m_rhiPipeline->SetConstantBuffer(m_shaderTransformGizmo->GetConstantBuffer(), 1, Buffer_Global);
-				m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
-
-				// Y - Axis		
-				buffer = Struct_Matrix_Vector3(m_transformGizmo->GetHandle().GetTransform(Vector3::Up), m_transformGizmo->GetHandle().GetColor(Vector3::Up));
-				m_shaderTransformGizmo->UpdateBuffer(&buffer);
-				m_rhiPipeline->SetConstantBuffer(m_shaderTransformGizmo->GetConstantBuffer(), 1, Buffer_Global);
-				m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
+			m_rhiPipeline->SetShader(m_shaderTransformGizmo);
+			m_rhiPipeline->SetIndexBuffer(m_transformGizmo->GetIndexBuffer());
+			m_rhiPipeline->SetVertexBuffer(m_transformGizmo->GetVertexBuffer());
+			SetGlobalBuffer();
 
-				// Z - Axis		
-				buffer = Struct_Matrix_Vector3(m_transformGizmo->GetHandle().GetTransform(Vector3::Forward), m_transformGizmo->GetHandle().GetColor(Vector3::Forward));
+			// X, Y and Z axis
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				auto buffer = Struct_Matrix_Vector3(m_snapshot->transformGizmoHandles[i], m_snapshot->transformGizmoColors[i]);
 				m_shaderTransformGizmo->UpdateBuffer(&buffer);
 				m_rhiPipeline->SetConstantBuffer(m_shaderTransformGizmo->GetConstantBuffer(), 1, Buffer_Global);
 				m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
-
-				m_rhiDevice->EventEnd();
 			}
+
+			m_rhiDevice->EventEnd();
 		}
 
 		m_rhiPipeline->ClearPendingStates();
@@ -1598,15 +1945,14 @@ namespace Directus
 
 	void Renderer::Pass_PerformanceMetrics(shared_ptr<RHI_RenderTexture>& texOut)
 	{
-		bool draw = m_flags & Render_Gizmo_PerformanceMetrics;
+		bool draw = m_snapshot->flags & Render_Gizmo_PerformanceMetrics;
 		if (!draw)
 			return;
 
 		TIME_BLOCK_START_MULTI();
 		m_rhiDevice->EventBegin("Pass_PerformanceMetrics");
 
-		Vector2 textPos = Vector2(-(int)Settings::Get().Viewport_GetWidth() * 0.5f + 1.0f, (int)Settings::Get().Viewport_GetHeight() * 0.5f);
-		m_font->SetText(Profiler::Get().GetMetrics(), textPos);
+		m_font->SetText(m_snapshot->metrics, m_snapshot->metricsPosition);
 
 		m_rhiPipeline->SetAlphaBlending(true);
 		m_rhiPipeline->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
@@ -1632,11 +1978,11 @@ namespace Directus
 	bool Renderer::Pass_GBufferVisualize(shared_ptr<RHI_RenderTexture>& texOut)
 	{
 		GBuffer_Texture_Type texType = GBuffer_Target_Unknown;
-		texType	= Flags_IsSet(Render_GBuffer_Albedo)	? GBuffer_Target_Albedo		: texType;
-		texType = Flags_IsSet(Render_GBuffer_Normal)	? GBuffer_Target_Normal		: texType;
-		texType = Flags_IsSet(Render_GBuffer_Material)	? GBuffer_Target_Material	: texType;
-		texType = Flags_IsSet(Render_GBuffer_Velocity)	? GBuffer_Target_Velocity	: texType;
-		texType = Flags_IsSet(Render_GBuffer_Depth)		? GBuffer_Target_Depth		: texType;
+		texType	= m_snapshot->Flags_IsSet(Render_GBuffer_Albedo)	? GBuffer_Target_Albedo		: texType;
+		texType = m_snapshot->Flags_IsSet(Render_GBuffer_Normal)	? GBuffer_Target_Normal		: texType;
+		texType = m_snapshot->Flags_IsSet(Render_GBuffer_Material)	? GBuffer_Target_Material	: texType;
+		texType = m_snapshot->Flags_IsSet(Render_GBuffer_Velocity)	? GBuffer_Target_Velocity	: texType;
+		texType = m_snapshot->Flags_IsSet(Render_GBuffer_Depth)		? GBuffer_Target_Depth		: texType;
 
 		if (texType != GBuffer_Target_Unknown)
 		{
@@ -1666,18 +2012,4 @@ namespace Directus
 		return true;
 	}
 	//=============================================================================================================
-
-	Light* Renderer::GetLightDirectional()
-	{
-		auto actors = m_actors[Renderable_Light];
-
-		for (const auto& actor : actors)
-		{
-			Light* light = actor->GetComponent<Light>().get();
-			if (light->GetLightType() == LightType_Directional)
-				return light;
-		}
-
-		return nullptr;
-	}
 }
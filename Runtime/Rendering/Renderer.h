@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <thread>
 #include "../Core/SubSystem.h"
 #include "../RHI/RHI_Definition.h"
 #include "../RHI/RHI_Pipeline.h"
@@ -47,6 +48,13 @@ namespace Directus
 	class Variant;
 	class Grid;
 	class Transform_Gizmo;
+	class RenderGraph;
+	class ShaderWatcher;
+	class ShaderVariation;
+	class OcclusionCulling;
+	class RenderSnapshot_Pipeline;
+	struct RenderSnapshot;
+	struct RenderSnapshot_Light;
 	namespace Math
 	{
 		class BoundingBox;
@@ -76,7 +84,8 @@ namespace Directus
 		Render_PostProcess_Sharpening			= 1UL << 18,
 		Render_PostProcess_ChromaticAberration	= 1UL << 19,
 		Render_PostProcess_Dithering			= 1UL << 20,
-		Render_PostProcess_ToneMapping			= 1UL << 21
+		Render_PostProcess_ToneMapping			= 1UL << 21,
+		Render_OcclusionCulling					= 1UL << 22
 	};
 
 	enum RenderableType
@@ -106,6 +115,7 @@ namespace Directus
 		void SetBackBufferAsRenderTarget(bool clear = true);
 		void* GetFrameShaderResource();
 		void Present();
+		// Captures a snapshot of the world and renders it, either right away or on the render thread (Engine_RenderThread)
 		void Render();
 
 		// The back-buffer is the final output (should match the display/window size)
@@ -129,10 +139,15 @@ namespace Directus
 		//===========================================================================================================================================================================
 
 		const std::shared_ptr<RHI_Device>& GetRHIDevice()	{ return m_rhiDevice; }
+		// True while the world is being captured, the only time the renderer reads actors
 		static bool IsRendering()							{ return m_isRendering; }
 		uint64_t GetFrameNum()								{ return m_frameNum; }
 		Camera* GetCamera()									{ return m_camera; }
 		static unsigned int GetMaxResolution()				{ return m_maxResolution; }
+		RenderGraph* GetRenderGraph()						{ return m_renderGraph.get(); }
+		ShaderWatcher* GetShaderWatcher()					{ return m_shaderWatcher.get(); }
+		OcclusionCulling* GetOcclusionCulling()				{ return m_occlusionCulling.get(); }
+		RenderSnapshot_Pipeline* GetSnapshotPipeline()		{ return m_snapshots.get(); }
 
 		//= Graphics Settings ====================================================================================================================================================
 		float m_gamma					= 2.2f;
@@ -166,15 +181,24 @@ namespace Directus
 			float blur_sigma					= 0.0f,
 			const Math::Vector2& blur_direction	= Math::Vector2::Zero
 		);
-		void Renderables_Acquire(const Variant& renderables);
+		void Renderables_Acquire(const std::vector<std::shared_ptr<Actor>>& actors);
 		void Renderables_Sort(std::vector<Actor*>* renderables);
+		// Headless stand-in for the passes, counts what they would draw
+		void Renderables_Cull();
+		void RenderGraph_Build();
+
+		//= SNAPSHOT =================================================================================
+		// Simulation thread, copies everything the passes need out of the world
+		void Snapshot_Capture(RenderSnapshot& snapshot);
+		// Render thread (or the simulation thread when there is no render thread)
+		void Snapshot_Render(const RenderSnapshot& snapshot);
+		void RenderThread_Loop();
+		//============================================================================================
 
 		//= PASSES ==============================================================================================================================================
-		void Pass_DepthDirectionalLight(Light* directionalLight);
+		void Pass_DepthDirectionalLight(const RenderSnapshot_Light* directionalLight);
 		void Pass_GBuffer();
-		void Pass_PreLight(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut, std::shared_ptr<RHI_RenderTexture>& texOut2);
 		void Pass_Light(std::shared_ptr<RHI_RenderTexture>& texShadows, std::shared_ptr<RHI_RenderTexture>& texSSAO, std::shared_ptr<RHI_RenderTexture>& texOut);
-		void Pass_PostLight(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_TAA(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_Transparent(std::shared_ptr<RHI_RenderTexture>& texOut);
 		bool Pass_GBufferVisualize(std::shared_ptr<RHI_RenderTexture>& texOut);
@@ -185,30 +209,24 @@ namespace Directus
 		void Pass_ChromaticAberration(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_MotionBlur(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_Dithering(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
-		void Pass_Bloom(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut);
+		void Pass_Bloom(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut, std::shared_ptr<RHI_RenderTexture>& texBlur1, std::shared_ptr<RHI_RenderTexture>& texBlur2);
 		void Pass_BlurBox(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut, float sigma);
 		void Pass_BlurGaussian(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut, float sigma);
 		void Pass_BlurBilateralGaussian(std::shared_ptr<RHI_RenderTexture>& texIn, std::shared_ptr<RHI_RenderTexture>& texOut, float sigma, float pixelStride);
 		void Pass_SSAO(std::shared_ptr<RHI_RenderTexture>& texOut);
-		void Pass_ShadowMapping(std::shared_ptr<RHI_RenderTexture>& texOut, Light* inDirectionalLight);
+		void Pass_ShadowMapping(std::shared_ptr<RHI_RenderTexture>& texOut, const RenderSnapshot_Light* inDirectionalLight);
 		void Pass_Lines(std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_Gizmos(std::shared_ptr<RHI_RenderTexture>& texOut);
 		void Pass_PerformanceMetrics(std::shared_ptr<RHI_RenderTexture>& texOut);
 		//=======================================================================================================================================================
 
 		//= RENDER TEXTURES ===========================================
-		// 1/1
-		std::shared_ptr<RHI_RenderTexture> m_renderTexFull_HDR_Light;
+		// Persistent across frames (transient ones live in the render graph)
 		std::shared_ptr<RHI_RenderTexture> m_renderTexFull_TAA_Current;
 		std::shared_ptr<RHI_RenderTexture> m_renderTexFull_TAA_History;
 		std::shared_ptr<RHI_RenderTexture> m_renderTexFull_HDR_Light2;
-		// 1/2
-		std::shared_ptr<RHI_RenderTexture> m_renderTexHalf_Shadows;
-		std::shared_ptr<RHI_RenderTexture> m_renderTexHalf_SSAO;
-		std::shared_ptr<RHI_RenderTexture> m_renderTexHalf_Spare;
-		// 1/4
-		std::shared_ptr<RHI_RenderTexture> m_renderTexQuarter_Blur1;
-		std::shared_ptr<RHI_RenderTexture> m_renderTexQuarter_Blur2;
+		std::unique_ptr<RenderGraph> m_renderGraph;
+		std::unique_ptr<OcclusionCulling> m_occlusionCulling;
 		//=============================================================
 
 		//= SHADERS ====================================================
@@ -237,6 +255,9 @@ namespace Directus
 		std::shared_ptr<RHI_Shader> m_shaderQuad_toneMapping;
 		std::shared_ptr<RHI_Shader> m_shaderQuad_gammaCorrection;
 		std::shared_ptr<RHI_Shader> m_shaderQuad_dithering;
+		// Used by objects whose material variation is still compiling
+		std::shared_ptr<ShaderVariation> m_shaderVariationFallback;
+		std::unique_ptr<ShaderWatcher> m_shaderWatcher;
 		//==============================================================
 
 		//= SAMPLERS =========================================
@@ -248,9 +269,9 @@ namespace Directus
 		std::shared_ptr<RHI_Sampler> m_samplerAnisotropicWrap;
 		//====================================================
 
-		//= PIPELINE STATES =============
-		RHI_PipelineState m_pipelineLine;
-		//===============================
+		//= PIPELINE STATES =============================
+		std::shared_ptr<RHI_PipelineState> m_pipelineLine;
+		//===============================================
 
 		//= STANDARD TEXTURES ==================================
 		std::shared_ptr<RHI_Texture> m_texNoiseNormal;
@@ -274,14 +295,21 @@ namespace Directus
 		std::unique_ptr<Rectangle> m_gizmoRectLight;
 		//===============================================
 
+		//= SNAPSHOT ====================================================
+		std::unique_ptr<RenderSnapshot_Pipeline> m_snapshots;
+		// The snapshot being rendered, only valid during Snapshot_Render()
+		const RenderSnapshot* m_snapshot = nullptr;
+		std::thread m_renderThread;
+		//===============================================================
+
 		//= MISC ========================================================
-		Light* GetLightDirectional();
 		std::shared_ptr<RHI_Device> m_rhiDevice;
 		std::shared_ptr<RHI_Pipeline> m_rhiPipeline;
 		std::unique_ptr<GBuffer> m_gbuffer;
 		std::shared_ptr<RHI_Viewport> m_viewport;		
 		std::unique_ptr<Rectangle> m_quad;
 		std::unordered_map<RenderableType, std::vector<Actor*>> m_actors;
+		// Copied from the snapshot being rendered
 		Math::Matrix m_view;
 		Math::Matrix m_viewBase;
 		Math::Matrix m_projection;
@@ -296,7 +324,7 @@ namespace Directus
 		std::unique_ptr<Font> m_font;	
 		unsigned long m_flags;
 		uint64_t m_frameNum;
-		bool m_isOddFrame;
+		// Simulation thread state, carried over from one captured frame to the next
 		Math::Vector2 m_taa_jitter;
 		Math::Vector2 m_taa_jitterPrevious;
 		static unsigned int m_maxResolution;
@@ -0,0 +1,119 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =========================
+#include "ShaderWatcher.h"
+#include <algorithm>
+#include "../RHI/RHI_Shader.h"
+#include "../FileSystem/FileSystem.h"
+#include "../Logging/Log.h"
+//====================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	static const chrono::milliseconds POLL_INTERVAL = chrono::milliseconds(500);
+
+	ShaderWatcher::ShaderWatcher(Context* context)
+	{
+		m_context	= context;
+		m_lastPoll	= chrono::steady_clock::now();
+	}
+
+	void ShaderWatcher::Watch(const shared_ptr<RHI_Shader>& shader)
+	{
+		if (!shader)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		lock_guard<mutex> lock(m_mutex);
+		for (const auto& watched : m_shaders)
+		{
+			if (watched.shader.lock() == shader)
+				return;
+		}
+
+		Watched watched;
+		watched.shader = shader;
+		m_shaders.emplace_back(watched);
+	}
+
+	void ShaderWatcher::Tick()
+	{
+		auto now = chrono::steady_clock::now();
+		if (!m_enabled || now - m_lastPoll < POLL_INTERVAL)
+			return;
+		m_lastPoll = now;
+
+		lock_guard<mutex> lock(m_mutex);
+
+		// Forget destroyed shaders
+		m_shaders.erase(remove_if(m_shaders.begin(), m_shaders.end(), [](const Watched& watched) { return watched.shader.expired(); }), m_shaders.end());
+
+		// Many shaders share files (e.g. Common.hlsl), so stat each file once per poll
+		map<string, long long> writeTimes;
+		auto GetWriteTime = [&writeTimes](const string& filePath)
+		{
+			auto it = writeTimes.find(filePath);
+			if (it != writeTimes.end())
+				return it->second;
+
+			return writeTimes[filePath] = FileSystem::GetLastWriteTime(filePath);
+		};
+
+		for (auto& watched : m_shaders)
+		{
+			auto shader = watched.shader.lock();
+
+			// Shaders which haven't compiled yet, or are compiling, are visited again on the next poll
+			if (!shader || shader->IsCompiling())
+				continue;
+
+			long long writeTime = 0;
+			for (const auto& filePath : shader->GetDependencies())
+			{
+				writeTime = max(writeTime, GetWriteTime(filePath));
+			}
+
+			// First sighting
+			if (watched.writeTime == 0)
+			{
+				watched.writeTime = writeTime;
+				continue;
+			}
+
+			if (writeTime <= watched.writeTime)
+				continue;
+
+			if (shader->Recompile_Async(m_context))
+			{
+				LOGF_INFO("Reloading %s", FileSystem::GetFileNameFromFilePath(shader->GetFilePath()).c_str());
+				watched.writeTime = writeTime;
+			}
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ================
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include "../Core/EngineDefs.h"
+//===========================
+
+namespace Directus
+{
+	class Context;
+	class RHI_Shader;
+
+	// Polls the source files (includes too) of every watched shader and recompiles, in the
+	// background, the shaders whose files changed. Shaders keep rendering with their previous
+	// bytecode until the new one is ready, so editing a shader never stalls or blanks a frame.
+	class ENGINE_CLASS ShaderWatcher
+	{
+	public:
+		ShaderWatcher(Context* context);
+		~ShaderWatcher() = default;
+
+		void Watch(const std::shared_ptr<RHI_Shader>& shader);
+		// Cheap to call every frame, files are only polled once per interval
+		void Tick();
+
+		void SetEnabled(bool enabled)	{ m_enabled = enabled; }
+		bool IsEnabled()				{ return m_enabled; }
+
+	private:
+		struct Watched
+		{
+			std::weak_ptr<RHI_Shader> shader;
+			// Newest write time of the shader's files, as of the last (re)compilation
+			long long writeTime = 0;
+		};
+
+		Context* m_context;
+		std::vector<Watched> m_shaders;
+		std::mutex m_mutex;
+		std::chrono::steady_clock::time_point m_lastPoll;
+		bool m_enabled = true;
+	};
+}
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Rendering/Mesh.h"
 #include "../Rendering/Model.h"
 #include "../Rendering/Font/Font.h"
+#include "../World/Prefab.h"
 //================================================
 
 //= NAMESPACES ==========
@@ -46,6 +47,7 @@ INSTANTIATE_ToResourceType(Mesh,			Resource_Mesh)
 INSTANTIATE_ToResourceType(Model,			Resource_Model)
 INSTANTIATE_ToResourceType(Animation,		Resource_Animation)
 INSTANTIATE_ToResourceType(Font,			Resource_Font)
+INSTANTIATE_ToResourceType(Prefab,			Resource_Prefab)
 
 IResource::IResource(Context* context, Resource_Type type)
 {
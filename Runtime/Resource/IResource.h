@@ -43,7 +43,8 @@ namespace Directus
 		Resource_Animation,
 		Resource_Font,
 		Resource_Shader, // not an actual resource, just a memory resource, enum is here just so we can get a standard path
-		Resource_Script	 // not an actual resource, just a memory resource, enum is here just so we can get a standard path
+		Resource_Script, // not an actual resource, just a memory resource, enum is here just so we can get a standard path
+		Resource_Prefab
 	};
 
 	enum LoadState
@@ -98,12 +99,17 @@ namespace Directus
 		LoadState GetLoadState()			{ return m_loadState; }
 		void SetLoadState(LoadState state)	{ m_loadState = state; }
 
+		// Set when the resource differs from its file, only modified resources are saved
+		bool IsModified()					{ return m_isModified; }
+		void SetModified(bool modified)		{ m_isModified = modified; }
+
 	protected:
 		unsigned int m_resourceID			= NOT_ASSIGNED_HASH;
 		std::string m_resourceName			= NOT_ASSIGNED;
 		std::string m_resourceFilePath		= NOT_ASSIGNED;
 		Resource_Type m_resourceType		= Resource_Unknown;
 		LoadState m_loadState				= LoadState_Idle;
+		bool m_isModified					= true;
 		Context* m_context					= nullptr;
 	};
 }
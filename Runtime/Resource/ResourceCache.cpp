@@ -151,10 +151,13 @@ namespace Directus
 		{
 			for (const auto& resource : resourceGroup.second)
 			{
-				if (!resource->HasFilePath())
+				if (!resource->HasFilePath() || !resource->IsModified())
 					continue;
 
-				resource->SaveToFile(resource->GetResourceFilePath());
+				if (resource->SaveToFile(resource->GetResourceFilePath()))
+				{
+					resource->SetModified(false);
+				}
 			}
 		}
 	}
@@ -121,6 +121,9 @@ namespace Directus
 				return nullptr;
 			}
 
+			// A resource which was imported from a foreign format points to an engine file that doesn't exist yet
+			typed->SetModified(typed->GetResourceFilePath() != filePathRelative);
+
 			// Cache it and cast it
 			return typed;
 		}
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Timer.h"
 #include "../Rendering/Material.h"
 #include "../Input/Input.h"
+#include "../Physics/Physics.h"
 #include "../World/Actor.h"
 #include "../World/Components/RigidBody.h"
 #include "../World/Components/Camera.h"
@@ -57,6 +58,7 @@ namespace Directus
 		RegisterMaterial();
 		RegisterCamera();
 		RegisterRigidBody();
+		RegisterPhysics();
 		Registeractor();
 		RegisterLog();
 	}
@@ -135,6 +137,8 @@ namespace Directus
 		m_scriptEngine->RegisterObjectType("Material", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Camera", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("RigidBody", 0, asOBJ_REF | asOBJ_NOCOUNT);
+		m_scriptEngine->RegisterObjectType("Physics", 0, asOBJ_REF | asOBJ_NOCOUNT);
+		m_scriptEngine->RegisterObjectType("PhysicsHit", sizeof(PhysicsHit), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_C);
 		m_scriptEngine->RegisterObjectType("MathHelper", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("Vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_COPY_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR);
 		m_scriptEngine->RegisterObjectType("Vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_COPY_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR);
@@ -243,6 +247,72 @@ namespace Directus
 		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyForceAtPosition(Vector3, Vector3, ForceMode)", asMETHOD(RigidBody, ApplyForceAtPosition), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyTorque(Vector3, ForceMode)", asMETHOD(RigidBody, ApplyTorque), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("RigidBody", "void SetRotation(Quaternion)", asMETHOD(RigidBody, SetRotation), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "void SetLayer(uint)", asMETHOD(RigidBody, SetLayer), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "uint GetLayer()", asMETHOD(RigidBody, GetLayer), asCALL_THISCALL);
+	}
+
+	/*------------------------------------------------------------------------------
+										[PHYSICS]
+	------------------------------------------------------------------------------*/
+	void ConstructorPhysicsHit(PhysicsHit* self)
+	{
+		new(self) PhysicsHit();
+	}
+
+	static Actor* PhysicsHitGetActor(PhysicsHit* self)
+	{
+		return self->body ? self->body->GetActor_PtrRaw() : nullptr;
+	}
+
+	static bool PhysicsRaycast(const Vector3& from, const Vector3& to, PhysicsHit& hit, unsigned int mask, Physics* self)
+	{
+		return self->Raycast(from, to, &hit, mask);
+	}
+
+	// Line of sight, ends at the first hit instead of looking for the closest
+	static bool PhysicsRaycastAny(const Vector3& from, const Vector3& to, unsigned int mask, Physics* self)
+	{
+		return self->Raycast(from, to, nullptr, mask);
+	}
+
+	static bool PhysicsSweepSphere(float radius, const Vector3& from, const Vector3& to, PhysicsHit& hit, unsigned int mask, Physics* self)
+	{
+		PhysicsShape shape;
+		shape.size = Vector3(radius);
+		return self->Sweep(shape, from, to, &hit, mask);
+	}
+
+	static bool PhysicsOverlapSphere(const Vector3& position, float radius, unsigned int mask, Physics* self)
+	{
+		PhysicsShape shape;
+		shape.size = Vector3(radius);
+		return self->Overlap(shape, position, nullptr, mask);
+	}
+
+	static bool PhysicsOverlapBox(const Vector3& position, const Vector3& halfExtents, const Quaternion& rotation, unsigned int mask, Physics* self)
+	{
+		PhysicsShape shape;
+		shape.type		= PhysicsShape_Box;
+		shape.size		= halfExtents;
+		shape.rotation	= rotation;
+		return self->Overlap(shape, position, nullptr, mask);
+	}
+
+	void ScriptInterface::RegisterPhysics()
+	{
+		m_scriptEngine->RegisterObjectBehaviour("PhysicsHit", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ConstructorPhysicsHit), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("PhysicsHit", "bool HasHit() const", asMETHOD(PhysicsHit, HasHit), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("PhysicsHit", "Actor @GetActor()", asFUNCTION(PhysicsHitGetActor), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectProperty("PhysicsHit", "Vector3 position", asOFFSET(PhysicsHit, position));
+		m_scriptEngine->RegisterObjectProperty("PhysicsHit", "Vector3 normal", asOFFSET(PhysicsHit, normal));
+		m_scriptEngine->RegisterObjectProperty("PhysicsHit", "float fraction", asOFFSET(PhysicsHit, fraction));
+
+		m_scriptEngine->RegisterGlobalProperty("Physics physics", m_context->GetSubsystem<Physics>());
+		m_scriptEngine->RegisterObjectMethod("Physics", "bool Raycast(const Vector3 &in, const Vector3 &in, PhysicsHit &out, uint mask = 0xFFFFFFFF)", asFUNCTION(PhysicsRaycast), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("Physics", "bool RaycastAny(const Vector3 &in, const Vector3 &in, uint mask = 0xFFFFFFFF)", asFUNCTION(PhysicsRaycastAny), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("Physics", "bool SweepSphere(float, const Vector3 &in, const Vector3 &in, PhysicsHit &out, uint mask = 0xFFFFFFFF)", asFUNCTION(PhysicsSweepSphere), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("Physics", "bool OverlapSphere(const Vector3 &in, float, uint mask = 0xFFFFFFFF)", asFUNCTION(PhysicsOverlapSphere), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("Physics", "bool OverlapBox(const Vector3 &in, const Vector3 &in, const Quaternion &in, uint mask = 0xFFFFFFFF)", asFUNCTION(PhysicsOverlapBox), asCALL_CDECL_OBJLAST);
 	}
 
 	/*------------------------------------------------------------------------------
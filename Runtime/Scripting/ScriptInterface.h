@@ -46,6 +46,7 @@ namespace Directus
 		void RegisterMaterial();
 		void RegisterCamera();
 		void RegisterRigidBody();
+		void RegisterPhysics();
 		void RegisterMathHelper();
 		void RegisterVector2();
 		void RegisterVector3();
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ================
 #include "Threading.h"
 #include "../Core/Settings.h"
+#include "../Profiling/Profiler.h"
 //===========================
 
 //= NAMESPACES =====
@@ -73,6 +74,8 @@ namespace Directus
 
 	void Threading::Invoke()
 	{
+		Profiler::Trace_SetThreadName("Worker");
+
 		shared_ptr<Task> task;
 		while (true)
 		{
@@ -96,7 +99,63 @@ namespace Directus
 			lock.unlock();
 
 			// Execute the task.
+			PROFILE_ZONE("Threading::Task");
 			task->Execute();
 		}
 	}
+
+	void Threading::ParallelFor(unsigned int count, const function<void(unsigned int)>& task)
+	{
+		if (count == 0)
+			return;
+
+		if (m_threads.empty() || count == 1)
+		{
+			for (unsigned int i = 0; i < count; i++)
+			{
+				task(i);
+			}
+			return;
+		}
+
+		// Shared with the helper tasks, which may start after the loop is already done. The task is only called
+		// while iterations are left, so it can point to the caller's function, which waits for all of them.
+		struct Loop
+		{
+			const function<void(unsigned int)>* task = nullptr;
+			unsigned int count;
+			atomic<unsigned int> next		= 0;
+			atomic<unsigned int> completed	= 0;
+			mutex doneMutex;
+			condition_variable doneCondition;
+		};
+		auto loop		= Pool_MakeShared<Loop>();
+		loop->task		= &task;
+		loop->count		= count;
+
+		auto Work = [](const shared_ptr<Loop>& loop)
+		{
+			unsigned int i;
+			while ((i = loop->next++) < loop->count)
+			{
+				(*loop->task)(i);
+				if (++loop->completed == loop->count)
+				{
+					lock_guard<mutex> lock(loop->doneMutex);
+					loop->doneCondition.notify_all();
+				}
+			}
+		};
+
+		unsigned int helpers = min((unsigned int)m_threads.size(), count - 1);
+		for (unsigned int i = 0; i < helpers; i++)
+		{
+			AddTask([loop, Work]() { Work(loop); });
+		}
+
+		Work(loop);
+
+		unique_lock<mutex> lock(loop->doneMutex);
+		loop->doneCondition.wait(lock, [&loop] { return loop->completed == loop->count; });
+	}
 }
\ No newline at end of file
@@ -26,8 +26,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
 #include "../Core/SubSystem.h"
 #include "../Logging/Log.h"
+#include "../Core/Allocators.h"
 //============================
 
 namespace Directus
@@ -74,7 +78,7 @@ namespace Directus
 			std::unique_lock<std::mutex> lock(m_tasksMutex);
 
 			// Save the task
-			m_tasks.push(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
+			m_tasks.push(Pool_MakeShared<Task>(std::bind(std::forward<Function>(function))));
 
 			// Unlock the mutex
 			lock.unlock();
@@ -83,6 +87,12 @@ namespace Directus
 			m_conditionVar.notify_one();
 		}
 
+		// Invokes task(i) for every i in [0, count) across the threads and returns once all of them are done.
+		// The calling thread works too, so this is safe to call from within a task.
+		void ParallelFor(unsigned int count, const std::function<void(unsigned int)>& task);
+
+		unsigned int GetThreadCount() { return (unsigned int)m_threads.size(); }
+
 	private:
 		unsigned int m_threadCount;
 		std::vector<std::thread> m_threads;
@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Script.h"
 #include "../World/Components/AudioSource.h"
 #include "../World/Components/AudioListener.h"
+#include "Prefab.h"
 #include "../IO/FileStream.h"
 #include "../FileSystem/FileSystem.h"
 #include "../Logging/Log.h"
@@ -79,51 +80,10 @@ namespace Directus
 
 	void Actor::Clone()
 	{
-		auto scene = m_context->GetSubsystem<World>();
-		vector<Actor*> clones;
-
-		// Creation of new actor and copying of a few properties
-		auto CloneActor = [&scene, &clones](Actor* actor)
-		{
-			// Clone the name and the ID
-			Actor* clone = scene->Actor_Create().get();
-			clone->SetID(GENERATE_GUID);
-			clone->SetName(actor->GetName());
-			clone->SetActive(actor->IsActive());
-			clone->SetHierarchyVisibility(actor->IsVisibleInHierarchy());
-
-			// Clone all the components
-			for (const auto& component : actor->GetAllComponents())
-			{
-				shared_ptr<IComponent> originalComp = component;
-				shared_ptr<IComponent> cloneComp	= clone->AddComponent(component->GetType());
-				cloneComp->SetAttributes(originalComp->GetAttributes());
-			}
-
-			clones.emplace_back(clone);
-
-			return clone;
-		};
-
-		// Cloning of an actor and it's descendants (this is a recursive lambda)
-		function<Actor*(Actor*)> CloneActorAndDescendants = [&CloneActorAndDescendants, &CloneActor, &clones](Actor* original)
-		{
-			// clone self
-			Actor* cloneSelf = CloneActor(original);
-
-			// clone children make them call this lambda
-			for (const auto& childTransform : original->GetTransform_PtrRaw()->GetChildren())
-			{
-				Actor* cloneChild = CloneActorAndDescendants(childTransform->GetActor_PtrRaw());
-				cloneChild->GetTransform_PtrRaw()->SetParent(cloneSelf->GetTransform_PtrRaw());
-			}
-
-			// return self
-			return cloneSelf;
-		};
-
-		// Clone the entire hierarchy
-		CloneActorAndDescendants(this);
+		// Capture the actor and its descendants and decode a single instance of them, in one batch
+		auto prefab = make_shared<Prefab>(m_context);
+		prefab->CreateFromActor(this);
+		m_context->GetSubsystem<World>()->Prefab_Instantiate(prefab, 1);
 	}
 
 	void Actor::Start()
@@ -274,30 +234,56 @@ namespace Directus
 		FIRE_EVENT(EVENT_WORLD_RESOLVE);
 	}
 
-	shared_ptr<IComponent> Actor::AddComponent(ComponentType type)
+	bool Actor::IsModified()
+	{
+		if (m_isModified)
+			return true;
+
+		for (const auto& component : m_components)
+		{
+			if (component->IsModified())
+				return true;
+		}
+
+		return false;
+	}
+
+	void Actor::SetModified(bool modified)
+	{
+		m_isModified = modified;
+		for (const auto& component : m_components)
+		{
+			component->SetModified(modified);
+		}
+	}
+
+	shared_ptr<IComponent> Actor::AddComponent(ComponentType type, bool resolve)
 	{
 		// This is the only hardcoded part regarding components. It's 
 		// one function but it would be nice if that gets automated too, somehow...
 		shared_ptr<IComponent> component;
 		switch (type)
 		{
-			case ComponentType_AudioListener:	component = AddComponent<AudioListener>();	break;
-			case ComponentType_AudioSource:		component = AddComponent<AudioSource>();	break;
-			case ComponentType_Camera:			component = AddComponent<Camera>();			break;
-			case ComponentType_Collider:		component = AddComponent<Collider>();		break;
-			case ComponentType_Constraint:		component = AddComponent<Constraint>();		break;
-			case ComponentType_Light:			component = AddComponent<Light>();			break;
-			case ComponentType_Renderable:		component = AddComponent<Renderable>();		break;
-			case ComponentType_RigidBody:		component = AddComponent<RigidBody>();		break;
-			case ComponentType_Script:			component = AddComponent<Script>();			break;
-			case ComponentType_Skybox:			component = AddComponent<Skybox>();			break;
-			case ComponentType_Transform:		component = AddComponent<Transform>();		break;
-			case ComponentType_Unknown:														break;
-			default:																		break;
+			case ComponentType_AudioListener:	component = AddComponent<AudioListener>(false);	break;
+			case ComponentType_AudioSource:		component = AddComponent<AudioSource>(false);	break;
+			case ComponentType_Camera:			component = AddComponent<Camera>(false);		break;
+			case ComponentType_Collider:		component = AddComponent<Collider>(false);		break;
+			case ComponentType_Constraint:		component = AddComponent<Constraint>(false);	break;
+			case ComponentType_Light:			component = AddComponent<Light>(false);			break;
+			case ComponentType_Renderable:		component = AddComponent<Renderable>(false);	break;
+			case ComponentType_RigidBody:		component = AddComponent<RigidBody>(false);		break;
+			case ComponentType_Script:			component = AddComponent<Script>(false);		break;
+			case ComponentType_Skybox:			component = AddComponent<Skybox>(false);		break;
+			case ComponentType_Transform:		component = AddComponent<Transform>(false);		break;
+			case ComponentType_Unknown:																break;
+			default:																				break;
 		}
 
 		// Make the scene resolve
-		FIRE_EVENT(EVENT_WORLD_RESOLVE);
+		if (resolve)
+		{
+			FIRE_EVENT(EVENT_WORLD_RESOLVE);
+		}
 
 		return component;
 	}
@@ -312,6 +298,7 @@ namespace Directus
 				component->OnRemove();
 				component.reset();
 				it = m_components.erase(it);
+				m_isModified = true;
 			}
 			else
 			{
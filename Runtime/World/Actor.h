@@ -27,12 +27,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/IComponent.h"
 #include "../Core/Context.h"
 #include "../Core/EventSystem.h"
+#include "../Core/Allocators.h"
 //================================
 
 namespace Directus
 {
 	class Transform;
 	class Renderable;
+	class Prefab;
 
 	class ENGINE_CLASS Actor : public std::enable_shared_from_this<Actor>
 	{
@@ -54,22 +56,34 @@ namespace Directus
 
 		//= PROPERTIES =========================================================================================
 		const std::string& GetName()			{ return m_name; }
-		void SetName(const std::string& name)	{ m_name = name; }
+		void SetName(const std::string& name)	{ m_name = name; m_isModified = true; }
 
 		unsigned int GetID()		{ return m_ID; }
 		void SetID(unsigned int ID) { m_ID = ID; }
 
 		bool IsActive()				{ return m_isActive; }
-		void SetActive(bool active) { m_isActive = active; }
+		void SetActive(bool active) { m_isActive = active; m_isModified = true; }
 
 		bool IsVisibleInHierarchy()								{ return m_hierarchyVisibility; }
-		void SetHierarchyVisibility(bool hierarchyVisibility)	{ m_hierarchyVisibility = hierarchyVisibility; }
+		void SetHierarchyVisibility(bool hierarchyVisibility)	{ m_hierarchyVisibility = hierarchyVisibility; m_isModified = true; }
+
+		// True if the actor or any of its components changed since the world was last saved or loaded
+		bool IsModified();
+		// Applies to the actor and all of its components
+		void SetModified(bool modified);
+		//======================================================================================================
+
+		//= PREFAB =============================================================================================
+		// The prefab (and the node of it) this actor was instantiated from, if any
+		const std::shared_ptr<Prefab>& GetPrefab()	{ return m_prefab; }
+		unsigned int GetPrefabNode()				{ return m_prefabNode; }
+		void SetPrefab(const std::shared_ptr<Prefab>& prefab, unsigned int node) { m_prefab = prefab; m_prefabNode = node; }
 		//======================================================================================================
 
 		//= COMPONENTS =========================================================================================
-		// Adds a component of type T
+		// Adds a component of type T, the world resolves unless told otherwise (for batches which resolve once)
 		template <class T>
-		std::shared_ptr<T> AddComponent()
+		std::shared_ptr<T> AddComponent(bool resolve = true)
 		{
 			ComponentType type = IComponent::Type_To_Enum<T>();
 
@@ -80,7 +94,7 @@ namespace Directus
 			// Add component
 			m_components.emplace_back
 			(	
-				std::make_shared<T>
+				Pool_MakeShared<T>
 				(
 					m_context,
 					this,
@@ -91,6 +105,7 @@ namespace Directus
 			auto newComponent = std::static_pointer_cast<T>(m_components.back());
 			newComponent->SetType(IComponent::Type_To_Enum<T>());
 			newComponent->OnInitialize();
+			m_isModified = true;
 
 			// Caching of rendering performance critical components
 			if (newComponent->GetType() == ComponentType_Renderable)
@@ -99,12 +114,15 @@ namespace Directus
 			}
 
 			// Make the scene resolve
-			FIRE_EVENT(EVENT_WORLD_RESOLVE);
+			if (resolve)
+			{
+				FIRE_EVENT(EVENT_WORLD_RESOLVE);
+			}
 
 			return newComponent;
 		}
 
-		std::shared_ptr<IComponent> AddComponent(ComponentType type);
+		std::shared_ptr<IComponent> AddComponent(ComponentType type, bool resolve = true);
 
 		// Returns a component of type T (if it exists)
 		template <class T>
@@ -170,6 +188,7 @@ namespace Directus
 					component->OnRemove();
 					component.reset();
 					it = m_components.erase(it);
+					m_isModified = true;
 				}
 				else
 				{
@@ -196,9 +215,12 @@ namespace Directus
 		std::string m_name;
 		bool m_isActive;
 		bool m_hierarchyVisibility;
+		bool m_isModified = true;
 		std::vector<std::shared_ptr<IComponent>> m_components;
 		Context* m_context;
 		std::shared_ptr<Actor> m_componentEmpty;
+		std::shared_ptr<Prefab> m_prefab;
+		unsigned int m_prefabNode = 0;
 
 		// Caching of performance critical components
 		Transform* m_transform;
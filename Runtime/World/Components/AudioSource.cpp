@@ -123,6 +123,8 @@ namespace Directus
 			LOG_ERROR_INVALID_PARAMETER();
 			return;
 		}
+
+		m_isModified = true;
 		m_audioClip = audioClip;
 	}
 
@@ -159,6 +161,8 @@ namespace Directus
 		if (m_mute == mute || !m_audioClip)
 			return;
 	
+		m_isModified = true;
+
 		m_mute = mute;
 		m_audioClip->SetMute(mute);
 	}
@@ -168,6 +172,8 @@ namespace Directus
 		if (!m_audioClip)
 			return;
 	
+		m_isModified = true;
+
 		// Priority for the channel, from 0 (most important) 
 		// to 256 (least important), default = 128.
 		m_priority = (int)Clamp(priority, 0, 255);
@@ -179,6 +185,8 @@ namespace Directus
 		if (!m_audioClip)
 			return;
 	
+		m_isModified = true;
+
 		m_volume = Clamp(volume, 0.0f, 1.0f);
 		m_audioClip->SetVolume(m_volume);
 	}
@@ -188,6 +196,8 @@ namespace Directus
 		if (!m_audioClip)
 			return;
 	
+		m_isModified = true;
+
 		m_pitch = Clamp(pitch, 0.0f, 3.0f);
 		m_audioClip->SetPitch(m_pitch);
 	}
@@ -197,6 +207,8 @@ namespace Directus
 		if (!m_audioClip)
 			return;
 	
+		m_isModified = true;
+
 		// Pan level, from -1.0 (left) to 1.0 (right).
 		m_pan = Clamp(pan, -1.0f, 1.0f);
 		m_audioClip->SetPan(m_pan);
@@ -58,10 +58,10 @@ namespace Directus
 		void SetMute(bool mute);
 
 		bool GetPlayOnStart()					{ return m_playOnStart; }
-		void SetPlayOnStart(bool playOnStart)	{ m_playOnStart = playOnStart; }
+		void SetPlayOnStart(bool playOnStart)	{ m_playOnStart = playOnStart; m_isModified = true; }
 
 		bool GetLoop()			{ return m_loop; }
-		void SetLoop(bool loop) { m_loop = loop; }
+		void SetLoop(bool loop) { m_loop = loop; m_isModified = true; }
 
 		int GetPriority() { return m_priority; }
 		void SetPriority(int priority);
@@ -117,18 +117,24 @@ namespace Directus
 	//= PLANES/PROJECTION =====================================================
 	void Camera::SetNearPlane(float nearPlane)
 	{
+		m_isModified = true;
+
 		m_nearPlane = Max(0.01f, nearPlane);
 		m_isDirty = true;
 	}
 
 	void Camera::SetFarPlane(float farPlane)
 	{
+		m_isModified = true;
+
 		m_farPlane = farPlane;
 		m_isDirty = true;
 	}
 
 	void Camera::SetProjection(ProjectionType projection)
 	{
+		m_isModified = true;
+
 		m_projectionType = projection;
 		m_isDirty = true;
 	}
@@ -140,6 +146,8 @@ namespace Directus
 
 	void Camera::SetFOV_Horizontal_Deg(float fov)
 	{
+		m_isModified = true;
+
 		m_fovHorizontalRad = DegreesToRadians(fov);
 		m_isDirty = true;
 	}
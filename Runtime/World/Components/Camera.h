@@ -96,7 +96,7 @@ namespace Directus
 		bool IsInViewFrustrum(Renderable* renderable);
 		bool IsInViewFrustrum(const Math::Vector3& center, const Math::Vector3& extents);
 		const Math::Vector4& GetClearColor() { return m_clearColor; }
-		void SetClearColor(const Math::Vector4& color) { m_clearColor = color; }
+		void SetClearColor(const Math::Vector4& color) { m_clearColor = color; m_isModified = true; }
 		//===============================================================================
 
 	private:
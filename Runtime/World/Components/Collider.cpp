@@ -26,6 +26,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Renderable.h"
 #include "../Actor.h"
 #include "../../IO/FileStream.h"
+#include "../../Physics/Physics.h"
+#include "../../Physics/ShapeCache.h"
 #include "../../Physics/BulletPhysicsHelper.h"
 #include "../../Logging/Log.h"
 #pragma warning(push, 0) // Hide warnings which belong to Bullet
@@ -34,7 +36,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <BulletCollision/CollisionShapes/btCapsuleShape.h>
 #include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
 #include <BulletCollision/CollisionShapes/btConeShape.h>
-#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
 #pragma warning(pop)
 //=============================================================
 
@@ -50,7 +51,8 @@ namespace Directus
 		m_shapeType = ColliderShape_Box;
 		m_center	= Vector3::Zero;
 		m_size		= Vector3::One;
-		m_shape			= nullptr;
+		m_shape		= nullptr;
+		m_physics	= GetContext()->GetSubsystem<Physics>();
 
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_size, Vector3);
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_center, Vector3);
@@ -107,6 +109,8 @@ namespace Directus
 		if (m_size == boundingBox)
 			return;
 
+		m_isModified = true;
+
 		m_size = boundingBox;
 		m_size.x = Clamp(m_size.x, M_EPSILON, INFINITY);
 		m_size.y = Clamp(m_size.y, M_EPSILON, INFINITY);
@@ -120,6 +124,8 @@ namespace Directus
 		if (m_center == center)
 			return;
 
+		m_isModified = true;
+
 		m_center = center;
 		RigidBody_SetCenterOfMass(m_center);
 	}
@@ -129,6 +135,8 @@ namespace Directus
 		if (m_shapeType == type)
 			return;
 
+		m_isModified = true;
+
 		m_shapeType = type;
 		Shape_Update();
 	}
@@ -138,12 +146,16 @@ namespace Directus
 		if (m_optimize == optimize)
 			return;
 
+		m_isModified = true;
+
 		m_optimize = optimize;
 		Shape_Update();
 	}
 
 	void Collider::Shape_Update()
 	{
+		// The body swaps shapes as a whole, neither a step nor a query may see it without one or with the released one
+		auto lock = m_physics->World_Lock();
 		Shape_Release();
 		Vector3 worldScale = GetTransform()->GetScale();
 
@@ -179,6 +191,7 @@ namespace Directus
 			break;
 
 		case ColliderShape_Mesh:
+		case ColliderShape_StaticMesh:
 			// Get Renderable
 			Renderable* renderable = GetActor_PtrRaw()->GetComponent<Renderable>().get();
 			if (!renderable)
@@ -187,44 +200,44 @@ namespace Directus
 				return;
 			}
 
-			// Validate vertex count
-			if (renderable->Geometry_VertexCount() >= m_vertexLimit)
+			if (m_shapeType == ColliderShape_Mesh)
 			{
-				LOG_WARNING("Collider::Shape_Update: No user defined collider with more than " + to_string(m_vertexLimit) + " vertices is allowed.");
-				return;
+				// Validate vertex count
+				if (renderable->Geometry_VertexCount() >= m_vertexLimit)
+				{
+					LOG_WARNING("Collider::Shape_Update: No convex hull with more than " + to_string(m_vertexLimit) + " vertices is allowed, use a static mesh instead.");
+					return;
+				}
+
+				m_shapeShared = m_physics->GetShapeCache()->Acquire(renderable, ShapeCache_ConvexHull, worldScale, m_optimize);
 			}
-
-			// Get geometry
-			vector<unsigned int> indices;
-			vector<RHI_Vertex_PosUvNorTan> vertices;
-			renderable->Geometry_Get(&indices, &vertices);
-
-			if (vertices.empty())
+			else
 			{
-				LOG_WARNING("Collider::UpdateShape: No vertices.");
-				return;
+				// Triangle meshes can't be simulated
+				const auto& rigidBody = m_actor->GetComponent<RigidBody>();
+				if (rigidBody && rigidBody->GetMass() > 0.0f && !rigidBody->GetIsKinematic())
+				{
+					LOG_WARNING("Collider::Shape_Update: A static mesh will not move with a dynamic rigid body, use a mass of 0 or make it kinematic.");
+				}
+
+				m_shapeShared = m_physics->GetShapeCache()->Acquire(renderable, ShapeCache_TriangleMesh, worldScale, false);
 			}
 
-			// Construct hull approximation
-			m_shape = new btConvexHullShape(
-				(btScalar*)&vertices[0],					// points
-				renderable->Geometry_VertexCount(),			// point count
-				(unsigned int)sizeof(RHI_Vertex_PosUvNorTan));	// stride
-
-			// Scaling has to be done before (potential) optimization
-			m_shape->setLocalScaling(ToBtVector3(worldScale));
-
-			// Optimize if requested
-			if (m_optimize)
+			if (!m_shapeShared)
 			{
-				auto hull = (btConvexHullShape*)m_shape;
-				hull->optimizeConvexHull();
-				hull->initializePolyhedralFeatures();
+				LOG_WARNING("Collider::Shape_Update: Failed to construct mesh shape.");
+				return;
 			}
+
+			m_shape = m_shapeShared.get();
 			break;
 		}
 
-		m_shape->setUserPointer(this);
+		// Shared shapes belong to no collider in particular
+		if (!m_shapeShared)
+		{
+			m_shape->setUserPointer(this);
+		}
 
 		RigidBody_SetShape(m_shape);
 		RigidBody_SetCenterOfMass(m_center);
@@ -232,8 +245,18 @@ namespace Directus
 
 	void Collider::Shape_Release()
 	{
+		auto lock = m_physics->World_Lock();
 		RigidBody_SetShape(nullptr);
-		SafeDelete(m_shape);
+
+		if (m_shapeShared)
+		{
+			m_shapeShared.reset();
+			m_shape = nullptr;
+		}
+		else
+		{
+			SafeDelete(m_shape);
+		}
 	}
 
 	void Collider::RigidBody_SetShape(btCollisionShape* shape)
@@ -32,6 +32,7 @@ class btCollisionShape;
 namespace Directus
 {
 	class Mesh;
+	class Physics;
 
 	enum ColliderShape
 	{
@@ -41,7 +42,10 @@ namespace Directus
 		ColliderShape_Cylinder,
 		ColliderShape_Capsule,
 		ColliderShape_Cone,
+		// Convex hull around the mesh
 		ColliderShape_Mesh,
+		// Exact triangle mesh of any size, for static and kinematic bodies
+		ColliderShape_StaticMesh,
 	};
 
 	class ENGINE_CLASS Collider : public IComponent
@@ -84,9 +88,13 @@ namespace Directus
 
 		ColliderShape m_shapeType;
 		btCollisionShape* m_shape;
+		// Mesh shapes come from the physics shape cache and may be shared with other colliders
+		std::shared_ptr<btCollisionShape> m_shapeShared;
 		Math::Vector3 m_size;
 		Math::Vector3 m_center;
+		// Convex hulls only
 		unsigned int m_vertexLimit = 100000;
 		bool m_optimize = true;
+		Physics* m_physics;
 	};
 }
\ No newline at end of file
@@ -125,6 +125,8 @@ namespace Directus
 
 	void Constraint::SetConstraintType(ConstraintType type)
 	{
+		m_isModified = true;
+
 		if (m_type != type || !m_constraint)
 		{
 			m_constraintType = type;
@@ -134,6 +136,8 @@ namespace Directus
 
 	void Constraint::SetPosition(const Vector3& position)
 	{
+		m_isModified = true;
+
 		if (m_position != position)
 		{
 			m_position = position;
@@ -143,6 +147,8 @@ namespace Directus
 
 	void Constraint::SetRotation(const Quaternion& rotation)
 	{
+		m_isModified = true;
+
 		if (m_rotation != rotation)
 		{
 			m_rotation = rotation;
@@ -152,6 +158,8 @@ namespace Directus
 
 	void Constraint::SetPositionOther(const Vector3& position)
 	{
+		m_isModified = true;
+
 		if (position != m_positionOther)
 		{
 			m_positionOther = position;
@@ -161,6 +169,8 @@ namespace Directus
 
 	void Constraint::SetRotationOther(const Quaternion& rotation)
 	{
+		m_isModified = true;
+
 		if (rotation != m_rotationOther)
 		{
 			m_rotationOther = rotation;
@@ -173,6 +183,8 @@ namespace Directus
 		if (bodyOther.expired())
 			return;
 
+		m_isModified = true;
+
 		if (!bodyOther.expired() && bodyOther.lock()->GetID() == m_actor->GetID())
 		{
 			LOG_WARNING("You can't connect a body to itself.");
@@ -185,6 +197,8 @@ namespace Directus
 
 	void Constraint::SetHighLimit(const Vector2& limit)
 	{
+		m_isModified = true;
+
 		if (m_highLimit != limit)
 		{
 			m_highLimit = limit;
@@ -194,6 +208,8 @@ namespace Directus
 
 	void Constraint::SetLowLimit(const Vector2& limit)
 	{
+		m_isModified = true;
+
 		if (m_lowLimit != limit)
 		{
 			m_lowLimit = limit;
@@ -205,6 +221,7 @@ namespace Directus
 	{
 		if (m_constraint)
 		{
+			auto lock = m_physics->World_Lock();
 			RigidBody* rigidBodyOwn		= m_actor->GetComponent<RigidBody>().get();
 			RigidBody* rigidBodyOther	= !m_bodyOther.expired() ? m_bodyOther.lock()->GetComponent<RigidBody>().get() : nullptr;
 
@@ -278,6 +295,7 @@ namespace Directus
 	------------------------------------------------------------------------------*/
 	void Constraint::Construct()
 	{
+		auto lock = m_physics->World_Lock();
 		ReleaseConstraint();
 
 		// Make sure we have two bodies
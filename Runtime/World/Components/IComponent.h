@@ -98,6 +98,10 @@ namespace Directus
 		ComponentType GetType()				{ return m_type; }
 		void SetType(ComponentType type)	{ m_type = type; }
 
+		// Set when state that gets serialized changes, cleared once the world is saved
+		bool IsModified()					{ return m_isModified; }
+		void SetModified(bool modified)		{ m_isModified = modified; }
+
 		const std::string& GetActorName();
 
 		template <typename T>
@@ -110,6 +114,7 @@ namespace Directus
 			{
 				m_attributes[i].setter(attributes[i].getter());
 			}
+			m_isModified = true;
 		}
 		//=======================================================================================
 
@@ -147,6 +152,8 @@ namespace Directus
 		Transform* m_transform		= nullptr;
 		// The context of the engine
 		Context* m_context			= nullptr;
+		// Differs from what was last saved (new components haven't been saved at all)
+		bool m_isModified			= true;
 
 	private:
 		// The attributes of the component
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../IO/FileStream.h"
 #include "../../Rendering/Renderer.h"
 #include "../../RHI/RHI_RenderTexture.h"
+#include "../../RHI/RHI_Device.h"
 //========================================
 
 //= NAMESPACES ================
@@ -78,10 +79,6 @@ namespace Directus
 			m_lastPosLight = GetTransform()->GetPosition();
 			m_lastRotLight = GetTransform()->GetRotation();
 			
-			// Used to prevent directional light
-			// from casting shadows form underneath
-			// the scene which can look weird
-			ClampRotation();
 			ComputeViewMatrix();
 
 			m_isDirty = true;
@@ -96,7 +93,7 @@ namespace Directus
 
 				// Update shadow map projection matrices
 				m_shadowMapsProjectionMatrix.clear();
-				for (unsigned int i = 0; i < m_shadowMap->GetArraySize(); i++)
+				for (unsigned int i = 0; i < m_shadowMapArraySize; i++)
 				{
 					m_shadowMapsProjectionMatrix.emplace_back(Matrix());
 					ShadowMap_ComputeProjectionMatrix(i);
@@ -136,6 +133,8 @@ namespace Directus
 
 	void Light::SetLightType(LightType type)
 	{
+		m_isModified = true;
+
 		m_lightType = type;
 		m_isDirty = true;
 		ShadowMap_Create(true);
@@ -143,6 +142,8 @@ namespace Directus
 
 	void Light::SetCastShadows(bool castShadows)
 	{
+		m_isModified = true;
+
 		if (m_castShadows = castShadows)
 			return;
 
@@ -152,32 +153,40 @@ namespace Directus
 
 	void Light::SetRange(float range)
 	{
+		m_isModified = true;
+
 		m_range = Clamp(range, 0.0f, INFINITY);
 		m_isDirty = true;
 	}
 
 	void Light::SetAngle(float angle)
 	{
+		m_isModified = true;
+
 		m_angle = Clamp(angle, 0.0f, 1.0f);
 		m_isDirty = true;
 	}
 
 	Vector3 Light::GetDirection()
 	{
-		return GetTransform()->GetForward();
+		if (m_lightType != LightType_Directional)
+			return GetTransform()->GetForward();
+
+		return ClampRotation(GetTransform()->GetRotationLocal()) * Vector3::Forward;
 	}
 
-	void Light::ClampRotation()
+	Quaternion Light::ClampRotation(const Quaternion& rotation)
 	{
-		Vector3 rotation = GetTransform()->GetRotation().ToEulerAngles();
-		if (rotation.x <= 0.0f)
-		{
-			GetTransform()->SetRotation(Quaternion::FromEulerAngles(179.0f, rotation.y, rotation.z));
-		}
-		if (rotation.x >= 180.0f)
-		{
-			GetTransform()->SetRotation(Quaternion::FromEulerAngles(1.0f, rotation.y, rotation.z));
-		}
+		// Used to prevent directional light from casting shadows from underneath the scene, which can look weird.
+		// Lights tick in parallel and only read their transform, so the clamped rotation isn't written back.
+		Vector3 angles = rotation.ToEulerAngles();
+		if (angles.x <= 0.0f)
+			return Quaternion::FromEulerAngles(179.0f, angles.y, angles.z);
+
+		if (angles.x >= 180.0f)
+			return Quaternion::FromEulerAngles(1.0f, angles.y, angles.z);
+
+		return rotation;
 	}
 
 	void Light::ComputeViewMatrix()
@@ -201,7 +210,7 @@ namespace Directus
 
 	bool Light::ShadowMap_ComputeProjectionMatrix(unsigned int index /*= 0*/)
 	{
-		if (!m_renderer->GetCamera() || index >= m_shadowMap->GetArraySize())
+		if (!m_renderer->GetCamera() || index >= m_shadowMapArraySize || index >= (unsigned int)m_shadowMapsProjectionMatrix.size())
 			return false;
 
 		float camera_far			= m_renderer->GetCamera()->GetFarPlane();
@@ -215,7 +224,7 @@ namespace Directus
 		};
 		float extent = extents[index];
 
-		Vector3 box_center	= m_lastPosCamera * GetViewMatrix();						// Follow the camera
+		Vector3 box_center	= GetViewMatrix().TransformPoint(m_lastPosCamera);			// Follow the camera
 		Vector3 box_extent	= Vector3(extents[index]) * GetTransform()->GetRotation();	// Rotate towards light direction
 		Vector3 box_min		= box_center - box_extent;
 		Vector3 box_max		= box_center + box_extent;
@@ -223,7 +232,7 @@ namespace Directus
 		//= Prevent shadow shimmering  ===================================================
 		// Shadow shimmering remedy based on
 		// https://msdn.microsoft.com/en-us/library/windows/desktop/ee416324(v=vs.85).aspx
-		float worldUnitsPerTexel = (extent * 2.0f) / m_shadowMap->GetWidth();
+		float worldUnitsPerTexel = (extent * 2.0f) / m_shadowMapResolution;
 		box_min /= worldUnitsPerTexel;
 		box_min.Floor();
 		box_min *= worldUnitsPerTexel;
@@ -249,23 +258,27 @@ namespace Directus
 		m_shadowMap.reset();
 	
 		// Compute array size
-		int arraySize = 0;
+		m_shadowMapArraySize = 0;
 		if (GetLightType() == LightType_Directional)
 		{
-			arraySize = 3; // cascades
+			m_shadowMapArraySize = 3; // cascades
 		}
 		else if (GetLightType() == LightType_Point)
 		{
-			arraySize = 6; // points of view
+			m_shadowMapArraySize = 6; // points of view
 		}
 		else if (GetLightType() == LightType_Spot)
 		{
-			arraySize = 1;
+			m_shadowMapArraySize = 1;
 		}
+		m_shadowMapResolution = Settings::Get().Shadows_GetResolution();
+
+		// Create the shadow maps (headless, there is no device to create them with, but the
+		// array size and resolution are kept so the cascade projections are still computed)
+		auto rhiDevice = m_context->GetSubsystem<Renderer>()->GetRHIDevice();
+		if (!rhiDevice->IsInitialized())
+			return;
 
-		// Create the shadow maps
-		unsigned int resolution	= Settings::Get().Shadows_GetResolution();
-		auto rhiDevice			= m_context->GetSubsystem<Renderer>()->GetRHIDevice();
-		m_shadowMap				= make_unique<RHI_RenderTexture>(rhiDevice, resolution, resolution, Texture_Format_R32_FLOAT, true, Texture_Format_D32_FLOAT, arraySize); // could use the g-buffers depth which should be same res
+		m_shadowMap = make_unique<RHI_RenderTexture>(rhiDevice, m_shadowMapResolution, m_shadowMapResolution, Texture_Format_R32_FLOAT, true, Texture_Format_D32_FLOAT, m_shadowMapArraySize); // could use the g-buffers depth which should be same res
 	}
 }
\ No newline at end of file
@@ -66,11 +66,11 @@ namespace Directus
 		LightType GetLightType() { return m_lightType; }
 		void SetLightType(LightType type);
 
-		void SetColor(float r, float g, float b, float a)	{ m_color = Math::Vector4(r, g, b, a); }
-		void SetColor(Math::Vector4 color)					{ m_color = color; }
+		void SetColor(float r, float g, float b, float a)	{ m_color = Math::Vector4(r, g, b, a); m_isModified = true; }
+		void SetColor(Math::Vector4 color)					{ m_color = color; m_isModified = true; }
 		Math::Vector4 GetColor()							{ return m_color; }
 
-		void SetIntensity(float value) { m_intensity = value; }
+		void SetIntensity(float value) { m_intensity = value; m_isModified = true; }
 		float GetIntensity() { return m_intensity; }
 
 		bool GetCastShadows() { return m_castShadows; }
@@ -82,14 +82,14 @@ namespace Directus
 		void SetAngle(float angle);
 		float GetAngle() { return m_angle; }
 
-		void SetBias(float value)	{ m_bias = value; }
+		void SetBias(float value)	{ m_bias = value; m_isModified = true; }
 		float GetBias()				{ return m_bias; }
 
-		void SetNormalBias(float value) { m_normalBias = value; }
+		void SetNormalBias(float value) { m_normalBias = value; m_isModified = true; }
 		float GetNormalBias()			{ return m_normalBias; }
 
+		// Directional lights are clamped to shine from above
 		Math::Vector3 GetDirection();
-		void ClampRotation();
 
 		Math::Matrix GetViewMatrix() { return m_viewMatrix; }
 
@@ -98,6 +98,7 @@ namespace Directus
 		std::shared_ptr<RHI_RenderTexture> GetShadowMap() { return m_shadowMap; }
 
 	private:
+		static Math::Quaternion ClampRotation(const Math::Quaternion& rotation);
 		void ComputeViewMatrix();
 		bool ShadowMap_ComputeProjectionMatrix(unsigned int index = 0);	
 		void ShadowMap_Create(bool force);
@@ -116,8 +117,10 @@ namespace Directus
 		Math::Vector3 m_lastPosLight;
 		Math::Vector3 m_lastPosCamera;
 		
-		// Shadow map
+		// Shadow map (the array size and resolution are known even when there is no texture, e.g. headless)
 		std::shared_ptr<RHI_RenderTexture> m_shadowMap;
+		unsigned int m_shadowMapArraySize	= 0;
+		unsigned int m_shadowMapResolution	= 0;
 		std::vector<Math::Matrix> m_shadowMapsProjectionMatrix;
 		Renderer* m_renderer;
 	};
@@ -177,6 +177,8 @@ namespace Directus
 	//= GEOMETRY =====================================================================================
 	void Renderable::Geometry_Set(const string& name, unsigned int indexOffset, unsigned int indexCount, unsigned int vertexOffset, unsigned int vertexCount, const BoundingBox& AABB, shared_ptr<Model>& model)
 	{	
+		m_isModified = true;
+
 		m_geometryName			= name;
 		m_geometryIndexOffset	= indexOffset;
 		m_geometryIndexCount	= indexCount;
@@ -188,6 +190,8 @@ namespace Directus
 
 	void Renderable::Geometry_Set(GeometryType type)
 	{
+		m_isModified = true;
+
 		m_geometryType = type;
 
 		if (type != Geometry_Custom)
@@ -222,6 +226,8 @@ namespace Directus
 			LOG_ERROR_INVALID_PARAMETER();
 			return;
 		}
+
+		m_isModified = true;
 		m_material = material;
 	}
 
@@ -244,6 +250,8 @@ namespace Directus
 
 	void Renderable::Material_UseDefault()
 	{
+		m_isModified = true;
+
 		m_materialDefault = true;
 
 		auto projectStandardAssetDir = GetContext()->GetSubsystem<ResourceCache>()->GetProjectStandardAssetsDirectory();
@@ -96,9 +96,9 @@ namespace Directus
 		//=======================================================================
 
 		//= PROPERTIES ===================================================================
-		void SetCastShadows(bool castShadows)		{ m_castShadows = castShadows; }
+		void SetCastShadows(bool castShadows)		{ m_castShadows = castShadows; m_isModified = true; }
 		bool GetCastShadows()						{ return m_castShadows; }
-		void SetReceiveShadows(bool receiveShadows) { m_receiveShadows = receiveShadows; }
+		void SetReceiveShadows(bool receiveShadows) { m_receiveShadows = receiveShadows; m_isModified = true; }
 		bool GetReceiveShadows()					{ return m_receiveShadows; }
 		//================================================================================
 
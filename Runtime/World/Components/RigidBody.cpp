@@ -54,8 +54,9 @@ namespace Directus
 	class MotionState : public btMotionState
 	{
 		RigidBody* m_rigidBody;
+		Physics* m_physics;
 	public:
-		MotionState(RigidBody* rigidBody) { m_rigidBody = rigidBody; }
+		MotionState(RigidBody* rigidBody, Physics* physics) { m_rigidBody = rigidBody; m_physics = physics; }
 		// Update from engine, ENGINE -> BULLET
 		void getWorldTransform(btTransform& worldTrans) const override
 		{
@@ -68,15 +69,13 @@ namespace Directus
 		}
 
 		// Update from bullet, BULLET -> ENGINE
+		// Called from within the step, so the pose is only recorded, physics applies it to the transform after the step
 		void setWorldTransform(const btTransform& worldTrans) override
 		{
 			Quaternion newWorldRot	= ToQuaternion(worldTrans.getRotation());
 			Vector3 newWorldPos		= ToVector3(worldTrans.getOrigin()) - newWorldRot * m_rigidBody->GetCenterOfMass();
 
-			m_rigidBody->GetTransform()->SetPosition(newWorldPos);
-			m_rigidBody->GetTransform()->SetRotation(newWorldRot);
-
-			m_rigidBody->m_hasSimulated = true;
+			m_physics->Sync_Record(m_rigidBody, newWorldPos, newWorldRot);
 		}
 	};
 
@@ -95,6 +94,7 @@ namespace Directus
 		m_physics			= GetContext()->GetSubsystem<Physics>();
 		m_collisionShape	= nullptr;
 		m_rigidBody			= nullptr;
+		m_layer				= 0;
 
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_mass, float);
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_friction, float);
@@ -132,10 +132,15 @@ namespace Directus
 
 	void RigidBody::OnTick()
 	{
-		// When in editor mode, get position from transform (so the user can move the body around)
-		if (!Engine::EngineMode_IsSet(Engine_Game))
+		// When in editor mode, get position from transform (so the user can move the body around).
+		// Only when it was moved, setting it wakes the body up.
+		if (!Engine::EngineMode_IsSet(Engine_Game) && m_rigidBody)
 		{
-			SetPosition(GetTransform()->GetPosition());
+			Vector3 position = GetTransform()->GetPosition();
+			if (position != GetPosition())
+			{
+				SetPosition(position);
+			}
 		}
 	}
 
@@ -151,6 +156,7 @@ namespace Directus
 		stream->Write(m_positionLock);
 		stream->Write(m_rotationLock);
 		stream->Write(m_inWorld);
+		stream->Write(m_layer);
 	}
 
 	void RigidBody::Deserialize(FileStream* stream)
@@ -165,6 +171,13 @@ namespace Directus
 		stream->Read(&m_positionLock);
 		stream->Read(&m_rotationLock);
 		stream->Read(&m_inWorld);
+		// Worlds older than v3 don't save the layer
+		m_layer = 0;
+		if (stream->GetVersion() >= 3)
+		{
+			stream->Read(&m_layer);
+			m_layer = Min(m_layer, 31u);
+		}
 
 		Body_AcquireShape();
 		Body_AddToWorld();
@@ -173,9 +186,12 @@ namespace Directus
 	// = PROPERTIES =========================================================
 	void RigidBody::SetMass(float mass)
 	{
+		m_isModified = true;
+
 		mass = Max(mass, 0.0f);
 		if (mass != m_mass)
 		{
+			auto lock = m_physics->World_Lock();
 			m_mass = mass;
 			Body_AddToWorld();
 		}
@@ -186,6 +202,9 @@ namespace Directus
 		if (!m_rigidBody || m_friction == friction)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_friction = friction;
 		m_rigidBody->setFriction(friction);
 	}
@@ -195,6 +214,9 @@ namespace Directus
 		if (!m_rigidBody || m_frictionRolling == frictionRolling)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_frictionRolling = frictionRolling;
 		m_rigidBody->setRollingFriction(frictionRolling);
 	}
@@ -204,6 +226,9 @@ namespace Directus
 		if (!m_rigidBody || m_restitution == restitution)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_restitution = restitution;
 		m_rigidBody->setRestitution(restitution);
 	}
@@ -213,6 +238,9 @@ namespace Directus
 		if (gravity == m_useGravity)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_useGravity = gravity;
 		Body_AddToWorld();
 	}
@@ -222,6 +250,9 @@ namespace Directus
 		if (m_gravity == acceleration)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_gravity = acceleration;
 		Body_AddToWorld();
 	}
@@ -231,16 +262,34 @@ namespace Directus
 		if (kinematic == m_isKinematic)
 			return;
 
+		m_isModified = true;
+
+		auto lock = m_physics->World_Lock();
 		m_isKinematic = kinematic;
 		Body_AddToWorld();
 	}
 
+	void RigidBody::SetLayer(unsigned int layer)
+	{
+		layer = Min(layer, 31u);
+		if (m_layer == layer)
+			return;
+
+		m_layer = layer;
+		if (m_rigidBody)
+		{
+			auto lock = m_physics->World_Lock();
+			m_rigidBody->setUserIndex(m_layer);
+		}
+	}
+
 	//= FORCE/TORQUE ========================================================
 	void RigidBody::SetLinearVelocity(const Vector3& velocity) const
 	{
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		m_rigidBody->setLinearVelocity(ToBtVector3(velocity));
 		if (velocity != Vector3::Zero)
 		{
@@ -253,6 +302,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		m_rigidBody->setAngularVelocity(ToBtVector3(velocity));
 		if (velocity != Vector3::Zero)
 		{
@@ -265,6 +315,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		Activate();
 
 		if (mode == Force)
@@ -282,6 +333,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		Activate();
 
 		if (mode == Force)
@@ -299,6 +351,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		Activate();
 
 		if (mode == Force)
@@ -329,6 +382,9 @@ namespace Directus
 		if (!m_rigidBody || m_positionLock == lock)
 			return;
 
+		m_isModified = true;
+
+		auto worldLock = m_physics->World_Lock();
 		m_positionLock = lock;
 		Vector3 linearFactor = Vector3(!lock.x, !lock.y, !lock.z);
 		m_rigidBody->setLinearFactor(ToBtVector3(linearFactor));
@@ -351,6 +407,9 @@ namespace Directus
 		if (!m_rigidBody || m_rotationLock == lock)
 			return;
 
+		m_isModified = true;
+
+		auto worldLock = m_physics->World_Lock();
 		m_rotationLock = lock;
 		Vector3 angularFactor = Vector3(!lock.x, !lock.y, !lock.z);
 		m_rigidBody->setAngularFactor(ToBtVector3(angularFactor));
@@ -359,6 +418,7 @@ namespace Directus
 	//= CENTER OF MASS ===============================================
 	void RigidBody::SetCenterOfMass(const Vector3& centerOfMass)
 	{
+		auto lock = m_physics->World_Lock();
 		m_centerOfMass = centerOfMass;
 		SetPosition(GetPosition());
 	}
@@ -381,6 +441,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		btTransform& worldTrans = m_rigidBody->getWorldTransform();
 		worldTrans.setOrigin(ToBtVector3(position + ToQuaternion(worldTrans.getRotation()) * m_centerOfMass));
 
@@ -406,6 +467,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		Vector3 oldPosition = GetPosition();
 		btTransform& worldTrans = m_rigidBody->getWorldTransform();
 		worldTrans.setRotation(ToBtQuaternion(rotation));
@@ -436,6 +498,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		m_rigidBody->clearForces();
 	}
 
@@ -444,6 +507,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		if (m_mass > 0.0f)
 		{
 			m_rigidBody->activate(true);
@@ -455,6 +519,7 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
 		m_rigidBody->setActivationState(WANTS_DEACTIVATION);
 	}
 
@@ -483,6 +548,7 @@ namespace Directus
 
 	void RigidBody::SetShape(btCollisionShape* shape)
 	{
+		auto lock = m_physics->World_Lock();
 		m_collisionShape = shape;
 		if (m_collisionShape)
 		{
@@ -496,14 +562,17 @@ namespace Directus
 
 	void RigidBody::Body_AddToWorld()
 	{
+		// The body is re-created, neither a step nor a query may see it in between
+		auto lock = m_physics->World_Lock();
+
 		if (m_mass < 0.0f)
 		{
 			m_mass = 0.0f;
 		}
 
-		// Transfer inertia to new collision shape
+		// Transfer inertia to new collision shape (concave shapes are static and have none)
 		btVector3 localInertia = btVector3(0, 0, 0);
-		if (m_collisionShape && m_rigidBody)
+		if (m_collisionShape && m_rigidBody && !m_collisionShape->isConcave())
 		{
 			localInertia = m_rigidBody ? m_rigidBody->getLocalInertia() : localInertia;
 			m_collisionShape->calculateLocalInertia(m_mass, localInertia);
@@ -514,7 +583,7 @@ namespace Directus
 		// CONSTRUCTION
 		{
 			// Create a motion state (memory will be freed by the RigidBody)
-			auto motionState = new MotionState(this);
+			auto motionState = new MotionState(this, m_physics);
 			
 			// Info
 			btRigidBody::btRigidBodyConstructionInfo constructionInfo(m_mass, motionState, m_collisionShape, localInertia);
@@ -528,6 +597,7 @@ namespace Directus
 
 			m_rigidBody = new btRigidBody(constructionInfo);
 			m_rigidBody->setUserPointer(this);
+			m_rigidBody->setUserIndex(m_layer);
 		}
 
 		// Reapply constraint positions for new center of mass shift
@@ -568,6 +638,8 @@ namespace Directus
 		if (!m_rigidBody)
 			return;
 
+		auto lock = m_physics->World_Lock();
+
 		// Release any constraints that refer to it
 		for (const auto& constraint : m_constraints)
 		{
@@ -588,6 +660,7 @@ namespace Directus
 
 		if (m_inWorld)
 		{
+			auto lock = m_physics->World_Lock();
 			m_physics->GetWorld()->removeRigidBody(m_rigidBody);
 			delete m_rigidBody->getMotionState();
 			delete m_rigidBody;
@@ -132,6 +132,9 @@ namespace Directus
 		void Deactivate() const;
 		btRigidBody* GetBtRigidBody() { return m_rigidBody; }
 		bool IsInWorld() { return m_inWorld; }
+		// Layer (0 to 31) physics queries filter by
+		void SetLayer(unsigned int layer);
+		unsigned int GetLayer() { return m_layer; }
 		//===================================================
 
 		// Communication with other physics components
@@ -163,6 +166,7 @@ namespace Directus
 		btCollisionShape* m_collisionShape;
 		std::vector<Constraint*> m_constraints;
 		bool m_inWorld;
+		unsigned int m_layer;
 		Physics* m_physics;
 	public:
 		bool m_hasSimulated;
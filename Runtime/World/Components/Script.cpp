@@ -84,6 +84,8 @@ namespace Directus
 
 	bool Script::SetScript(const string& filePath)
 	{
+		m_isModified = true;
+
 		// Instantiate the script
 		m_scriptInstance = make_shared<ScriptInstance>();
 		m_scriptInstance->Instantiate(filePath, GetActor_PtrWeak(), GetContext()->GetSubsystem<Scripting>());
@@ -36,6 +36,18 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	namespace _Transform
+	{
+		// What a transform block stores per transform
+		struct State
+		{
+			Vector3 position;
+			Quaternion rotation;
+			Vector3 scale;
+			Vector3 lookAt;
+		};
+	}
+
 	Transform::Transform(Context* context, Actor* actor, Transform* transform) : IComponent(context, actor, transform)
 	{
 		m_positionLocal		= Vector3::Zero;
@@ -93,6 +105,32 @@ namespace Directus
 
 		UpdateTransform();
 	}
+
+	void Transform::Block_Serialize(const vector<Transform*>& transforms, FileStream* stream)
+	{
+		vector<_Transform::State> states;
+		states.reserve(transforms.size());
+		for (const auto& transform : transforms)
+		{
+			states.push_back({ transform->m_positionLocal, transform->m_rotationLocal, transform->m_scaleLocal, transform->m_lookAt });
+		}
+
+		stream->Write(states.data(), states.size() * sizeof(_Transform::State));
+	}
+
+	void Transform::Block_Deserialize(const vector<Transform*>& transforms, FileStream* stream)
+	{
+		vector<_Transform::State> states(transforms.size());
+		stream->Read(states.data(), states.size() * sizeof(_Transform::State));
+
+		for (unsigned int i = 0; i < (unsigned int)transforms.size(); i++)
+		{
+			transforms[i]->m_positionLocal	= states[i].position;
+			transforms[i]->m_rotationLocal	= states[i].rotation;
+			transforms[i]->m_scaleLocal		= states[i].scale;
+			transforms[i]->m_lookAt			= states[i].lookAt;
+		}
+	}
 	//===============================================================================================
 	void Transform::UpdateTransform()
 	{
@@ -122,7 +160,7 @@ namespace Directus
 		if (GetPosition() == position)
 			return;
 
-		SetPositionLocal(!HasParent() ? position : position * GetParent()->GetMatrix().Inverted());
+		SetPositionLocal(!HasParent() ? position : GetParent()->GetMatrix().InvertedAffine().TransformPoint(position));
 	}
 
 	void Transform::SetPositionLocal(const Vector3& position)
@@ -130,6 +168,8 @@ namespace Directus
 		if (m_positionLocal == position)
 			return;
 
+		m_isModified = true;
+
 		m_positionLocal = position;
 		UpdateTransform();
 	}
@@ -149,6 +189,8 @@ namespace Directus
 		if (m_rotationLocal == rotation)
 			return;
 
+		m_isModified = true;
+
 		m_rotationLocal = rotation;
 		UpdateTransform();
 	}
@@ -168,6 +210,8 @@ namespace Directus
 		if (m_scaleLocal == scale)
 			return;
 
+		m_isModified = true;
+
 		m_scaleLocal = scale;
 
 		// A scale of 0 will cause a division by zero when 
@@ -189,7 +233,7 @@ namespace Directus
 		}
 		else
 		{
-			SetPositionLocal(m_positionLocal + GetParent()->GetMatrix().Inverted() * delta);
+			SetPositionLocal(m_positionLocal + GetParent()->GetMatrix().InvertedAffine().TransformPoint(delta));
 		}
 	}
 
@@ -205,6 +249,26 @@ namespace Directus
 		}	
 	}
 
+	void Transform::SetPositionAndRotation(const Vector3& position, const Quaternion& rotation)
+	{
+		Vector3 positionLocal		= position;
+		Quaternion rotationLocal	= rotation;
+		if (HasParent())
+		{
+			positionLocal = GetParent()->GetMatrix().InvertedAffine().TransformPoint(position);
+			rotationLocal = rotation * GetParent()->GetRotation().Inverse();
+		}
+
+		if (m_positionLocal == positionLocal && m_rotationLocal == rotationLocal)
+			return;
+
+		m_isModified = true;
+
+		m_positionLocal = positionLocal;
+		m_rotationLocal = rotationLocal;
+		UpdateTransform();
+	}
+
 	Vector3 Transform::GetUp()
 	{
 		return GetRotationLocal() * Vector3::Up;
@@ -268,6 +332,8 @@ namespace Directus
 			}
 		}
 
+		m_isModified = true;
+
 		// Switch parent but keep a pointer to the old one
 		auto parentOld = m_parent;
 		m_parent = newParent;
@@ -356,6 +422,15 @@ namespace Directus
 		}
 	}
 
+	void Transform::SetParentUnresolved(Transform* parent)
+	{
+		if (!parent || parent == this)
+			return;
+
+		m_parent = parent;
+		parent->m_children.emplace_back(this);
+	}
+
 	bool Transform::IsDescendantOf(Transform* transform)
 	{
 		vector<Transform*> descendants;
@@ -392,6 +467,8 @@ namespace Directus
 		if (!m_parent)
 			return;
 
+		m_isModified = true;
+
 		// create a temporary reference to the parent
 		Transform* tempRef = m_parent;
 
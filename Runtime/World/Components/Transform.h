@@ -44,6 +44,10 @@ namespace Directus
 		void Deserialize(FileStream* stream) override;
 		//============================================
 
+		// Local state of many transforms in one contiguous block, the hierarchy is stored by the caller
+		static void Block_Serialize(const std::vector<Transform*>& transforms, FileStream* stream);
+		static void Block_Deserialize(const std::vector<Transform*>& transforms, FileStream* stream);
+
 		void UpdateTransform();
 
 		//= POSITION ================================================================
@@ -70,6 +74,8 @@ namespace Directus
 		//= TRANSLATION/ROTATION ==================
 		void Translate(const Math::Vector3& delta);
 		void Rotate(const Math::Quaternion& delta);
+		// World position and rotation at once, updates the hierarchy below this transform a single time
+		void SetPositionAndRotation(const Math::Vector3& position, const Math::Quaternion& rotation);
 		//=========================================
 
 		//= DIRECTIONS ============
@@ -92,11 +98,13 @@ namespace Directus
 		const std::vector<Transform*>& GetChildren() { return m_children; }
 		int GetChildrenCount() { return (int)m_children.size(); }
 		void AcquireChildren();
+		// Appends this transform to the children of the parent without resolving the hierarchy, for loaders which already know it's valid
+		void SetParentUnresolved(Transform* parent);
 		bool IsDescendantOf(Transform* transform);
 		void GetDescendants(std::vector<Transform*>* descendants);
 		//=============================================================================
 
-		void LookAt(const Math::Vector3& v) { m_lookAt = v; }
+		void LookAt(const Math::Vector3& v) { m_lookAt = v; m_isModified = true; }
 		Math::Matrix& GetMatrix()			{ return m_matrix; }
 		Math::Matrix& GetLocalMatrix()		{ return m_matrixLocal; }
 
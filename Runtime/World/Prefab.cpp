@@ -0,0 +1,207 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ======================
+#include "Prefab.h"
+#include "Actor.h"
+#include "Components/Transform.h"
+#include "../IO/FileStream.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _Prefab
+	{
+		static const unsigned int magic		= 0x42465250; // "PRFB"
+		// The world file version its component payloads are written in, files
+		// without the header were written before v3
+		static const unsigned int version	= 3;
+		static const unsigned int legacy	= 2;
+	}
+
+	Prefab::Prefab(Context* context) : IResource(context, Resource_Prefab)
+	{
+
+	}
+
+	bool Prefab::LoadFromFile(const string& filePath)
+	{
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
+		if (!file->IsOpen())
+			return false;
+
+		auto version	= _Prefab::legacy;
+		auto count		= file->ReadUInt();
+		if (count == _Prefab::magic)
+		{
+			version	= file->ReadUInt();
+			count	= file->ReadUInt();
+			if (version == 0 || version > _Prefab::version)
+			{
+				LOGF_ERROR("\"%s\" is not a supported prefab file.", filePath.c_str());
+				return false;
+			}
+		}
+
+		vector<Node> nodes(count);
+		for (unsigned int i = 0; i < (unsigned int)nodes.size() && !file->HasFailed(); i++)
+		{
+			auto& node = nodes[i];
+			file->Read(&node.name);
+			file->Read(&node.flags);
+			file->Read(&node.parent);
+			node.components.resize(file->ReadUInt());
+			for (auto& component : node.components)
+			{
+				component.type = (ComponentType)file->ReadUInt();
+				file->Read(&component.payload);
+			}
+
+			if (node.parent != NoParent && node.parent >= i)
+			{
+				LOGF_ERROR("\"%s\" is corrupted.", filePath.c_str());
+				return false;
+			}
+		}
+
+		if (file->HasFailed())
+		{
+			LOGF_ERROR("\"%s\" is corrupted.", filePath.c_str());
+			return false;
+		}
+
+		m_nodes		= move(nodes);
+		m_version	= version;
+		ComputeMemoryUsage();
+
+		return true;
+	}
+
+	bool Prefab::SaveToFile(const string& filePath)
+	{
+		// Written once and instanced many times
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, FileStreamCompression_High);
+		if (!file->IsOpen())
+			return false;
+
+		file->Write(_Prefab::magic);
+		file->Write(m_version);
+		file->Write((unsigned int)m_nodes.size());
+		for (const auto& node : m_nodes)
+		{
+			file->Write(node.name);
+			file->Write(node.flags);
+			file->Write(node.parent);
+			file->Write((unsigned int)node.components.size());
+			for (const auto& component : node.components)
+			{
+				file->Write((unsigned int)component.type);
+				file->Write(component.payload);
+			}
+		}
+
+		return true;
+	}
+
+	void Prefab::CreateFromActor(Actor* root)
+	{
+		m_nodes.clear();
+		m_version = _Prefab::version;
+		if (!root)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Depth first, so parents always come before their children
+		vector<pair<Actor*, unsigned int>> stack = { { root, NoParent } };
+		while (!stack.empty())
+		{
+			auto [actor, parent] = stack.back();
+			stack.pop_back();
+
+			auto index	= (unsigned int)m_nodes.size();
+			auto& node	= m_nodes.emplace_back();
+			node.name	= actor->GetName();
+			node.flags	= (actor->IsActive() ? 1 : 0) | (actor->IsVisibleInHierarchy() ? 2 : 0);
+			node.parent	= parent;
+
+			for (const auto& component : actor->GetAllComponents())
+			{
+				auto& captured	= node.components.emplace_back();
+				captured.type	= component->GetType();
+
+				FileStream stream(&captured.payload);
+				if (captured.type == ComponentType_Transform)
+				{
+					Transform::Block_Serialize({ static_cast<Transform*>(component.get()) }, &stream);
+				}
+				else
+				{
+					component->Serialize(&stream);
+				}
+			}
+
+			const auto& children = actor->GetTransform_PtrRaw()->GetChildren();
+			for (auto it = children.rbegin(); it != children.rend(); it++)
+			{
+				stack.emplace_back((*it)->GetActor_PtrRaw(), index);
+			}
+		}
+
+		ComputeMemoryUsage();
+	}
+
+	const vector<std::byte>* Prefab::GetPayload(unsigned int node, ComponentType type, unsigned int ordinal) const
+	{
+		if (node >= (unsigned int)m_nodes.size())
+			return nullptr;
+
+		for (const auto& component : m_nodes[node].components)
+		{
+			if (component.type != type)
+				continue;
+
+			if (ordinal-- == 0)
+				return &component.payload;
+		}
+
+		return nullptr;
+	}
+
+	void Prefab::ComputeMemoryUsage()
+	{
+		m_memoryUsage = 0;
+		for (const auto& node : m_nodes)
+		{
+			m_memoryUsage += (unsigned int)(sizeof(Node) + node.name.size());
+			for (const auto& component : node.components)
+			{
+				m_memoryUsage += (unsigned int)(sizeof(Component) + component.payload.size());
+			}
+		}
+	}
+}
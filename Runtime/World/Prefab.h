@@ -0,0 +1,85 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =========================
+#include <vector>
+#include <string>
+#include "../Resource/IResource.h"
+#include "Components/IComponent.h"
+//====================================
+
+namespace Directus
+{
+	class Actor;
+
+	// An actor hierarchy captured as serialized component data. The data is immutable once captured, instances
+	// are decoded from it in bulk (see World::Prefab_Instantiate) and the world file only stores the components
+	// of an instance which differ from it.
+	class ENGINE_CLASS Prefab : public IResource
+	{
+	public:
+		struct Component
+		{
+			ComponentType type = ComponentType_Unknown;
+			std::vector<std::byte> payload;
+		};
+
+		struct Node
+		{
+			std::string name;
+			// 1 = active, 2 = visible in hierarchy
+			unsigned char flags	= 3;
+			// Index of the parent node, parents come before their children
+			unsigned int parent	= NoParent;
+			std::vector<Component> components;
+		};
+
+		static const unsigned int NoParent = 4294967295;
+
+		Prefab(Context* context);
+		~Prefab() = default;
+
+		//= RESOURCE INTERFACE =========================================
+		bool LoadFromFile(const std::string& filePath) override;
+		bool SaveToFile(const std::string& filePath) override;
+		unsigned int GetMemoryUsage() override { return m_memoryUsage; }
+		//==============================================================
+
+		// Captures the actor and its descendants, the actor becomes the root node
+		void CreateFromActor(Actor* root);
+
+		const std::vector<Node>& GetNodes() const { return m_nodes; }
+		// The payload of a node's n-th component of the given type, nullptr if there is no such component
+		const std::vector<std::byte>* GetPayload(unsigned int node, ComponentType type, unsigned int ordinal) const;
+		// The world file version the payloads are written in (see FileStream::SetVersion)
+		unsigned int GetVersion() const { return m_version; }
+
+	private:
+		void ComputeMemoryUsage();
+
+		std::vector<Node> m_nodes;
+		unsigned int m_version		= 3;
+		unsigned int m_memoryUsage	= 0;
+	};
+}
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==========================
 #include "World.h"
 #include "Actor.h"
+#include "Prefab.h"
 #include "Components/Transform.h"
 #include "Components/Camera.h"
 #include "Components/Light.h"
@@ -30,9 +31,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/AudioListener.h"
 #include "Components/Renderable.h"
 #include "../Core/Engine.h"
+#include "../Core/Allocators.h"
 #include "../Core/Stopwatch.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ProgressReport.h"
+#include "../FileSystem/FileSystem.h"
 #include "../IO/FileStream.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
@@ -48,15 +51,106 @@ namespace Directus
 	namespace _World
 	{
 		shared_ptr<Actor> emptyActor;
+		// Components of a parallel phase are handed out to the threads in batches of this size
+		static const unsigned int tickBatchSize = 64;
+
+		// Scene file
+		static const unsigned int sceneMagic	= 0x444C5257; // "WRLD"
+		static const unsigned int sceneVersion	= 3;
+		static const unsigned int sceneNoParent	= 4294967295;
+		static const unsigned int sceneNoPrefab	= 4294967295;
+		// Incremental saves append patches to this file next to the world file
+		static const char* journalExtension		= ".journal";
+		// Once the journal holds this fraction of the world's size, the next save compacts both into a full save
+		static const size_t journalCompactRatio	= 4;
+		// Component blocks are written and decoded in this order, transforms come first
+		// as everything else may depend on them, constraints need their bodies to exist.
+		static const ComponentType sceneBlockOrder[] =
+		{
+			ComponentType_Transform,
+			ComponentType_AudioListener,
+			ComponentType_AudioSource,
+			ComponentType_Camera,
+			ComponentType_Light,
+			ComponentType_Skybox,
+			ComponentType_Renderable,
+			ComponentType_RigidBody,
+			ComponentType_Collider,
+			ComponentType_Constraint,
+			ComponentType_Script
+		};
+		// Components which only touch themselves while deserializing, their blocks are decoded concurrently with the rest
+		inline bool IsDecodeIsolated(ComponentType type) { return type == ComponentType_Camera || type == ComponentType_AudioListener || type == ComponentType_Skybox; }
+
+		struct SceneBlock
+		{
+			ComponentType type = ComponentType_Unknown;
+			vector<unsigned int> actorIndices;
+			vector<unsigned int> componentIDs;
+			vector<IComponent*> components;
+			vector<std::byte> payload;
+			// Components equal to their prefab's have no payload and are decoded from the prefab instead
+			vector<unsigned char> shared;
+			vector<const vector<std::byte>*> sharedPayloads;
+			vector<unsigned int> sharedVersions;
+		};
+
+		// The prefab an actor is saved against, only prefabs which live in a file can be referenced
+		inline Prefab* GetSavedPrefab(Actor* actor)
+		{
+			const auto& prefab = actor->GetPrefab();
+			return prefab && prefab->HasFilePath() ? prefab.get() : nullptr;
+		}
+
+		// Components of the same type belong to the same actor while they are next to each other in a block
+		inline unsigned int NextOrdinal(const vector<unsigned int>& actorIndices, unsigned int index, unsigned int ordinal)
+		{
+			return index > 0 && actorIndices[index - 1] == actorIndices[index] ? ordinal + 1 : 0;
+		}
+
+		// An actor as written to the journal, with all of its components
+		struct JournalRecord
+		{
+			Actor* actor			= nullptr;
+			unsigned int parentID	= sceneNoParent;
+			vector<ComponentType> types;
+			vector<IComponent*> components;
+			vector<vector<std::byte>> payloads;
+		};
+
+		inline void LoadResource(ResourceCache* cache, const string& resourcePath)
+		{
+			if (FileSystem::IsEngineModelFile(resourcePath))
+			{
+				cache->Load<Model>(resourcePath);
+			}
+
+			if (FileSystem::IsEngineMaterialFile(resourcePath))
+			{
+				cache->Load<Material>(resourcePath);
+			}
+
+			if (FileSystem::IsEngineTextureFile(resourcePath))
+			{
+				cache->Load<RHI_Texture>(resourcePath);
+			}
+
+			if (FileSystem::IsEnginePrefabFile(resourcePath))
+			{
+				cache->Load<Prefab>(resourcePath);
+			}
+		}
 	}
 
 	World::World(Context* context) : Subsystem(context)
 	{
-		m_state = Ticking;
-		SUBSCRIBE_TO_EVENT(EVENT_WORLD_RESOLVE, [this](Variant) { m_isDirty = true; });
+		m_state		= Ticking;
+		m_threading	= nullptr;
+		TickPhases_Build();
+		SUBSCRIBE_TO_EVENT(EVENT_WORLD_RESOLVE, [this](const Variant&) { m_isDirty = true; });
 		SUBSCRIBE_TO_EVENT(EVENT_TICK, EVENT_HANDLER(Tick));
-		SUBSCRIBE_TO_EVENT(EVENT_WORLD_STOP, [this](Variant)	{ m_state = Idle; });
-		SUBSCRIBE_TO_EVENT(EVENT_WORLD_START, [this](Variant)	{ m_state = Ticking; });
+		SUBSCRIBE_TO_EVENT(EVENT_WORLD_STOP, [this](const Variant&)	{ m_state = Idle; });
+		SUBSCRIBE_TO_EVENT(EVENT_WORLD_START, [this](const Variant&)	{ m_state = Ticking; });
 	}
 
 	World::~World()
@@ -66,7 +160,8 @@ namespace Directus
 
 	bool World::Initialize()
 	{
-		m_isDirty = true;
+		m_isDirty	= true;
+		m_threading	= m_context->GetSubsystem<Threading>();
 		CreateCamera();
 		CreateSkybox();
 		CreateDirectionalLight();
@@ -78,7 +173,11 @@ namespace Directus
 	{	
 		if (m_state == Request_Loading)
 		{
-			m_state = Loading;
+			{
+				lock_guard<mutex> lock(m_stateMutex);
+				m_state = Loading;
+			}
+			m_stateCondition.notify_all();
 			return;
 		}
 
@@ -109,9 +208,22 @@ namespace Directus
 			}
 		}
 		// ACTOR TICK
-		for (const auto& actor : m_actorsPrimary)
+		bool gathered = false;
+		for (const auto& wave : m_tickWaves)
 		{
-			actor->Tick();
+			if (!gathered)
+			{
+				TickPhases_Gather();
+				gathered = true;
+			}
+
+			TickPhases_Execute(wave);
+
+			// Phases which can change the structure of the world invalidate the gathered components
+			for (const auto phase : wave)
+			{
+				gathered = gathered && !(m_tickPhases[phase].writes & Tick_Structure);
+			}
 		}
 
 		TIME_BLOCK_END_CPU();
@@ -120,7 +232,7 @@ namespace Directus
 		{
 			m_actorsSecondry = m_actorsPrimary;
 			// Submit to the Renderer
-			FIRE_EVENT_DATA(EVENT_WORLD_SUBMIT, m_actorsSecondry);
+			EventSystem::Get().Fire<Event_WorldSubmit>(m_actorsSecondry);
 			m_isDirty = false;
 		}
 	}
@@ -134,7 +246,7 @@ namespace Directus
 	//=========================================================================================================
 
 	//= I/O ===================================================================================================
-	bool World::SaveToFile(const string& filePathIn)
+	bool World::SaveToFile(const string& filePathIn, World_Save mode)
 	{
 		ProgressReport::Get().Reset(g_progress_Scene);
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, true);
@@ -151,39 +263,202 @@ namespace Directus
 		// Save any in-memory changes done to resources while running.
 		m_context->GetSubsystem<ResourceCache>()->SaveResourcesToFiles();
 
+		if (mode == World_Save_Incremental && Journal_Append(filePath))
+		{
+			ProgressReport::Get().SetIsLoading(g_progress_Scene, false);
+			LOG_INFO("Saving (incremental) took " + to_string((int)timer.GetElapsedTimeMs()) + " ms");
+			FIRE_EVENT(EVENT_WORLD_SAVED);
+			return true;
+		}
+
+		// A full save holds everything, so the journal of the previous one goes first
+		auto journalPath = filePath + _World::journalExtension;
+		if (FileSystem::FileExists(journalPath))
+		{
+			FileSystem::DeleteFile_(journalPath);
+		}
+
 		// Create a prefab file
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, FileStreamCompression_Fast);
 		if (!file->IsOpen())
 		{
 			return false;
 		}
 
+		file->Write(_World::sceneMagic);
+		file->Write(_World::sceneVersion);
+
 		// Save currently loaded resource paths
 		vector<string> filePaths;
 		m_context->GetSubsystem<ResourceCache>()->GetResourceFilePaths(filePaths);
 		file->Write(filePaths);
 
 		//= Save actors ============================
-		// Only save root actors as they will also save their descendants
-		vector<shared_ptr<Actor>> rootActors = Actors_GetRoots();
+		// Depth first from the roots, so parents always come before their children
+		vector<Actor*> actors;
+		vector<unsigned int> parents;
+		actors.reserve(m_actorsPrimary.size());
+		parents.reserve(m_actorsPrimary.size());
+		{
+			vector<pair<Transform*, unsigned int>> stack;
+			auto roots = Actors_GetRoots();
+			for (auto it = roots.rbegin(); it != roots.rend(); it++)
+			{
+				stack.emplace_back((*it)->GetTransform_PtrRaw(), _World::sceneNoParent);
+			}
 
-		// 1st - actor count
-		auto rootActorCount = (int)rootActors.size();
-		file->Write(rootActorCount);
+			while (!stack.empty())
+			{
+				auto [transform, parent] = stack.back();
+				stack.pop_back();
+
+				auto index = (unsigned int)actors.size();
+				actors.emplace_back(transform->GetActor_PtrRaw());
+				parents.emplace_back(parent);
+
+				const auto& children = transform->GetChildren();
+				for (auto it = children.rbegin(); it != children.rend(); it++)
+				{
+					stack.emplace_back(*it, index);
+				}
+			}
+		}
 
-		// 2nd - actor IDs
-		for (const auto& root : rootActors)
+		// Actor properties, one column each
+		vector<std::byte> buffer;
+		FileStream stream(&buffer);
 		{
-			file->Write(root->GetID());
+			vector<unsigned int> ids;
+			vector<unsigned char> flags;
+			vector<string> names;
+			for (const auto& actor : actors)
+			{
+				ids.emplace_back(actor->GetID());
+				flags.emplace_back((actor->IsActive() ? 1 : 0) | (actor->IsVisibleInHierarchy() ? 2 : 0));
+				names.emplace_back(actor->GetName());
+			}
+			stream.Write(ids);
+			stream.Write(parents);
+			stream.Write(flags);
+			stream.Write(names);
+
+			// Prefab instances, by index into the list of prefabs
+			vector<string> prefabPaths;
+			vector<unsigned int> prefabs;
+			vector<unsigned int> prefabNodes;
+			for (const auto& actor : actors)
+			{
+				auto prefab = _World::GetSavedPrefab(actor);
+				if (!prefab)
+				{
+					prefabs.emplace_back(_World::sceneNoPrefab);
+					prefabNodes.emplace_back(0);
+					continue;
+				}
+
+				auto it = find(prefabPaths.begin(), prefabPaths.end(), prefab->GetResourceFilePath());
+				prefabs.emplace_back((unsigned int)(it - prefabPaths.begin()));
+				prefabNodes.emplace_back(actor->GetPrefabNode());
+				if (it == prefabPaths.end())
+				{
+					prefabPaths.emplace_back(prefab->GetResourceFilePath());
+				}
+			}
+			stream.Write(prefabPaths);
+			stream.Write(prefabs);
+			stream.Write(prefabNodes);
 		}
 
-		// 3rd - actors
-		for (const auto& root : rootActors)
+		// Components, grouped by type into contiguous blocks
+		vector<_World::SceneBlock> blocks;
+		for (const auto type : _World::sceneBlockOrder)
 		{
-			root->Serialize(file.get());
+			_World::SceneBlock block;
+			block.type = type;
+			for (unsigned int i = 0; i < (unsigned int)actors.size(); i++)
+			{
+				for (const auto& component : actors[i]->GetAllComponents())
+				{
+					if (component->GetType() != type)
+						continue;
+
+					block.actorIndices.emplace_back(i);
+					block.componentIDs.emplace_back(component->GetID());
+					block.components.emplace_back(component.get());
+				}
+			}
+
+			if (!block.components.empty())
+			{
+				blocks.emplace_back(move(block));
+			}
+		}
+
+		// Encoding a block only reads its components, so the blocks are encoded in parallel
+		auto Encode = [&blocks, &actors](unsigned int index)
+		{
+			auto& block = blocks[index];
+			FileStream payload(&block.payload);
+			block.shared.assign(block.components.size(), 0);
+			if (block.type == ComponentType_Transform)
+			{
+				vector<Transform*> transforms;
+				for (const auto& component : block.components) { transforms.emplace_back(static_cast<Transform*>(component)); }
+				Transform::Block_Serialize(transforms, &payload);
+				return;
+			}
+
+			vector<std::byte> scratch;
+			unsigned int ordinal = 0;
+			for (unsigned int i = 0; i < (unsigned int)block.components.size(); i++)
+			{
+				ordinal				= _World::NextOrdinal(block.actorIndices, i, ordinal);
+				auto actor			= actors[block.actorIndices[i]];
+				auto prefab			= _World::GetSavedPrefab(actor);
+				auto prefabPayload	= prefab ? prefab->GetPayload(actor->GetPrefabNode(), block.type, ordinal) : nullptr;
+				if (!prefabPayload)
+				{
+					block.components[i]->Serialize(&payload);
+					continue;
+				}
+
+				// Instances only store what they override
+				scratch.clear();
+				FileStream scratchStream(&scratch);
+				block.components[i]->Serialize(&scratchStream);
+				if (scratch == *prefabPayload)
+				{
+					block.shared[i] = 1;
+					continue;
+				}
+				payload.Write(scratch.data(), scratch.size());
+			}
+		};
+		if (m_threading)
+		{
+			m_threading->ParallelFor((unsigned int)blocks.size(), Encode);
 		}
+		else
+		{
+			for (unsigned int i = 0; i < (unsigned int)blocks.size(); i++) { Encode(i); }
+		}
+
+		stream.Write((unsigned int)blocks.size());
+		for (const auto& block : blocks)
+		{
+			stream.Write((unsigned int)block.type);
+			stream.Write(block.actorIndices);
+			stream.Write(block.componentIDs);
+			stream.Write(block.shared);
+			stream.Write(block.payload);
+		}
+
+		// Everything goes to the file in a single write
+		file->Write(buffer);
 		//==============================================
 
+		Journal_Reset(filePath, buffer.size(), 0);
+
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, false);
 		LOG_INFO("Saving took " + to_string((int)timer.GetElapsedTimeMs()) + " ms");	
 		FIRE_EVENT(EVENT_WORLD_SAVED);
@@ -199,8 +474,13 @@ namespace Directus
 			return false;
 		}
 
-		// Thread safety: Wait for scene and the renderer to stop the actors (could do double buffering in the future)
-		while (m_state != Loading || Renderer::IsRendering()) { m_state = Request_Loading; this_thread::sleep_for(chrono::milliseconds(16)); }
+		// Thread safety: Wait for the simulation thread to stop ticking the actors. The renderer doesn't need to be waited
+		// for, it only reads actors while capturing a snapshot, which happens on the simulation thread.
+		{
+			unique_lock<mutex> lock(m_stateMutex);
+			m_state = Request_Loading;
+			m_stateCondition.wait(lock, [this] { return m_state == Loading; });
+		}
 
 		ProgressReport::Get().Reset(g_progress_Scene);
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, true);
@@ -215,6 +495,16 @@ namespace Directus
 
 		Stopwatch timer;
 
+		auto magic		= file->ReadUInt();
+		auto version	= file->ReadUInt();
+		if (magic != _World::sceneMagic || version == 0 || version > _World::sceneVersion)
+		{
+			LOG_ERROR(filePath + " is not a supported world file.");
+			m_state = Ticking;
+			ProgressReport::Get().SetIsLoading(g_progress_Scene, false);
+			return false;
+		}
+
 		vector<string> resourcePaths;
 		file->Read(&resourcePaths);
 
@@ -224,46 +514,201 @@ namespace Directus
 		auto resourceMng = m_context->GetSubsystem<ResourceCache>();
 		for (const auto& resourcePath : resourcePaths)
 		{
-			if (FileSystem::IsEngineModelFile(resourcePath))
+			_World::LoadResource(resourceMng, resourcePath);
+			ProgressReport::Get().IncrementJobsDone(g_progress_Scene);
+		}
+
+		//= Load actors ============================
+		vector<std::byte> buffer;
+		file->Read(&buffer);
+		FileStream stream(buffer.data(), buffer.size());
+
+		// Actor properties
+		vector<unsigned int> ids;
+		vector<unsigned int> parents;
+		vector<unsigned char> flags;
+		vector<string> names;
+		stream.Read(&ids);
+		stream.Read(&parents);
+		stream.Read(&flags);
+		stream.Read(&names);
+		vector<string> prefabPaths;
+		vector<unsigned int> prefabs(ids.size(), _World::sceneNoPrefab);
+		vector<unsigned int> prefabNodes(ids.size(), 0);
+		if (version >= 2)
+		{
+			stream.Read(&prefabPaths);
+			stream.Read(&prefabs);
+			stream.Read(&prefabNodes);
+		}
+		auto actorCount = (unsigned int)ids.size();
+		if (parents.size() != actorCount || flags.size() != actorCount || names.size() != actorCount || prefabs.size() != actorCount || prefabNodes.size() != actorCount)
+		{
+			LOG_ERROR(filePath + " is corrupted.");
+			m_state = Ticking;
+			ProgressReport::Get().SetIsLoading(g_progress_Scene, false);
+			return false;
+		}
+
+		vector<Actor*> actors(actorCount);
+		m_actorsPrimary.reserve(actorCount);
+		for (unsigned int i = 0; i < actorCount; i++)
+		{
+			auto& actor = Actor_Create();
+			actor->SetID(ids[i]);
+			actor->SetName(names[i]);
+			actor->SetActive(flags[i] & 1);
+			actor->SetHierarchyVisibility(flags[i] & 2);
+			actors[i] = actor.get();
+		}
+
+		// Prefab instances
+		vector<shared_ptr<Prefab>> loadedPrefabs;
+		for (const auto& prefabPath : prefabPaths)
+		{
+			loadedPrefabs.emplace_back(resourceMng->Load<Prefab>(prefabPath));
+		}
+		for (unsigned int i = 0; i < actorCount; i++)
+		{
+			if (prefabs[i] < (unsigned int)loadedPrefabs.size() && loadedPrefabs[prefabs[i]])
 			{
-				resourceMng->Load<Model>(resourcePath);
+				actors[i]->SetPrefab(loadedPrefabs[prefabs[i]], prefabNodes[i]);
 			}
+		}
 
-			if (FileSystem::IsEngineMaterialFile(resourcePath))
+		// Component blocks, all the components are created before any of them is deserialized
+		// as some depend on each other (e.g. a collider sets its shape to a rigid body).
+		vector<_World::SceneBlock> blocks(stream.ReadUInt());
+		for (auto& block : blocks)
+		{
+			block.type = (ComponentType)stream.ReadUInt();
+			stream.Read(&block.actorIndices);
+			stream.Read(&block.componentIDs);
+			vector<unsigned char> shared;
+			if (version >= 2)
 			{
-				resourceMng->Load<Material>(resourcePath);
+				stream.Read(&shared);
 			}
+			stream.Read(&block.payload);
 
-			if (FileSystem::IsEngineTextureFile(resourcePath))
+			unsigned int ordinal = 0;
+			for (unsigned int i = 0; i < (unsigned int)block.actorIndices.size() && i < (unsigned int)block.componentIDs.size(); i++)
 			{
-				resourceMng->Load<RHI_Texture>(resourcePath);
+				ordinal = _World::NextOrdinal(block.actorIndices, i, ordinal);
+				if (block.actorIndices[i] >= actorCount)
+					continue;
+
+				auto actor		= actors[block.actorIndices[i]];
+				auto component	= block.type == ComponentType_Transform ? actor->GetTransform_PtrRaw() : actor->AddComponent(block.type, false).get();
+				if (!component)
+					continue;
+
+				// A shared component whose prefab went missing keeps its defaults
+				const vector<std::byte>* sharedPayload = nullptr;
+				unsigned int sharedVersion = 0;
+				bool isShared = i < (unsigned int)shared.size() && shared[i];
+				if (isShared && actor->GetPrefab())
+				{
+					sharedPayload = actor->GetPrefab()->GetPayload(actor->GetPrefabNode(), block.type, ordinal);
+					sharedVersion = actor->GetPrefab()->GetVersion();
+				}
+
+				component->SetID(block.componentIDs[i]);
+				block.components.emplace_back(component);
+				block.shared.emplace_back(isShared ? 1 : 0);
+				block.sharedPayloads.emplace_back(sharedPayload);
+				block.sharedVersions.emplace_back(sharedVersion);
 			}
-
-			ProgressReport::Get().IncrementJobsDone(g_progress_Scene);
 		}
 
-		//= Load actors ============================	
-		// 1st - Root actor count
-		int rootactorCount = file->ReadInt();
+		auto Decode = [version](_World::SceneBlock& block)
+		{
+			FileStream payload(block.payload.data(), block.payload.size());
+			payload.SetVersion(version);
+			if (block.type == ComponentType_Transform)
+			{
+				vector<Transform*> transforms;
+				for (const auto& component : block.components) { transforms.emplace_back(static_cast<Transform*>(component)); }
+				Transform::Block_Deserialize(transforms, &payload);
+			}
+			else
+			{
+				for (unsigned int i = 0; i < (unsigned int)block.components.size(); i++)
+				{
+					if (!block.shared[i])
+					{
+						block.components[i]->Deserialize(&payload);
+					}
+					else if (block.sharedPayloads[i])
+					{
+						FileStream sharedPayload(block.sharedPayloads[i]->data(), block.sharedPayloads[i]->size());
+						sharedPayload.SetVersion(block.sharedVersions[i]);
+						block.components[i]->Deserialize(&sharedPayload);
+					}
+				}
+			}
+		};
 
-		// 2nd - Root actor IDs
-		for (int i = 0; i < rootactorCount; i++)
+		auto Run = [this](unsigned int count, const function<void(unsigned int)>& job)
 		{
-			auto& actor = Actor_Create();
-			actor->SetID(file->ReadInt());
+			if (m_threading)
+			{
+				m_threading->ParallelFor(count, job);
+				return;
+			}
+
+			for (unsigned int i = 0; i < count; i++) { job(i); }
+		};
+
+		// Transforms and hierarchy, parents are indices to actors that come earlier
+		vector<Transform*> roots;
+		for (auto& block : blocks)
+		{
+			if (block.type == ComponentType_Transform)
+			{
+				Decode(block);
+			}
+		}
+		for (unsigned int i = 0; i < actorCount; i++)
+		{
+			if (parents[i] < i)
+			{
+				actors[i]->GetTransform_PtrRaw()->SetParentUnresolved(actors[parents[i]]->GetTransform_PtrRaw());
+			}
+			else
+			{
+				roots.emplace_back(actors[i]->GetTransform_PtrRaw());
+			}
 		}
+		Run((unsigned int)roots.size(), [&roots](unsigned int i) { roots[i]->UpdateTransform(); });
 
-		// 3rd - actors
-		// It's important to loop with rootactorCount
-		// as the vector size will increase as we deserialize
-		// actors. This is because a actor will also
-		// deserialize their descendants.
-		for (int i = 0; i < rootactorCount; i++)
+		// The rest, isolated blocks are decoded concurrently while the others are decoded in order by a single job
+		vector<_World::SceneBlock*> isolated;
+		vector<_World::SceneBlock*> ordered;
+		for (auto& block : blocks)
 		{
-			m_actorsPrimary[i]->Deserialize(file.get(), nullptr);
+			if (block.type == ComponentType_Transform)
+				continue;
+
+			(_World::IsDecodeIsolated(block.type) ? isolated : ordered).emplace_back(&block);
 		}
+		Run((unsigned int)isolated.size() + (ordered.empty() ? 0 : 1), [&](unsigned int job)
+		{
+			if (job < (unsigned int)isolated.size())
+			{
+				Decode(*isolated[job]);
+				return;
+			}
+
+			for (const auto& block : ordered) { Decode(*block); }
+		});
 		//==============================================
 
+		// Changes saved incrementally since the world file was written, they are in the world file's format.
+		// An older world file is rewritten whole by the next save rather than mixing formats in its journal.
+		auto journalSize = Journal_Replay(filePath, version);
+		Journal_Reset(version == _World::sceneVersion ? filePath : string(), buffer.size(), journalSize);
+
 		m_isDirty	= true;
 		m_state		= Ticking;
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, false);	
@@ -274,10 +719,287 @@ namespace Directus
 	}
 	//===================================================================================================
 
+	//= JOURNAL =======================================================================================
+	bool World::Journal_Append(const string& filePath)
+	{
+		// Patches only make sense against the world file they were made for
+		if (filePath != m_savedFilePath || !FileSystem::FileExists(filePath) || m_journalSize * _World::journalCompactRatio > m_savedSize)
+			return false;
+
+		// New and modified actors are written whole, removed ones by ID
+		unordered_set<unsigned int> actorIDs;
+		vector<Actor*> actors;
+		for (const auto& actor : m_actorsPrimary)
+		{
+			actorIDs.insert(actor->GetID());
+			if (actor->IsModified() || m_savedActorIDs.find(actor->GetID()) == m_savedActorIDs.end())
+			{
+				actors.emplace_back(actor.get());
+			}
+		}
+
+		vector<unsigned int> removed;
+		for (const auto& ID : m_savedActorIDs)
+		{
+			if (actorIDs.find(ID) == actorIDs.end())
+			{
+				removed.emplace_back(ID);
+			}
+		}
+
+		if (actors.empty() && removed.empty())
+			return true;
+
+		vector<std::byte> patch;
+		FileStream stream(&patch);
+		{
+			vector<string> resourcePaths;
+			m_context->GetSubsystem<ResourceCache>()->GetResourceFilePaths(resourcePaths);
+			stream.Write(resourcePaths);
+		}
+		stream.Write(removed);
+		stream.Write((unsigned int)actors.size());
+		for (const auto& actor : actors)
+		{
+			Transform* parent = actor->GetTransform_PtrRaw()->GetParent();
+			stream.Write(actor->GetID());
+			stream.Write(parent ? parent->GetActor_PtrRaw()->GetID() : _World::sceneNoParent);
+			stream.Write((unsigned char)((actor->IsActive() ? 1 : 0) | (actor->IsVisibleInHierarchy() ? 2 : 0)));
+			stream.Write(actor->GetName());
+			auto prefab = _World::GetSavedPrefab(actor);
+			stream.Write(prefab ? prefab->GetResourceFilePath() : string());
+			stream.Write(prefab ? actor->GetPrefabNode() : 0);
+
+			const auto& components = actor->GetAllComponents();
+			stream.Write((unsigned int)components.size());
+			for (const auto& component : components)
+			{
+				vector<std::byte> payload;
+				FileStream payloadStream(&payload);
+				if (component->GetType() == ComponentType_Transform)
+				{
+					Transform::Block_Serialize({ static_cast<Transform*>(component.get()) }, &payloadStream);
+				}
+				else
+				{
+					component->Serialize(&payloadStream);
+				}
+
+				stream.Write((unsigned int)component->GetType());
+				stream.Write(component->GetID());
+				stream.Write(payload);
+			}
+		}
+
+		{
+			FileStream journal(filePath + _World::journalExtension, FileStreamMode_Append, FileStreamCompression_Fast);
+			if (!journal.IsOpen())
+				return false;
+
+			journal.Write(patch);
+		}
+
+		for (const auto& actor : actors)
+		{
+			actor->SetModified(false);
+		}
+		m_savedActorIDs	= move(actorIDs);
+		m_journalSize	+= patch.size();
+
+		return true;
+	}
+
+	bool World::Journal_ApplyPatch(const vector<std::byte>& patch, unsigned int version)
+	{
+		FileStream stream(patch.data(), patch.size());
+		stream.SetVersion(version);
+
+		vector<string> resourcePaths;
+		stream.Read(&resourcePaths);
+		auto resourceMng = m_context->GetSubsystem<ResourceCache>();
+		for (const auto& resourcePath : resourcePaths)
+		{
+			_World::LoadResource(resourceMng, resourcePath);
+		}
+
+		vector<unsigned int> removed;
+		stream.Read(&removed);
+
+		// Actors and their components, all of them exist before any component is deserialized
+		vector<_World::JournalRecord> records(stream.ReadUInt());
+		for (auto& record : records)
+		{
+			unsigned int ID = stream.ReadUInt();
+			record.parentID = stream.ReadUInt();
+			unsigned char flags = 0;
+			stream.Read(&flags);
+			string name;
+			stream.Read(&name);
+			string prefabPath;
+			stream.Read(&prefabPath);
+			unsigned int prefabNode = stream.ReadUInt();
+
+			vector<unsigned int> componentIDs(stream.ReadUInt());
+			for (auto& componentID : componentIDs)
+			{
+				record.types.emplace_back((ComponentType)stream.ReadUInt());
+				componentID = stream.ReadUInt();
+				record.payloads.emplace_back();
+				stream.Read(&record.payloads.back());
+			}
+
+			if (stream.HasFailed())
+				return false;
+
+			record.actor = Actor_GetByID(ID).get();
+			if (!record.actor)
+			{
+				record.actor = Actor_Create().get();
+				record.actor->SetID(ID);
+			}
+			record.actor->SetName(name);
+			record.actor->SetActive(flags & 1);
+			record.actor->SetHierarchyVisibility(flags & 2);
+			record.actor->SetPrefab(!prefabPath.empty() ? resourceMng->Load<Prefab>(prefabPath) : nullptr, prefabNode);
+
+			// Components the actor no longer has
+			vector<unsigned int> stale;
+			for (const auto& component : record.actor->GetAllComponents())
+			{
+				if (component->GetType() != ComponentType_Transform && find(componentIDs.begin(), componentIDs.end(), component->GetID()) == componentIDs.end())
+				{
+					stale.emplace_back(component->GetID());
+				}
+			}
+			for (const auto& componentID : stale)
+			{
+				record.actor->RemoveComponentByID(componentID);
+			}
+
+			for (unsigned int i = 0; i < (unsigned int)componentIDs.size(); i++)
+			{
+				IComponent* component = nullptr;
+				if (record.types[i] == ComponentType_Transform)
+				{
+					component = record.actor->GetTransform_PtrRaw();
+				}
+				else
+				{
+					for (const auto& existing : record.actor->GetAllComponents())
+					{
+						if (existing->GetID() == componentIDs[i])
+						{
+							component = existing.get();
+							break;
+						}
+					}
+
+					if (!component)
+					{
+						component = record.actor->AddComponent(record.types[i]).get();
+					}
+				}
+
+				if (component)
+				{
+					component->SetID(componentIDs[i]);
+				}
+				record.components.emplace_back(component);
+			}
+		}
+
+		if (stream.HasFailed())
+			return false;
+
+		for (const auto type : _World::sceneBlockOrder)
+		{
+			for (const auto& record : records)
+			{
+				for (unsigned int i = 0; i < (unsigned int)record.components.size(); i++)
+				{
+					if (record.types[i] != type || !record.components[i])
+						continue;
+
+					FileStream payload(record.payloads[i].data(), record.payloads[i].size());
+					payload.SetVersion(version);
+					if (type == ComponentType_Transform)
+					{
+						Transform::Block_Deserialize({ static_cast<Transform*>(record.components[i]) }, &payload);
+					}
+					else
+					{
+						record.components[i]->Deserialize(&payload);
+					}
+				}
+			}
+		}
+
+		// Hierarchy, before removing actors as their children may have moved away from them
+		for (const auto& record : records)
+		{
+			const auto& parent = Actor_GetByID(record.parentID);
+			record.actor->GetTransform_PtrRaw()->SetParent(parent ? parent->GetTransform_PtrRaw() : nullptr);
+		}
+		for (const auto& record : records)
+		{
+			record.actor->GetTransform_PtrRaw()->UpdateTransform();
+		}
+
+		for (const auto& ID : removed)
+		{
+			Actor_Remove(Actor_GetByID(ID));
+		}
+
+		return true;
+	}
+
+	size_t World::Journal_Replay(const string& filePath, unsigned int version)
+	{
+		auto journalPath = filePath + _World::journalExtension;
+		if (!FileSystem::FileExists(journalPath))
+			return 0;
+
+		FileStream journal(journalPath, FileStreamMode_Read);
+		if (!journal.IsOpen())
+			return 0;
+
+		// A save which was interrupted leaves a truncated patch at the end, everything before it still applies
+		size_t journalSize = 0;
+		while (!journal.IsAtEnd())
+		{
+			vector<std::byte> patch;
+			journal.Read(&patch);
+			if (journal.HasFailed() || !Journal_ApplyPatch(patch, version))
+			{
+				LOG_WARNING(journalPath + " is corrupted, the changes it holds past this point are lost.");
+				break;
+			}
+
+			journalSize += patch.size();
+		}
+
+		return journalSize;
+	}
+
+	void World::Journal_Reset(const string& filePath, size_t savedSize, size_t journalSize)
+	{
+		m_savedFilePath	= filePath;
+		m_savedSize		= savedSize;
+		m_journalSize	= journalSize;
+
+		m_savedActorIDs.clear();
+		for (const auto& actor : m_actorsPrimary)
+		{
+			m_savedActorIDs.insert(actor->GetID());
+			actor->SetModified(false);
+		}
+	}
+	//================================================================================================
+
 	//= Actor HELPER FUNCTIONS  ====================================================================
 	shared_ptr<Actor>& World::Actor_Create()
 	{
-		auto actor = make_shared<Actor>(m_context);
+		auto actor = Pool_MakeShared<Actor>(m_context);
 		actor->Initialize(actor->AddComponent<Transform>().get());
 		return m_actorsPrimary.emplace_back(actor);
 	}
@@ -373,6 +1095,115 @@ namespace Directus
 	}
 	//===================================================================================================
 
+	//= PREFABS ======================================================================================
+	vector<shared_ptr<Actor>> World::Prefab_Instantiate(const shared_ptr<Prefab>& prefab, unsigned int count, const Matrix* transforms)
+	{
+		vector<shared_ptr<Actor>> roots;
+		if (!prefab || prefab->GetNodes().empty() || count == 0)
+			return roots;
+
+		const auto& nodes	= prefab->GetNodes();
+		const bool link		= prefab->HasFilePath();
+		roots.reserve(count);
+		m_actorsPrimary.reserve(m_actorsPrimary.size() + count * nodes.size());
+
+		// Components are created first and decoded per type afterwards, in the same order a world file is decoded
+		vector<vector<pair<IComponent*, const vector<std::byte>*>>> decode(size(_World::sceneBlockOrder));
+		auto Queue = [&decode](IComponent* component, ComponentType type, const vector<std::byte>* payload)
+		{
+			for (unsigned int i = 0; i < (unsigned int)decode.size(); i++)
+			{
+				if (_World::sceneBlockOrder[i] == type)
+				{
+					decode[i].emplace_back(component, payload);
+					return;
+				}
+			}
+		};
+
+		vector<Actor*> instance(nodes.size());
+		for (unsigned int i = 0; i < count; i++)
+		{
+			for (unsigned int n = 0; n < (unsigned int)nodes.size(); n++)
+			{
+				const auto& node = nodes[n];
+
+				auto actor = Pool_MakeShared<Actor>(m_context);
+				actor->Initialize(actor->AddComponent<Transform>(false).get());
+				actor->SetName(node.name);
+				actor->SetActive(node.flags & 1);
+				actor->SetHierarchyVisibility(node.flags & 2);
+				if (link)
+				{
+					actor->SetPrefab(prefab, n);
+				}
+
+				for (const auto& component : node.components)
+				{
+					auto created = component.type == ComponentType_Transform ? actor->GetTransform_PtrRaw() : actor->AddComponent(component.type, false).get();
+					if (created)
+					{
+						Queue(created, component.type, &component.payload);
+					}
+				}
+
+				if (node.parent < n)
+				{
+					actor->GetTransform_PtrRaw()->SetParentUnresolved(instance[node.parent]->GetTransform_PtrRaw());
+				}
+				else if (n == 0)
+				{
+					roots.emplace_back(actor);
+				}
+
+				instance[n] = actor.get();
+				m_actorsPrimary.emplace_back(move(actor));
+			}
+		}
+
+		for (unsigned int i = 0; i < (unsigned int)decode.size(); i++)
+		{
+			for (const auto& [component, payload] : decode[i])
+			{
+				FileStream stream(payload->data(), payload->size());
+				stream.SetVersion(prefab->GetVersion());
+				if (_World::sceneBlockOrder[i] == ComponentType_Transform)
+				{
+					Transform::Block_Deserialize({ static_cast<Transform*>(component) }, &stream);
+				}
+				else
+				{
+					component->Deserialize(&stream);
+				}
+			}
+
+			// Everything after the transforms may read them, so the instances are placed first
+			if (_World::sceneBlockOrder[i] == ComponentType_Transform)
+			{
+				for (unsigned int r = 0; r < (unsigned int)roots.size(); r++)
+				{
+					auto transform = roots[r]->GetTransform_PtrRaw();
+					if (transforms)
+					{
+						Vector3 scale, position;
+						Quaternion rotation;
+						Matrix(transforms[r]).Decompose(scale, rotation, position);
+						transform->SetPositionLocal(position);
+						transform->SetRotationLocal(rotation);
+						transform->SetScaleLocal(scale);
+					}
+					transform->UpdateTransform();
+				}
+			}
+		}
+
+		// One resolve for the whole batch
+		FIRE_EVENT(EVENT_WORLD_RESOLVE);
+
+		return roots;
+	}
+	//================================================================================================
+
 	//= COMMON ACTOR CREATION ========================================================================
 	shared_ptr<Actor>& World::CreateSkybox()
 	{
@@ -414,4 +1245,129 @@ namespace Directus
 		return light;
 	}
 	//================================================================================================
+
+	//= TICK PHASES ==================================================================================
+	void World::TickPhases_Build()
+	{
+		// Scripts can do anything, so they tick alone. Rigid bodies, constraints and audio go through
+		// Bullet's world and FMOD, they tick on a single thread but next to other phases (a body which
+		// was moved takes the world's exclusive lock, so parallel batches would only wait on each other).
+		// Colliders, skyboxes, renderables and transforms have no per-frame work.
+		m_tickPhases =
+		{
+			{ "Scripts",		{ ComponentType_Script },									Tick_All,						Tick_All,		false },
+			{ "RigidBodies",	{ ComponentType_RigidBody },								Tick_Transform,					Tick_Physics,	false },
+			{ "Constraints",	{ ComponentType_Constraint },								Tick_Physics,					Tick_Physics,	false },
+			{ "Cameras",		{ ComponentType_Camera },									Tick_Transform | Tick_Settings,	Tick_Camera,	true },
+			{ "Lights",			{ ComponentType_Light },									Tick_Transform | Tick_Camera,	Tick_Light,		true },
+			{ "Audio",			{ ComponentType_AudioListener, ComponentType_AudioSource },	Tick_Transform,					Tick_Audio,		false }
+		};
+
+		// Greedily merge consecutive phases into waves, a phase starts a new wave if it conflicts with any phase of the current one
+		m_tickWaves.clear();
+		for (unsigned int i = 0; i < (unsigned int)m_tickPhases.size(); i++)
+		{
+			bool conflicts = m_tickWaves.empty();
+			if (!conflicts)
+			{
+				for (const auto phase : m_tickWaves.back())
+				{
+					conflicts = conflicts || m_tickPhases[phase].ConflictsWith(m_tickPhases[i]);
+				}
+			}
+
+			if (conflicts)
+			{
+				m_tickWaves.emplace_back();
+			}
+			m_tickWaves.back().emplace_back(i);
+		}
+
+		m_tickComponents.resize(ComponentType_Unknown + 1);
+	}
+
+	void World::TickPhases_Gather()
+	{
+		// Clearing keeps the capacity, so this doesn't allocate once the world has settled
+		for (auto& components : m_tickComponents)
+		{
+			components.clear();
+		}
+
+		for (const auto& actor : m_actorsPrimary)
+		{
+			if (!actor->IsActive())
+				continue;
+
+			for (const auto& component : actor->GetAllComponents())
+			{
+				m_tickComponents[component->GetType()].emplace_back(component.get());
+			}
+		}
+	}
+
+	void World::TickPhases_Execute(const vector<unsigned int>& wave)
+	{
+		// Clearing keeps the capacity, so this doesn't allocate once the world has settled
+		auto& jobs = m_tickJobs;
+		jobs.clear();
+
+		// Serial phases go first, so the longest jobs are picked up early
+		for (const auto phase : wave)
+		{
+			if (!m_tickPhases[phase].parallel)
+			{
+				jobs.push_back({ phase, ComponentType_Unknown, 0, 0 });
+			}
+		}
+
+		for (const auto phase : wave)
+		{
+			if (!m_tickPhases[phase].parallel)
+				continue;
+
+			for (const auto type : m_tickPhases[phase].componentTypes)
+			{
+				auto count = (unsigned int)m_tickComponents[type].size();
+				for (unsigned int begin = 0; begin < count; begin += _World::tickBatchSize)
+				{
+					jobs.push_back({ phase, type, begin, min(begin + _World::tickBatchSize, count) });
+				}
+			}
+		}
+
+		auto Execute = [this, &jobs](unsigned int index)
+		{
+			const auto& job = jobs[index];
+			if (job.type == ComponentType_Unknown)
+			{
+				for (const auto type : m_tickPhases[job.phase].componentTypes)
+				{
+					for (const auto& component : m_tickComponents[type])
+					{
+						component->OnTick();
+					}
+				}
+				return;
+			}
+
+			const auto& components = m_tickComponents[job.type];
+			for (unsigned int i = job.begin; i < job.end; i++)
+			{
+				components[i]->OnTick();
+			}
+		};
+
+		if (!m_threading)
+		{
+			for (unsigned int i = 0; i < (unsigned int)jobs.size(); i++)
+			{
+				Execute(i);
+			}
+			return;
+		}
+
+		m_threading->ParallelFor((unsigned int)jobs.size(), Execute);
+	}
+	//================================================================================================
 }
@@ -23,6 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include <vector>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
 #include "../Math/Vector3.h"
 #include "../Threading/Threading.h"
 //=================================
@@ -31,6 +34,56 @@ namespace Directus
 {
 	class Actor;
 	class Light;
+	class IComponent;
+	class Prefab;
+	namespace Math { class Matrix; }
+
+	// What a tick phase touches, phases which don't conflict can tick at the same time
+	enum Tick_Access : unsigned long
+	{
+		Tick_Transform	= 1UL << 0,
+		Tick_Physics	= 1UL << 1,
+		Tick_Camera		= 1UL << 2,
+		Tick_Light		= 1UL << 3,
+		Tick_Audio		= 1UL << 4,
+		Tick_Settings	= 1UL << 5,
+		// Actors and components can be added or removed (invalidates the gathered components)
+		Tick_Structure	= 1UL << 6,
+		Tick_All		= ~0UL
+	};
+
+	struct Tick_Phase
+	{
+		const char* name;
+		std::vector<unsigned int> componentTypes;
+		unsigned long reads;
+		unsigned long writes;
+		// Components of a phase which isn't parallel tick one after the other, on a single thread
+		bool parallel;
+
+		bool ConflictsWith(const Tick_Phase& other) const
+		{
+			return (writes & (other.reads | other.writes)) || (other.writes & (reads | writes));
+		}
+	};
+
+	// Either a batch of a parallel phase or an entire serial phase (type is ComponentType_Unknown)
+	struct Tick_Job
+	{
+		unsigned int phase;
+		unsigned int type;
+		unsigned int begin;
+		unsigned int end;
+	};
+
+	enum World_Save
+	{
+		// Rewrites the whole world file (and drops its journal)
+		World_Save_Full,
+		// Appends the actors which changed since the last save or load to the world's journal,
+		// falls back to a full save when there is nothing to patch or the journal grew too large
+		World_Save_Incremental
+	};
 
 	enum Scene_State
 	{
@@ -54,7 +107,7 @@ namespace Directus
 		void Unload();
 
 		//= IO ========================================
-		bool SaveToFile(const std::string& filePath);
+		bool SaveToFile(const std::string& filePath, World_Save mode = World_Save_Full);
 		bool LoadFromFile(const std::string& filePath);
 		//=============================================
 
@@ -70,6 +123,12 @@ namespace Directus
 		int Actor_GetCount() { return (int)m_actorsPrimary.size(); }
 		//====================================================================================
 
+		//= PREFABS ==========================================================================
+		// Creates count instances of the prefab in one batch and returns their roots. If given, transforms
+		// holds a local transform per instance for the roots, otherwise they keep the prefab's.
+		std::vector<std::shared_ptr<Actor>> Prefab_Instantiate(const std::shared_ptr<Prefab>& prefab, unsigned int count, const Math::Matrix* transforms = nullptr);
+		//====================================================================================
+
 		//= SELECTED ACTOR ===============================================================
 		std::weak_ptr<Actor> GetSelectedActor()				{ return m_actor_selected; }
 		void SetSelectedActor(std::weak_ptr<Actor> actor)	{ m_actor_selected = actor; }
@@ -82,6 +141,19 @@ namespace Directus
 		std::shared_ptr<Actor>& CreateDirectionalLight();
 		//===============================================
 
+		//= JOURNAL =====================================================
+		bool Journal_Append(const std::string& filePath);
+		bool Journal_ApplyPatch(const std::vector<std::byte>& patch, unsigned int version);
+		size_t Journal_Replay(const std::string& filePath, unsigned int version);
+		void Journal_Reset(const std::string& filePath, size_t savedSize, size_t journalSize);
+		//===============================================================
+
+		//= TICK PHASES ====================================================
+		void TickPhases_Build();
+		void TickPhases_Gather();
+		void TickPhases_Execute(const std::vector<unsigned int>& wave);
+		//==================================================================
+
 		// Double-buffered actors
 		std::vector<std::shared_ptr<Actor>> m_actorsPrimary;
 		std::vector<std::shared_ptr<Actor>> m_actorsSecondry;
@@ -92,5 +164,23 @@ namespace Directus
 		bool m_wasInEditorMode;
 		bool m_isDirty;
 		Scene_State m_state;
+		// Hands the world over from the simulation thread to a loading thread
+		std::mutex m_stateMutex;
+		std::condition_variable m_stateCondition;
+
+		// Components tick in phases (by type), consecutive phases which don't conflict form a wave and tick together
+		std::vector<Tick_Phase> m_tickPhases;
+		std::vector<std::vector<unsigned int>> m_tickWaves;
+		// Components of every active actor, gathered by type
+		std::vector<std::vector<IComponent*>> m_tickComponents;
+		// Jobs of the wave being ticked, kept around so the capacity is reused
+		std::vector<Tick_Job> m_tickJobs;
+		Threading* m_threading;
+
+		// What the world file on disk holds, changes relative to it go to the journal
+		std::string m_savedFilePath;
+		std::unordered_set<unsigned int> m_savedActorIDs;
+		size_t m_savedSize		= 0;
+		size_t m_journalSize	= 0;
 	};
 }
\ No newline at end of file
@@ -21,12 +21,16 @@ WIN_SDK_VERSION 		= "10.0.17763.0"
 CPP_VERSION 			= "C++17"
 SOLUTION_NAME 			= "Directus"
 EDITOR_NAME 			= "Editor"
+TESTS_NAME 				= "Tests"
+BENCHMARK_NAME 			= "Benchmark"
 RUNTIME_NAME 			= "Runtime"
 TARGET_DIR_RELEASE 		= "../Binaries/Release"
 TARGET_DIR_DEBUG 		= "../Binaries/Debug"
 INTERMEDIATE_DIR 		= "../Binaries/Intermediate"
 EDITOR_DIR				= "../" .. EDITOR_NAME
 RUNTIME_DIR				= "../" .. RUNTIME_NAME
+TESTS_DIR				= "../" .. TESTS_NAME
+BENCHMARK_DIR			= "../" .. BENCHMARK_NAME
 
 -- Solution
 	solution (SOLUTION_NAME)
@@ -136,4 +140,88 @@ RUNTIME_DIR				= "../" .. RUNTIME_NAME
 	configuration "Release"
 		targetdir (TARGET_DIR_RELEASE)
 		objdir (INTERMEDIATE_DIR)
-		debugdir (TARGET_DIR_RELEASE)
\ No newline at end of file
+		debugdir (TARGET_DIR_RELEASE)
+
+ -- Tests ---------------------------------------------------------------------------------------------------
+	project (TESTS_NAME)
+		location (TESTS_DIR)
+		kind "ConsoleApp"
+		language "C++"
+		files { "../Tests/**.h", "../Tests/**.cpp" }
+		links { RUNTIME_NAME }
+		dependson { RUNTIME_NAME }
+		systemversion(WIN_SDK_VERSION)
+		cppdialect (CPP_VERSION)
+
+-- Includes
+	includedirs { "../Runtime" }
+
+-- Library directory
+	libdirs { "../ThirdParty/mvsc141_x64" }
+
+-- Debug configuration
+	filter "configurations:Debug"
+		defines { "DEBUG", "ENGINE_RUNTIME", "LINKING_STATIC"}
+		symbols "On"
+		staticruntime "On"
+		flags { "MultiProcessorCompile" }
+
+-- Release configuration
+	filter "configurations:Release"
+		defines { "NDEBUG", "ENGINE_RUNTIME", "LINKING_STATIC"}
+		optimize "Full"
+		staticruntime "On"
+		flags { "MultiProcessorCompile", "LinkTimeOptimization" }
+
+-- Output directories
+	configuration "Debug"
+		targetdir (TARGET_DIR_DEBUG)
+		objdir (INTERMEDIATE_DIR)
+		debugdir (TARGET_DIR_DEBUG)
+
+	configuration "Release"
+		targetdir (TARGET_DIR_RELEASE)
+		objdir (INTERMEDIATE_DIR)
+		debugdir (TARGET_DIR_RELEASE)
+
+ -- Benchmark -----------------------------------------------------------------------------------------------
+	project (BENCHMARK_NAME)
+		location (BENCHMARK_DIR)
+		kind "ConsoleApp"
+		language "C++"
+		files { "../Benchmark/**.h", "../Benchmark/**.cpp" }
+		links { RUNTIME_NAME }
+		dependson { RUNTIME_NAME }
+		systemversion(WIN_SDK_VERSION)
+		cppdialect (CPP_VERSION)
+
+-- Includes
+	includedirs { "../Runtime" }
+
+-- Library directory
+	libdirs { "../ThirdParty/mvsc141_x64" }
+
+-- Debug configuration
+	filter "configurations:Debug"
+		defines { "DEBUG", "ENGINE_RUNTIME", "LINKING_STATIC"}
+		symbols "On"
+		staticruntime "On"
+		flags { "MultiProcessorCompile" }
+
+-- Release configuration
+	filter "configurations:Release"
+		defines { "NDEBUG", "ENGINE_RUNTIME", "LINKING_STATIC"}
+		optimize "Full"
+		staticruntime "On"
+		flags { "MultiProcessorCompile", "LinkTimeOptimization" }
+
+-- Output directories
+	configuration "Debug"
+		targetdir (TARGET_DIR_DEBUG)
+		objdir (INTERMEDIATE_DIR)
+		debugdir (TARGET_DIR_DEBUG)
+
+	configuration "Release"
+		targetdir (TARGET_DIR_RELEASE)
+		objdir (INTERMEDIATE_DIR)
+		debugdir (TARGET_DIR_RELEASE)
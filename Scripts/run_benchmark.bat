@@ -0,0 +1,9 @@
+@echo off
+
+:: Runs the benchmarks against the Release build and writes the reports next to it, the exit code is non-zero if any failed
+cd "Binaries\Release"
+Benchmark.exe %*
+set result=%errorlevel%
+cd "..\.."
+
+exit /b %result%
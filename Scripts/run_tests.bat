@@ -0,0 +1,9 @@
+@echo off
+
+:: Runs the tests against the Release build, the exit code is non-zero if any test failed
+cd "Binaries\Release"
+Tests.exe %*
+set result=%errorlevel%
+cd "..\.."
+
+exit /b %result%
@@ -0,0 +1,91 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======
+#include "Test.h"
+#include <cstdio>
+#include <cstring>
+//=================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace Tests
+{
+	namespace _Test
+	{
+		// Function local so that registration doesn't depend on the static initialization order of translation units
+		vector<Test>& GetTests()
+		{
+			static vector<Test> tests;
+			return tests;
+		}
+
+		Context* context		= nullptr;
+		unsigned int failures	= 0;
+	}
+
+	Test_Registrar::Test_Registrar(const char* name, Test_Function function)
+	{
+		_Test::GetTests().push_back(Test{ name, function });
+	}
+
+	bool Check(bool condition, const char* expression, const char* file, int line)
+	{
+		if (!condition)
+		{
+			printf("    %s(%d): CHECK(%s) failed\n", file, line, expression);
+			_Test::failures++;
+		}
+
+		return condition;
+	}
+
+	unsigned int Run(Context* context, const char* filter)
+	{
+		_Test::context = context;
+
+		unsigned int ran	= 0;
+		unsigned int failed	= 0;
+		for (const auto& test : _Test::GetTests())
+		{
+			if (filter && strncmp(test.name, filter, strlen(filter)) != 0)
+				continue;
+
+			_Test::failures = 0;
+			test.function();
+			printf("[%s] %s\n", _Test::failures == 0 ? "PASS" : "FAIL", test.name);
+
+			ran++;
+			failed += _Test::failures == 0 ? 0 : 1;
+		}
+		printf("%u of %u tests passed\n", ran - failed, ran);
+
+		return failed;
+	}
+
+	Context* GetContext()
+	{
+		return _Test::context;
+	}
+}
@@ -0,0 +1,60 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==
+#include <vector>
+//=============
+
+namespace Directus { class Context; }
+
+// A minimal test runner. Every TEST() registers itself before main() runs and every
+// CHECK() that fails is reported with the test, file and line it failed at.
+namespace Tests
+{
+	typedef void (*Test_Function)();
+
+	struct Test
+	{
+		const char* name;
+		Test_Function function;
+	};
+
+	struct Test_Registrar
+	{
+		Test_Registrar(const char* name, Test_Function function);
+	};
+
+	// Returns true if the condition holds, otherwise reports it and fails the running test
+	bool Check(bool condition, const char* expression, const char* file, int line);
+	// Runs every registered test whose name starts with filter (all of them if filter is null), returns the failure count
+	unsigned int Run(Directus::Context* context, const char* filter = nullptr);
+	// The context of the headless engine the tests run against
+	Directus::Context* GetContext();
+}
+
+#define TEST(name)																		\
+	static void Test_##name();															\
+	static Tests::Test_Registrar _test_registrar_##name(#name, Test_##name);			\
+	static void Test_##name()
+
+#define CHECK(condition) Tests::Check((condition), #condition, __FILE__, __LINE__)
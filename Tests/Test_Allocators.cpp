@@ -0,0 +1,118 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include <vector>
+#include "Core/Context.h"
+#include "Core/Engine.h"
+#include "Core/Allocators.h"
+#include "Math/Matrix.h"
+//=============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace _Test_Allocators
+{
+	bool IsAligned(const void* ptr, size_t alignment) { return reinterpret_cast<uintptr_t>(ptr) % alignment == 0; }
+}
+
+TEST(Allocators_PoolRecyclesBlocks)
+{
+	Pool_Allocator pool(24, 16, 4);
+	vector<void*> blocks;
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		blocks.emplace_back(pool.Allocate());
+		CHECK(_Test_Allocators::IsAligned(blocks.back(), 16));
+	}
+	CHECK(pool.GetChunkCount() == 1);
+	CHECK(pool.GetBlocksInUse() == 4);
+	CHECK(pool.GetBlockSize() == 32);
+
+	// Freed blocks are handed out again before another chunk is allocated
+	for (const auto block : blocks) { pool.Deallocate(block); }
+	for (auto& block : blocks) { block = pool.Allocate(); }
+	CHECK(pool.GetChunkCount() == 1);
+
+	blocks.emplace_back(pool.Allocate());
+	CHECK(pool.GetChunkCount() == 2);
+	for (const auto block : blocks) { pool.Deallocate(block); }
+	CHECK(pool.GetBlocksInUse() == 0);
+}
+
+TEST(Allocators_PoolStlAlignsArrays)
+{
+	// Single objects come from the pool, arrays from the heap, both aligned for the type
+	struct alignas(64) Aligned { float data[16]; };
+	Pool_Allocator_Stl<Aligned> allocator;
+	auto single	= allocator.allocate(1);
+	auto array	= allocator.allocate(7);
+	CHECK(_Test_Allocators::IsAligned(single, alignof(Aligned)));
+	CHECK(_Test_Allocators::IsAligned(array, alignof(Aligned)));
+	allocator.deallocate(array, 7);
+	allocator.deallocate(single, 1);
+
+	vector<Math::Matrix, Pool_Allocator_Stl<Math::Matrix>> matrices(5);
+	CHECK(_Test_Allocators::IsAligned(matrices.data(), alignof(Math::Matrix)));
+}
+
+TEST(Allocators_FrameArenaGrows)
+{
+	Frame_Arena arena(256);
+	CHECK(_Test_Allocators::IsAligned(arena.Allocate(8, 64), 64));
+	CHECK(_Test_Allocators::IsAligned(arena.Allocate<double>(4), alignof(double)));
+
+	// A request which doesn't fit goes to the heap, and the next reset grows the arena to fit it
+	CHECK(arena.Allocate(1024) != nullptr);
+	arena.Reset();
+	CHECK(arena.GetOverflowsLastFrame() == 1);
+	CHECK(arena.GetCapacity() >= 1024);
+
+	arena.Allocate(1024);
+	arena.Reset();
+	CHECK(arena.GetOverflowsLastFrame() == 0);
+}
+
+TEST(Allocators_FramesSettle)
+{
+	// Whole engine frames of the current world, once it has settled they shouldn't allocate
+	const unsigned int frameCount	= 60;
+	auto engine						= Tests::GetContext()->GetSubsystem<Engine>();
+	engine->Tick(frameCount);
+
+	uint64_t heapAllocations		= Allocation_Counters::GetHeapAllocations();
+	uint64_t poolChunkAllocations	= Allocation_Counters::GetPoolChunkAllocations();
+	unsigned int arenaOverflows		= 0;
+	for (unsigned int i = 0; i < frameCount; i++)
+	{
+		engine->Tick();
+		arenaOverflows += Frame_Arena::Get().GetOverflowsLastFrame();
+	}
+
+	CHECK(Allocation_Counters::GetPoolChunkAllocations() == poolChunkAllocations);
+	CHECK(arenaOverflows == 0);
+	// Heap allocations are only counted when the engine is built with ALLOCATION_TRACKING
+	CHECK(!Allocation_Counters::IsHeapTracked() || Allocation_Counters::GetHeapAllocations() == heapAllocations);
+}
@@ -0,0 +1,157 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include <memory>
+#include <thread>
+#include "Core/EventSystem.h"
+#include "Core/Variant.h"
+#include "Core/Allocators.h"
+//=============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+// Every test uses a private event system, so that the engine's subscribers don't take part
+
+TEST(Events_SubscribeWhileFiring)
+{
+	// The new function is only called by the next event
+	auto events			= make_unique<EventSystem>();
+	unsigned int calls	= 0;
+	EventHandle added;
+	events->Subscribe(EVENT_TICK, [&events, &calls, &added](const Variant&)
+	{
+		if (added.eventID == -1)
+		{
+			added = events->Subscribe(EVENT_TICK, [&calls](const Variant&) { calls++; });
+		}
+	});
+
+	events->Fire(EVENT_TICK);
+	CHECK(calls == 0);
+	events->Fire(EVENT_TICK);
+	CHECK(calls == 1);
+}
+
+TEST(Events_UnsubscribeWhileFiring)
+{
+	// From a handler which comes before, from itself and before a pending subscription takes effect
+	auto events				= make_unique<EventSystem>();
+	unsigned int callsSelf	= 0;
+	unsigned int callsLater	= 0;
+	unsigned int callsAdded	= 0;
+	EventHandle self, later;
+	self = events->Subscribe(EVENT_TICK, [&](const Variant&)
+	{
+		callsSelf++;
+		events->Unsubscribe(later);
+		events->Unsubscribe(self);
+		events->Unsubscribe(events->Subscribe(EVENT_TICK, [&callsAdded](const Variant&) { callsAdded++; }));
+	});
+	later = events->Subscribe(EVENT_TICK, [&callsLater](const Variant&) { callsLater++; });
+
+	events->Fire(EVENT_TICK);
+	events->Fire(EVENT_TICK);
+	CHECK(callsSelf == 1);
+	CHECK(callsLater == 0);
+	CHECK(callsAdded == 0);
+}
+
+TEST(Events_DeferredOrder)
+{
+	// Deferred events are fired in the order they were posted (per thread), events deferred while dispatching wait for the next dispatch
+	auto events						= make_unique<EventSystem>();
+	const unsigned int threadCount	= 4;
+	const unsigned int perThread	= 1000;
+	vector<int> received;
+	events->Subscribe(EVENT_TICK, [&events, &received](const Variant& data)
+	{
+		received.emplace_back(data.Get<int>());
+		if (data.Get<int>() == -1)
+		{
+			events->Deferred_Fire(EVENT_TICK, -2);
+		}
+	});
+
+	vector<thread> threads;
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&events, t, perThread]()
+		{
+			for (unsigned int i = 0; i < perThread; i++)
+			{
+				events->Deferred_Fire(EVENT_TICK, (int)(t * perThread + i));
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	events->Deferred_Fire(EVENT_TICK, -1);
+	events->Deferred_Dispatch();
+
+	CHECK(received.size() == threadCount * perThread + 1);
+	CHECK(!received.empty() && received.back() == -1);
+	bool ordered = true;
+	vector<int> last(threadCount, -1);
+	for (unsigned int i = 0; ordered && i + 1 < (unsigned int)received.size(); i++)
+	{
+		int t	= received[i] / perThread;
+		ordered	= received[i] > last[t];
+		last[t]	= received[i];
+	}
+	CHECK(ordered);
+
+	received.clear();
+	events->Deferred_Dispatch();
+	CHECK(received.size() == 1 && received[0] == -2);
+}
+
+TEST(Events_DeferredPoolSettles)
+{
+	// Once their pool has settled, deferred events don't allocate and none of them get lost
+	auto events						= make_unique<EventSystem>();
+	const unsigned int iterations	= 10000;
+	const unsigned int batch		= 100;
+	unsigned int calls				= 0;
+	events->Subscribe(EVENT_TICK, [&calls](const Variant&) { calls++; });
+
+	for (unsigned int i = 0; i < batch; i++) { events->Deferred_Fire(EVENT_TICK, (int)i); }
+	events->Deferred_Dispatch();
+
+	uint64_t chunks = Allocation_Counters::GetPoolChunkAllocations();
+	for (unsigned int i = 0; i < iterations; i += batch)
+	{
+		for (unsigned int j = 0; j < batch; j++)
+		{
+			events->Deferred_Fire(EVENT_TICK, (int)j);
+		}
+		events->Deferred_Dispatch();
+	}
+
+	CHECK(Allocation_Counters::GetPoolChunkAllocations() == chunks);
+	CHECK(calls == iterations + batch);
+}
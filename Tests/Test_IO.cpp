@@ -0,0 +1,203 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================================
+#include "Test.h"
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include "Core/Context.h"
+#include "Core/Stopwatch.h"
+#include "World/World.h"
+#include "World/Actor.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Light.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#include "Threading/Threading.h"
+#include "FileSystem/FileSystem.h"
+//=============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus;
+using namespace Directus::Math;
+//=============================
+
+namespace _Test_IO
+{
+	// What a world file has to preserve of an actor
+	struct ActorRecord
+	{
+		string name;
+		bool active					= false;
+		unsigned int parentID		= 0;
+		bool hasParent				= false;
+		unsigned int childCount		= 0;
+		Vector3 position;
+		vector<ComponentType> components;
+		float mass					= 0.0f;
+		float friction				= 0.0f;
+		unsigned int layer			= 0;
+		float range					= 0.0f;
+		float intensity				= 0.0f;
+	};
+
+	ActorRecord Record(Actor* actor)
+	{
+		ActorRecord record;
+		record.name			= actor->GetName();
+		record.active		= actor->IsActive();
+		auto transform		= actor->GetTransform_PtrRaw();
+		record.hasParent	= transform->HasParent();
+		record.parentID		= record.hasParent ? transform->GetParent()->GetActor_PtrRaw()->GetID() : 0;
+		record.childCount	= (unsigned int)transform->GetChildrenCount();
+		record.position		= transform->GetPositionLocal();
+		for (const auto& component : actor->GetAllComponents())
+		{
+			record.components.emplace_back(component->GetType());
+		}
+		sort(record.components.begin(), record.components.end());
+		if (auto rigidBody = actor->GetComponent<RigidBody>())
+		{
+			record.mass		= rigidBody->GetMass();
+			record.friction	= rigidBody->GetFriction();
+			record.layer	= rigidBody->GetLayer();
+		}
+		if (auto light = actor->GetComponent<Light>())
+		{
+			record.range		= light->GetRange();
+			record.intensity	= light->GetIntensity();
+		}
+		return record;
+	}
+
+	bool operator==(const ActorRecord& a, const ActorRecord& b)
+	{
+		return
+			a.name		== b.name		&& a.active		== b.active		&& a.hasParent	== b.hasParent	&& a.parentID	== b.parentID	&&
+			a.childCount== b.childCount	&& a.position	== b.position	&& a.components	== b.components	&& a.mass		== b.mass		&&
+			a.friction	== b.friction	&& a.layer		== b.layer		&& a.range		== b.range		&& a.intensity	== b.intensity;
+	}
+
+	// Hierarchies of a few levels, with fields which differ from their defaults and between actors
+	void CreateWorld(World* world, unsigned int actorCount, unsigned int hierarchyDepth)
+	{
+		Transform* parent = nullptr;
+		for (unsigned int i = 0; i < actorCount; i++)
+		{
+			auto& actor				= world->Actor_Create();
+			Transform* transform	= actor->GetTransform_PtrRaw();
+			actor->SetName("Actor_" + to_string(i));
+			actor->SetActive(i % 11 != 0);
+			if (i % hierarchyDepth != 0)
+			{
+				transform->SetParent(parent);
+			}
+			transform->SetPositionLocal(Vector3((float)i, (float)(i % hierarchyDepth), 0.0f));
+			parent = transform;
+
+			if (i % 3 == 0)
+			{
+				auto light = actor->AddComponent<Light>();
+				light->SetLightType(LightType_Point);
+				light->SetRange(1.0f + i % 4);
+				light->SetIntensity(0.5f + i % 3);
+			}
+
+			if (i % 2 == 0)
+			{
+				actor->AddComponent<Collider>();
+				auto rigidBody = actor->AddComponent<RigidBody>();
+				rigidBody->SetMass(1.0f + i % 7);
+				rigidBody->SetFriction(0.1f * (i % 5));
+				rigidBody->SetLayer(1 + i % 31);
+			}
+		}
+	}
+
+	// The world only lets go of its actors once it ticks, so it's loaded on another thread while this one ticks it
+	bool LoadWorld(Context* context, const string& filePath)
+	{
+		auto world			= context->GetSubsystem<World>();
+		auto done			= make_shared<atomic<bool>>(false);
+		auto success		= make_shared<atomic<bool>>(false);
+		context->GetSubsystem<Threading>()->AddTask([world, filePath, done, success]()
+		{
+			*success	= world->LoadFromFile(filePath);
+			*done		= true;
+		});
+
+		Stopwatch stopwatch;
+		while (!*done)
+		{
+			if (stopwatch.GetElapsedTimeSec() > 60.0f)
+				return false;
+
+			world->Tick();
+			this_thread::yield();
+		}
+		return *success;
+	}
+}
+
+TEST(IO_WorldRoundTrip)
+{
+	// A world saved and loaded back, everything the file holds has to come back the same
+	auto context	= Tests::GetContext();
+	auto world		= context->GetSubsystem<World>();
+	world->Unload();
+	_Test_IO::CreateWorld(world, 1000, 4);
+
+	unordered_map<unsigned int, _Test_IO::ActorRecord> records;
+	for (const auto& actor : world->Actors_GetAll())
+	{
+		records[actor->GetID()] = _Test_IO::Record(actor.get());
+	}
+
+	const string directory	= "Tests//";
+	const string filePath	= directory + "RoundTrip" + EXTENSION_WORLD;
+	FileSystem::CreateDirectory_(directory);
+	bool saved				= world->SaveToFile(filePath);
+	bool loaded				= saved && _Test_IO::LoadWorld(context, filePath);
+	CHECK(saved);
+	CHECK(loaded);
+
+	if (loaded)
+	{
+		auto actors = world->Actors_GetAll();
+		CHECK(actors.size() == records.size());
+
+		unsigned int mismatches = 0;
+		for (const auto& actor : actors)
+		{
+			auto it = records.find(actor->GetID());
+			mismatches += (it == records.end() || !(_Test_IO::Record(actor.get()) == it->second)) ? 1 : 0;
+		}
+		CHECK(mismatches == 0);
+	}
+
+	// Leave a default world behind for the tests after this one
+	FileSystem::DeleteDirectory(directory);
+	world->Unload();
+	world->Initialize();
+}
@@ -0,0 +1,273 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include <vector>
+#include <random>
+#include <cstring>
+#include <algorithm>
+#include "Math/Matrix.h"
+#include "Math/Vector3.h"
+#include "Math/Quaternion.h"
+#include "Math/BoundingBox.h"
+#include "Math/Ray.h"
+#include "RHI/RHI_Vertex.h"
+//=============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus;
+using namespace Directus::Math;
+//=============================
+
+namespace _Test_Math
+{
+	// Distance between two floats in units in the last place, 0 means bitwise equal (or both zero)
+	uint32_t Ulps(float a, float b)
+	{
+		int32_t ia, ib;
+		memcpy(&ia, &a, sizeof(float));
+		memcpy(&ib, &b, sizeof(float));
+		// Map the sign-magnitude representation onto a monotonic integer line
+		ia = ia < 0 ? INT32_MIN - ia : ia;
+		ib = ib < 0 ? INT32_MIN - ib : ib;
+		return ia > ib ? (uint32_t)((int64_t)ia - ib) : (uint32_t)((int64_t)ib - ia);
+	}
+
+	uint32_t Ulps(const Matrix& a, const Matrix& b)
+	{
+		uint32_t ulps = 0;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			ulps = max(ulps, Ulps(a.Data()[i], b.Data()[i]));
+		}
+		return ulps;
+	}
+
+	uint32_t Ulps(const Vector3& a, const Vector3& b)
+	{
+		return max(max(Ulps(a.x, b.x), Ulps(a.y, b.y)), Ulps(a.z, b.z));
+	}
+
+	uint32_t Ulps(const BoundingBox& a, const BoundingBox& b)
+	{
+		return max(Ulps(a.GetMin(), b.GetMin()), Ulps(a.GetMax(), b.GetMax()));
+	}
+
+	// Largest difference between the elements, relative to the largest element of the reference (or 1, if smaller)
+	float Error(const Matrix& value, const Matrix& reference)
+	{
+		float difference	= 0.0f;
+		float magnitude		= 1.0f;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			difference	= max(difference, fabs(value.Data()[i] - reference.Data()[i]));
+			magnitude	= max(magnitude, fabs(reference.Data()[i]));
+		}
+		return difference / magnitude;
+	}
+
+	// A world matrix, like the ones transforms produce
+	Matrix RandomTransform(mt19937& random)
+	{
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		uniform_real_distribution<float> angle(-180.0f, 180.0f);
+		uniform_real_distribution<float> scale(0.5f, 2.0f);
+		return Matrix
+		(
+			Vector3(position(random), position(random), position(random)),
+			Quaternion::FromEulerAngles(angle(random), angle(random), angle(random)),
+			Vector3(scale(random), scale(random), scale(random))
+		);
+	}
+
+	// A general (e.g. projective) matrix, kept diagonally dominant so that it's well conditioned
+	Matrix RandomMatrix(mt19937& random)
+	{
+		uniform_real_distribution<float> element(-1.0f, 1.0f);
+		Matrix matrix;
+		float* elements = &matrix.m00;
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			elements[i] = element(random) + ((i % 5 == 0) ? 4.0f : 0.0f);
+		}
+		return matrix;
+	}
+
+	Vector3 RandomPoint(mt19937& random)
+	{
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		return Vector3(position(random), position(random), position(random));
+	}
+
+	BoundingBox RandomBox(mt19937& random)
+	{
+		uniform_real_distribution<float> size(0.1f, 10.0f);
+		Vector3 center = RandomPoint(random);
+		Vector3 extent = Vector3(size(random), size(random), size(random));
+		return BoundingBox(center - extent, center + extent);
+	}
+
+	const unsigned int count		= 10000;
+	const unsigned int countBounds	= 10001; // Not a multiple of 4, so the tail of the ray kernel is covered too
+}
+
+// The SIMD paths against the scalar ones, which stay compiled for this. Products and transforms add the same terms
+// in the same order, so they have to match bitwise, inverses are computed differently and have to be close.
+
+TEST(Matrix_SimdMatchesScalar)
+{
+	mt19937 random(1234);
+	uint32_t ulpsMultiply	= 0;
+	uint32_t ulpsTranspose	= 0;
+	for (unsigned int i = 0; i < _Test_Math::count; i++)
+	{
+		Matrix lhs = _Test_Math::RandomMatrix(random);
+		Matrix rhs = _Test_Math::RandomMatrix(random);
+		ulpsMultiply	= max(ulpsMultiply, _Test_Math::Ulps(lhs * rhs, Matrix::Multiply_Scalar(lhs, rhs)));
+		ulpsTranspose	= max(ulpsTranspose, _Test_Math::Ulps(Matrix::Transpose(lhs), Matrix::Transpose_Scalar(lhs)));
+	}
+	CHECK(ulpsMultiply == 0);
+	CHECK(ulpsTranspose == 0);
+}
+
+TEST(Matrix_BatchedTransformsMatchSingle)
+{
+	mt19937 random(1234);
+	const Matrix transform = _Test_Math::RandomTransform(random);
+	vector<Vector3> points(_Test_Math::count), out(_Test_Math::count);
+	for (auto& point : points)
+	{
+		point = _Test_Math::RandomPoint(random);
+	}
+
+	uint32_t ulpsPoints = 0;
+	vector<Vector3> outScalar(_Test_Math::count);
+	transform.TransformPoints(points.data(), out.data(), _Test_Math::count);
+	transform.TransformPoints_Scalar(points.data(), outScalar.data(), _Test_Math::count);
+	for (unsigned int i = 0; i < _Test_Math::count; i++)
+	{
+		ulpsPoints = max(ulpsPoints, _Test_Math::Ulps(out[i], transform.TransformPoint(points[i])));
+		ulpsPoints = max(ulpsPoints, _Test_Math::Ulps(out[i], outScalar[i]));
+	}
+
+	uint32_t ulpsDirections = 0;
+	transform.TransformDirections(points.data(), out.data(), _Test_Math::count);
+	for (unsigned int i = 0; i < _Test_Math::count; i++)
+	{
+		ulpsDirections = max(ulpsDirections, _Test_Math::Ulps(out[i], transform.TransformDirection(points[i])));
+	}
+
+	CHECK(ulpsPoints == 0);
+	CHECK(ulpsDirections == 0);
+}
+
+TEST(Matrix_InversesAreClose)
+{
+	const float errorMax	= 1e-4f;
+	float errorInvert		= 0.0f;
+	float errorAffine		= 0.0f;
+	mt19937 random(1234);
+	for (unsigned int i = 0; i < _Test_Math::count; i++)
+	{
+		Matrix matrix		= _Test_Math::RandomMatrix(random);
+		Matrix transform	= _Test_Math::RandomTransform(random);
+		errorInvert			= max(errorInvert, _Test_Math::Error(Matrix::Invert(matrix), Matrix::Invert_Scalar(matrix)));
+		errorAffine			= max(errorAffine, _Test_Math::Error(Matrix::InvertAffine(transform), Matrix::Invert_Scalar(transform)));
+	}
+	CHECK(errorInvert <= errorMax);
+	CHECK(errorAffine <= errorMax);
+}
+
+// The bulk bounds kernels against their scalar versions, both do the same operations in the same order, so they have to match bitwise
+
+TEST(Bounds_SimdMatchesScalar)
+{
+	mt19937 random(1234);
+	vector<RHI_Vertex_PosUvNorTan> vertices(_Test_Math::countBounds);
+	vector<Vector3> points(_Test_Math::countBounds);
+	vector<BoundingBox> boxes(_Test_Math::countBounds), boxesOut(_Test_Math::countBounds), boxesOutScalar(_Test_Math::countBounds);
+	vector<Matrix> transforms(_Test_Math::countBounds);
+	for (unsigned int i = 0; i < _Test_Math::countBounds; i++)
+	{
+		points[i]			= _Test_Math::RandomPoint(random);
+		vertices[i].pos[0]	= points[i].x;
+		vertices[i].pos[1]	= points[i].y;
+		vertices[i].pos[2]	= points[i].z;
+		boxes[i]			= _Test_Math::RandomBox(random);
+		transforms[i]		= _Test_Math::RandomTransform(random);
+	}
+
+	BoundingBox fromVertices		= BoundingBox::FromPoints(&vertices[0].pos[0], _Test_Math::countBounds, sizeof(RHI_Vertex_PosUvNorTan));
+	BoundingBox fromVerticesScalar	= BoundingBox::FromPoints_Scalar(&vertices[0].pos[0], _Test_Math::countBounds, sizeof(RHI_Vertex_PosUvNorTan));
+	BoundingBox fromPoints			= BoundingBox::FromPoints(&points[0].x, _Test_Math::countBounds, sizeof(Vector3));
+	BoundingBox fromPointsScalar	= BoundingBox::FromPoints_Scalar(&points[0].x, _Test_Math::countBounds, sizeof(Vector3));
+	CHECK(_Test_Math::Ulps(fromVertices, fromVerticesScalar) == 0);
+	CHECK(_Test_Math::Ulps(fromPoints, fromPointsScalar) == 0);
+
+	uint32_t ulpsTransform = 0;
+	BoundingBox::Transform(boxes.data(), transforms.data(), boxesOut.data(), _Test_Math::countBounds);
+	BoundingBox::Transform_Scalar(boxes.data(), transforms.data(), boxesOutScalar.data(), _Test_Math::countBounds);
+	for (unsigned int i = 0; i < _Test_Math::countBounds; i++)
+	{
+		ulpsTransform = max(ulpsTransform, _Test_Math::Ulps(boxesOut[i], boxesOutScalar[i]));
+	}
+	CHECK(ulpsTransform == 0);
+}
+
+TEST(Bounds_RayHitsMatchScalar)
+{
+	mt19937 random(1234);
+	const BoundingBox first = _Test_Math::RandomBox(random);
+	BoundingBox_SoA boxes;
+	boxes.Add(first);
+	for (unsigned int i = 1; i < _Test_Math::countBounds; i++)
+	{
+		boxes.Add(_Test_Math::RandomBox(random));
+	}
+	boxes.Add(BoundingBox()); // Undefined, can't be hit
+	vector<float> distances(boxes.GetCount()), distancesScalar(boxes.GetCount());
+
+	// Rays along an axis (zero direction components) and diagonal ones, from outside the boxes and from inside one
+	const Ray rays[] =
+	{
+		Ray(Vector3(-200.0f, 0.0f, 0.0f), Vector3(200.0f, 0.0f, 0.0f)),
+		Ray(Vector3(-200.0f, -150.0f, -100.0f), Vector3(200.0f, 150.0f, 100.0f)),
+		Ray(first.GetCenter(), first.GetCenter() + Vector3(1.0f, -2.0f, 3.0f))
+	};
+
+	uint32_t ulpsHits	= 0;
+	bool hitsNone		= true;
+	for (const auto& ray : rays)
+	{
+		ray.HitDistances(boxes, distances.data());
+		ray.HitDistances_Scalar(boxes, distancesScalar.data());
+		for (unsigned int i = 0; i < boxes.GetCount(); i++)
+		{
+			ulpsHits = max(ulpsHits, _Test_Math::Ulps(distances[i], distancesScalar[i]));
+		}
+		hitsNone = hitsNone && distances.back() == INFINITY;
+	}
+	CHECK(ulpsHits == 0);
+	CHECK(hitsNone);
+	CHECK(distances[0] == 0.0f); // The last ray starts inside the first box
+}
@@ -0,0 +1,65 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================
+#include "Test.h"
+#include "Profiling/Profiler.h"
+//==============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace _Test_Profiling
+{
+	// Opens and closes every kind of zone, toggling tracing half way through
+	void Zones(bool enabled)
+	{
+		Profiler::Trace_SetEnabled(enabled);
+		{
+			PROFILE_ZONE("Test_Zone");
+			CHECK(Profiler::Trace_GetDepth() != 0);
+			TIME_BLOCK_START_CPU();
+			TIME_BLOCK_END_CPU();
+			TIME_BLOCK_START_GPU();
+			TIME_BLOCK_END_GPU();
+			TIME_BLOCK_START_MULTI();
+			TIME_BLOCK_END_MULTI();
+			Profiler::Trace_SetEnabled(!enabled);
+		}
+	}
+}
+
+TEST(Profiler_ZonesKeepTheTraceStackBalanced)
+{
+	// Whether tracing is enabled or not, and even when it's toggled while a zone is open
+	const bool enabled			= Profiler::Trace_IsEnabled();
+	const unsigned int depth	= Profiler::Trace_GetDepth();
+
+	_Test_Profiling::Zones(true);
+	CHECK(Profiler::Trace_GetDepth() == depth);
+
+	_Test_Profiling::Zones(false);
+	CHECK(Profiler::Trace_GetDepth() == depth);
+
+	Profiler::Trace_SetEnabled(enabled);
+}
@@ -0,0 +1,208 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "Test.h"
+#include <cstdio>
+#include "RHI/RHI_Pipeline.h"
+#include "RHI/RHI_PipelineState.h"
+#include "RHI/RHI_Device.h"
+//===============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace _Test_RHI
+{
+	// A device which counts what the pipeline asks of it instead of talking to a GPU. It's
+	// created without a draw handle, so the base device stays uninitialized, like a headless one.
+	class Device_Recorder : public RHI_Device
+	{
+	public:
+		Device_Recorder() : RHI_Device(nullptr) {}
+
+		void Draw(unsigned int vertexCount) override															{ draws++; }
+		void DrawIndexed(unsigned int indexCount, unsigned int indexOffset, unsigned int vertexOffset) override	{ draws++; }
+		void ClearRenderTarget(void* renderTarget, const Math::Vector4& color) override							{}
+		void ClearDepthStencil(void* depthStencil, unsigned int flags, float depth, uint8_t stencil) override	{}
+
+		void Set_VertexShader(void* buffer) override																	{ state++; }
+		void Set_PixelShader(void* buffer) override																		{ state++; }
+		void Set_ConstantBuffers(unsigned int startSlot, unsigned int bufferCount, Buffer_Scope scope, void* const* buffer) override	{ resources++; }
+		void Set_Samplers(unsigned int startSlot, unsigned int samplerCount, void* const* samplers) override				{ resources++; }
+		void Set_RenderTargets(unsigned int renderTargetCount, void* const* renderTargets, void* depthStencil) override	{ resources++; }
+		void Set_Textures(unsigned int startSlot, unsigned int resourceCount, void* const* shaderResources) override	{ resources++; }
+		void Set_Viewport(const shared_ptr<RHI_Viewport>& viewport) override											{ resources++; }
+
+		bool Set_DepthEnabled(bool enable) override									{ resources++; return true; }
+		bool Set_AlphaBlendingEnabled(bool enable) override							{ state++; return true; }
+		bool Set_CullMode(Cull_Mode cullMode) override								{ state++; cull++; return true; }
+		bool Set_PrimitiveTopology(PrimitiveTopology_Mode primitiveTopology) override	{ state++; return true; }
+		bool Set_FillMode(Fill_Mode fillMode) override								{ state++; return true; }
+		bool Set_InputLayout(void* inputLayout) override							{ state++; return true; }
+
+		void Reset() { draws = 0; state = 0; cull = 0; resources = 0; }
+
+		// Draw calls
+		unsigned int draws		= 0;
+		// Pipeline state bindings (shaders, input layout, topology, cull mode, fill mode and blending)
+		unsigned int state		= 0;
+		// Cull mode bindings alone
+		unsigned int cull		= 0;
+		// Everything else (render targets, viewport, samplers, textures and constant buffers)
+		unsigned int resources	= 0;
+	};
+
+	// Shaders need a GPU to be created, so the states only differ by their fixed function part
+	shared_ptr<RHI_PipelineState> State(RHI_Pipeline& pipeline, PrimitiveTopology_Mode topology, Cull_Mode cullMode, bool alphaBlending)
+	{
+		return pipeline.State_Get(nullptr, nullptr, topology, cullMode, Fill_Solid, alphaBlending);
+	}
+
+	// What every pass does before it draws
+	void BeginPass(RHI_Pipeline& pipeline)
+	{
+		pipeline.ClearPendingStates();
+		pipeline.SetRenderTarget((void*)&pipeline);
+	}
+
+	void Draw(RHI_Pipeline& pipeline, const RHI_PipelineState& state, bool bindAll)
+	{
+		if (bindAll)
+		{
+			pipeline.State_Invalidate();
+		}
+		pipeline.SetState(state);
+		pipeline.DrawIndexed(36, 0, 0);
+	}
+
+	// The pipeline states a deferred frame asks for, one per draw: shadow cascades, a material sorted
+	// G-Buffer (some materials are two-sided), transparents and lines. With bindAll set, the bound state
+	// is forgotten before every draw, which is how the pipeline bound before it started binding the delta.
+	void Frame(RHI_Pipeline& pipeline, bool bindAll)
+	{
+		const unsigned int drawCount		= 2000;
+		const unsigned int materialCount	= 50;
+
+		auto opaque		= State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, false);
+		auto twoSided	= State(pipeline, PrimitiveTopology_TriangleList, Cull_None, false);
+		auto blended	= State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, true);
+		auto lines		= State(pipeline, PrimitiveTopology_LineList, Cull_Back, false);
+
+		for (unsigned int cascade = 0; cascade < 3; cascade++)
+		{
+			BeginPass(pipeline);
+			for (unsigned int i = 0; i < drawCount; i++) { Draw(pipeline, *opaque, bindAll); }
+		}
+
+		BeginPass(pipeline);
+		for (unsigned int i = 0; i < drawCount; i++)
+		{
+			bool isTwoSided = ((i * materialCount / drawCount) % 5) == 0;
+			Draw(pipeline, isTwoSided ? *twoSided : *opaque, bindAll);
+		}
+
+		BeginPass(pipeline);
+		for (unsigned int i = 0; i < drawCount / 10; i++) { Draw(pipeline, *blended, bindAll); }
+
+		BeginPass(pipeline);
+		Draw(pipeline, *lines, bindAll);
+	}
+}
+
+TEST(Pipeline_IdenticalDrawsBindNothing)
+{
+	auto device = make_shared<_Test_RHI::Device_Recorder>();
+	RHI_Pipeline pipeline(device);
+	auto state = _Test_RHI::State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, false);
+
+	_Test_RHI::BeginPass(pipeline);
+	_Test_RHI::Draw(pipeline, *state, false);
+	CHECK(device->state == 4);
+
+	device->Reset();
+	for (unsigned int i = 0; i < 10; i++) { _Test_RHI::Draw(pipeline, *state, false); }
+	CHECK(device->draws == 10);
+	CHECK(device->state == 0);
+	CHECK(device->resources == 0);
+
+	// The same states come back from the cache
+	CHECK(_Test_RHI::State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, false) == state);
+	CHECK(pipeline.State_GetCachedCount() == 1);
+}
+
+TEST(Pipeline_CullChangeBindsCullOnly)
+{
+	auto device = make_shared<_Test_RHI::Device_Recorder>();
+	RHI_Pipeline pipeline(device);
+	auto back = _Test_RHI::State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, false);
+	auto none = _Test_RHI::State(pipeline, PrimitiveTopology_TriangleList, Cull_None, false);
+
+	_Test_RHI::BeginPass(pipeline);
+	_Test_RHI::Draw(pipeline, *back, false);
+
+	device->Reset();
+	_Test_RHI::Draw(pipeline, *none, false);
+	CHECK(device->cull == 1);
+	CHECK(device->state == 1);
+
+	// A new pass clears the pending state, which has to keep what's bound instead of re-binding it
+	_Test_RHI::BeginPass(pipeline);
+	device->Reset();
+	_Test_RHI::Draw(pipeline, *none, false);
+	CHECK(device->state == 0);
+}
+
+TEST(Pipeline_InvalidateBindsAll)
+{
+	auto device = make_shared<_Test_RHI::Device_Recorder>();
+	RHI_Pipeline pipeline(device);
+	auto state = _Test_RHI::State(pipeline, PrimitiveTopology_TriangleList, Cull_Back, false);
+
+	_Test_RHI::BeginPass(pipeline);
+	_Test_RHI::Draw(pipeline, *state, false);
+
+	// Topology, cull mode, fill mode and blending (there are no shaders or input layout to bind)
+	device->Reset();
+	_Test_RHI::Draw(pipeline, *state, true);
+	CHECK(device->state == 4);
+}
+
+TEST(Pipeline_DeltaBinding)
+{
+	auto device = make_shared<_Test_RHI::Device_Recorder>();
+	RHI_Pipeline pipeline(device);
+
+	_Test_RHI::Frame(pipeline, true);
+	const unsigned int draws	= device->draws;
+	const unsigned int before	= device->state;
+
+	device->Reset();
+	_Test_RHI::Frame(pipeline, false);
+	const unsigned int after	= device->state;
+
+	CHECK(device->draws == draws);
+	CHECK(before == draws * 4);
+	CHECK(after < before);
+	printf("    %u draws, %u state bindings when binding everything, %u when binding the delta\n", draws, before, after);
+}
@@ -0,0 +1,193 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Test.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/RenderGraph.h"
+//=================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace _Test_RenderGraph
+{
+	const unsigned int width	= 1920;
+	const unsigned int height	= 1080;
+	const unsigned int effects	= 6;
+
+	struct Frame
+	{
+		RenderGraph_Resource frame;
+		RenderGraph_Resource gbuffer;
+		RenderGraph_Resource shadows;
+		RenderGraph_Resource shadowsRaw;
+		RenderGraph_Resource ssao;
+		RenderGraph_Resource light;
+		unsigned int passSSAO;
+		// Every pass which survives culling, with everything it reads or writes
+		vector<vector<RenderGraph_Resource>> passes;
+	};
+
+	// A 1080p deferred frame, shaped like the renderer's: shadows and SSAO at half resolution,
+	// a lighting target and a chain of full resolution post-processing effects
+	Frame Build(RenderGraph& graph)
+	{
+		Frame f;
+		graph.Clear();
+		f.frame			= graph.Resource_Import("Frame", nullptr);
+		f.gbuffer		= graph.Resource_Import("GBuffer", nullptr);
+		f.shadows		= graph.Resource_Create("Shadows", width / 2, height / 2, Texture_Format_R8_UNORM);
+		f.shadowsRaw	= graph.Resource_Create("Shadows_Raw", width / 2, height / 2, Texture_Format_R8_UNORM);
+		f.ssao			= graph.Resource_Create("SSAO", width / 2, height / 2, Texture_Format_R8_UNORM);
+		f.light			= graph.Resource_Create("HDR_Light", width, height, Texture_Format_R32G32B32A32_FLOAT);
+
+		auto pass = graph.Pass_Add("GBuffer", nullptr);
+		graph.Pass_Write(pass, f.gbuffer);
+		f.passes.push_back({ f.gbuffer });
+
+		pass = graph.Pass_Add("Shadowing", nullptr);
+		graph.Pass_Read(pass, f.gbuffer);
+		graph.Pass_Write(pass, f.shadowsRaw);
+		graph.Pass_Write(pass, f.shadows);
+		f.passes.push_back({ f.gbuffer, f.shadowsRaw, f.shadows });
+
+		// Nothing reads it, so it has to be culled
+		f.passSSAO = graph.Pass_Add("SSAO", nullptr);
+		graph.Pass_Read(f.passSSAO, f.gbuffer);
+		graph.Pass_Write(f.passSSAO, f.ssao);
+
+		pass = graph.Pass_Add("Light", nullptr);
+		graph.Pass_Read(pass, f.gbuffer);
+		graph.Pass_Read(pass, f.shadows);
+		graph.Pass_Write(pass, f.light);
+		f.passes.push_back({ f.gbuffer, f.shadows, f.light });
+
+		auto res_in = f.light;
+		for (unsigned int i = 0; i < effects; i++)
+		{
+			auto res_out = graph.Resource_Create("Effect", width, height, Texture_Format_R32G32B32A32_FLOAT);
+			pass = graph.Pass_Add("Effect", nullptr);
+			graph.Pass_Read(pass, res_in);
+			graph.Pass_Write(pass, res_out);
+			f.passes.push_back({ res_in, res_out });
+			res_in = res_out;
+		}
+
+		pass = graph.Pass_Add("Present", nullptr);
+		graph.Pass_Read(pass, res_in);
+		graph.Pass_Write(pass, f.frame);
+		f.passes.push_back({ res_in, f.frame });
+
+		return f;
+	}
+
+	void Allocate(RenderGraph& graph)
+	{
+		// The headless device creates no GPU memory, but the render targets still carry their descriptor
+		graph.Allocate(Tests::GetContext()->GetSubsystem<Renderer>()->GetRHIDevice());
+	}
+}
+
+TEST(RenderGraph_Culling)
+{
+	RenderGraph graph;
+	auto frame = _Test_RenderGraph::Build(graph);
+
+	CHECK(graph.Compile());
+	CHECK(graph.GetPassCulledCount() == 1);
+	CHECK(graph.Pass_IsCulled(frame.passSSAO));
+}
+
+TEST(RenderGraph_ImportedIsKept)
+{
+	// Nothing in the graph reads an imported resource, its writer has to survive anyway
+	RenderGraph graph;
+	auto res_imported	= graph.Resource_Import("Imported", nullptr);
+	auto res_transient	= graph.Resource_Create("Transient", 64, 64, Texture_Format_R8G8B8A8_UNORM);
+	auto pass_imported	= graph.Pass_Add("Imported", nullptr);
+	auto pass_transient	= graph.Pass_Add("Transient", nullptr);
+	auto pass_effects	= graph.Pass_Add("SideEffects", nullptr);
+	graph.Pass_Write(pass_imported, res_imported);
+	graph.Pass_Write(pass_transient, res_transient);
+	graph.Pass_Write(pass_effects, res_transient);
+	graph.Pass_SetSideEffects(pass_effects, true);
+
+	CHECK(graph.Compile());
+	CHECK(!graph.Pass_IsCulled(pass_imported));
+	CHECK(graph.Pass_IsCulled(pass_transient));
+	CHECK(!graph.Pass_IsCulled(pass_effects));
+	CHECK(graph.GetPassCulledCount() == 1);
+}
+
+TEST(RenderGraph_Aliasing)
+{
+	RenderGraph graph;
+	auto frame = _Test_RenderGraph::Build(graph);
+	CHECK(graph.Compile());
+
+	// The post-processing chain only ever needs two targets to ping-pong between
+	CHECK(graph.GetPoolSlotCount() == 4);
+	CHECK(graph.GetMemoryAliased() < graph.GetMemoryTransient());
+
+	// Resources which are alive during the same pass can never share a render target
+	_Test_RenderGraph::Allocate(graph);
+	for (const auto& resources : frame.passes)
+	{
+		for (unsigned int i = 0; i < (unsigned int)resources.size(); i++)
+		{
+			for (unsigned int j = i + 1; j < (unsigned int)resources.size(); j++)
+			{
+				const auto& a = graph.Resource_Get(resources[i]);
+				const auto& b = graph.Resource_Get(resources[j]);
+				CHECK(!a || a != b);
+			}
+		}
+	}
+
+	// Re-compiling the same frame has to re-use the pool instead of growing it
+	auto light = graph.Resource_Get(frame.light).get();
+	frame = _Test_RenderGraph::Build(graph);
+	CHECK(graph.Compile());
+	_Test_RenderGraph::Allocate(graph);
+	CHECK(graph.GetPoolSlotCount() == 4);
+	CHECK(graph.Resource_Get(frame.light).get() == light);
+}
+
+TEST(RenderGraph_CulledResourceIsNull)
+{
+	RenderGraph graph;
+	auto frame = _Test_RenderGraph::Build(graph);
+	CHECK(graph.Compile());
+	_Test_RenderGraph::Allocate(graph);
+
+	// A resource written only by a culled pass has no render target, it gets the same shared null an invalid handle gets
+	const auto& ssao = graph.Resource_Get(frame.ssao);
+	CHECK(!ssao);
+	CHECK(&ssao == &graph.Resource_Get(RenderGraph_Resource_Invalid));
+
+	// While resources which survived culling get one
+	CHECK(graph.Resource_Get(frame.shadows) != nullptr);
+	CHECK(graph.Resource_Get(frame.light) != nullptr);
+}
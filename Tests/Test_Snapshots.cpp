@@ -0,0 +1,120 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "Test.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "Rendering/RenderSnapshot.h"
+#include "Profiling/Profiler.h"
+//===================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+TEST(Snapshots_Streaming)
+{
+	// A private pipeline between this thread (the simulation side) and a reader standing in for the render thread.
+	// The reader hands the frame number back as the draw call count, so the stats hand-off can be followed too.
+	// Frames have to arrive in order and the writer can never get more than "depth" frames ahead, while the
+	// depth changes mid-stream (like a resize does).
+	const uint64_t frameCount	= 3000;
+	auto pipeline				= make_unique<RenderSnapshot_Pipeline>(1);
+	atomic<bool> ordered		= true;
+	thread reader([&pipeline, &ordered]()
+	{
+		uint64_t expected = 1;
+		Profiler_RenderStats stats;
+		while (const RenderSnapshot* snapshot = pipeline->Read_Begin())
+		{
+			if (snapshot->frame != expected++) ordered = false;
+			stats.rhiDrawCalls = (unsigned int)snapshot->frame;
+			pipeline->Read_End(&stats);
+		}
+	});
+
+	bool bounded		= true;
+	bool flushed		= true;
+	bool monotonic		= true;
+	unsigned int last	= 0;
+	Profiler_RenderStats stats;
+	for (uint64_t frame = 1; frame <= frameCount; frame++)
+	{
+		if (frame % 100 == 0)
+		{
+			pipeline->SetDepth((unsigned int)(frame / 100) % 3 + 1);
+			flushed = pipeline->GetPublishedCount() == 0 && flushed;
+		}
+
+		// The reader can only take snapshots out, so the count can't grow behind our back
+		RenderSnapshot* snapshot = pipeline->Write_Begin();
+		if (!snapshot) { bounded = false; break; }
+		bounded = pipeline->GetPublishedCount() < pipeline->GetDepth() && bounded;
+		snapshot->frame = frame;
+		pipeline->Write_End();
+
+		if (pipeline->GetStats(&stats))
+		{
+			monotonic	= stats.rhiDrawCalls > last && stats.rhiDrawCalls <= frame && monotonic;
+			last		= stats.rhiDrawCalls;
+		}
+	}
+	pipeline->Flush();
+	flushed = pipeline->GetPublishedCount() == 0 && flushed;
+	if (pipeline->GetStats(&stats))
+	{
+		last = stats.rhiDrawCalls;
+	}
+	pipeline->Stop();
+	reader.join();
+
+	CHECK(ordered);
+	CHECK(bounded);
+	// Nothing is left published after a flush or a depth change
+	CHECK(flushed);
+	CHECK(monotonic);
+	// The flush hands over the stats of the last frame
+	CHECK(last == frameCount);
+	CHECK(!pipeline->Write_Begin());
+}
+
+TEST(Snapshots_StopDrains)
+{
+	// Once stopped, the reader drains what was published and then stops too
+	auto pipeline = make_unique<RenderSnapshot_Pipeline>(2);
+	for (uint64_t frame = 1; frame <= 2; frame++)
+	{
+		pipeline->Write_Begin()->frame = frame;
+		pipeline->Write_End();
+	}
+	pipeline->Stop();
+
+	uint64_t drained = 0;
+	while (const RenderSnapshot* snapshot = pipeline->Read_Begin())
+	{
+		drained = snapshot->frame == drained + 1 ? drained + 1 : 0;
+		pipeline->Read_End();
+	}
+	CHECK(drained == 2);
+}
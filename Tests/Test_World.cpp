@@ -0,0 +1,83 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ============================
+#include "Test.h"
+#include "Core/Context.h"
+#include "Core/Engine.h"
+#include "World/World.h"
+#include "World/Actor.h"
+#include "World/Components/Light.h"
+#include "World/Components/Camera.h"
+#include "World/Components/Transform.h"
+#include "Rendering/Renderer.h"
+//=======================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus;
+using namespace Directus::Math;
+//=============================
+
+TEST(World_DefaultWorldTicksHeadless)
+{
+	// The default world (a camera, a skybox and a directional light) on an engine without a GPU,
+	// so lights have no shadow maps, but the cascades they are drawn with still have to be computed
+	auto context	= Tests::GetContext();
+	auto engine		= context->GetSubsystem<Engine>();
+	auto world		= context->GetSubsystem<World>();
+	auto renderer	= context->GetSubsystem<Renderer>();
+
+	Light* light = nullptr;
+	for (const auto& actor : world->Actors_GetAll())
+	{
+		auto component = actor->GetComponent<Light>();
+		if (component && component->GetLightType() == LightType_Directional)
+		{
+			light = component.get();
+		}
+	}
+	CHECK(light != nullptr);
+	if (!light)
+		return;
+	CHECK(!light->GetShadowMap());
+
+	engine->Tick(3);
+	CHECK(renderer->GetCamera() != nullptr);
+	if (!renderer->GetCamera())
+		return;
+
+	Matrix cascades[3];
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		cascades[i] = light->ShadowMap_GetProjectionMatrix(i);
+		CHECK(cascades[i] != Matrix::Identity);
+	}
+
+	// Moving the camera moves the cascades along with it
+	auto transform = renderer->GetCamera()->GetTransform();
+	transform->SetPosition(transform->GetPosition() + Vector3(100.0f, 0.0f, 100.0f));
+	engine->Tick(1);
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		CHECK(light->ShadowMap_GetProjectionMatrix(i) != cascades[i]);
+	}
+}